@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/ModelDefinition.h"
+#include "BenchmarkUtils.h"
+#include "EL/CompiledExpression.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::EL
+{
+namespace
+{
+constexpr size_t NumEvaluations = 100000;
+
+const auto Variables = VariableTable{MapType{
+  {"spawnflags", Value{6}},
+  {"skin", Value{"2"}},
+  {"frame", Value{3}},
+  {"scale", Value{"0.5"}},
+  {"targetname", Value{"door_1"}},
+}};
+
+const auto Expressions = std::vector<std::string>{
+  R"("progs/armor.mdl")",
+  R"((spawnflags & 4) == 4 && frame > 2)",
+  R"((frame + 1) * 2 - skin % 3)",
+  R"({ "path": "progs/armor.mdl", "skin": skin, "frame": frame })",
+  R"({{
+      spawnflags & 1 -> "progs/g_shot.mdl",
+      spawnflags & 2 -> { "path": "progs/armor.mdl", "skin": skin },
+      "progs/missing.mdl"
+    }})",
+  R"([1, 2, 3, 4, 5, 6, 7, 8][1..frame])",
+};
+} // namespace
+
+TEST_CASE("ExpressionBenchmark.evaluate")
+{
+  for (const auto& source : Expressions)
+  {
+    const auto expression = IO::ELParser::parseStrict(source);
+    const auto compiledExpression = CompiledExpression{expression};
+
+    auto treeResult = Value{};
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumEvaluations; ++i)
+        {
+          treeResult = expression.evaluate(EvaluationContext{Variables});
+        }
+      },
+      "tree: " + source);
+
+    auto compiledResult = Value{};
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumEvaluations; ++i)
+        {
+          compiledResult = compiledExpression.evaluate(Variables);
+        }
+      },
+      "compiled: " + source);
+
+    CHECK(compiledResult == treeResult);
+  }
+}
+
+TEST_CASE("ExpressionBenchmark.modelSpecification")
+{
+  const auto definition = Assets::ModelDefinition{IO::ELParser::parseStrict(R"({{
+      spawnflags & 1 -> "progs/g_shot.mdl",
+      spawnflags & 2 -> { "path": "progs/armor.mdl", "skin": skin, "frame": frame },
+      "progs/missing.mdl"
+    }})")};
+
+  auto specification = Assets::ModelSpecification{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumEvaluations; ++i)
+      {
+        specification = definition.modelSpecification(Variables);
+      }
+    },
+    "model specification");
+
+  CHECK(specification == Assets::ModelSpecification{"progs/armor.mdl", 2, 3});
+}
+} // namespace TrenchBroom::EL
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test/src/Catch2.h"
+#include "Assets/EntityDefinition.h"
+#include "BenchmarkUtils.h"
+#include "IO/DiskIO.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
+#include "IO/FgdParser.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr size_t NumIncludedFiles = 10;
+constexpr size_t NumClassesPerFile = 500;
+
+std::string makeClasses(const size_t fileIndex)
+{
+  auto str = std::string{};
+  for (size_t i = 0; i < NumClassesPerFile; ++i)
+  {
+    str += fmt::format(
+      R"(@PointClass base(Targetname) size(-16 -16 -16, 16 16 16) color(255 128 0)
+  model({{ "path": "models/item_{0}_{1}.mdl", "skin": spawnflags }}) =
+  item_{0}_{1} : "Item {0} {1}"
+[
+  spawnflags(flags) =
+  [
+    1 : "Suspended" : 0
+    2 : "Respawn" : 1
+  ]
+  count(integer) : "Count" : 1
+  speed(float) : "Speed" : "0.5"
+  style(choices) : "Style" : 0 =
+  [
+    0 : "Normal"
+    1 : "Flicker"
+  ]
+  message(string) : "Message"
+]
+
+)",
+      fileIndex,
+      i);
+  }
+  return str;
+}
+
+std::filesystem::path writeDefinitionFiles(const std::filesystem::path& dir)
+{
+  std::filesystem::create_directories(dir);
+
+  auto host = std::string{R"(@BaseClass = Targetname [ targetname(target_source) ])"};
+  host += "\n";
+  for (size_t i = 0; i < NumIncludedFiles; ++i)
+  {
+    const auto filename = fmt::format("include_{}.fgd", i);
+    auto stream = std::ofstream{dir / filename};
+    stream << makeClasses(i);
+    host += fmt::format("@include \"{}\"\n", filename);
+  }
+
+  const auto hostPath = dir / "host.fgd";
+  auto stream = std::ofstream{hostPath};
+  stream << host;
+  return hostPath;
+}
+} // namespace
+
+TEST_CASE("FgdParserBenchmark.parseIncludedFiles")
+{
+  const auto dir = std::filesystem::temp_directory_path() / "FgdParserBenchmark";
+  const auto path = writeDefinitionFiles(dir);
+
+  auto file = Disk::openFile(path).value();
+  auto reader = file->reader().buffer();
+
+  const auto defaultColor = Color{1.0f, 1.0f, 1.0f, 1.0f};
+  const auto numClasses = NumIncludedFiles * NumClassesPerFile;
+
+  auto cache = EntityDefinitionClassInfoCache{};
+  auto status = TestParserStatus{};
+
+  timeLambda(
+    [&]() {
+      auto parser = FgdParser{reader.stringView(), defaultColor, path};
+      CHECK(parser.parseDefinitions(status).size() == numClasses);
+    },
+    fmt::format("parse {} classes in {} included files", numClasses, NumIncludedFiles));
+
+  timeLambda(
+    [&]() {
+      auto parser = FgdParser{reader.stringView(), defaultColor, path};
+      CHECK(parser.parseDefinitions(status, cache, path).size() == numClasses);
+    },
+    fmt::format("parse {} classes and populate cache", numClasses));
+
+  timeLambda(
+    [&]() {
+      auto parser = FgdParser{reader.stringView(), defaultColor, path};
+      CHECK(parser.parseDefinitions(status, cache, path).size() == numClasses);
+    },
+    fmt::format("create {} definitions from cache", numClasses));
+
+  std::filesystem::remove_all(dir);
+}
+
+} // namespace TrenchBroom::IO
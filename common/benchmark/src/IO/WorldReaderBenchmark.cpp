@@ -0,0 +1,163 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr size_t NumEntities = 2'000;
+constexpr size_t NumBrushesPerEntity = 100;
+
+std::string makeMap()
+{
+  auto str = std::string{R"({
+"classname" "worldspawn"
+}
+)"};
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    str += R"({
+"classname" "func_detail"
+)";
+    for (size_t j = 0; j < NumBrushesPerEntity; ++j)
+    {
+      const auto index = i * NumBrushesPerEntity + j;
+      const auto x = static_cast<int>(index % 200) * 32 - 3200;
+      const auto y = static_cast<int>(index / 200 % 200) * 32 - 3200;
+      const auto z = static_cast<int>(index / 40'000) * 32 - 3200;
+      str += fmt::format(
+        R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) tex 0 0 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {6} {9} {8} ) ( {10} {7} {8} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {10} {7} {8} ) ( {6} {7} {11} ) tex 0 0 0 1 1
+( {6} {7} {8} ) ( {6} {7} {11} ) ( {6} {9} {8} ) tex 0 0 0 1 1
+}}
+)",
+        x,
+        y,
+        z,
+        x + 1,
+        y + 1,
+        z + 1,
+        x + 16,
+        y + 16,
+        z + 16,
+        y + 17,
+        x + 17,
+        z + 17);
+    }
+    str += "}\n";
+  }
+
+  return str;
+}
+
+/**
+ * Returns the resident set size of this process in bytes, if it can be determined on
+ * this platform.
+ */
+std::optional<size_t> residentSetSize()
+{
+#ifdef __linux__
+  if (auto* file = std::fopen("/proc/self/statm", "r"))
+  {
+    auto size = 0ul;
+    auto resident = 0ul;
+    const auto count = std::fscanf(file, "%lu %lu", &size, &resident);
+    std::fclose(file);
+
+    if (count == 2)
+    {
+      return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+  }
+#endif
+  return std::nullopt;
+}
+
+void printResidentSetSize(const std::string& message)
+{
+  if (const auto rss = residentSetSize())
+  {
+    printf("Resident set size %s: %zuMB\n", message.c_str(), *rss / (1024u * 1024u));
+  }
+}
+} // namespace
+
+TEST_CASE("WorldReaderBenchmark.loadLargeMap")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto data = makeMap();
+
+  printResidentSetSize("before loading");
+
+  auto status = TestParserStatus{};
+  auto world = std::unique_ptr<Model::WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+      world = reader.read(worldBounds, status);
+    },
+    "load a map with " + std::to_string(NumEntities * NumBrushesPerEntity) + " brushes");
+
+  printResidentSetSize("after loading");
+
+  REQUIRE(world != nullptr);
+  CHECK(status.countStatus(LogLevel::Error) == 0u);
+
+  const auto& entityNodes = world->defaultLayer()->children();
+  REQUIRE(entityNodes.size() == NumEntities);
+  for (const auto* entityNode : entityNodes)
+  {
+    CHECK(entityNode->childCount() == NumBrushesPerEntity);
+  }
+
+  timeLambda([&]() { world.reset(); }, "delete the map");
+
+  printResidentSetSize("after deleting");
+}
+
+} // namespace TrenchBroom::IO
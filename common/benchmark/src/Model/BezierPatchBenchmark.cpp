@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/BezierPatch.h"
+#include "Model/PatchNode.h"
+
+#include <vecmath/bezier_surface.h>
+#include <vecmath/vec.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumPatches = 10'000;
+constexpr size_t SubdivisionsPerSurface = 3;
+
+std::vector<BezierPatch> makePatches()
+{
+  using P = BezierPatch::Point;
+
+  auto result = std::vector<BezierPatch>{};
+  result.reserve(NumPatches);
+  for (size_t i = 0; i < NumPatches; ++i)
+  {
+    const auto x = static_cast<FloatType>(i % 100) * 192.0;
+    const auto y = static_cast<FloatType>(i / 100) * 192.0;
+
+    // a 5x5 patch with 2x2 surfaces that bulges in the middle
+    auto controlPoints = std::vector<P>{};
+    for (size_t row = 0; row < 5; ++row)
+    {
+      for (size_t col = 0; col < 5; ++col)
+      {
+        const auto u = static_cast<FloatType>(col) / 4.0;
+        const auto v = static_cast<FloatType>(row) / 4.0;
+        const auto z = (row % 4 == 0 || col % 4 == 0) ? 0.0 : 32.0;
+        controlPoints.push_back(P{x + u * 128.0, y + v * 128.0, z, u, v});
+      }
+    }
+    result.emplace_back(5, 5, std::move(controlPoints), "texture");
+  }
+  return result;
+}
+
+/**
+ * Evaluates every grid point of the given patch separately, which is how
+ * BezierPatch::evaluate used to work.
+ */
+std::vector<BezierPatch::Point> evaluatePointByPoint(
+  const BezierPatch& patch, const size_t subdivisionsPerSurface)
+{
+  const auto quadsPerSurfaceSide = size_t(1) << subdivisionsPerSurface;
+  const auto gridPointRowCount = patch.surfaceRowCount() * quadsPerSurfaceSide + 1u;
+  const auto gridPointColumnCount = patch.surfaceColumnCount() * quadsPerSurfaceSide + 1u;
+
+  auto grid = std::vector<BezierPatch::Point>{};
+  grid.reserve(gridPointRowCount * gridPointColumnCount);
+
+  for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
+  {
+    const auto surfaceRow = (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
+    const auto v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide)
+                   / static_cast<FloatType>(quadsPerSurfaceSide);
+
+    for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
+    {
+      const auto surfaceCol =
+        (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
+      const auto u = static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide)
+                     / static_cast<FloatType>(quadsPerSurfaceSide);
+
+      auto surfaceControlPoints = std::array<std::array<BezierPatch::Point, 3>, 3>{};
+      for (size_t row = 0u; row < 3u; ++row)
+      {
+        for (size_t col = 0u; col < 3u; ++col)
+        {
+          surfaceControlPoints[row][col] =
+            patch.controlPoint(2u * surfaceRow + row, 2u * surfaceCol + col);
+        }
+      }
+
+      grid.push_back(vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v));
+    }
+  }
+
+  return grid;
+}
+} // namespace
+
+TEST_CASE("BezierPatchBenchmark.evaluate")
+{
+  const auto patches = makePatches();
+
+  auto pointByPointGrids = std::vector<std::vector<BezierPatch::Point>>{};
+  pointByPointGrids.reserve(NumPatches);
+  timeLambda(
+    [&]() {
+      for (const auto& patch : patches)
+      {
+        pointByPointGrids.push_back(evaluatePointByPoint(patch, SubdivisionsPerSurface));
+      }
+    },
+    "evaluate " + std::to_string(NumPatches) + " patches point by point");
+
+  auto batchedGrids = std::vector<std::vector<BezierPatch::Point>>{};
+  batchedGrids.reserve(NumPatches);
+  timeLambda(
+    [&]() {
+      for (const auto& patch : patches)
+      {
+        batchedGrids.push_back(patch.evaluate(SubdivisionsPerSurface));
+      }
+    },
+    "evaluate " + std::to_string(NumPatches) + " patches surface by surface");
+
+  CHECK(batchedGrids == pointByPointGrids);
+
+  auto patchGrids = std::vector<PatchGrid>{};
+  patchGrids.reserve(NumPatches);
+  timeLambda(
+    [&]() {
+      for (const auto& patch : patches)
+      {
+        patchGrids.push_back(makePatchGrid(patch, SubdivisionsPerSurface));
+      }
+    },
+    "make " + std::to_string(NumPatches) + " patch grids with normals");
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 10'000;
+
+std::vector<Brush> makeBrushes(const size_t count)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto x = static_cast<FloatType>(i % 200) * 64.0 - 6400.0;
+    const auto y = static_cast<FloatType>((i / 200) % 200) * 64.0 - 6400.0;
+    const auto z = static_cast<FloatType>(i / 40'000) * 64.0;
+    const auto bounds =
+      vm::bbox3{vm::vec3{x, y, z}, vm::vec3{x + 32.0, y + 32.0, z + 32.0}};
+    result.push_back(builder.createCuboid(bounds, "texture").value());
+  }
+  return result;
+}
+
+std::vector<BrushNode*> makeBrushNodes()
+{
+  return kdl::vec_transform(
+    makeBrushes(NumBrushes), [](auto brush) { return new BrushNode{std::move(brush)}; });
+}
+} // namespace
+
+TEST_CASE("BrushBenchmark.setFaceAttributes")
+{
+  auto brushNodes = makeBrushNodes();
+
+  // Like the command that sets the face attributes, copy every brush, change the
+  // attributes of its faces and swap it into the node, keeping the old brush for undo.
+  auto oldBrushes = std::vector<Brush>{};
+  oldBrushes.reserve(brushNodes.size());
+
+  timeLambda(
+    [&]() {
+      for (auto* brushNode : brushNodes)
+      {
+        auto brush = brushNode->brush();
+        for (auto& face : brush.faces())
+        {
+          auto attributes = face.attributes();
+          attributes.setTextureName("other");
+          attributes.setXOffset(16.0f);
+          face.setAttributes(attributes);
+        }
+        oldBrushes.push_back(brushNode->setBrush(std::move(brush)));
+      }
+    },
+    "set face attributes of " + std::to_string(brushNodes.size()) + " brushes");
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < brushNodes.size(); ++i)
+      {
+        oldBrushes[i] = brushNodes[i]->setBrush(std::move(oldBrushes[i]));
+      }
+    },
+    "undo setting face attributes of " + std::to_string(brushNodes.size()) + " brushes");
+
+  kdl::vec_clear_and_delete(brushNodes);
+}
+
+TEST_CASE("BrushBenchmark.compare")
+{
+  const auto brushes = makeBrushes(100'000);
+  const auto equalBrushes = brushes;
+
+  // only the last face differs, so comparing the faces must compare all of them
+  auto changedBrushes = brushes;
+  for (auto& brush : changedBrushes)
+  {
+    auto& face = brush.face(brush.faceCount() - 1u);
+    auto attributes = face.attributes();
+    attributes.setTextureName("other");
+    face.setAttributes(attributes);
+  }
+
+  const auto countEqual = [&](const auto& others, const auto& equal) {
+    auto count = size_t{0};
+    for (size_t i = 0; i < brushes.size(); ++i)
+    {
+      if (equal(brushes[i], others[i]))
+      {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  const auto compareFaces = [](const Brush& lhs, const Brush& rhs) {
+    return lhs.faces() == rhs.faces();
+  };
+  const auto compareBrushes = [](const Brush& lhs, const Brush& rhs) {
+    return lhs == rhs;
+  };
+
+  auto count = size_t{0};
+  const auto message = [&](const std::string& what) {
+    return what + " of " + std::to_string(brushes.size()) + " brushes";
+  };
+
+  timeLambda(
+    [&]() { count = countEqual(equalBrushes, compareFaces); },
+    message("compare faces of equal pairs"));
+  CHECK(count == brushes.size());
+
+  timeLambda(
+    [&]() { count = countEqual(changedBrushes, compareFaces); },
+    message("compare faces of changed pairs"));
+  CHECK(count == 0);
+
+  timeLambda(
+    [&]() { count = countEqual(equalBrushes, compareBrushes); },
+    message("compare equal pairs, computing hashes"));
+  CHECK(count == brushes.size());
+
+  timeLambda(
+    [&]() { count = countEqual(changedBrushes, compareBrushes); },
+    message("compare changed pairs, computing hashes"));
+  CHECK(count == 0);
+
+  timeLambda(
+    [&]() { count = countEqual(equalBrushes, compareBrushes); },
+    message("compare equal pairs with cached hashes"));
+  CHECK(count == brushes.size());
+
+  timeLambda(
+    [&]() { count = countEqual(changedBrushes, compareBrushes); },
+    message("compare changed pairs with cached hashes"));
+  CHECK(count == 0);
+}
+
+} // namespace TrenchBroom::Model
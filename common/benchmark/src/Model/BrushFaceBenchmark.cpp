@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Ensure.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 10'000;
+constexpr size_t NumTextures = 100;
+
+std::vector<BrushFace> makeFaces(const MapFormat mapFormat)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto result = std::vector<BrushFace>{};
+  result.reserve(NumBrushes * 6);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = static_cast<FloatType>(i % 100) * 64.0;
+    const auto y = static_cast<FloatType>(i / 100) * 64.0;
+    const auto bounds =
+      vm::bbox3{vm::vec3{x, y, 0.0}, vm::vec3{x + 32.0, y + 32.0, 32.0}};
+
+    // realistic texture names are too long for the small string optimization
+    const auto textureName =
+      "base_wall/concrete_panel_" + std::to_string(i % NumTextures);
+    const auto brush = builder.createCuboid(bounds, textureName).value();
+    for (const auto& face : brush.faces())
+    {
+      result.push_back(face);
+    }
+  }
+  return result;
+}
+
+/**
+ * The texture name is interned and shared among all faces, and the tex coord system is
+ * stored inline, so an untagged face owns no heap memory beyond sizeof(BrushFace).
+ */
+size_t bytesPerFace(const BrushFace& face)
+{
+  ensure(!face.hasAnyTag(), "face is not tagged");
+  return sizeof(BrushFace);
+}
+
+void measureFaces(const MapFormat mapFormat, const std::string& name)
+{
+  const auto faces = makeFaces(mapFormat);
+
+  printf(
+    "%s faces: %zu bytes per face (sizeof(ParaxialTexCoordSystem) = %zu, "
+    "sizeof(ParallelTexCoordSystem) = %zu)\n",
+    name.c_str(),
+    bytesPerFace(faces.front()),
+    sizeof(ParaxialTexCoordSystem),
+    sizeof(ParallelTexCoordSystem));
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 10; ++i)
+      {
+        auto moreCopies = faces;
+      }
+    },
+    "copy " + std::to_string(faces.size()) + " " + name + " faces 10 times");
+}
+} // namespace
+
+TEST_CASE("BrushFaceBenchmark.memory")
+{
+  measureFaces(MapFormat::Standard, "paraxial");
+  measureFaces(MapFormat::Valve, "parallel");
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumLinks = 50'000;
+
+std::vector<std::string> makeTargetnames()
+{
+  auto result = std::vector<std::string>{};
+  result.reserve(NumLinks);
+  for (size_t i = 0; i < NumLinks; ++i)
+  {
+    result.push_back("target_" + std::to_string(i));
+  }
+  return result;
+}
+
+std::vector<Node*> makeEntityNodes(const std::vector<std::string>& targetnames)
+{
+  auto result = std::vector<Node*>{};
+  result.reserve(2 * targetnames.size());
+  for (const auto& targetname : targetnames)
+  {
+    result.push_back(new EntityNode{Entity{
+      {},
+      {{EntityPropertyKeys::Classname, "trigger_relay"},
+       {EntityPropertyKeys::Targetname, targetname}}}});
+    result.push_back(new EntityNode{Entity{
+      {},
+      {{EntityPropertyKeys::Classname, "func_button"},
+       {EntityPropertyKeys::Target, targetname}}}});
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("EntityNodeIndexBenchmark.resolveLinks")
+{
+  const auto targetnames = makeTargetnames();
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  const auto entityNodes = makeEntityNodes(targetnames);
+
+  timeLambda(
+    [&]() { worldNode.defaultLayer()->addChildren(entityNodes); },
+    "add " + std::to_string(entityNodes.size()) + " entities and resolve their links");
+
+  const auto* sourceNode = static_cast<EntityNode*>(entityNodes[1]);
+  REQUIRE(sourceNode->linkTargets().size() == 1u);
+  CHECK(sourceNode->linkTargets().front() == entityNodes[0]);
+
+  timeLambda(
+    [&]() {
+      // each entity change removes and resolves the links of the changed entity
+      for (size_t i = 0; i < targetnames.size(); ++i)
+      {
+        auto* entityNode = static_cast<EntityNode*>(entityNodes[2 * i + 1]);
+        auto entity = entityNode->entity();
+        entity.addOrUpdateProperty(
+          {}, EntityPropertyKeys::Target, targetnames[(i + 1) % targetnames.size()]);
+        entityNode->setEntity(std::move(entity));
+      }
+    },
+    "retarget " + std::to_string(targetnames.size()) + " entities");
+
+  REQUIRE(sourceNode->linkTargets().size() == 1u);
+  CHECK(sourceNode->linkTargets().front() == entityNodes[2]);
+
+  const auto& index = worldNode.entityNodeIndex();
+  timeLambda(
+    [&]() {
+      for (const auto& targetname : targetnames)
+      {
+        index.findEntityNodes(
+          EntityNodeIndexQuery::numbered(EntityPropertyKeys::Target), targetname);
+      }
+    },
+    "find the link sources of " + std::to_string(targetnames.size()) + " entities");
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/LinkedGroupUtils.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 1'000;
+constexpr size_t NumLinkedGroups = 500;
+
+const auto WorldBounds = vm::bbox3{8192.0};
+
+void transformBrushNode(BrushNode& brushNode, const vm::mat4x4& transformation)
+{
+  auto brush = brushNode.brush();
+  if (!brush.transform(WorldBounds, transformation, false).is_success())
+  {
+    throw std::runtime_error{"failed to transform brush"};
+  }
+  brushNode.setBrush(std::move(brush));
+}
+
+void translateGroupNode(GroupNode& groupNode, const vm::vec3& delta)
+{
+  const auto transformation = vm::translation_matrix(delta);
+
+  auto group = groupNode.group();
+  group.transform(transformation);
+  groupNode.setGroup(std::move(group));
+
+  for (auto* child : groupNode.children())
+  {
+    transformBrushNode(static_cast<BrushNode&>(*child), transformation);
+  }
+}
+
+std::vector<std::unique_ptr<GroupNode>> createLinkedGroupNodes()
+{
+  const auto builder = BrushBuilder{MapFormat::Standard, WorldBounds};
+
+  auto groupNode = std::make_unique<GroupNode>(Group{"group"});
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = static_cast<FloatType>(i % 40) * 12.0;
+    const auto y = static_cast<FloatType>(i / 40) * 12.0;
+    const auto bounds = vm::bbox3{vm::vec3{x, y, 0.0}, vm::vec3{x + 8.0, y + 8.0, 8.0}};
+    groupNode->addChild(new BrushNode{builder.createCuboid(bounds, "texture").value()});
+  }
+
+  auto result = std::vector<std::unique_ptr<GroupNode>>{};
+  result.reserve(NumLinkedGroups);
+  for (size_t i = 1; i < NumLinkedGroups; ++i)
+  {
+    auto linkedGroupNode = std::unique_ptr<GroupNode>{static_cast<GroupNode*>(
+      groupNode->cloneRecursively(WorldBounds, SetLinkId::keep))};
+
+    const auto x = static_cast<FloatType>(i % 25) * 512.0 - 6400.0;
+    const auto y = static_cast<FloatType>(i / 25) * 320.0 - 3200.0;
+    translateGroupNode(*linkedGroupNode, vm::vec3{x, y, 0.0});
+    result.push_back(std::move(linkedGroupNode));
+  }
+  result.insert(result.begin(), std::move(groupNode));
+
+  return result;
+}
+
+void timeUpdateLinkedGroups(
+  const std::vector<std::unique_ptr<GroupNode>>& groupNodes, const std::string& message)
+{
+  const auto& sourceGroupNode = *groupNodes.front();
+  // the source group node is skipped by updateLinkedGroups
+  const auto targetGroupNodes = kdl::vec_transform(
+    groupNodes, [](const auto& groupNode) { return groupNode.get(); });
+
+  timeLambda(
+    [&]() {
+      if (!updateLinkedGroups(sourceGroupNode, targetGroupNodes, WorldBounds)
+             .is_success())
+      {
+        throw std::runtime_error{"failed to update linked groups"};
+      }
+    },
+    message);
+}
+} // namespace
+
+TEST_CASE("LinkedGroupBenchmark.updateLinkedGroups")
+{
+  const auto groupNodes = createLinkedGroupNodes();
+  const auto delta = vm::translation_matrix(vm::vec3{0.0, 0.0, 8.0});
+  const auto& sourceChildren = groupNodes.front()->children();
+
+  SECTION("Changing one brush")
+  {
+    transformBrushNode(static_cast<BrushNode&>(*sourceChildren.front()), delta);
+    timeUpdateLinkedGroups(
+      groupNodes,
+      "update " + std::to_string(NumLinkedGroups - 1u)
+        + " linked groups after changing one of " + std::to_string(NumBrushes)
+        + " brushes");
+  }
+
+  SECTION("Changing all brushes")
+  {
+    for (auto* child : sourceChildren)
+    {
+      transformBrushNode(static_cast<BrushNode&>(*child), delta);
+    }
+    timeUpdateLinkedGroups(
+      groupNodes,
+      "update " + std::to_string(NumLinkedGroups - 1u)
+        + " linked groups after changing all of " + std::to_string(NumBrushes)
+        + " brushes");
+  }
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeCollection.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumNodes = 100'000;
+
+std::vector<Node*> makeBrushNodes()
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto brush =
+    BrushBuilder{MapFormat::Standard, worldBounds}.createCube(64.0, "texture").value();
+
+  auto result = std::vector<Node*>{};
+  result.reserve(NumNodes);
+  for (size_t i = 0; i < NumNodes; ++i)
+  {
+    result.push_back(new BrushNode{brush});
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("NodeCollectionBenchmark.selectAndDeselect")
+{
+  auto nodes = makeBrushNodes();
+  auto nodeCollection = NodeCollection{};
+
+  timeLambda(
+    [&]() { nodeCollection.addNodes(nodes); },
+    "add " + std::to_string(nodes.size()) + " nodes");
+  REQUIRE(nodeCollection.nodeCount() == nodes.size());
+
+  timeLambda(
+    [&]() { nodeCollection.removeNodes(nodes); },
+    "remove " + std::to_string(nodes.size()) + " nodes");
+  REQUIRE(nodeCollection.empty());
+
+  nodeCollection.addNodes(nodes);
+
+  // remove every other node
+  auto nodesToRemove = std::vector<Node*>{};
+  for (size_t i = 0; i < nodes.size(); i += 2)
+  {
+    nodesToRemove.push_back(nodes[i]);
+  }
+
+  timeLambda(
+    [&]() { nodeCollection.removeNodes(nodesToRemove); },
+    "remove " + std::to_string(nodesToRemove.size()) + " of "
+      + std::to_string(nodes.size()) + " nodes");
+  REQUIRE(nodeCollection.nodeCount() == nodes.size() - nodesToRemove.size());
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 1; i < 1000; i += 2)
+      {
+        nodeCollection.removeNode(nodes[i]);
+      }
+    },
+    "remove 500 nodes individually");
+  REQUIRE(nodeCollection.nodeCount() == nodes.size() - nodesToRemove.size() - 500);
+
+  kdl::vec_clear_and_delete(nodes);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/Texture.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Tag.h"
+#include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_set.h>
+#include <kdl/vector_utils.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 20'000;
+constexpr size_t NumTextures = 256;
+
+void addSmartTag(
+  std::vector<SmartTag>& smartTags,
+  const std::string& name,
+  std::unique_ptr<TagMatcher> matcher)
+{
+  smartTags.emplace_back(name, std::vector<TagAttribute>{}, std::move(matcher));
+}
+
+// modeled after the smart tags of the Quake 3 game configuration
+std::vector<SmartTag> makeSmartTags()
+{
+  auto result = std::vector<SmartTag>{};
+  addSmartTag(result, "Trigger", std::make_unique<TextureNameTagMatcher>("trigger*"));
+  addSmartTag(result, "Clip", std::make_unique<TextureNameTagMatcher>("clip"));
+  addSmartTag(result, "Skip", std::make_unique<TextureNameTagMatcher>("skip"));
+  addSmartTag(result, "Hint", std::make_unique<TextureNameTagMatcher>("common/hint*"));
+  addSmartTag(result, "Caulk", std::make_unique<TextureNameTagMatcher>("common/*caulk"));
+  addSmartTag(result, "Origin", std::make_unique<TextureNameTagMatcher>("origin"));
+  addSmartTag(result, "Shader", std::make_unique<TextureNameTagMatcher>("\\**"));
+  addSmartTag(
+    result,
+    "Liquid",
+    std::make_unique<SurfaceParmTagMatcher>(
+      kdl::vector_set<std::string>{"water", "lava", "slime"}));
+  addSmartTag(result, "Fog", std::make_unique<SurfaceParmTagMatcher>("fog"));
+  addSmartTag(result, "Detail", std::make_unique<ContentFlagsTagMatcher>(1 << 27));
+  addSmartTag(result, "Light", std::make_unique<SurfaceFlagsTagMatcher>(1 << 0));
+  return result;
+}
+
+std::vector<Assets::Texture> makeTextures()
+{
+  auto result = std::vector<Assets::Texture>{};
+  result.reserve(NumTextures);
+  for (size_t i = 0; i < NumTextures; ++i)
+  {
+    switch (i % 16)
+    {
+    case 0:
+      result.emplace_back("common/caulk", 16, 16);
+      break;
+    case 1:
+      result.emplace_back("common/trigger", 16, 16);
+      break;
+    case 2:
+      result.emplace_back("liquids/water_" + std::to_string(i), 16, 16);
+      result.back().setSurfaceParms({"trans", "water"});
+      break;
+    default:
+      result.emplace_back("base_wall/concrete_" + std::to_string(i), 16, 16);
+      break;
+    }
+  }
+  return result;
+}
+
+std::vector<BrushNode*> makeBrushNodes(std::vector<Assets::Texture>& textures)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto builder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto result = std::vector<BrushNode*>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    auto brush = builder.createCube(64.0, "").value();
+    for (size_t j = 0; j < brush.faceCount(); ++j)
+    {
+      auto& texture = textures[(i * 7 + j) % textures.size()];
+      auto& face = brush.face(j);
+
+      auto attributes = face.attributes();
+      attributes.setTextureName(texture.name());
+      face.setAttributes(attributes);
+      face.setTexture(&texture);
+    }
+    result.push_back(new BrushNode{std::move(brush)});
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("TagManagerBenchmark.initializeTags")
+{
+  auto textures = makeTextures();
+  auto brushNodes = makeBrushNodes(textures);
+
+  auto tagManager = TagManager{};
+  tagManager.registerSmartTags(makeSmartTags());
+
+  const auto faceCount = NumBrushes * brushNodes.front()->brush().faceCount();
+
+  // the tags of each face were previously matched one smart tag at a time
+  timeLambda(
+    [&]() {
+      for (auto* brushNode : brushNodes)
+      {
+        for (const auto& face : brushNode->brush().faces())
+        {
+          for (const auto& tag : tagManager.smartTags())
+          {
+            tag.matches(face);
+          }
+        }
+      }
+    },
+    "match the smart tags of " + std::to_string(faceCount) + " faces individually");
+
+  timeLambda(
+    [&]() {
+      for (auto* brushNode : brushNodes)
+      {
+        brushNode->initializeTags(tagManager);
+      }
+    },
+    "initialize the tags of " + std::to_string(NumBrushes) + " brushes");
+
+  const auto& caulk = tagManager.smartTag("Caulk");
+  const auto& liquid = tagManager.smartTag("Liquid");
+  for (auto* brushNode : brushNodes)
+  {
+    for (const auto& face : brushNode->brush().faces())
+    {
+      CHECK(face.hasTag(caulk) == caulk.matches(face));
+      CHECK(face.hasTag(liquid) == liquid.matches(face));
+    }
+  }
+
+  timeLambda(
+    [&]() {
+      for (auto* brushNode : brushNodes)
+      {
+        brushNode->updateTags(tagManager);
+      }
+    },
+    "update the tags of " + std::to_string(NumBrushes) + " brushes");
+
+  kdl::vec_clear_and_delete(brushNodes);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 50'000;
+
+std::vector<BrushNode*> addBrushNodes(WorldNode& worldNode)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<BrushNode*>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = static_cast<FloatType>(i % 250) * 48.0 - 6000.0;
+    const auto y = static_cast<FloatType>(i / 250) * 48.0 - 6000.0;
+    const auto bounds =
+      vm::bbox3{vm::vec3{x, y, 0.0}, vm::vec3{x + 32.0, y + 32.0, 32.0}};
+    result.push_back(new BrushNode{builder.createCuboid(bounds, "texture").value()});
+  }
+
+  worldNode.defaultLayer()->addChildren(kdl::vec_static_cast<Node*>(result));
+  return result;
+}
+
+std::vector<Brush> translateBrushes(
+  const std::vector<BrushNode*>& brushNodes, const vm::vec3& delta)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto transformation = vm::translation_matrix(delta);
+
+  return kdl::vec_transform(brushNodes, [&](const auto* brushNode) {
+    auto brush = brushNode->brush();
+    if (!brush.transform(worldBounds, transformation, false).is_success())
+    {
+      throw std::runtime_error{"failed to transform brush"};
+    }
+    return brush;
+  });
+}
+
+void setBrushes(const std::vector<BrushNode*>& brushNodes, std::vector<Brush>& brushes)
+{
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    brushes[i] = brushNodes[i]->setBrush(std::move(brushes[i]));
+  }
+}
+} // namespace
+
+TEST_CASE("WorldNodeBenchmark.dragBrushes")
+{
+  // Like a drag step, swap translated brushes into their nodes. Most of the brushes
+  // remain in the same node tree node.
+  const auto delta = vm::vec3{8.0, 4.0, 0.0};
+
+  SECTION("Updating the node tree for every node")
+  {
+    auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+    const auto brushNodes = addBrushNodes(worldNode);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      auto brushes = translateBrushes(brushNodes, delta);
+      timeLambda(
+        [&]() { setBrushes(brushNodes, brushes); },
+        "move " + std::to_string(brushNodes.size())
+          + " brushes, updating the node tree for every node");
+    }
+  }
+
+  SECTION("Deferring node tree updates")
+  {
+    auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+    const auto brushNodes = addBrushNodes(worldNode);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      auto brushes = translateBrushes(brushNodes, delta);
+      timeLambda(
+        [&]() {
+          worldNode.deferNodeTreeUpdates();
+          setBrushes(brushNodes, brushes);
+          worldNode.applyDeferredNodeTreeUpdates();
+        },
+        "move " + std::to_string(brushNodes.size())
+          + " brushes, deferring node tree updates");
+    }
+  }
+}
+
+} // namespace TrenchBroom::Model
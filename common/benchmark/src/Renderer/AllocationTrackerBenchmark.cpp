@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Renderer/AllocationTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+constexpr size_t NumBlocks = 64'000;
+constexpr size_t NumRounds = 50;
+constexpr size_t MaxCompactionSize = 1u << 16;
+
+// Alternates between small and large blocks, so that the holes left by small blocks
+// can't be reused for large ones.
+size_t getBlockSize(std::mt19937& engine, const size_t round)
+{
+  return (round % 2 == 0 ? 12 : 76) + (4 * (engine() % 17));
+}
+
+void printStats(const AllocationTracker& tracker, const std::string& message)
+{
+  const auto stats = tracker.stats();
+  printf(
+    "%s: capacity %zu, used %zu, %zu free blocks, largest free block %zu, "
+    "fragmentation %.2f\n",
+    message.c_str(),
+    stats.capacity,
+    stats.usedSize,
+    stats.freeBlockCount,
+    stats.largestFreeBlock,
+    stats.fragmentation());
+}
+
+bool shouldCompact(const AllocationTracker& tracker)
+{
+  const auto stats = tracker.stats();
+  return stats.freeSize * 4 >= stats.capacity && stats.fragmentation() >= 0.5;
+}
+
+/**
+ * In every round, frees a random half of the blocks and allocates new blocks of a
+ * different size range in their place, growing the tracker when an allocation fails.
+ * If `compact` is true, the tracker is compacted incrementally after freeing the blocks,
+ * like BrushRenderer does when validating.
+ */
+void stress(const bool compact)
+{
+  auto engine = std::mt19937{};
+  auto tracker = AllocationTracker{};
+  auto blocks = std::vector<AllocationTracker::Block*>(NumBlocks, nullptr);
+
+  const auto allocate = [&](const size_t size) {
+    auto* block = tracker.allocate(size);
+    if (block == nullptr)
+    {
+      tracker.expand(std::max(2 * tracker.capacity(), tracker.capacity() + size));
+      block = tracker.allocate(size);
+    }
+    return block;
+  };
+
+  auto movedSize = size_t(0);
+  auto compactionSteps = size_t(0);
+  const auto mode = std::string{compact ? "with compaction" : "without compaction"};
+  timeLambda(
+    [&]() {
+      for (size_t round = 0; round < NumRounds; ++round)
+      {
+        for (auto& block : blocks)
+        {
+          if (block != nullptr && engine() % 2 == 0)
+          {
+            tracker.free(block);
+            block = nullptr;
+          }
+        }
+
+        while (compact && shouldCompact(tracker))
+        {
+          movedSize += tracker.compact(MaxCompactionSize, [](const auto&, const auto) {});
+          ++compactionSteps;
+        }
+
+        for (auto& block : blocks)
+        {
+          if (block == nullptr)
+          {
+            block = allocate(getBlockSize(engine, round));
+          }
+        }
+      }
+    },
+    std::to_string(NumRounds) + " rounds of replacing random blocks " + mode);
+
+  printStats(tracker, "Tracker " + mode);
+  printf("Moved %zu elements in %zu steps\n", movedSize, compactionSteps);
+
+  CHECK(tracker.stats().usedBlockCount == NumBlocks);
+}
+} // namespace
+
+TEST_CASE("AllocationTrackerBenchmark.stress")
+{
+  stress(false);
+  stress(true);
+}
+} // namespace TrenchBroom::Renderer
@@ -29,11 +29,14 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererArrays.h"
 
 #include <kdl/result.h>
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -92,6 +95,16 @@ makeBrushes()
   return {result, textures};
 }
 
+static void printFaceDrawCalls(const BrushRenderer& r, const std::string& message)
+{
+  printf(
+    "Face draw calls %s: %zu (%zu ranges, %zu indices)\n",
+    message.c_str(),
+    r.faceDrawCallCount(),
+    r.faceDrawRangeCount(),
+    r.faceIndexCount());
+}
+
 TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
 {
   auto brushesTextures = makeBrushes();
@@ -117,6 +130,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
     },
     "validate after adding " + std::to_string(brushes.size())
       + " brushes to BrushRenderer");
+  printFaceDrawCalls(r, "after adding brushes");
 
   // Tiny change: remove the last brush
   timeLambda([&]() { r.removeBrush(brushes.back()); }, "call removeBrush once");
@@ -128,6 +142,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
       }
     },
     "validate after removing one brush");
+  printFaceDrawCalls(r, "after removing one brush");
 
   // Large change: keep every second brush
   timeLambda(
@@ -150,9 +165,101 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
       }
     },
     "validate remaining brushes");
+  printFaceDrawCalls(r, "for remaining brushes");
+
+  // one draw call per texture, regardless of the number of brushes
+  CHECK(r.faceDrawCallCount() == NumTextures);
+
+  // Rebuild everything including the vertex caches, like after loading a map
+  r.clear();
+  for (auto* brush : brushes)
+  {
+    brush->invalidateVertexCache();
+    r.addBrush(brush);
+  }
+  timeLambda(
+    [&]() { r.validate(); },
+    "validate " + std::to_string(brushes.size()) + " brushes with invalid vertex caches");
 
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(textures);
 }
+
+TEST_CASE("BrushRendererBenchmark.benchPackedBrushIndexArray")
+{
+  // one index array per texture with the indices of two triangles per face
+  constexpr auto NumFacesPerTexture = NumBrushes * 6 / NumTextures;
+  constexpr auto NumIndicesPerFace = size_t(6);
+  constexpr auto NumUpdates = size_t(100);
+
+  auto textures = std::vector<Assets::Texture>{};
+  textures.reserve(NumTextures);
+  for (size_t i = 0; i < NumTextures; ++i)
+  {
+    textures.emplace_back("texture " + std::to_string(i), 64, 64);
+  }
+
+  auto indexArrays = TextureToBrushIndicesMap{};
+  auto blocks = std::vector<std::vector<AllocationTracker::Block*>>{};
+  for (const auto& texture : textures)
+  {
+    auto indexArray = std::make_shared<BrushIndexArray>();
+    auto& textureBlocks = blocks.emplace_back();
+    for (size_t i = 0; i < NumFacesPerTexture; ++i)
+    {
+      auto [block, dest] = indexArray->getPointerToInsertElementsAt(NumIndicesPerFace);
+      std::fill_n(dest, NumIndicesPerFace, GLuint(i));
+      textureBlocks.push_back(block);
+    }
+    indexArrays.emplace(&texture, std::move(indexArray));
+  }
+
+  auto packedArray = PackedBrushIndexArray{};
+  packedArray.update(indexArrays);
+
+  // every update rebuilds the draw commands after one face was removed
+  const auto timeUpdates = [&](const std::string& message) {
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < NumUpdates; ++i)
+        {
+          auto& textureBlocks = blocks[i % NumTextures];
+          auto& indexArray = indexArrays.at(&textures[i % NumTextures]);
+          indexArray->zeroElementsWithKey(textureBlocks.back());
+          textureBlocks.pop_back();
+          packedArray.update(indexArrays);
+        }
+      },
+      "update face draw commands " + std::to_string(NumUpdates) + " times " + message);
+    printf(
+      "Face draw ranges %s: %zu (%zu indices)\n",
+      message.c_str(),
+      packedArray.rangeCount(),
+      packedArray.indexCount());
+  };
+
+  timeUpdates("without freed ranges");
+
+  // remove every second face
+  for (size_t t = 0; t < NumTextures; ++t)
+  {
+    auto& indexArray = indexArrays.at(&textures[t]);
+    auto& textureBlocks = blocks[t];
+    for (size_t i = 0; i < textureBlocks.size(); i += 2)
+    {
+      indexArray->zeroElementsWithKey(textureBlocks[i]);
+      textureBlocks[i] = nullptr;
+    }
+    textureBlocks.erase(
+      std::remove(textureBlocks.begin(), textureBlocks.end(), nullptr),
+      textureBlocks.end());
+  }
+  packedArray.update(indexArrays);
+
+  timeUpdates("with every second face freed");
+
+  // one draw command per texture, regardless of the number of freed ranges
+  CHECK(packedArray.drawCallCount() == NumTextures);
+}
 } // namespace Renderer
 } // namespace TrenchBroom
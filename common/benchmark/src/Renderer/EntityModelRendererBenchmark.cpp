@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/EntityModel.h"
+#include "BenchmarkUtils.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Renderer/EntityModelRenderer.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+constexpr size_t NumEntities = 20'000;
+constexpr size_t NumModels = 50;
+
+std::vector<std::unique_ptr<Assets::EntityModel>> makeModels()
+{
+  auto result = std::vector<std::unique_ptr<Assets::EntityModel>>{};
+  for (size_t i = 0; i < NumModels; ++i)
+  {
+    auto model = std::make_unique<Assets::EntityModel>(
+      "model " + std::to_string(i),
+      Assets::PitchType::Normal,
+      Assets::Orientation::Oriented);
+    model->addFrame();
+    model->loadFrame(0, "frame", vm::bbox3f{8.0f});
+    result.push_back(std::move(model));
+  }
+  return result;
+}
+
+std::vector<Model::EntityNode*> makeEntities(
+  const std::vector<std::unique_ptr<Assets::EntityModel>>& models)
+{
+  auto result = std::vector<Model::EntityNode*>{};
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    const auto origin = std::to_string(i % 100 * 64) + " " + std::to_string(i / 100 * 64)
+                        + " " + std::to_string(i % 7 * 16);
+    auto* entityNode = new Model::EntityNode{Model::Entity{
+      {},
+      {{Model::EntityPropertyKeys::Classname, "item"},
+       {Model::EntityPropertyKeys::Origin, origin},
+       {Model::EntityPropertyKeys::Angle, std::to_string(i % 360)}}}};
+    entityNode->setModelFrame(models[i % NumModels]->frames().front());
+    result.push_back(entityNode);
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("EntityModelRendererBenchmark.makeInstanceBatches")
+{
+  const auto models = makeModels();
+  auto entityNodes = makeEntities(models);
+
+  // the renderers are never rendered, so they don't need any vertices
+  auto renderers = std::vector<std::unique_ptr<TexturedIndexRangeRenderer>>{};
+  for (size_t i = 0; i < NumModels; ++i)
+  {
+    renderers.push_back(std::make_unique<TexturedIndexRangeRenderer>());
+  }
+
+  auto entities = std::unordered_map<const Model::EntityNode*, TexturedRenderer*>{};
+  for (size_t i = 0; i < entityNodes.size(); ++i)
+  {
+    entities.emplace(entityNodes[i], renderers[i % NumModels].get());
+  }
+
+  const auto editorContext = Model::EditorContext{};
+
+  auto batches = std::vector<EntityModelInstanceBatch>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        batches = makeEntityModelInstanceBatches(entities, editorContext, true);
+      }
+    },
+    "build instance batches for " + std::to_string(NumEntities) + " entities 100 times");
+
+  auto instanceCount = size_t(0);
+  for (const auto& batch : batches)
+  {
+    instanceCount += batch.transformations.size();
+  }
+
+  printf(
+    "Submitted %zu batches for %zu entities (previously one per entity)\n",
+    batches.size(),
+    instanceCount);
+
+  CHECK(batches.size() == NumModels);
+  CHECK(instanceCount == NumEntities);
+
+  kdl::vec_clear_and_delete(entityNodes);
+}
+
+} // namespace TrenchBroom::Renderer
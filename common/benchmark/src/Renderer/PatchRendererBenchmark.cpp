@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/BezierPatch.h"
+#include "Model/PatchNode.h"
+#include "Renderer/PatchRenderer.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/vec.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+constexpr size_t NumPatches = 10'000;
+constexpr size_t PatchesPerRow = 100;
+constexpr double PatchSize = 128.0;
+constexpr double PatchSpacing = 192.0;
+
+Model::BezierPatch makePatch(const size_t i)
+{
+  using P = Model::BezierPatch::Point;
+
+  const auto x = static_cast<double>(i % PatchesPerRow) * PatchSpacing;
+  const auto y = static_cast<double>(i / PatchesPerRow) * PatchSpacing;
+
+  // a 5x5 patch with 2x2 surfaces that bulges in the middle
+  auto controlPoints = std::vector<P>{};
+  for (size_t row = 0; row < 5; ++row)
+  {
+    for (size_t col = 0; col < 5; ++col)
+    {
+      const auto u = static_cast<double>(col) / 4.0;
+      const auto v = static_cast<double>(row) / 4.0;
+      const auto z = (row % 4 == 0 || col % 4 == 0) ? 0.0 : 32.0;
+      controlPoints.push_back(P{x + u * PatchSize, y + v * PatchSize, z, u, v});
+    }
+  }
+  return Model::BezierPatch{5, 5, std::move(controlPoints), "texture"};
+}
+} // namespace
+
+TEST_CASE("PatchRendererBenchmark.levelOfDetail")
+{
+  auto patchNodes = std::vector<Model::PatchNode*>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumPatches; ++i)
+      {
+        patchNodes.push_back(new Model::PatchNode{makePatch(i)});
+      }
+    },
+    "tessellate " + std::to_string(NumPatches) + " patches at full detail");
+
+  // look across the patches from one of their corners
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    32768.0f,
+    Camera::Viewport{0, 0, 1920, 1080},
+    vm::vec3f{-256.0f, -256.0f, 512.0f},
+    vm::normalize(vm::vec3f{1.0f, 1.0f, -0.25f}),
+    vm::vec3f{0.0f, 0.0f, 1.0f}};
+
+  auto levels = std::vector<size_t>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        levels = kdl::vec_transform(patchNodes, [&](const auto* patchNode) {
+          return computePatchLevelOfDetail(*patchNode, camera);
+        });
+      }
+    },
+    "select the level of detail of " + std::to_string(NumPatches)
+      + " patches 100 times");
+
+  const auto& grid = patchNodes.front()->grid();
+  const auto maxLevel = size_t(3);
+  REQUIRE(grid.quadRowCount() == 2u << maxLevel);
+
+  auto fullIndexCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumPatches; ++i)
+      {
+        fullIndexCount +=
+          makePatchGridTriangles(grid.pointRowCount, grid.pointColumnCount, 1).size();
+      }
+    },
+    "triangulate " + std::to_string(NumPatches) + " patches at full detail");
+
+  auto lodIndexCount = size_t(0);
+  auto patchCountPerLevel = std::array<size_t, maxLevel + 1>{};
+  timeLambda(
+    [&]() {
+      for (const auto level : levels)
+      {
+        const auto stride = size_t(1) << (maxLevel - level);
+        lodIndexCount +=
+          makePatchGridTriangles(grid.pointRowCount, grid.pointColumnCount, stride)
+            .size();
+        ++patchCountPerLevel[level];
+      }
+    },
+    "triangulate " + std::to_string(NumPatches) + " patches at their level of detail");
+
+  for (size_t level = 0; level <= maxLevel; ++level)
+  {
+    printf("Level %zu: %zu patches\n", level, patchCountPerLevel[level]);
+  }
+  printf(
+    "Rendering %zu triangles instead of %zu at full detail\n",
+    lodIndexCount / 3u,
+    fullIndexCount / 3u);
+
+  CHECK(lodIndexCount < fullIndexCount);
+
+  kdl::vec_clear_and_delete(patchNodes);
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "View/CellLayout.h"
+
+#include <string>
+
+namespace TrenchBroom::View
+{
+namespace
+{
+constexpr size_t NumCells = 50'000;
+constexpr size_t NumGroups = 50;
+
+void initLayout(CellLayout& layout)
+{
+  layout.setOuterMargin(5.0f);
+  layout.setGroupMargin(5.0f);
+  layout.setRowMargin(15.0f);
+  layout.setCellMargin(10.0f);
+  layout.setTitleMargin(2.0f);
+  layout.setCellWidth(64.0f, 64.0f);
+  layout.setCellHeight(64.0f, 128.0f);
+}
+
+void addCells(CellLayout& layout)
+{
+  for (size_t i = 0; i < NumCells; ++i)
+  {
+    if (i % (NumCells / NumGroups) == 0)
+    {
+      layout.addGroup("group " + std::to_string(i / (NumCells / NumGroups)), 14.0f);
+    }
+
+    const auto itemWidth = float(32 << (i % 3));
+    const auto itemHeight = float(32 << (i % 4));
+    layout.addItem(i, "texture_" + std::to_string(i), itemWidth, itemHeight, 64.0f, 18.0f);
+  }
+}
+
+size_t renderCells(CellLayout& layout, const float y)
+{
+  // mimics what the cell views do when rendering a frame
+  auto count = size_t(0);
+  for (const auto* cell : layout.cells(y, 600.0f))
+  {
+    count += cell->itemAs<size_t>();
+  }
+  return count;
+}
+} // namespace
+
+TEST_CASE("CellLayoutBenchmark.relayout")
+{
+  auto layout = CellLayout{};
+  initLayout(layout);
+  layout.setWidth(800.0f);
+
+  timeLambda(
+    [&]() {
+      layout.clear();
+      addCells(layout);
+      renderCells(layout, 0.0f);
+    },
+    "reload layout with " + std::to_string(NumCells) + " cells");
+
+  for (const auto width : {640.0f, 1024.0f, 800.0f})
+  {
+    layout.setWidth(width);
+    timeLambda(
+      [&]() { renderCells(layout, layout.height() / 2.0f); },
+      "relayout " + std::to_string(NumCells) + " cells for width "
+        + std::to_string(int(width)));
+  }
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 1000; ++i)
+      {
+        renderCells(layout, float(i) / 1000.0f * layout.height());
+      }
+    },
+    "render 1000 frames while scrolling");
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 1000; ++i)
+      {
+        layout.cellAt(400.0f, float(i) / 1000.0f * layout.height());
+      }
+    },
+    "find 1000 cells by position");
+}
+
+} // namespace TrenchBroom::View
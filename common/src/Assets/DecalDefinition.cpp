@@ -69,16 +69,19 @@ kdl_reflect_impl(DecalSpecification);
 
 DecalDefinition::DecalDefinition()
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, 0, 0}
+  , m_compiledExpression{m_expression}
 {
 }
 
 DecalDefinition::DecalDefinition(const size_t line, const size_t column)
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, line, column}
+  , m_compiledExpression{m_expression}
 {
 }
 
 DecalDefinition::DecalDefinition(EL::Expression expression)
   : m_expression{std::move(expression)}
+  , m_compiledExpression{m_expression}
 {
 }
 
@@ -89,12 +92,13 @@ void DecalDefinition::append(const DecalDefinition& other)
 
   auto cases = std::vector<EL::Expression>{std::move(m_expression), other.m_expression};
   m_expression = EL::Expression{EL::SwitchExpression{std::move(cases)}, line, column};
+  m_compiledExpression = EL::CompiledExpression{m_expression};
 }
 
 DecalSpecification DecalDefinition::decalSpecification(
   const EL::VariableStore& variableStore) const
 {
-  return convertToDecal(m_expression.evaluate(EL::EvaluationContext{variableStore}));
+  return convertToDecal(m_compiledExpression.evaluate(variableStore));
 }
 
 DecalSpecification DecalDefinition::defaultDecalSpecification() const
@@ -102,6 +106,11 @@ DecalSpecification DecalDefinition::defaultDecalSpecification() const
   return decalSpecification(EL::NullVariableStore{});
 }
 
+const std::vector<std::string>& DecalDefinition::variableNames() const
+{
+  return m_compiledExpression.variableNames();
+}
+
 kdl_reflect_impl(DecalDefinition);
 
 } // namespace Assets
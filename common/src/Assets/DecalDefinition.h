@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "EL/CompiledExpression.h"
 #include "EL/Expression.h"
 
 #include <kdl/reflection_decl.h>
@@ -26,6 +27,8 @@
 #include <vecmath/vec.h>
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom::Assets
 {
@@ -46,6 +49,7 @@ class DecalDefinition
 {
 private:
   EL::Expression m_expression;
+  EL::CompiledExpression m_compiledExpression;
 
 public:
   DecalDefinition();
@@ -74,6 +78,12 @@ public:
    */
   DecalSpecification defaultDecalSpecification() const;
 
+  /**
+   * Returns the sorted names of the variables read by the decal expression. The decal
+   * specification only changes if the value of one of these variables changes.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   kdl_reflect_decl(DecalDefinition, m_expression);
 };
 
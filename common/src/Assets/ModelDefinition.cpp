@@ -60,16 +60,19 @@ kdl_reflect_impl(ModelSpecification);
 
 ModelDefinition::ModelDefinition()
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, 0, 0}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(const size_t line, const size_t column)
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, line, column}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(EL::Expression expression)
   : m_expression{std::move(expression)}
+  , m_compiledExpression{m_expression}
 {
 }
 
@@ -80,6 +83,7 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = EL::Expression{EL::SwitchExpression{std::move(cases)}, line, column};
+  m_compiledExpression = EL::CompiledExpression{m_expression};
 }
 
 static std::filesystem::path path(const EL::Value& value)
@@ -128,8 +132,7 @@ static ModelSpecification convertToModel(const EL::Value& value)
 ModelSpecification ModelDefinition::modelSpecification(
   const EL::VariableStore& variableStore) const
 {
-  const auto context = EL::EvaluationContext{variableStore};
-  return convertToModel(m_expression.evaluate(context));
+  return convertToModel(m_compiledExpression.evaluate(variableStore));
 }
 
 ModelSpecification ModelDefinition::defaultModelSpecification() const
@@ -137,6 +140,11 @@ ModelSpecification ModelDefinition::defaultModelSpecification() const
   return modelSpecification(EL::NullVariableStore{});
 }
 
+const std::vector<std::string>& ModelDefinition::variableNames() const
+{
+  return m_compiledExpression.variableNames();
+}
+
 static std::optional<vm::vec3> scaleValue(const EL::Value& value)
 {
   if (value.type() == EL::ValueType::Number)
@@ -192,8 +200,7 @@ vm::vec3 ModelDefinition::scale(
   const EL::VariableStore& variableStore,
   const std::optional<EL::Expression>& defaultScaleExpression) const
 {
-  const auto context = EL::EvaluationContext{variableStore};
-  const auto value = m_expression.evaluate(context);
+  const auto value = m_compiledExpression.evaluate(variableStore);
 
   switch (value.type())
   {
@@ -214,6 +221,7 @@ vm::vec3 ModelDefinition::scale(
 
   if (defaultScaleExpression)
   {
+    const auto context = EL::EvaluationContext{variableStore};
     if (const auto scale = convertToScale(defaultScaleExpression->evaluate(context)))
     {
       return *scale;
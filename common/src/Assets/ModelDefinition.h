@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "EL/CompiledExpression.h"
 #include "EL/Expression.h"
 #include "FloatType.h"
 
@@ -29,6 +30,8 @@
 #include <filesystem>
 #include <iosfwd>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -60,6 +63,7 @@ class ModelDefinition
 {
 private:
   EL::Expression m_expression;
+  EL::CompiledExpression m_compiledExpression;
 
 public:
   ModelDefinition();
@@ -89,6 +93,12 @@ public:
    */
   ModelSpecification defaultModelSpecification() const;
 
+  /**
+   * Returns the sorted names of the variables read by the model expression. The model
+   * specification only changes if the value of one of these variables changes.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   /**
    * Evaluates the model expression using the given variable store to interpolate
    * variables, and returns the scale value configured for the model, if any. If the model
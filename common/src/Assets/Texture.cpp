@@ -220,6 +220,10 @@ Texture::Texture(Texture&& other)
   , m_blendFunc{std::move(other.m_blendFunc)}
   , m_textureId{std::move(other.m_textureId)}
   , m_buffers{std::move(other.m_buffers)}
+  , m_thumbnailAtlas{other.m_thumbnailAtlas}
+  , m_thumbnailRegion{other.m_thumbnailRegion}
+  , m_tagMaskKey{other.m_tagMaskKey}
+  , m_tagMask{other.m_tagMask}
   , m_gameData{std::move(other.m_gameData)}
 {
 }
@@ -241,6 +245,10 @@ Texture& Texture::operator=(Texture&& other)
   m_blendFunc = std::move(other.m_blendFunc);
   m_textureId = std::move(other.m_textureId);
   m_buffers = std::move(other.m_buffers);
+  m_thumbnailAtlas = other.m_thumbnailAtlas;
+  m_thumbnailRegion = other.m_thumbnailRegion;
+  m_tagMaskKey = other.m_tagMaskKey;
+  m_tagMask = other.m_tagMask;
   m_gameData = std::move(other.m_gameData);
   return *this;
 }
@@ -308,6 +316,7 @@ const std::set<std::string>& Texture::surfaceParms() const
 void Texture::setSurfaceParms(std::set<std::string> surfaceParms)
 {
   m_surfaceParms = std::move(surfaceParms);
+  m_tagMaskKey = 0;
 }
 
 TextureCulling Texture::culling() const
@@ -539,6 +548,33 @@ void Texture::deactivate() const
   }
 }
 
+const TextureAtlas* Texture::thumbnailAtlas() const
+{
+  return m_thumbnailAtlas;
+}
+
+const TextureAtlasRegion& Texture::thumbnailRegion() const
+{
+  return m_thumbnailRegion;
+}
+
+void Texture::setThumbnail(const TextureAtlas& atlas, const TextureAtlasRegion& region)
+{
+  m_thumbnailAtlas = &atlas;
+  m_thumbnailRegion = region;
+}
+
+std::optional<std::uint64_t> Texture::cachedTagMask(const std::uint64_t key) const
+{
+  return key != 0 && key == m_tagMaskKey ? std::optional{m_tagMask} : std::nullopt;
+}
+
+void Texture::setCachedTagMask(const std::uint64_t key, const std::uint64_t tagMask) const
+{
+  m_tagMaskKey = key;
+  m_tagMask = tagMask;
+}
+
 const Texture::BufferList& Texture::buffersIfUnprepared() const
 {
   return m_buffers;
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Assets/TextureAtlas.h"
 #include "Assets/TextureBuffer.h"
 #include "Color.h"
 #include "Renderer/GL.h"
@@ -28,7 +29,9 @@
 #include <vecmath/forward.h>
 
 #include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <string>
 #include <variant>
@@ -134,6 +137,14 @@ private:
   mutable GLuint m_textureId;
   mutable BufferList m_buffers;
 
+  const TextureAtlas* m_thumbnailAtlas = nullptr;
+  TextureAtlasRegion m_thumbnailRegion = {0, 0, 0, 0, 0};
+
+  // the texture tags matching this texture, cached by Model::TagManager, and the key of
+  // the tag manager that computed them
+  mutable std::uint64_t m_tagMaskKey = 0;
+  mutable std::uint64_t m_tagMask = 0;
+
   GameData m_gameData;
 
   kdl_reflect_decl(
@@ -235,6 +246,24 @@ public:
   void activate() const;
   void deactivate() const;
 
+  /**
+   * Returns the atlas that contains the thumbnail of this texture, or nullptr if this
+   * texture has no thumbnail.
+   */
+  const TextureAtlas* thumbnailAtlas() const;
+  const TextureAtlasRegion& thumbnailRegion() const;
+  void setThumbnail(const TextureAtlas& atlas, const TextureAtlasRegion& region);
+
+  /**
+   * Returns the cached mask of the texture tags that match this texture if it was
+   * cached with the given key, and an empty optional otherwise.
+   *
+   * Texture tags only depend on the texture, so the tag manager identified by the key
+   * computes them once and reuses them for all faces using this texture.
+   */
+  std::optional<std::uint64_t> cachedTagMask(std::uint64_t key) const;
+  void setCachedTagMask(std::uint64_t key, std::uint64_t tagMask) const;
+
 public: // exposed for tests only
   /**
    * Returns the texture data in the format returned by format().
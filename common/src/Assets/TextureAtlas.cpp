@@ -0,0 +1,212 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureAtlas.h"
+
+#include "Assets/TextureThumbnail.h"
+#include "Ensure.h"
+
+#include <kdl/reflection_impl.h>
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom::Assets
+{
+
+kdl_reflect_impl(TextureAtlasRegion);
+
+bool canDrawFromThumbnail(
+  const TextureAtlasRegion& region,
+  const float width,
+  const float height,
+  const float devicePixelRatio)
+{
+  return width <= float(region.width) * devicePixelRatio
+         && height <= float(region.height) * devicePixelRatio;
+}
+
+TextureAtlas::TextureAtlas(const size_t pageSize, const size_t padding)
+  : m_pageSize{pageSize}
+  , m_padding{padding}
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+  if (!m_pageIds.empty())
+  {
+    glAssert(glDeleteTextures(
+      static_cast<GLsizei>(m_pageIds.size()), static_cast<GLuint*>(&m_pageIds.front())));
+    m_pageIds.clear();
+  }
+}
+
+size_t TextureAtlas::pageSize() const
+{
+  return m_pageSize;
+}
+
+size_t TextureAtlas::pageCount() const
+{
+  return m_pages.size();
+}
+
+const std::vector<unsigned char>& TextureAtlas::pagePixels(const size_t page) const
+{
+  ensure(page < m_pages.size(), "page index is in range");
+  return m_pages[page].pixels;
+}
+
+std::optional<TextureAtlasRegion> TextureAtlas::add(const TextureThumbnail& thumbnail)
+{
+  assert(!prepared());
+  assert(thumbnail.pixels.size() == thumbnail.width * thumbnail.height * 4);
+
+  if (thumbnail.width > m_pageSize || thumbnail.height > m_pageSize)
+  {
+    return std::nullopt;
+  }
+
+  auto position = std::optional<vm::vec2s>{};
+  if (!m_pages.empty())
+  {
+    position = allocate(m_pages.back(), thumbnail.width, thumbnail.height);
+  }
+
+  if (!position)
+  {
+    m_pages.push_back(Page{std::vector<unsigned char>(m_pageSize * m_pageSize * 4, 0)});
+    position = allocate(m_pages.back(), thumbnail.width, thumbnail.height);
+    assert(position);
+  }
+
+  const auto page = m_pages.size() - 1;
+  const auto x = position->x();
+  const auto y = position->y();
+
+  const auto rowLength = thumbnail.width * 4;
+  auto* pixels = m_pages.back().pixels.data();
+  for (size_t row = 0; row < thumbnail.height; ++row)
+  {
+    std::copy_n(
+      thumbnail.pixels.data() + row * rowLength,
+      rowLength,
+      pixels + ((y + row) * m_pageSize + x) * 4);
+  }
+
+  return TextureAtlasRegion{page, x, y, thumbnail.width, thumbnail.height};
+}
+
+std::pair<vm::vec2f, vm::vec2f> TextureAtlas::texCoords(
+  const TextureAtlasRegion& region) const
+{
+  const auto pageSize = float(m_pageSize);
+  return {
+    vm::vec2f{float(region.x), float(region.y)} / pageSize,
+    vm::vec2f{float(region.x + region.width), float(region.y + region.height)}
+      / pageSize};
+}
+
+bool TextureAtlas::prepared() const
+{
+  return !m_pageIds.empty();
+}
+
+void TextureAtlas::prepare()
+{
+  assert(!prepared());
+
+  if (m_pages.empty())
+  {
+    return;
+  }
+
+  m_pageIds.resize(m_pages.size());
+  glAssert(glGenTextures(
+    static_cast<GLsizei>(m_pageIds.size()), static_cast<GLuint*>(&m_pageIds.front())));
+
+  glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+  glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+  glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    glAssert(glBindTexture(GL_TEXTURE_2D, m_pageIds[i]));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    glAssert(glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      GL_RGBA,
+      static_cast<GLsizei>(m_pageSize),
+      static_cast<GLsizei>(m_pageSize),
+      0,
+      GL_RGBA,
+      GL_UNSIGNED_BYTE,
+      reinterpret_cast<const GLvoid*>(m_pages[i].pixels.data())));
+
+    // the pixels are not needed anymore
+    m_pages[i].pixels = std::vector<unsigned char>{};
+  }
+
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+void TextureAtlas::activate(const size_t page) const
+{
+  ensure(page < m_pageIds.size(), "page index is in range");
+  glAssert(glBindTexture(GL_TEXTURE_2D, m_pageIds[page]));
+}
+
+void TextureAtlas::deactivate() const
+{
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+std::optional<vm::vec2s> TextureAtlas::allocate(
+  Page& page, const size_t width, const size_t height) const
+{
+  if (page.shelfX > 0 && page.shelfX + width > m_pageSize)
+  {
+    // start a new shelf
+    page.shelfY += page.shelfHeight + m_padding;
+    page.shelfX = 0;
+    page.shelfHeight = 0;
+  }
+
+  if (page.shelfX + width > m_pageSize || page.shelfY + height > m_pageSize)
+  {
+    return std::nullopt;
+  }
+
+  const auto position = vm::vec2s{page.shelfX, page.shelfY};
+  page.shelfX += width + m_padding;
+  page.shelfHeight = std::max(page.shelfHeight, height);
+  return position;
+}
+
+} // namespace TrenchBroom::Assets
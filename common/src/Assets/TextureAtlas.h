@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include <kdl/reflection_decl.h>
+
+#include <vecmath/forward.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+struct TextureThumbnail;
+
+struct TextureAtlasRegion
+{
+  size_t page;
+  size_t x;
+  size_t y;
+  size_t width;
+  size_t height;
+
+  kdl_reflect_decl(TextureAtlasRegion, page, x, y, width, height);
+};
+
+/**
+ * Returns whether an item with the given on-screen size in logical pixels can be drawn
+ * from the given thumbnail region, i.e. whether it is not larger than the thumbnail
+ * scaled by the given device pixel ratio.
+ */
+bool canDrawFromThumbnail(
+  const TextureAtlasRegion& region, float width, float height, float devicePixelRatio);
+
+/**
+ * Packs thumbnails into square pages so that many thumbnails can be rendered with a
+ * single texture bind.
+ *
+ * Thumbnails are packed into shelves, i.e. rows that are as high as the highest thumbnail
+ * they contain. A new page is started when a thumbnail doesn't fit into the current page.
+ * The pages are kept in memory until they are uploaded by calling `prepare`.
+ */
+class TextureAtlas
+{
+private:
+  struct Page
+  {
+    std::vector<unsigned char> pixels;
+    size_t shelfY = 0;
+    size_t shelfHeight = 0;
+    size_t shelfX = 0;
+  };
+
+  size_t m_pageSize;
+  size_t m_padding;
+  std::vector<Page> m_pages;
+  std::vector<GLuint> m_pageIds;
+
+public:
+  explicit TextureAtlas(size_t pageSize, size_t padding = 1);
+  ~TextureAtlas();
+
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+  size_t pageSize() const;
+  size_t pageCount() const;
+
+  /**
+   * Returns the RGBA pixels of the given page. Once prepare() is called, this will be
+   * an empty vector.
+   */
+  const std::vector<unsigned char>& pagePixels(size_t page) const;
+
+  /**
+   * Adds the given thumbnail to this atlas and returns the region where it was placed,
+   * or nothing if the thumbnail is larger than a page.
+   */
+  std::optional<TextureAtlasRegion> add(const TextureThumbnail& thumbnail);
+
+  /**
+   * Returns the texture coordinates of the top left and the bottom right corners of the
+   * given region.
+   */
+  std::pair<vm::vec2f, vm::vec2f> texCoords(const TextureAtlasRegion& region) const;
+
+  bool prepared() const;
+  void prepare();
+
+  void activate(size_t page) const;
+  void deactivate() const;
+
+private:
+  std::optional<vm::vec2s> allocate(Page& page, size_t width, size_t height) const;
+};
+
+} // namespace TrenchBroom::Assets
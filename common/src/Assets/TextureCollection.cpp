@@ -19,16 +19,43 @@
 
 #include "TextureCollection.h"
 
+#include "Assets/TextureAtlas.h"
+#include "Assets/TextureThumbnail.h"
 #include "Ensure.h"
 
 #include <kdl/reflection_impl.h>
 #include <kdl/vector_utils.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom::Assets
 {
+namespace
+{
+constexpr size_t MaxThumbnailAtlasPageSize = 2048;
+
+/**
+ * Returns the smallest power of two that is large enough to hold the given thumbnails in
+ * one page, but not larger than the maximum page size.
+ */
+size_t thumbnailAtlasPageSize(const std::vector<TextureThumbnail>& thumbnails)
+{
+  auto area = size_t(0);
+  for (const auto& thumbnail : thumbnails)
+  {
+    area += (thumbnail.width + 1) * (thumbnail.height + 1);
+  }
+
+  auto pageSize = ThumbnailSize;
+  while (pageSize < MaxThumbnailAtlasPageSize && pageSize * pageSize < area)
+  {
+    pageSize *= 2;
+  }
+  return pageSize;
+}
+} // namespace
 
 kdl_reflect_impl(TextureCollection);
 
@@ -52,6 +79,18 @@ TextureCollection::TextureCollection(
 {
 }
 
+TextureCollection::TextureCollection(
+  std::filesystem::path path,
+  std::vector<Texture> textures,
+  std::vector<TextureThumbnail> thumbnails)
+  : m_path{std::move(path)}
+  , m_textures{std::move(textures)}
+  , m_thumbnails{std::move(thumbnails)}
+  , m_loaded{true}
+{
+  ensure(m_thumbnails.size() == m_textures.size(), "one thumbnail per texture");
+}
+
 TextureCollection::~TextureCollection()
 {
   if (!m_textureIds.empty())
@@ -131,6 +170,9 @@ void TextureCollection::prepare(const int minFilter, const int magFilter)
   m_textureIds.resize(textureCount());
   if (textureCount() != 0u)
   {
+    // the thumbnails must be created before the texture data is uploaded and discarded
+    prepareThumbnails();
+
     glAssert(glGenTextures(
       static_cast<GLsizei>(textureCount()), static_cast<GLuint*>(&m_textureIds.front())));
 
@@ -142,6 +184,24 @@ void TextureCollection::prepare(const int minFilter, const int magFilter)
   }
 }
 
+void TextureCollection::prepareThumbnails()
+{
+  // collections that were not loaded from disk don't have thumbnails yet
+  const auto thumbnails = m_thumbnails.size() == m_textures.size()
+                            ? std::exchange(m_thumbnails, {})
+                            : createTextureThumbnails(m_textures, ThumbnailSize);
+
+  m_thumbnailAtlas = std::make_unique<TextureAtlas>(thumbnailAtlasPageSize(thumbnails));
+  for (size_t i = 0; i < thumbnails.size(); ++i)
+  {
+    if (const auto region = m_thumbnailAtlas->add(thumbnails[i]))
+    {
+      m_textures[i].setThumbnail(*m_thumbnailAtlas, *region);
+    }
+  }
+  m_thumbnailAtlas->prepare();
+}
+
 void TextureCollection::setTextureMode(const int minFilter, const int magFilter)
 {
   for (auto& texture : m_textures)
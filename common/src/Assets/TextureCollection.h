@@ -20,11 +20,13 @@
 #pragma once
 
 #include "Assets/Texture.h"
+#include "Assets/TextureThumbnail.h"
 #include "Renderer/GL.h"
 
 #include <kdl/reflection_decl.h>
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,8 +41,15 @@ private:
   std::filesystem::path m_path;
   std::vector<Texture> m_textures;
 
+  /**
+   * The thumbnails created while loading the textures, one per texture. They are moved
+   * into the thumbnail atlas when the collection is prepared.
+   */
+  std::vector<TextureThumbnail> m_thumbnails;
+
   bool m_loaded{false};
   TextureIdList m_textureIds;
+  std::unique_ptr<TextureAtlas> m_thumbnailAtlas;
 
   friend class Texture;
 
@@ -51,6 +60,10 @@ public:
   explicit TextureCollection(std::vector<Texture> textures);
   explicit TextureCollection(std::filesystem::path path);
   TextureCollection(std::filesystem::path path, std::vector<Texture> textures);
+  TextureCollection(
+    std::filesystem::path path,
+    std::vector<Texture> textures,
+    std::vector<TextureThumbnail> thumbnails);
 
   TextureCollection(const TextureCollection&) = delete;
   TextureCollection& operator=(const TextureCollection&) = delete;
@@ -77,6 +90,9 @@ public:
   bool prepared() const;
   void prepare(int minFilter, int magFilter);
   void setTextureMode(int minFilter, int magFilter);
+
+private:
+  void prepareThumbnails();
 };
 
 } // namespace TrenchBroom::Assets
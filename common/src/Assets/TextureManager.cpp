@@ -24,6 +24,7 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "IO/LoadTextureCollection.h"
+#include "IO/TextureThumbnailCache.h"
 #include "Logger.h"
 
 #include <kdl/map_utils.h>
@@ -64,6 +65,11 @@ void TextureManager::reload(
     });
 }
 
+void TextureManager::setThumbnailCacheDirectory(std::filesystem::path directory)
+{
+  m_thumbnailCache = std::make_unique<IO::TextureThumbnailCache>(std::move(directory));
+}
+
 void TextureManager::setTextureCollections(std::vector<TextureCollection> collections)
 {
   for (auto& collection : collections)
@@ -90,7 +96,7 @@ void TextureManager::setTextureCollections(
 
     if (it == collections.end() || !it->loaded())
     {
-      IO::loadTextureCollection(path, fs, textureConfig, m_logger)
+      IO::loadTextureCollection(path, fs, textureConfig, m_logger, m_thumbnailCache.get())
         .transform_error([&](const auto& error) {
           if (it == collections.end())
           {
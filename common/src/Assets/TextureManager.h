@@ -23,6 +23,7 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,7 @@ class Logger;
 namespace IO
 {
 class FileSystem;
+class TextureThumbnailCache;
 } // namespace IO
 
 namespace Model
@@ -62,12 +64,20 @@ private:
   int m_magFilter;
   bool m_resetTextureMode{false};
 
+  std::unique_ptr<IO::TextureThumbnailCache> m_thumbnailCache;
+
 public:
   TextureManager(int magFilter, int minFilter, Logger& logger);
   ~TextureManager();
 
   void reload(const IO::FileSystem& fs, const Model::TextureConfig& textureConfig);
 
+  /**
+   * Stores the thumbnails of the loaded texture collections in the given directory and
+   * reuses them when the collections are loaded again.
+   */
+  void setThumbnailCacheDirectory(std::filesystem::path directory);
+
   // for testing
   void setTextureCollections(std::vector<TextureCollection> collections);
 
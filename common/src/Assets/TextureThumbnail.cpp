@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnail.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Color.h"
+
+#include <kdl/parallel.h>
+#include <kdl/reflection_impl.h>
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+
+vm::vec2s thumbnailSize(const size_t width, const size_t height, const size_t maxSize)
+{
+  if (width <= maxSize && height <= maxSize)
+  {
+    return vm::vec2s{width, height};
+  }
+
+  const auto scale = double(maxSize) / double(std::max(width, height));
+  return vm::vec2s{
+    std::max(size_t(1), size_t(std::round(double(width) * scale))),
+    std::max(size_t(1), size_t(std::round(double(height) * scale)))};
+}
+
+TextureThumbnail createSolidThumbnail(const vm::vec2s& size, const Color& color)
+{
+  const auto toByte = [](const float f) {
+    return static_cast<unsigned char>(std::clamp(f, 0.0f, 1.0f) * 255.0f);
+  };
+  const auto rgba = std::array<unsigned char, 4>{
+    toByte(color.r()), toByte(color.g()), toByte(color.b()), toByte(color.a())};
+
+  auto pixels = std::vector<unsigned char>(size.x() * size.y() * 4);
+  for (size_t i = 0; i < pixels.size(); i += 4)
+  {
+    std::copy(rgba.begin(), rgba.end(), pixels.data() + i);
+  }
+  return TextureThumbnail{size.x(), size.y(), std::move(pixels)};
+}
+
+size_t selectMipLevel(const Texture& texture, const vm::vec2s& size)
+{
+  const auto mipLevels = texture.buffersIfUnprepared().size();
+
+  auto level = size_t(0);
+  while (level + 1 < mipLevels)
+  {
+    const auto mipSize = sizeAtMipLevel(texture.width(), texture.height(), level + 1);
+    if (mipSize.x() < size.x() || mipSize.y() < size.y())
+    {
+      break;
+    }
+    ++level;
+  }
+  return level;
+}
+
+/**
+ * Downscales the given pixels using a box filter.
+ */
+TextureThumbnail downscale(
+  const unsigned char* data,
+  const vm::vec2s& sourceSize,
+  const size_t bytesPerPixel,
+  const bool bgr,
+  const vm::vec2s& size)
+{
+  const auto sourceWidth = sourceSize.x();
+  const auto sourceHeight = sourceSize.y();
+  const auto width = size.x();
+  const auto height = size.y();
+
+  auto pixels = std::vector<unsigned char>(width * height * 4);
+  for (size_t y = 0; y < height; ++y)
+  {
+    const auto y0 = y * sourceHeight / height;
+    const auto y1 = std::max(y0 + 1, (y + 1) * sourceHeight / height);
+
+    for (size_t x = 0; x < width; ++x)
+    {
+      const auto x0 = x * sourceWidth / width;
+      const auto x1 = std::max(x0 + 1, (x + 1) * sourceWidth / width);
+
+      auto sum = std::array<size_t, 4>{0, 0, 0, 0};
+      for (size_t sy = y0; sy < y1; ++sy)
+      {
+        for (size_t sx = x0; sx < x1; ++sx)
+        {
+          const auto* pixel = data + (sy * sourceWidth + sx) * bytesPerPixel;
+          sum[0] += pixel[0];
+          sum[1] += pixel[1];
+          sum[2] += pixel[2];
+          sum[3] += bytesPerPixel == 4 ? pixel[3] : 0xFF;
+        }
+      }
+
+      const auto count = (y1 - y0) * (x1 - x0);
+      auto* target = pixels.data() + (y * width + x) * 4;
+      target[0] = static_cast<unsigned char>(sum[bgr ? 2 : 0] / count);
+      target[1] = static_cast<unsigned char>(sum[1] / count);
+      target[2] = static_cast<unsigned char>(sum[bgr ? 0 : 2] / count);
+      target[3] = static_cast<unsigned char>(sum[3] / count);
+    }
+  }
+
+  return TextureThumbnail{width, height, std::move(pixels)};
+}
+
+} // namespace
+
+kdl_reflect_impl(TextureThumbnail);
+
+TextureThumbnail createTextureThumbnail(const Texture& texture, const size_t maxSize)
+{
+  const auto size = thumbnailSize(texture.width(), texture.height(), maxSize);
+
+  const auto& buffers = texture.buffersIfUnprepared();
+  if (buffers.empty() || isCompressedFormat(texture.format()))
+  {
+    return createSolidThumbnail(size, texture.averageColor());
+  }
+
+  const auto level = selectMipLevel(texture, size);
+  const auto mipSize = sizeAtMipLevel(texture.width(), texture.height(), level);
+  const auto bytesPerPixel = bytesPerPixelForFormat(texture.format());
+  if (buffers[level].size() < mipSize.x() * mipSize.y() * bytesPerPixel)
+  {
+    return createSolidThumbnail(size, texture.averageColor());
+  }
+
+  const auto bgr = texture.format() == GL_BGR || texture.format() == GL_BGRA;
+  return downscale(buffers[level].data(), mipSize, bytesPerPixel, bgr, size);
+}
+
+std::vector<TextureThumbnail> createTextureThumbnails(
+  const std::vector<Texture>& textures, const size_t maxSize)
+{
+  auto result = std::vector<TextureThumbnail>(textures.size());
+  kdl::parallel_for(textures.size(), [&](const size_t i) {
+    result[i] = createTextureThumbnail(textures[i], maxSize);
+  });
+  return result;
+}
+
+} // namespace TrenchBroom::Assets
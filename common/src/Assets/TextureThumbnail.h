@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <kdl/reflection_decl.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+class Texture;
+
+/**
+ * The maximum width and height of the texture thumbnails.
+ */
+constexpr size_t ThumbnailSize = 64;
+
+/**
+ * A small downscaled preview of a texture.
+ */
+struct TextureThumbnail
+{
+  size_t width = 0;
+  size_t height = 0;
+
+  /**
+   * The RGBA pixels of the thumbnail, in the same row order as the texture data.
+   */
+  std::vector<unsigned char> pixels;
+
+  kdl_reflect_decl(TextureThumbnail, width, height, pixels);
+};
+
+/**
+ * Creates a thumbnail of the given texture that fits into a square of the given size.
+ *
+ * The thumbnail is created from the smallest mip level of the texture that is at least
+ * as large as the thumbnail. If the texture data is not available anymore or if it is
+ * compressed, the thumbnail is filled with the average color of the texture.
+ */
+TextureThumbnail createTextureThumbnail(const Texture& texture, size_t maxSize);
+
+/**
+ * Creates thumbnails of the given textures in parallel.
+ */
+std::vector<TextureThumbnail> createTextureThumbnails(
+  const std::vector<Texture>& textures, size_t maxSize);
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,323 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledExpression.h"
+
+#include "EL/EvaluationContext.h"
+#include "EL/Expressions.h"
+#include "EL/VariableStore.h"
+#include "Ensure.h"
+#include "Macros.h"
+
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
+namespace TrenchBroom::EL
+{
+void ExpressionCompiler::pushConstant(Value value)
+{
+  emit(OpCode::PushConstant, m_constants.size());
+  m_constants.push_back(std::move(value));
+  push();
+}
+
+void ExpressionCompiler::loadVariable(const std::string& name)
+{
+  if (m_subscriptDepth > 0 && name == SubscriptExpression::AutoRangeParameterName())
+  {
+    emit(OpCode::LoadAutoRange);
+  }
+  else
+  {
+    emit(OpCode::LoadVariable, m_names.size());
+    m_names.push_back(name);
+    m_variableNames.push_back(name);
+  }
+  push();
+}
+
+void ExpressionCompiler::makeArray(const size_t count)
+{
+  emit(OpCode::MakeArray, 0, count);
+  pop(count);
+  push();
+}
+
+void ExpressionCompiler::makeMap(const std::vector<std::string>& keys)
+{
+  emit(OpCode::MakeMap, m_names.size(), keys.size());
+  m_names.insert(m_names.end(), keys.begin(), keys.end());
+  pop(keys.size());
+  push();
+}
+
+void ExpressionCompiler::applyUnaryOperator(const UnaryOperator operator_)
+{
+  emit(OpCode::ApplyUnaryOperator, static_cast<std::uint8_t>(operator_));
+}
+
+std::optional<size_t> ExpressionCompiler::shortCircuit(const BinaryOperator operator_)
+{
+  switch (operator_)
+  {
+  case BinaryOperator::LogicalAnd:
+  case BinaryOperator::LogicalOr:
+  case BinaryOperator::Case:
+    emit(OpCode::ShortCircuit, static_cast<std::uint8_t>(operator_));
+    return m_instructions.size() - 1u;
+  case BinaryOperator::Addition:
+  case BinaryOperator::Subtraction:
+  case BinaryOperator::Multiplication:
+  case BinaryOperator::Division:
+  case BinaryOperator::Modulus:
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+    return std::nullopt;
+    switchDefault();
+  }
+}
+
+void ExpressionCompiler::applyBinaryOperator(const BinaryOperator operator_)
+{
+  emit(OpCode::ApplyBinaryOperator, static_cast<std::uint8_t>(operator_));
+  pop();
+}
+
+void ExpressionCompiler::beginSubscript()
+{
+  emit(OpCode::BeginSubscript);
+  ++m_subscriptDepth;
+}
+
+void ExpressionCompiler::endSubscript()
+{
+  assert(m_subscriptDepth > 0);
+
+  emit(OpCode::EndSubscript);
+  --m_subscriptDepth;
+  pop();
+}
+
+size_t ExpressionCompiler::jumpIfDefined()
+{
+  emit(OpCode::JumpIfDefined);
+  pop();
+  return m_instructions.size() - 1u;
+}
+
+void ExpressionCompiler::bindJump(const size_t jump)
+{
+  assert(jump < m_instructions.size());
+  m_instructions[jump].argument = static_cast<std::uint32_t>(m_instructions.size());
+}
+
+void ExpressionCompiler::emit(
+  const OpCode opCode, const size_t argument, const size_t count)
+{
+  ensure(
+    argument <= std::numeric_limits<std::uint32_t>::max()
+      && count <= std::numeric_limits<std::uint32_t>::max(),
+    "instruction arguments fit into 32 bits");
+
+  m_instructions.push_back(Instruction{
+    opCode, 0, static_cast<std::uint32_t>(argument), static_cast<std::uint32_t>(count)});
+}
+
+void ExpressionCompiler::emit(const OpCode opCode, const std::uint8_t operator_)
+{
+  m_instructions.push_back(Instruction{opCode, operator_, 0, 0});
+}
+
+void ExpressionCompiler::push(const size_t count)
+{
+  m_stackSize += count;
+  m_maxStackSize = std::max(m_maxStackSize, m_stackSize);
+}
+
+void ExpressionCompiler::pop(const size_t count)
+{
+  assert(m_stackSize >= count);
+  m_stackSize -= count;
+}
+
+CompiledExpression::CompiledExpression(Expression expression)
+  : m_expression{std::move(expression)}
+{
+  auto compiler = ExpressionCompiler{};
+  m_expression.compile(compiler);
+  assert(compiler.m_stackSize == 1u);
+
+  m_instructions = std::move(compiler.m_instructions);
+  m_constants = std::move(compiler.m_constants);
+  m_names = std::move(compiler.m_names);
+  m_variableNames =
+    kdl::vec_sort_and_remove_duplicates(std::move(compiler.m_variableNames));
+  m_maxStackSize = compiler.m_maxStackSize;
+}
+
+const Expression& CompiledExpression::expression() const
+{
+  return m_expression;
+}
+
+size_t CompiledExpression::instructionCount() const
+{
+  return m_instructions.size();
+}
+
+const std::vector<std::string>& CompiledExpression::variableNames() const
+{
+  return m_variableNames;
+}
+
+Value CompiledExpression::evaluate(const VariableStore& variableStore) const
+{
+  return execute([&](const auto& name) { return variableStore.value(name); });
+}
+
+Value CompiledExpression::evaluate(const EvaluationContext& context) const
+{
+  return execute([&](const auto& name) { return context.variableValue(name); });
+}
+
+template <typename LoadVariable>
+Value CompiledExpression::execute(const LoadVariable& loadVariable) const
+{
+  auto stack = std::vector<Value>{};
+  stack.reserve(m_maxStackSize);
+
+  auto autoRanges = std::vector<Value>{};
+
+  const auto pop = [&]() {
+    auto value = std::move(stack.back());
+    stack.pop_back();
+    return value;
+  };
+
+  size_t i = 0;
+  while (i < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[i++];
+    switch (instruction.opCode)
+    {
+    case OpCode::PushConstant:
+      stack.push_back(m_constants[instruction.argument]);
+      break;
+    case OpCode::LoadVariable:
+      stack.push_back(loadVariable(m_names[instruction.argument]));
+      break;
+    case OpCode::LoadAutoRange:
+      stack.push_back(autoRanges.back());
+      break;
+    case OpCode::MakeArray: {
+      const auto first = stack.end() - static_cast<std::ptrdiff_t>(instruction.count);
+      auto array = ArrayType{};
+      array.reserve(instruction.count);
+      for (auto it = first; it != stack.end(); ++it)
+      {
+        if (it->hasType(ValueType::Range))
+        {
+          const auto& range = it->rangeValue();
+          array.reserve(array.size() + range.size());
+          for (const auto index : range)
+          {
+            array.emplace_back(index, it->expression());
+          }
+        }
+        else
+        {
+          array.push_back(std::move(*it));
+        }
+      }
+      stack.erase(first, stack.end());
+      stack.emplace_back(std::move(array));
+      break;
+    }
+    case OpCode::MakeMap: {
+      const auto first = stack.end() - static_cast<std::ptrdiff_t>(instruction.count);
+      auto map = MapType{};
+      for (size_t j = 0; j < instruction.count; ++j)
+      {
+        map.emplace(m_names[instruction.argument + j], std::move(*(first + j)));
+      }
+      stack.erase(first, stack.end());
+      stack.emplace_back(std::move(map));
+      break;
+    }
+    case OpCode::ApplyUnaryOperator:
+      stack.back() = evaluateUnaryOperator(
+        static_cast<UnaryOperator>(instruction.operator_), stack.back());
+      break;
+    case OpCode::ApplyBinaryOperator: {
+      const auto rhs = pop();
+      stack.back() = evaluateBinaryOperator(
+        static_cast<BinaryOperator>(instruction.operator_), stack.back(), rhs);
+      break;
+    }
+    case OpCode::ShortCircuit:
+      if (
+        auto result = evaluateShortCircuit(
+          static_cast<BinaryOperator>(instruction.operator_), stack.back()))
+      {
+        stack.back() = std::move(*result);
+        i = instruction.argument;
+      }
+      break;
+    case OpCode::BeginSubscript:
+      autoRanges.emplace_back(stack.back().length() - 1u);
+      break;
+    case OpCode::EndSubscript: {
+      const auto index = pop();
+      stack.back() = stack.back()[index];
+      autoRanges.pop_back();
+      break;
+    }
+    case OpCode::JumpIfDefined:
+      if (stack.back() != Value::Undefined)
+      {
+        i = instruction.argument;
+      }
+      else
+      {
+        stack.pop_back();
+      }
+      break;
+      switchDefault();
+    }
+  }
+
+  assert(stack.size() == 1u);
+  return Value{std::move(stack.back()), m_expression};
+}
+
+} // namespace TrenchBroom::EL
@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EL/EL_Forward.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::EL
+{
+enum class UnaryOperator;
+enum class BinaryOperator;
+
+enum class OpCode : std::uint8_t
+{
+  /** Pushes constants[argument]. */
+  PushConstant,
+  /** Pushes the value of the variable named names[argument]. */
+  LoadVariable,
+  /** Pushes the auto range parameter of the innermost subscript. */
+  LoadAutoRange,
+  /** Pops count values and pushes an array containing them. */
+  MakeArray,
+  /** Pops count values and pushes a map with the keys starting at names[argument]. */
+  MakeMap,
+  /** Replaces the top value with the result of the unary operator. */
+  ApplyUnaryOperator,
+  /** Pops the right operand and replaces the left operand with the result. */
+  ApplyBinaryOperator,
+  /**
+   * Replaces the left operand with the result of the binary operator and jumps to
+   * argument if the result is already determined by the left operand.
+   */
+  ShortCircuit,
+  /** Declares the auto range parameter for the subscripted value on top. */
+  BeginSubscript,
+  /** Pops the index and replaces the subscripted value with the indexed value. */
+  EndSubscript,
+  /** Jumps to argument if the top value is defined, otherwise pops it. */
+  JumpIfDefined,
+};
+
+struct Instruction
+{
+  OpCode opCode;
+  std::uint8_t operator_;
+  std::uint32_t argument;
+  std::uint32_t count;
+};
+
+/**
+ * Builds the instructions of a compiled expression. Each expression node appends the
+ * instructions that evaluate it, see ExpressionImpl::compile.
+ */
+class ExpressionCompiler
+{
+private:
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<std::string> m_names;
+  std::vector<std::string> m_variableNames;
+  size_t m_stackSize = 0;
+  size_t m_maxStackSize = 0;
+  size_t m_subscriptDepth = 0;
+
+public:
+  void pushConstant(Value value);
+  void loadVariable(const std::string& name);
+  void makeArray(size_t count);
+  void makeMap(const std::vector<std::string>& keys);
+  void applyUnaryOperator(UnaryOperator operator_);
+
+  /**
+   * Emits a short circuit for the given operator if it has one. The returned jump must be
+   * bound after the instructions of the right operand.
+   */
+  std::optional<size_t> shortCircuit(BinaryOperator operator_);
+  void applyBinaryOperator(BinaryOperator operator_);
+
+  void beginSubscript();
+  void endSubscript();
+
+  size_t jumpIfDefined();
+  void bindJump(size_t jump);
+
+private:
+  void emit(OpCode opCode, size_t argument = 0, size_t count = 0);
+  void emit(OpCode opCode, std::uint8_t operator_);
+  void push(size_t count = 1);
+  void pop(size_t count = 1);
+
+  friend class CompiledExpression;
+};
+
+/**
+ * An expression lowered to a flat list of instructions that are executed on a value
+ * stack. Evaluating a compiled expression yields the same values as evaluating the
+ * expression itself, but it doesn't walk the expression tree and it doesn't copy the
+ * given variable store.
+ *
+ * Unlike Expression::evaluate, only the result is tagged with the expression; nested
+ * values such as array elements do not carry their source location. Use the expression
+ * tree if the source location of nested values is required, e.g. for error messages.
+ *
+ * The given expression should be optimized before it is compiled.
+ */
+class CompiledExpression
+{
+private:
+  Expression m_expression;
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<std::string> m_names;
+  std::vector<std::string> m_variableNames;
+  size_t m_maxStackSize;
+
+public:
+  explicit CompiledExpression(Expression expression);
+
+  const Expression& expression() const;
+  size_t instructionCount() const;
+
+  /**
+   * Returns the sorted names of all variables that this expression may read. The result
+   * of evaluating this expression only depends on the values of these variables.
+   */
+  const std::vector<std::string>& variableNames() const;
+
+  Value evaluate(const VariableStore& variableStore) const;
+  Value evaluate(const EvaluationContext& context) const;
+
+private:
+  template <typename LoadVariable>
+  Value execute(const LoadVariable& loadVariable) const;
+};
+} // namespace TrenchBroom::EL
@@ -110,6 +110,11 @@ Expression Expression::optimize() const
   return Expression{m_expression->optimize(), m_line, m_column};
 }
 
+void Expression::compile(ExpressionCompiler& compiler) const
+{
+  m_expression->compile(compiler);
+}
+
 size_t Expression::line() const
 {
   return m_line;
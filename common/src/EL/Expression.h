@@ -64,6 +64,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const;
   Expression optimize() const;
+  void compile(ExpressionCompiler& compiler) const;
 
   size_t line() const;
   size_t column() const;
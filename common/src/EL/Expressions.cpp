@@ -19,6 +19,7 @@
 
 #include "Expressions.h"
 
+#include "EL/CompiledExpression.h"
 #include "EL/ELExceptions.h"
 #include "EL/EvaluationContext.h"
 #include "Ensure.h"
@@ -110,6 +111,11 @@ std::unique_ptr<ExpressionImpl> LiteralExpression::optimize() const
   return std::make_unique<LiteralExpression>(m_value);
 }
 
+void LiteralExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.pushConstant(m_value);
+}
+
 bool LiteralExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -140,6 +146,11 @@ std::unique_ptr<ExpressionImpl> VariableExpression::optimize() const
   return std::make_unique<VariableExpression>(m_variableName);
 }
 
+void VariableExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.loadVariable(m_variableName);
+}
+
 bool VariableExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -212,6 +223,15 @@ std::unique_ptr<ExpressionImpl> ArrayExpression::optimize() const
   return std::make_unique<LiteralExpression>(Value{std::move(values)});
 }
 
+void ArrayExpression::compile(ExpressionCompiler& compiler) const
+{
+  for (const auto& element : m_elements)
+  {
+    element.compile(compiler);
+  }
+  compiler.makeArray(m_elements.size());
+}
+
 bool ArrayExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -280,6 +300,19 @@ std::unique_ptr<ExpressionImpl> MapExpression::optimize() const
   return std::make_unique<LiteralExpression>(Value{std::move(values)});
 }
 
+void MapExpression::compile(ExpressionCompiler& compiler) const
+{
+  auto keys = std::vector<std::string>{};
+  keys.reserve(m_elements.size());
+
+  for (const auto& [key, expression] : m_elements)
+  {
+    expression.compile(compiler);
+    keys.push_back(key);
+  }
+  compiler.makeMap(keys);
+}
+
 bool MapExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -402,7 +435,7 @@ static Value evaluateBitwiseNegation(const Value& v)
     + v.typeName()};
 }
 
-static Value evaluateUnaryExpression(const UnaryOperator& operator_, const Value& operand)
+Value evaluateUnaryOperator(const UnaryOperator operator_, const Value& operand)
 {
   if (operand == Value::Undefined)
   {
@@ -427,13 +460,13 @@ static Value evaluateUnaryExpression(const UnaryOperator& operator_, const Value
 
 Value UnaryExpression::evaluate(const EvaluationContext& context) const
 {
-  return evaluateUnaryExpression(m_operator, m_operand.evaluate(context));
+  return evaluateUnaryOperator(m_operator, m_operand.evaluate(context));
 }
 
 std::unique_ptr<ExpressionImpl> UnaryExpression::optimize() const
 {
   auto optimizedOperand = m_operand.optimize();
-  if (auto value = evaluateUnaryExpression(
+  if (auto value = evaluateUnaryOperator(
         m_operator, optimizedOperand.evaluate(EvaluationContext{}));
       value != Value::Undefined)
   {
@@ -443,6 +476,12 @@ std::unique_ptr<ExpressionImpl> UnaryExpression::optimize() const
   return std::make_unique<UnaryExpression>(m_operator, std::move(optimizedOperand));
 }
 
+void UnaryExpression::compile(ExpressionCompiler& compiler) const
+{
+  m_operand.compile(compiler);
+  compiler.applyUnaryOperator(m_operator);
+}
+
 bool UnaryExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -643,90 +682,78 @@ static Value evaluateModulus(const Value& lhs, const Value& rhs)
     + " and '" + rhs.describe() + "' of type '" + typeName(rhs.type()) + "'"};
 }
 
-template <typename EvaluateLhs, typename EvaluateRhs>
-static Value evaluateLogicalAnd(
-  const EvaluateLhs& evaluateLhs, const EvaluateRhs& evaluateRhs)
+static std::optional<Value> shortCircuitLogicalAnd(const Value& lhs)
 {
-  const auto lhs = evaluateLhs();
-  auto rhs = std::make_optional<Value>();
-
   if (lhs.hasType(ValueType::Undefined))
   {
     return Value::Undefined;
   }
 
-  if (lhs.hasType(ValueType::Boolean, ValueType::Null))
+  if (
+    lhs.hasType(ValueType::Boolean, ValueType::Null)
+    && !lhs.convertTo(ValueType::Boolean).booleanValue())
   {
-    const auto lhsValue = lhs.convertTo(ValueType::Boolean).booleanValue();
-    if (!lhsValue)
-    {
-      return Value{false};
-    }
-
-    rhs = evaluateRhs();
-    if (rhs->hasType(ValueType::Boolean, ValueType::Null))
-    {
-      return Value{rhs->convertTo(ValueType::Boolean).booleanValue()};
-    }
+    return Value{false};
   }
 
-  if (!rhs)
+  return std::nullopt;
+}
+
+static Value evaluateLogicalAnd(const Value& lhs, const Value& rhs)
+{
+  if (
+    lhs.hasType(ValueType::Boolean, ValueType::Null)
+    && rhs.hasType(ValueType::Boolean, ValueType::Null))
   {
-    rhs = evaluateRhs();
+    return Value{rhs.convertTo(ValueType::Boolean).booleanValue()};
   }
 
-  if (rhs->hasType(ValueType::Undefined))
+  if (rhs.hasType(ValueType::Undefined))
   {
     return Value::Undefined;
   }
 
   throw EvaluationError{
     "Cannot apply operator && to '" + lhs.describe() + "' of type '"
-    + typeName(lhs.type()) + " and '" + rhs->describe() + "' of type '"
-    + typeName(rhs->type()) + "'"};
+    + typeName(lhs.type()) + " and '" + rhs.describe() + "' of type '"
+    + typeName(rhs.type()) + "'"};
 }
 
-template <typename EvaluateLhs, typename EvaluateRhs>
-static Value evaluateLogicalOr(
-  const EvaluateLhs& evaluateLhs, const EvaluateRhs& evaluateRhs)
+static std::optional<Value> shortCircuitLogicalOr(const Value& lhs)
 {
-  const auto lhs = evaluateLhs();
-  auto rhs = std::make_optional<Value>();
-
   if (lhs.hasType(ValueType::Undefined))
   {
     return Value::Undefined;
   }
 
-  if (lhs.hasType(ValueType::Boolean, ValueType::Null))
+  if (
+    lhs.hasType(ValueType::Boolean, ValueType::Null)
+    && lhs.convertTo(ValueType::Boolean).booleanValue())
   {
-    const auto lhsValue = lhs.convertTo(ValueType::Boolean).booleanValue();
-    if (lhsValue)
-    {
-      return Value{true};
-    }
-
-    rhs = evaluateRhs();
-    if (rhs->hasType(ValueType::Boolean, ValueType::Null))
-    {
-      return Value{rhs->convertTo(ValueType::Boolean).booleanValue()};
-    }
+    return Value{true};
   }
 
-  if (!rhs)
+  return std::nullopt;
+}
+
+static Value evaluateLogicalOr(const Value& lhs, const Value& rhs)
+{
+  if (
+    lhs.hasType(ValueType::Boolean, ValueType::Null)
+    && rhs.hasType(ValueType::Boolean, ValueType::Null))
   {
-    rhs = evaluateRhs();
+    return Value{rhs.convertTo(ValueType::Boolean).booleanValue()};
   }
 
-  if (rhs->hasType(ValueType::Undefined))
+  if (rhs.hasType(ValueType::Undefined))
   {
     return Value::Undefined;
   }
 
   throw EvaluationError{
     "Cannot apply operator || to '" + lhs.describe() + "' of type '"
-    + typeName(lhs.type()) + " and '" + rhs->describe() + "' of type '"
-    + typeName(rhs->type()) + "'"};
+    + typeName(lhs.type()) + " and '" + rhs.describe() + "' of type '"
+    + typeName(rhs.type()) + "'"};
 }
 
 template <typename Eval>
@@ -1042,73 +1069,115 @@ static Value evaluateRange(const Value& lhs, const Value& rhs)
   return Value{range};
 }
 
-template <typename EvaluateLhs, typename EvaluateRhs>
-static Value evaluateCase(const EvaluateLhs& evaluateLhs, const EvaluateRhs& evaluateRhs)
+static std::optional<Value> shortCircuitCase(const Value& lhs)
 {
-  const auto lhs = evaluateLhs();
-
   if (
-    lhs.type() != ValueType::Undefined
-    && lhs.convertTo(ValueType::Boolean).booleanValue())
+    lhs.type() == ValueType::Undefined
+    || !lhs.convertTo(ValueType::Boolean).booleanValue())
   {
-    return evaluateRhs();
+    return Value::Undefined;
   }
 
-  return Value::Undefined;
+  return std::nullopt;
 }
 
-template <typename EvalualateLhs, typename EvaluateRhs>
-static Value evaluateBinaryExpression(
-  const BinaryOperator operator_,
-  const EvalualateLhs& evaluateLhs,
-  const EvaluateRhs& evaluateRhs)
+std::optional<Value> evaluateShortCircuit(
+  const BinaryOperator operator_, const Value& lhs)
 {
   switch (operator_)
   {
+  case BinaryOperator::LogicalAnd:
+    return shortCircuitLogicalAnd(lhs);
+  case BinaryOperator::LogicalOr:
+    return shortCircuitLogicalOr(lhs);
+  case BinaryOperator::Case:
+    return shortCircuitCase(lhs);
   case BinaryOperator::Addition:
-    return evaluateAddition(evaluateLhs(), evaluateRhs());
   case BinaryOperator::Subtraction:
-    return evaluateSubtraction(evaluateLhs(), evaluateRhs());
   case BinaryOperator::Multiplication:
-    return evaluateMultiplication(evaluateLhs(), evaluateRhs());
   case BinaryOperator::Division:
-    return evaluateDivision(evaluateLhs(), evaluateRhs());
   case BinaryOperator::Modulus:
-    return evaluateModulus(evaluateLhs(), evaluateRhs());
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+    return std::nullopt;
+    switchDefault();
+  };
+}
+
+Value evaluateBinaryOperator(
+  const BinaryOperator operator_, const Value& lhs, const Value& rhs)
+{
+  switch (operator_)
+  {
+  case BinaryOperator::Addition:
+    return evaluateAddition(lhs, rhs);
+  case BinaryOperator::Subtraction:
+    return evaluateSubtraction(lhs, rhs);
+  case BinaryOperator::Multiplication:
+    return evaluateMultiplication(lhs, rhs);
+  case BinaryOperator::Division:
+    return evaluateDivision(lhs, rhs);
+  case BinaryOperator::Modulus:
+    return evaluateModulus(lhs, rhs);
   case BinaryOperator::LogicalAnd:
-    return evaluateLogicalAnd(evaluateLhs, evaluateRhs);
+    return evaluateLogicalAnd(lhs, rhs);
   case BinaryOperator::LogicalOr:
-    return evaluateLogicalOr(evaluateLhs, evaluateRhs);
+    return evaluateLogicalOr(lhs, rhs);
   case BinaryOperator::BitwiseAnd:
-    return evaluateBitwiseAnd(evaluateLhs(), evaluateRhs());
+    return evaluateBitwiseAnd(lhs, rhs);
   case BinaryOperator::BitwiseXOr:
-    return evaluateBitwiseXOr(evaluateLhs(), evaluateRhs());
+    return evaluateBitwiseXOr(lhs, rhs);
   case BinaryOperator::BitwiseOr:
-    return evaluateBitwiseOr(evaluateLhs(), evaluateRhs());
+    return evaluateBitwiseOr(lhs, rhs);
   case BinaryOperator::BitwiseShiftLeft:
-    return evaluateBitwiseShiftLeft(evaluateLhs(), evaluateRhs());
+    return evaluateBitwiseShiftLeft(lhs, rhs);
   case BinaryOperator::BitwiseShiftRight:
-    return evaluateBitwiseShiftRight(evaluateLhs(), evaluateRhs());
+    return evaluateBitwiseShiftRight(lhs, rhs);
   case BinaryOperator::Less:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) < 0};
+    return Value{evaluateCompare(lhs, rhs) < 0};
   case BinaryOperator::LessOrEqual:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) <= 0};
+    return Value{evaluateCompare(lhs, rhs) <= 0};
   case BinaryOperator::Greater:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) > 0};
+    return Value{evaluateCompare(lhs, rhs) > 0};
   case BinaryOperator::GreaterOrEqual:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) >= 0};
+    return Value{evaluateCompare(lhs, rhs) >= 0};
   case BinaryOperator::Equal:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) == 0};
+    return Value{evaluateCompare(lhs, rhs) == 0};
   case BinaryOperator::NotEqual:
-    return Value{evaluateCompare(evaluateLhs(), evaluateRhs()) != 0};
+    return Value{evaluateCompare(lhs, rhs) != 0};
   case BinaryOperator::Range:
-    return Value{evaluateRange(evaluateLhs(), evaluateRhs())};
+    return evaluateRange(lhs, rhs);
   case BinaryOperator::Case:
-    return evaluateCase(evaluateLhs, evaluateRhs);
+    return rhs;
     switchDefault();
   };
 }
 
+template <typename EvalualateLhs, typename EvaluateRhs>
+static Value evaluateBinaryExpression(
+  const BinaryOperator operator_,
+  const EvalualateLhs& evaluateLhs,
+  const EvaluateRhs& evaluateRhs)
+{
+  const auto lhs = evaluateLhs();
+  if (auto result = evaluateShortCircuit(operator_, lhs))
+  {
+    return std::move(*result);
+  }
+
+  return evaluateBinaryOperator(operator_, lhs, evaluateRhs());
+}
+
 Value BinaryExpression::evaluate(const EvaluationContext& context) const
 {
   return evaluateBinaryExpression(
@@ -1147,6 +1216,19 @@ std::unique_ptr<ExpressionImpl> BinaryExpression::optimize() const
     std::move(optimizedRightOperand).value_or(m_rightOperand.optimize()));
 }
 
+void BinaryExpression::compile(ExpressionCompiler& compiler) const
+{
+  m_leftOperand.compile(compiler);
+  const auto shortCircuit = compiler.shortCircuit(m_operator);
+  m_rightOperand.compile(compiler);
+  compiler.applyBinaryOperator(m_operator);
+
+  if (shortCircuit)
+  {
+    compiler.bindJump(*shortCircuit);
+  }
+}
+
 size_t BinaryExpression::precedence() const
 {
   switch (m_operator)
@@ -1315,6 +1397,14 @@ std::unique_ptr<ExpressionImpl> SubscriptExpression::optimize() const
     std::move(optimizedLeftOperand), std::move(optimizedRightOperand));
 }
 
+void SubscriptExpression::compile(ExpressionCompiler& compiler) const
+{
+  m_leftOperand.compile(compiler);
+  compiler.beginSubscript();
+  m_rightOperand.compile(compiler);
+  compiler.endSubscript();
+}
+
 bool SubscriptExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -1365,6 +1455,24 @@ std::unique_ptr<ExpressionImpl> SwitchExpression::optimize() const
   return std::make_unique<SwitchExpression>(std::move(optimizedExpressions));
 }
 
+void SwitchExpression::compile(ExpressionCompiler& compiler) const
+{
+  auto jumps = std::vector<size_t>{};
+  jumps.reserve(m_cases.size());
+
+  for (const auto& case_ : m_cases)
+  {
+    case_.compile(compiler);
+    jumps.push_back(compiler.jumpIfDefined());
+  }
+  compiler.pushConstant(Value::Undefined);
+
+  for (const auto jump : jumps)
+  {
+    compiler.bindJump(jump);
+  }
+}
+
 bool SwitchExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -25,6 +25,7 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,7 @@ public:
 
   virtual Value evaluate(const EvaluationContext& context) const = 0;
   virtual std::unique_ptr<ExpressionImpl> optimize() const = 0;
+  virtual void compile(ExpressionCompiler& compiler) const = 0;
 
   virtual size_t precedence() const;
 
@@ -70,6 +72,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const LiteralExpression& rhs) const override;
@@ -88,6 +91,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const VariableExpression& rhs) const override;
@@ -106,6 +110,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const ArrayExpression& rhs) const override;
@@ -124,6 +129,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const MapExpression& rhs) const override;
@@ -141,6 +147,11 @@ enum class UnaryOperator
   Group
 };
 
+/**
+ * Applies the given unary operator to the given operand.
+ */
+Value evaluateUnaryOperator(UnaryOperator operator_, const Value& operand);
+
 class UnaryExpression : public ExpressionImpl
 {
 private:
@@ -152,6 +163,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const UnaryExpression& rhs) const override;
@@ -184,6 +196,20 @@ enum class BinaryOperator
   Case,
 };
 
+/**
+ * Returns the result of the given binary operator if it is already determined by the left
+ * operand, in which case the right operand must not be evaluated. Returns std::nullopt
+ * for all operators except logical and, logical or and case.
+ */
+std::optional<Value> evaluateShortCircuit(BinaryOperator operator_, const Value& lhs);
+
+/**
+ * Applies the given binary operator to the given operands. For the short circuiting
+ * operators, this must only be called if evaluateShortCircuit returned std::nullopt.
+ */
+Value evaluateBinaryOperator(
+  BinaryOperator operator_, const Value& lhs, const Value& rhs);
+
 class BinaryExpression : public ExpressionImpl
 {
 public:
@@ -204,6 +230,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   size_t precedence() const override;
 
@@ -228,6 +255,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const SubscriptExpression& rhs) const override;
@@ -246,6 +274,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const SwitchExpression& rhs) const override;
@@ -49,12 +49,12 @@ const Value Value::Null = Value{NullType::Value};
 const Value Value::Undefined = Value{UndefinedType::Value};
 
 Value::Value()
-  : m_value{std::make_shared<VariantType>(NullType::Value)}
+  : m_value{NullType::Value}
 {
 }
 
 Value::Value(const BooleanType value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
   , m_expression{std::move(expression)}
 {
 }
@@ -72,25 +72,25 @@ Value::Value(const char* value, std::optional<Expression> expression)
 }
 
 Value::Value(const NumberType value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
   , m_expression{std::move(expression)}
 {
 }
 
 Value::Value(const int value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
   , m_expression{std::move(expression)}
 {
 }
 
 Value::Value(const long value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
   , m_expression{std::move(expression)}
 {
 }
 
 Value::Value(const size_t value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
   , m_expression{std::move(expression)}
 {
 }
@@ -114,13 +114,13 @@ Value::Value(RangeType value, std::optional<Expression> expression)
 }
 
 Value::Value(NullType value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
   , m_expression{std::move(expression)}
 {
 }
 
 Value::Value(UndefinedType value, std::optional<Expression> expression)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
   , m_expression{std::move(expression)}
 {
 }
@@ -133,7 +133,7 @@ Value::Value(Value value, std::optional<Expression> expression)
 
 ValueType Value::type() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [](const BooleanType&) { return ValueType::Boolean; },
       [](const StringType&) { return ValueType::String; },
@@ -142,8 +142,7 @@ ValueType Value::type() const
       [](const MapType&) { return ValueType::Map; },
       [](const RangeType&) { return ValueType::Range; },
       [](const NullType&) { return ValueType::Null; },
-      [](const UndefinedType&) { return ValueType::Undefined; }),
-    *m_value);
+      [](const UndefinedType&) { return ValueType::Undefined; }));
 }
 
 bool Value::hasType(ValueType type) const
@@ -178,7 +177,7 @@ size_t Value::column() const
 
 const BooleanType& Value::booleanValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType& b) -> const BooleanType& { return b; },
       [&](const StringType&) -> const BooleanType& {
@@ -202,13 +201,12 @@ const BooleanType& Value::booleanValue() const
       },
       [&](const UndefinedType&) -> const BooleanType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 const StringType& Value::stringValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) -> const StringType& {
         throw DereferenceError{describe(), type(), ValueType::Boolean};
@@ -232,13 +230,12 @@ const StringType& Value::stringValue() const
       },
       [&](const UndefinedType&) -> const StringType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 const NumberType& Value::numberValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) -> const NumberType& {
         throw DereferenceError{describe(), type(), ValueType::Boolean};
@@ -262,8 +259,7 @@ const NumberType& Value::numberValue() const
       },
       [&](const UndefinedType&) -> const NumberType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 IntegerType Value::integerValue() const
@@ -273,7 +269,7 @@ IntegerType Value::integerValue() const
 
 const ArrayType& Value::arrayValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) -> const ArrayType& {
         throw DereferenceError{describe(), type(), ValueType::Boolean};
@@ -297,13 +293,12 @@ const ArrayType& Value::arrayValue() const
       },
       [&](const UndefinedType&) -> const ArrayType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 const MapType& Value::mapValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) -> const MapType& {
         throw DereferenceError{describe(), type(), ValueType::Boolean};
@@ -327,13 +322,12 @@ const MapType& Value::mapValue() const
       },
       [&](const UndefinedType&) -> const MapType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 const RangeType& Value::rangeValue() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) -> const RangeType& {
         throw DereferenceError{describe(), type(), ValueType::Boolean};
@@ -356,8 +350,7 @@ const RangeType& Value::rangeValue() const
       },
       [&](const UndefinedType&) -> const RangeType& {
         throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+      }));
 }
 
 const std::vector<std::string> Value::asStringList() const
@@ -389,7 +382,7 @@ const std::vector<std::string> Value::asStringSet() const
 
 size_t Value::length() const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [](const BooleanType&) -> size_t { return 1u; },
       [](const StringType& s) -> size_t { return s.length(); },
@@ -398,13 +391,12 @@ size_t Value::length() const
       [](const MapType& m) -> size_t { return m.size(); },
       [](const RangeType& r) -> size_t { return r.size(); },
       [](const NullType&) -> size_t { return 0u; },
-      [](const UndefinedType&) -> size_t { return 0u; }),
-    *m_value);
+      [](const UndefinedType&) -> size_t { return 0u; }));
 }
 
 bool Value::convertibleTo(const ValueType toType) const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType&) {
         switch (toType)
@@ -554,13 +546,12 @@ bool Value::convertibleTo(const ValueType toType) const
         }
 
         return false;
-      }),
-    *m_value);
+      }));
 }
 
 Value Value::convertTo(const ValueType toType) const
 {
-  return std::visit(
+  return visit(
     kdl::overload(
       [&](const BooleanType& b) -> Value {
         switch (toType)
@@ -720,8 +711,7 @@ Value Value::convertTo(const ValueType toType) const
         }
 
         throw ConversionError{describe(), type(), toType};
-      }),
-    *m_value);
+      }));
 }
 
 std::optional<Value> Value::tryConvertTo(const ValueType toType) const
@@ -746,7 +736,7 @@ std::string Value::asString(const bool multiline) const
 void Value::appendToStream(
   std::ostream& str, const bool multiline, const std::string& indent) const
 {
-  std::visit(
+  visit(
     kdl::overload(
       [&](const BooleanType& b) { str << (b ? "true" : "false"); },
       [&](const StringType& s) {
@@ -873,8 +863,7 @@ void Value::appendToStream(
         str << "]";
       },
       [&](const NullType&) { str << "null"; },
-      [&](const UndefinedType&) { str << "undefined"; }),
-    *m_value);
+      [&](const UndefinedType&) { str << "undefined"; }));
 }
 
 static size_t computeIndex(const long index, const size_t indexableSize)
@@ -1282,29 +1271,30 @@ Value Value::operator[](const char* key) const
 
 bool operator==(const Value& lhs, const Value& rhs)
 {
-  return std::visit(
-    kdl::overload(
-      [](const BooleanType& lhsBool, const BooleanType& rhsBool) {
-        return lhsBool == rhsBool;
-      },
-      [](const StringType& lhsString, const StringType& rhsString) {
-        return lhsString == rhsString;
-      },
-      [](const NumberType& lhsNumber, const NumberType& rhsNumber) {
-        return lhsNumber == rhsNumber;
-      },
-      [](const ArrayType& lhsArray, const ArrayType& rhsArray) {
-        return lhsArray == rhsArray;
-      },
-      [](const MapType& lhsMap, const MapType& rhsMap) { return lhsMap == rhsMap; },
-      [](const RangeType& lhsRange, const RangeType& rhsRange) {
-        return lhsRange == rhsRange;
-      },
-      [](const NullType&, const NullType&) { return true; },
-      [](const UndefinedType&, const UndefinedType&) { return true; },
-      [](const auto&, const auto&) { return false; }),
-    *lhs.m_value,
-    *rhs.m_value);
+  const auto compare = kdl::overload(
+    [](const BooleanType& lhsBool, const BooleanType& rhsBool) {
+      return lhsBool == rhsBool;
+    },
+    [](const StringType& lhsString, const StringType& rhsString) {
+      return lhsString == rhsString;
+    },
+    [](const NumberType& lhsNumber, const NumberType& rhsNumber) {
+      return lhsNumber == rhsNumber;
+    },
+    [](const ArrayType& lhsArray, const ArrayType& rhsArray) {
+      return lhsArray == rhsArray;
+    },
+    [](const MapType& lhsMap, const MapType& rhsMap) { return lhsMap == rhsMap; },
+    [](const RangeType& lhsRange, const RangeType& rhsRange) {
+      return lhsRange == rhsRange;
+    },
+    [](const NullType&, const NullType&) { return true; },
+    [](const UndefinedType&, const UndefinedType&) { return true; },
+    [](const auto&, const auto&) { return false; });
+
+  return lhs.visit([&](const auto& lhsValue) {
+    return rhs.visit([&](const auto& rhsValue) { return compare(lhsValue, rhsValue); });
+  });
 }
 
 bool operator!=(const Value& lhs, const Value& rhs)
@@ -27,6 +27,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -64,7 +65,18 @@ private:
     RangeType,
     NullType,
     UndefinedType>;
-  std::shared_ptr<VariantType> m_value;
+
+  /**
+   * Booleans, numbers, null and undefined are stored inline so that creating and copying
+   * them doesn't allocate. All other values are shared between copies.
+   */
+  using StorageType = std::variant<
+    BooleanType,
+    NumberType,
+    NullType,
+    UndefinedType,
+    std::shared_ptr<VariantType>>;
+  StorageType m_value;
   std::optional<Expression> m_expression;
 
 public:
@@ -142,6 +154,25 @@ public:
   friend bool operator!=(const Value& lhs, const Value& rhs);
 
   friend std::ostream& operator<<(std::ostream& lhs, const Value& rhs);
+
+private:
+  template <typename Visitor>
+  decltype(auto) visit(const Visitor& visitor) const
+  {
+    return std::visit(
+      [&](const auto& value) -> decltype(auto) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::shared_ptr<VariantType>>)
+        {
+          return std::visit(visitor, *value);
+        }
+        else
+        {
+          return visitor(value);
+        }
+      },
+      m_value);
+  }
 };
 } // namespace EL
 } // namespace TrenchBroom
@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "EntityDefinitionClassInfoCache.h"
+
+#include <algorithm>
+
+namespace TrenchBroom::IO
+{
+
+std::optional<EntityDefinitionClassInfoCache::Dependency> EntityDefinitionClassInfoCache::
+  makeDependency(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  const auto modificationTime = std::filesystem::last_write_time(path, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+  return Dependency{path.lexically_normal(), modificationTime};
+}
+
+EntityDefinitionClassInfoCache::EntityDefinitionClassInfoCache() = default;
+
+EntityDefinitionClassInfoCache::~EntityDefinitionClassInfoCache() = default;
+
+std::optional<EntityDefinitionClassInfoCache::Entry> EntityDefinitionClassInfoCache::get(
+  const std::filesystem::path& path) const
+{
+  const auto lock = std::lock_guard{m_mutex};
+
+  const auto it = m_entries.find(path.lexically_normal());
+  if (it == m_entries.end())
+  {
+    return std::nullopt;
+  }
+
+  const auto& entry = it->second;
+  const auto isUnchanged = [](const auto& dependency) {
+    const auto currentDependency = makeDependency(dependency.path);
+    return currentDependency
+           && currentDependency->modificationTime == dependency.modificationTime;
+  };
+
+  if (!std::all_of(entry.dependencies.begin(), entry.dependencies.end(), isUnchanged))
+  {
+    return std::nullopt;
+  }
+
+  return entry;
+}
+
+void EntityDefinitionClassInfoCache::put(
+  const std::filesystem::path& path,
+  std::vector<EntityDefinitionClassInfo> classInfos,
+  std::vector<Dependency> dependencies,
+  ParserMessages messages)
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries.insert_or_assign(
+    path.lexically_normal(),
+    Entry{std::move(classInfos), std::move(dependencies), std::move(messages)});
+}
+
+void EntityDefinitionClassInfoCache::clear()
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries.clear();
+}
+
+size_t EntityDefinitionClassInfoCache::size() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_entries.size();
+}
+
+} // namespace TrenchBroom::IO
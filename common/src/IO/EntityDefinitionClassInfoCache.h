@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/RecordingParserStatus.h"
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Caches the class infos parsed from entity definition files.
+ *
+ * Every entry records the modification times of the files it was parsed from, i.e. the
+ * file itself and any files it includes. An entry is only returned if none of these files
+ * have changed since the entry was added. The cache can be used from multiple threads.
+ */
+class EntityDefinitionClassInfoCache
+{
+public:
+  struct Dependency
+  {
+    std::filesystem::path path;
+    std::filesystem::file_time_type modificationTime;
+  };
+
+  /**
+   * Returns the current modification time of the given file, or an empty optional if it
+   * cannot be determined.
+   */
+  static std::optional<Dependency> makeDependency(const std::filesystem::path& path);
+
+  struct Entry
+  {
+    std::vector<EntityDefinitionClassInfo> classInfos;
+    std::vector<Dependency> dependencies;
+    // the messages logged while parsing, replayed when the entry is used
+    ParserMessages messages;
+  };
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<std::filesystem::path, Entry> m_entries;
+
+public:
+  EntityDefinitionClassInfoCache();
+  ~EntityDefinitionClassInfoCache();
+
+  /**
+   * Returns a copy of the entry cached for the given file if none of the files it depends
+   * on have been modified since the entry was added.
+   */
+  std::optional<Entry> get(
+    const std::filesystem::path& path) const;
+
+  /**
+   * Adds the given class infos and the messages logged while parsing them for the given
+   * file, replacing any previous entry.
+   *
+   * The given dependencies must have been created before the files were read.
+   */
+  void put(
+    const std::filesystem::path& path,
+    std::vector<EntityDefinitionClassInfo> classInfos,
+    std::vector<Dependency> dependencies,
+    ParserMessages messages);
+
+  void clear();
+  size_t size() const;
+};
+
+} // namespace TrenchBroom::IO
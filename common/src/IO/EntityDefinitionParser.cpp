@@ -24,9 +24,11 @@
 #include "Assets/PropertyDefinition.h"
 #include "IO/EntityDefinitionClassInfo.h"
 #include "IO/ParserStatus.h"
+#include "IO/RecordingParserStatus.h"
 #include "Macros.h"
 #include "Model/EntityProperties.h"
 
+#include <kdl/set_temp.h>
 #include <kdl/vector_utils.h>
 
 #include <unordered_map>
@@ -482,4 +484,57 @@ std::vector<std::unique_ptr<Assets::EntityDefinition>> EntityDefinitionParser::
   return createDefinitions(status, classInfos, m_defaultEntityColor);
 }
 
+std::vector<std::unique_ptr<Assets::EntityDefinition>> EntityDefinitionParser::
+  parseDefinitions(
+    ParserStatus& status,
+    EntityDefinitionClassInfoCache& classInfoCache,
+    const std::filesystem::path& path)
+{
+  if (
+    auto definitions =
+      findCachedDefinitions(status, classInfoCache, path, m_defaultEntityColor))
+  {
+    return std::move(*definitions);
+  }
+
+  const auto dependency = EntityDefinitionClassInfoCache::makeDependency(path);
+
+  const auto setClassInfoCache = kdl::set_temp{m_classInfoCache, &classInfoCache};
+  auto recordingStatus = RecordingParserStatus{status};
+  const auto classInfos = parseClassInfos(recordingStatus);
+
+  if (dependency)
+  {
+    classInfoCache.put(
+      path,
+      classInfos,
+      kdl::vec_concat(std::vector{*dependency}, includedFiles()),
+      recordingStatus.takeMessages());
+  }
+
+  return createDefinitions(status, classInfos, m_defaultEntityColor);
+}
+
+std::optional<std::vector<std::unique_ptr<Assets::EntityDefinition>>>
+EntityDefinitionParser::findCachedDefinitions(
+  ParserStatus& status,
+  const EntityDefinitionClassInfoCache& classInfoCache,
+  const std::filesystem::path& path,
+  const Color& defaultEntityColor)
+{
+  if (const auto cachedEntry = classInfoCache.get(path))
+  {
+    replayMessages(status, cachedEntry->messages);
+    status.debug("Using cached entity definitions for '" + path.string() + "'");
+    return createDefinitions(status, cachedEntry->classInfos, defaultEntityColor);
+  }
+  return std::nullopt;
+}
+
+std::vector<EntityDefinitionClassInfoCache::Dependency> EntityDefinitionParser::
+  includedFiles() const
+{
+  return {};
+}
+
 } // namespace TrenchBroom::IO
@@ -20,8 +20,11 @@
 #pragma once
 
 #include "Color.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,6 +49,10 @@ class EntityDefinitionParser
 private:
   Color m_defaultEntityColor;
 
+protected:
+  // only set while parseDefinitions is running with a cache
+  EntityDefinitionClassInfoCache* m_classInfoCache = nullptr;
+
 public:
   explicit EntityDefinitionParser(const Color& defaultEntityColor);
   virtual ~EntityDefinitionParser();
@@ -53,9 +60,40 @@ public:
   std::vector<std::unique_ptr<Assets::EntityDefinition>> parseDefinitions(
     ParserStatus& status);
 
+  /**
+   * Parses the definitions like the overload above, but reuses the class infos cached
+   * for the given file if neither it nor any of the files it includes have changed.
+   * Otherwise, the parsed class infos are added to the given cache.
+   *
+   * The given path must be the absolute path of the file that is being parsed.
+   */
+  std::vector<std::unique_ptr<Assets::EntityDefinition>> parseDefinitions(
+    ParserStatus& status,
+    EntityDefinitionClassInfoCache& classInfoCache,
+    const std::filesystem::path& path);
+
+  /**
+   * Creates the definitions from the class infos cached for the given file, if there are
+   * any and the files they were parsed from are unchanged. The messages logged when the
+   * class infos were parsed are logged again.
+   *
+   * This allows callers to check the cache before reading the file.
+   */
+  static std::optional<std::vector<std::unique_ptr<Assets::EntityDefinition>>>
+  findCachedDefinitions(
+    ParserStatus& status,
+    const EntityDefinitionClassInfoCache& classInfoCache,
+    const std::filesystem::path& path,
+    const Color& defaultEntityColor);
+
 private:
   virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(
     ParserStatus& status) = 0;
+
+  /**
+   * Returns the files that were included by the most recent call to parseClassInfos.
+   */
+  virtual std::vector<EntityDefinitionClassInfoCache::Dependency> includedFiles() const;
 };
 
 } // namespace TrenchBroom::IO
@@ -29,8 +29,11 @@
 #include "IO/File.h"
 #include "IO/LegacyModelDefinitionParser.h"
 #include "IO/ParserStatus.h"
+#include "IO/RecordingParserStatus.h"
+#include "Logger.h"
 
 #include "kdl/invoke.h"
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
@@ -211,29 +214,179 @@ public:
 void FgdParser::pushIncludePath(std::filesystem::path path)
 {
   assert(!isRecursiveInclude(path));
-  m_paths.push_back(std::move(path));
+  assert(m_fs);
+
+  auto includedFile = IncludedFile{};
+  if (
+    const auto dependency = m_fs->makeAbsolute(path)
+                              .transform([](const auto& absPath) {
+                                return EntityDefinitionClassInfoCache::makeDependency(
+                                  absPath);
+                              })
+                              .value_or(std::nullopt))
+  {
+    includedFile.dependencies.push_back(*dependency);
+  }
+  else
+  {
+    includedFile.cacheable = false;
+  }
+  includedFile.path = std::move(path);
+
+  m_includeStack.push_back(std::move(includedFile));
 }
 
 void FgdParser::popIncludePath()
 {
-  assert(!m_paths.empty());
-  m_paths.pop_back();
+  assert(!m_includeStack.empty());
+  auto includedFile = std::move(m_includeStack.back());
+  m_includeStack.pop_back();
+
+  if (!m_includeStack.empty())
+  {
+    addDependencies(includedFile.dependencies);
+  }
 }
 
 std::filesystem::path FgdParser::currentRoot() const
 {
-  assert(m_paths.empty() || !m_paths.back().empty());
-  return !m_paths.empty() ? m_paths.back().parent_path() : std::filesystem::path{};
+  assert(m_includeStack.empty() || !m_includeStack.back().path.empty());
+  return !m_includeStack.empty() ? m_includeStack.back().path.parent_path()
+                                 : std::filesystem::path{};
 }
 
 bool FgdParser::isRecursiveInclude(const std::filesystem::path& path) const
 {
-  return std::any_of(m_paths.begin(), m_paths.end(), [&](const auto& includedPath) {
-    return includedPath == path;
+  return std::any_of(
+    m_includeStack.begin(), m_includeStack.end(), [&](const auto& includedFile) {
+      return includedFile.path == path;
+    });
+}
+
+void FgdParser::addDependencies(
+  const std::vector<EntityDefinitionClassInfoCache::Dependency>& dependencies)
+{
+  assert(!m_includeStack.empty());
+  auto& currentFile = m_includeStack.back();
+  currentFile.dependencies =
+    kdl::vec_concat(std::move(currentFile.dependencies), dependencies);
+}
+
+namespace
+{
+
+/**
+ * Finds the paths of all files included by the given FGD source without parsing it.
+ * Include directives in comments are found too, but parsing them ahead of time is
+ * harmless because their results are only used if the parser reaches them.
+ */
+std::vector<std::filesystem::path> findIncludePaths(const std::string_view str)
+{
+  static const auto directive = std::string_view{"@include"};
+
+  auto result = std::vector<std::filesystem::path>{};
+  for (auto pos = str.find('@'); pos != std::string_view::npos;
+       pos = str.find('@', pos + 1))
+  {
+    if (kdl::ci::str_is_prefix(str.substr(pos), directive))
+    {
+      const auto begin = str.find_first_not_of(" \t\r\n", pos + directive.size());
+      if (begin != std::string_view::npos && str[begin] == '"')
+      {
+        const auto end = str.find('"', begin + 1);
+        if (end != std::string_view::npos)
+        {
+          result.emplace_back(str.substr(begin + 1, end - begin - 1));
+          pos = end;
+        }
+      }
+    }
+  }
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
+} // namespace
+
+/**
+ * Parses the files included by the given source in parallel. The included files do not
+ * depend on each other, so they can be parsed independently. Their results are picked up
+ * in order when the parser reaches the corresponding include directives.
+ */
+void FgdParser::prefetchIncludes(const std::string_view str)
+{
+  if (!m_fs)
+  {
+    return;
+  }
+
+  const auto rootPath = m_fs->makeAbsolute(m_includeStack.front().path);
+  if (rootPath.is_error())
+  {
+    return;
+  }
+
+  const auto filePaths = kdl::vec_filter(
+    kdl::vec_transform(
+      findIncludePaths(str), [&](const auto& path) { return currentRoot() / path; }),
+    [&](const auto& filePath) { return !isRecursiveInclude(filePath); });
+
+  auto prefetchedIncludes = std::vector<PrefetchedInclude>(filePaths.size());
+  kdl::parallel_for(filePaths.size(), [&](const size_t i) {
+    const auto& filePath = filePaths[i];
+    auto& prefetchedInclude = prefetchedIncludes[i];
+    auto status = RecordingParserStatus{};
+
+    // the default color is only used when creating definitions
+    auto parser = FgdParser{std::string_view{}, Color{}, rootPath.value()};
+    parser.m_classInfoCache = m_classInfoCache;
+
+    try
+    {
+      prefetchedInclude.classInfos = parser.findCachedInclude(status, filePath);
+      if (!prefetchedInclude.classInfos)
+      {
+        // if the file cannot be opened, the host parser will report the error
+        if (auto file = parser.m_fs->openFile(filePath); file.is_success())
+        {
+          prefetchedInclude.classInfos =
+            parser.parseIncludedFile(status, filePath, *file.value());
+        }
+      }
+      prefetchedInclude.dependencies =
+        std::move(parser.m_includeStack.front().dependencies);
+    }
+    catch (...)
+    {
+      prefetchedInclude.exception = std::current_exception();
+    }
+
+    prefetchedInclude.messages = status.takeMessages();
   });
+
+  for (size_t i = 0; i < filePaths.size(); ++i)
+  {
+    m_prefetchedIncludes.emplace(filePaths[i], std::move(prefetchedIncludes[i]));
+  }
 }
 
 std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfos(ParserStatus& status)
+{
+  prefetchIncludes(m_tokenizer.remainder());
+  const auto clearPrefetchedIncludes =
+    kdl::invoke_later{[&]() { m_prefetchedIncludes.clear(); }};
+
+  return parseClassInfosOfCurrentFile(status);
+}
+
+std::vector<EntityDefinitionClassInfoCache::Dependency> FgdParser::includedFiles() const
+{
+  return !m_includeStack.empty()
+           ? m_includeStack.front().dependencies
+           : std::vector<EntityDefinitionClassInfoCache::Dependency>{};
+}
+
+std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfosOfCurrentFile(
+  ParserStatus& status)
 {
   auto classInfos = std::vector<EntityDefinitionClassInfo>{};
   auto token = m_tokenizer.peekToken();
@@ -1076,37 +1229,47 @@ std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
     return {};
   }
 
-  const auto restoreSnapshot =
-    kdl::invoke_later{[&, snapshot = m_tokenizer.snapshotStateAndSource()]() {
-      m_tokenizer.restoreStateAndSource(snapshot);
-    }};
-
   status.debug(
     m_tokenizer.line(), fmt::format("Parsing included file '{}'", path.string()));
 
   const auto filePath = currentRoot() / path;
-  return m_fs->openFile(filePath)
-    .transform([&](auto file) {
-      status.debug(
-        m_tokenizer.line(),
-        fmt::format("Resolved '{}' to '{}'", path.string(), filePath.string()));
+  status.debug(
+    m_tokenizer.line(),
+    fmt::format("Resolved '{}' to '{}'", path.string(), filePath.string()));
+
+  if (const auto it = std::find_if(
+        m_includeStack.begin(),
+        m_includeStack.end(),
+        [&](const auto& includedFile) { return includedFile.path == filePath; });
+      it != m_includeStack.end())
+  {
+    status.error(
+      m_tokenizer.line(),
+      fmt::format(
+        "Skipping recursively included file: {} ({})",
+        path.string(),
+        filePath.string()));
+
+    // the files included after the skipped file depend on the include chain
+    std::for_each(std::next(it), m_includeStack.end(), [](auto& includedFile) {
+      includedFile.cacheable = false;
+    });
+    return std::vector<EntityDefinitionClassInfo>{};
+  }
 
-      if (isRecursiveInclude(filePath))
-      {
-        status.error(
-          m_tokenizer.line(),
-          fmt::format(
-            "Skipping recursively included file: {} ({})",
-            path.string(),
-            filePath.string()));
-        return std::vector<EntityDefinitionClassInfo>{};
-      }
+  // check for results before reading the file
+  if (auto classInfos = findPrefetchedInclude(status, filePath))
+  {
+    return std::move(*classInfos);
+  }
 
-      const auto pushIncludePath = PushIncludePath{*this, filePath};
-      auto reader = file->reader().buffer();
-      m_tokenizer.replaceState(reader.stringView());
-      return parseClassInfos(status);
-    })
+  if (auto classInfos = findCachedInclude(status, filePath))
+  {
+    return std::move(*classInfos);
+  }
+
+  return m_fs->openFile(filePath)
+    .transform([&](auto file) { return parseIncludedFile(status, filePath, *file); })
     .transform_error([&](auto e) {
       status.error(
         m_tokenizer.line(), fmt::format("Failed to parse included file: {}", e.msg));
@@ -1115,4 +1278,85 @@ std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
     .value();
 }
 
+std::vector<EntityDefinitionClassInfo> FgdParser::parseIncludedFile(
+  ParserStatus& status, const std::filesystem::path& filePath, File& file)
+{
+  const auto restoreSnapshot =
+    kdl::invoke_later{[&, snapshot = m_tokenizer.snapshotStateAndSource()]() {
+      m_tokenizer.restoreStateAndSource(snapshot);
+    }};
+
+  const auto pushIncludePath = PushIncludePath{*this, filePath};
+  auto reader = file.reader().buffer();
+  m_tokenizer.replaceState(reader.stringView());
+
+  auto recordingStatus = RecordingParserStatus{status};
+  auto classInfos = parseClassInfosOfCurrentFile(recordingStatus);
+
+  const auto& includedFile = m_includeStack.back();
+  if (m_classInfoCache && includedFile.cacheable)
+  {
+    if (const auto absPath = m_fs->makeAbsolute(filePath); absPath.is_success())
+    {
+      m_classInfoCache->put(
+        absPath.value(),
+        classInfos,
+        includedFile.dependencies,
+        recordingStatus.takeMessages());
+    }
+  }
+
+  return classInfos;
+}
+
+std::optional<std::vector<EntityDefinitionClassInfo>> FgdParser::findPrefetchedInclude(
+  ParserStatus& status, const std::filesystem::path& filePath)
+{
+  const auto it = m_includeStack.size() == 1u ? m_prefetchedIncludes.find(filePath)
+                                               : m_prefetchedIncludes.end();
+  if (
+    it == m_prefetchedIncludes.end()
+    || (!it->second.classInfos && !it->second.exception))
+  {
+    return std::nullopt;
+  }
+
+  const auto& prefetchedInclude = it->second;
+  replayMessages(status, prefetchedInclude.messages);
+
+  if (prefetchedInclude.exception)
+  {
+    std::rethrow_exception(prefetchedInclude.exception);
+  }
+
+  addDependencies(prefetchedInclude.dependencies);
+  return prefetchedInclude.classInfos;
+}
+
+std::optional<std::vector<EntityDefinitionClassInfo>> FgdParser::findCachedInclude(
+  ParserStatus& status, const std::filesystem::path& filePath)
+{
+  if (!m_classInfoCache)
+  {
+    return std::nullopt;
+  }
+
+  return m_fs->makeAbsolute(filePath)
+    .transform([&](const auto& absPath) {
+      auto entry = m_classInfoCache->get(absPath);
+      if (!entry)
+      {
+        return std::optional<std::vector<EntityDefinitionClassInfo>>{};
+      }
+
+      replayMessages(status, entry->messages);
+      status.debug(
+        m_tokenizer.line(),
+        fmt::format("Using cached class infos for '{}'", filePath.string()));
+      addDependencies(entry->dependencies);
+      return std::optional{std::move(entry->classInfos)};
+    })
+    .value_or(std::nullopt);
+}
+
 } // namespace TrenchBroom::IO
@@ -21,11 +21,14 @@
 
 #include "Color.h"
 #include "FloatType.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 #include "IO/EntityDefinitionParser.h"
 #include "IO/Parser.h"
 #include "IO/Tokenizer.h"
 
+#include <exception>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -42,6 +45,7 @@ namespace TrenchBroom::IO
 
 struct EntityDefinitionClassInfo;
 enum class EntityDefinitionClassType;
+class File;
 class FileSystem;
 class ParserStatus;
 
@@ -78,8 +82,25 @@ class FgdParser : public EntityDefinitionParser, public Parser<FgdToken::Type>
 private:
   using Token = FgdTokenizer::Token;
 
-  std::vector<std::filesystem::path> m_paths;
+  struct IncludedFile
+  {
+    std::filesystem::path path;
+    std::vector<EntityDefinitionClassInfoCache::Dependency> dependencies;
+    bool cacheable = true;
+  };
+
+  struct PrefetchedInclude
+  {
+    // empty if the file could not be opened
+    std::optional<std::vector<EntityDefinitionClassInfo>> classInfos;
+    std::vector<EntityDefinitionClassInfoCache::Dependency> dependencies;
+    ParserMessages messages;
+    std::exception_ptr exception;
+  };
+
+  std::vector<IncludedFile> m_includeStack;
   std::unique_ptr<FileSystem> m_fs;
+  std::map<std::filesystem::path, PrefetchedInclude> m_prefetchedIncludes;
 
   FgdTokenizer m_tokenizer;
 
@@ -99,12 +120,19 @@ private:
 
   std::filesystem::path currentRoot() const;
   bool isRecursiveInclude(const std::filesystem::path& path) const;
+  void addDependencies(
+    const std::vector<EntityDefinitionClassInfoCache::Dependency>& dependencies);
+
+  void prefetchIncludes(std::string_view str);
 
 private:
   TokenNameMap tokenNames() const override;
 
   std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+  std::vector<EntityDefinitionClassInfoCache::Dependency> includedFiles() const override;
 
+  std::vector<EntityDefinitionClassInfo> parseClassInfosOfCurrentFile(
+    ParserStatus& status);
   void parseClassInfoOrInclude(
     ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos);
 
@@ -162,6 +190,12 @@ private:
   std::vector<EntityDefinitionClassInfo> parseInclude(ParserStatus& status);
   std::vector<EntityDefinitionClassInfo> handleInclude(
     ParserStatus& status, const std::filesystem::path& path);
+  std::vector<EntityDefinitionClassInfo> parseIncludedFile(
+    ParserStatus& status, const std::filesystem::path& filePath, File& file);
+  std::optional<std::vector<EntityDefinitionClassInfo>> findPrefetchedInclude(
+    ParserStatus& status, const std::filesystem::path& filePath);
+  std::optional<std::vector<EntityDefinitionClassInfo>> findCachedInclude(
+    ParserStatus& status, const std::filesystem::path& filePath);
 };
 
 } // namespace TrenchBroom::IO
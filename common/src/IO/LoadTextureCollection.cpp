@@ -22,6 +22,7 @@
 #include "Assets/Palette.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "Assets/TextureThumbnail.h"
 #include "Ensure.h"
 #include "Error.h"
 #include "IO/File.h"
@@ -35,6 +36,7 @@
 #include "IO/ReadQuake3ShaderTexture.h"
 #include "IO/ReadWalTexture.h"
 #include "IO/ResourceUtils.h"
+#include "IO/TextureThumbnailCache.h"
 #include "IO/TextureUtils.h"
 #include "IO/TraversalMode.h"
 #include "Logger.h"
@@ -49,8 +51,12 @@
 #include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -158,6 +164,62 @@ Result<ReadTextureFunc> makeReadTextureFunc(
     });
 }
 
+std::optional<std::filesystem::file_time_type> modificationTime(
+  const std::filesystem::path& absolutePath)
+{
+  auto error = std::error_code{};
+  const auto time = std::filesystem::last_write_time(absolutePath, error);
+  return !error ? std::optional{time} : std::nullopt;
+}
+
+struct CollectionVersion
+{
+  std::filesystem::path absolutePath;
+  std::filesystem::file_time_type modificationTime;
+};
+
+/**
+ * Returns the absolute path of the given collection and the latest modification time of
+ * the collection directory and its texture files. Returns an empty optional if these
+ * cannot be determined, e.g. if the collection is in an archive.
+ */
+std::optional<CollectionVersion> collectionVersion(
+  const std::filesystem::path& path,
+  const FileSystem& gameFS,
+  const std::vector<std::filesystem::path>& texturePaths)
+{
+  auto absolutePath = gameFS.makeAbsolute(path);
+  if (absolutePath.is_error())
+  {
+    return std::nullopt;
+  }
+
+  auto result = CollectionVersion{std::move(absolutePath).value(), {}};
+  const auto collectionTime = modificationTime(result.absolutePath);
+  if (!collectionTime)
+  {
+    return std::nullopt;
+  }
+  result.modificationTime = *collectionTime;
+
+  for (const auto& texturePath : texturePaths)
+  {
+    const auto textureTime =
+      gameFS.makeAbsolute(texturePath)
+        .transform([](const auto& absoluteTexturePath) {
+          return modificationTime(absoluteTexturePath);
+        })
+        .value_or(std::nullopt);
+    if (!textureTime)
+    {
+      return std::nullopt;
+    }
+    result.modificationTime = std::max(result.modificationTime, *textureTime);
+  }
+
+  return result;
+}
+
 } // namespace
 
 Result<std::vector<std::filesystem::path>> findTextureCollections(
@@ -178,7 +240,8 @@ Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger&)
+  Logger& logger,
+  const TextureThumbnailCache* thumbnailCache)
 {
   if (gameFS.pathInfo(path) != PathInfo::Directory)
   {
@@ -198,6 +261,13 @@ Result<Assets::TextureCollection> loadTextureCollection(
     })
     .join(makeReadTextureFunc(gameFS, textureConfig))
     .and_then([&](auto texturePaths, const auto& readTexture) {
+      // the thumbnails are looked up before the textures are read
+      const auto version =
+        thumbnailCache ? collectionVersion(path, gameFS, texturePaths) : std::nullopt;
+      const auto cachedThumbnails =
+        version ? thumbnailCache->load(version->absolutePath, version->modificationTime)
+                : std::unordered_map<std::string, Assets::TextureThumbnail>{};
+
       auto nullLogger = NullLogger{};
       return kdl::fold_results(
                kdl::vec_parallel_transform(
@@ -216,10 +286,45 @@ Result<Assets::TextureCollection> loadTextureCollection(
                            return texture;
                          });
                      })
-                     .or_else(makeReadTextureErrorHandler(gameFS, nullLogger));
+                     .or_else(makeReadTextureErrorHandler(gameFS, nullLogger))
+                     .transform([&](auto texture) {
+                       // create the thumbnail while the texture data is available
+                       const auto it = cachedThumbnails.find(texture.name());
+                       auto thumbnail =
+                         it != cachedThumbnails.end()
+                           ? it->second
+                           : Assets::createTextureThumbnail(
+                             texture, Assets::ThumbnailSize);
+                       return std::pair{std::move(texture), std::move(thumbnail)};
+                     });
                  }))
-        .transform([&](auto textures) {
-          return Assets::TextureCollection{path, std::move(textures)};
+        .transform([&](auto texturesAndThumbnails) {
+          auto textures = std::vector<Assets::Texture>{};
+          auto thumbnails = std::vector<Assets::TextureThumbnail>{};
+          textures.reserve(texturesAndThumbnails.size());
+          thumbnails.reserve(texturesAndThumbnails.size());
+          for (auto& [texture, thumbnail] : texturesAndThumbnails)
+          {
+            textures.push_back(std::move(texture));
+            thumbnails.push_back(std::move(thumbnail));
+          }
+
+          if (
+            version
+            && std::any_of(textures.begin(), textures.end(), [&](const auto& texture) {
+                 return cachedThumbnails.find(texture.name()) == cachedThumbnails.end();
+               }))
+          {
+            thumbnailCache
+              ->store(
+                version->absolutePath, version->modificationTime, textures, thumbnails)
+              .transform_error([&](const auto& e) {
+                logger.warn() << "Could not store texture thumbnails: " << e.msg;
+              });
+          }
+
+          return Assets::TextureCollection{
+            path, std::move(textures), std::move(thumbnails)};
         });
     });
 }
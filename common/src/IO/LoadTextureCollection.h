@@ -44,14 +44,22 @@ struct TextureConfig;
 namespace TrenchBroom::IO
 {
 class FileSystem;
+class TextureThumbnailCache;
 
 Result<std::vector<std::filesystem::path>> findTextureCollections(
   const FileSystem& gameFS, const Model::TextureConfig& textureConfig);
 
+/**
+ * Loads the textures of the collection at the given path and creates their thumbnails.
+ *
+ * If a thumbnail cache is given, the thumbnails stored for the collection are used
+ * instead of creating them, and the thumbnails are stored if any were created.
+ */
 Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger& logger);
+  Logger& logger,
+  const TextureThumbnailCache* thumbnailCache = nullptr);
 
 } // namespace TrenchBroom::IO
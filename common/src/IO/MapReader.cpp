@@ -51,6 +51,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -569,28 +570,65 @@ CreateNodeResult createNodeFromEntityInfo(
 }
 
 /**
- * Creates a brush node from the given brush info. Returns an error if the brush could not
- * be created.
+ * A brush that was created from a brush info, but whose node has not been created yet.
  */
-CreateNodeResult createBrushNode(
+struct BrushNodeInfo
+{
+  Model::Brush brush;
+  size_t startLine;
+  size_t lineCount;
+  std::optional<ParentInfo> parentInfo;
+};
+
+/**
+ * The result of creating a node or a brush in parallel.
+ */
+using CreateObjectResult = Result<std::variant<NodeInfo, BrushNodeInfo>, NodeError>;
+
+template <typename T>
+CreateObjectResult toCreateObjectResult(Result<T, NodeError> result)
+{
+  return std::move(result).transform(
+    [](T&& value) { return std::variant<NodeInfo, BrushNodeInfo>{std::move(value)}; });
+}
+
+/**
+ * Creates a brush from the given brush info. Returns an error if the brush could not be
+ * created.
+ */
+Result<BrushNodeInfo, NodeError> createBrush(
   MapReader::BrushInfo brushInfo, const vm::bbox3& worldBounds)
 {
   return Model::Brush::create(worldBounds, std::move(brushInfo.faces))
     .transform([&](auto brush) {
-      auto brushNode = std::make_unique<Model::BrushNode>(std::move(brush));
-      brushNode->setFilePosition(brushInfo.startLine, brushInfo.lineCount);
-
       auto parentInfo = brushInfo.parentIndex ? ParentInfo{*brushInfo.parentIndex}
                                               : std::optional<ParentInfo>{};
-      return NodeInfo{
-        std::move(brushNode), std::move(parentInfo), {} // issues
+      return BrushNodeInfo{
+        std::move(brush),
+        brushInfo.startLine,
+        brushInfo.lineCount,
+        std::move(parentInfo),
       };
     })
     .or_else([&](auto e) {
-      return CreateNodeResult{NodeError{brushInfo.startLine, kdl::str_to_string(e)}};
+      return Result<BrushNodeInfo, NodeError>{
+        NodeError{brushInfo.startLine, kdl::str_to_string(e)}};
     });
 }
 
+/**
+ * Creates a brush node for the given brush.
+ */
+NodeInfo createBrushNode(BrushNodeInfo brushNodeInfo)
+{
+  auto brushNode = std::make_unique<Model::BrushNode>(std::move(brushNodeInfo.brush));
+  brushNode->setFilePosition(brushNodeInfo.startLine, brushNodeInfo.lineCount);
+
+  return NodeInfo{
+    std::move(brushNode), std::move(brushNodeInfo.parentInfo), {} // issues
+  };
+}
+
 /**
  * Creates a patch node from the given patch info.
  */
@@ -624,35 +662,46 @@ std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   const Model::MapFormat mapFormat,
   ParserStatus& status)
 {
-  // create nodes in parallel, moving data out of objectInfos
+  // create nodes and brushes in parallel, moving data out of objectInfos
   // we store optionals in the result vector to make the elements default constructible,
   // which is a requirement for parallel transform
-  auto createNodeResults = kdl::vec_parallel_transform(
-    std::move(objectInfos), [&](MapReader::ObjectInfo&& objectInfo) -> CreateNodeResult {
+  auto createObjectResults = kdl::vec_parallel_transform(
+    std::move(objectInfos),
+    [&](MapReader::ObjectInfo&& objectInfo) -> CreateObjectResult {
       return std::visit(
         kdl::overload(
           [&](MapReader::EntityInfo&& entityInfo) {
-            return createNodeFromEntityInfo(
-              entityPropertyConfig, std::move(entityInfo), mapFormat);
+            return toCreateObjectResult(createNodeFromEntityInfo(
+              entityPropertyConfig, std::move(entityInfo), mapFormat));
           },
           [&](MapReader::BrushInfo&& brushInfo) {
-            return createBrushNode(std::move(brushInfo), worldBounds);
+            return toCreateObjectResult(createBrush(std::move(brushInfo), worldBounds));
           },
           [&](MapReader::PatchInfo&& patchInfo) {
-            return createPatchNode(std::move(patchInfo));
+            return toCreateObjectResult(createPatchNode(std::move(patchInfo)));
           }),
         std::move(objectInfo));
     });
 
+  // the brush nodes are created in file order so that the brushes of an entity are
+  // allocated next to each other, see Model::NodeAllocator
   return kdl::vec_transform(
-    std::move(createNodeResults),
-    [&](std::optional<CreateNodeResult>&& createNodeResult) -> std::optional<NodeInfo> {
-      assert(createNodeResult.has_value());
-
-      return std::move(*createNodeResult)
-        .transform([&](NodeInfo&& nodeInfo) -> std::optional<NodeInfo> {
-          return std::move(nodeInfo);
-        })
+    std::move(createObjectResults),
+    [&](std::optional<CreateObjectResult>&& createObjectResult)
+      -> std::optional<NodeInfo> {
+      assert(createObjectResult.has_value());
+
+      return std::move(*createObjectResult)
+        .transform(
+          [&](std::variant<NodeInfo, BrushNodeInfo>&& object) -> std::optional<NodeInfo> {
+            return std::visit(
+              kdl::overload(
+                [](NodeInfo&& nodeInfo) { return std::move(nodeInfo); },
+                [](BrushNodeInfo&& brushNodeInfo) {
+                  return createBrushNode(std::move(brushNodeInfo));
+                }),
+              std::move(object));
+          })
         .transform_error([&](const NodeError& e) -> std::optional<NodeInfo> {
           status.error(e.line, e.msg);
           return std::nullopt;
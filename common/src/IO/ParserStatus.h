@@ -61,6 +61,12 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+  /**
+   * Logs a message that was already formatted by another parser status, e.g. one that
+   * collected the messages of a parser running on a worker thread.
+   */
+  void logFormatted(LogLevel level, const std::string& str);
+
 private:
   void log(LogLevel level, size_t line, size_t column, const std::string& str);
   std::string buildMessage(size_t line, size_t column, const std::string& str) const;
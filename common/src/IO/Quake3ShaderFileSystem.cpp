@@ -24,21 +24,125 @@
 #include "IO/File.h"
 #include "IO/PathInfo.h"
 #include "IO/Quake3ShaderParser.h"
+#include "IO/RecordingParserStatus.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/TraversalMode.h"
 #include "Logger.h"
 
 #include "kdl/result_fold.h"
+#include <kdl/parallel.h>
 #include <kdl/path_utils.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom::IO
 {
+namespace
+{
+
+struct ShaderScript
+{
+  std::filesystem::path path;
+  std::shared_ptr<const std::string> contents;
+  std::vector<Quake3ShaderLocation> locations;
+  std::optional<std::string> error;
+};
+
+ShaderScript indexShaderScript(ShaderScript script)
+{
+  try
+  {
+    auto parser = Quake3ShaderParser{*script.contents};
+    script.locations = parser.index();
+  }
+  catch (const ParserException& e)
+  {
+    script.error = e.what();
+  }
+  return script;
+}
+
+/**
+ * Returns a function that parses the shader at the given location when it is called for
+ * the first time and returns the cached shader file afterwards.
+ *
+ * The returned function is called when textures are loaded, which may happen on multiple
+ * threads, so it guards the cached file and serializes logging with the given mutex.
+ */
+GetImageFile makeGetShaderFile(
+  std::filesystem::path scriptPath,
+  std::shared_ptr<const std::string> contents,
+  Quake3ShaderLocation location,
+  Logger& logger,
+  std::shared_ptr<std::mutex> loggerMutex)
+{
+  struct CachedShaderFile
+  {
+    std::mutex mutex;
+    std::shared_ptr<File> file;
+  };
+
+  auto cache = std::make_shared<CachedShaderFile>();
+  return [scriptPath = std::move(scriptPath),
+          contents = std::move(contents),
+          location = std::move(location),
+          cache = std::move(cache),
+          &logger,
+          loggerMutex = std::move(loggerMutex)]() -> Result<std::shared_ptr<File>> {
+    const auto lock = std::lock_guard{cache->mutex};
+    if (!cache->file)
+    {
+      try
+      {
+        const auto str =
+          std::string_view{*contents}.substr(location.position, location.length);
+        auto parser = Quake3ShaderParser{str, location.line, location.column};
+        auto recordingStatus = RecordingParserStatus{};
+        auto shaders = parser.parse(recordingStatus);
+
+        if (!recordingStatus.messages().empty())
+        {
+          const auto loggerLock = std::lock_guard{*loggerMutex};
+          auto status = SimpleParserStatus{logger, scriptPath.string()};
+          replayMessages(status, recordingStatus.messages());
+        }
+
+        if (shaders.size() != 1)
+        {
+          return Error{"Failed to parse shader " + location.shaderPath.string()};
+        }
+
+        cache->file =
+          std::make_shared<ObjectFile<Assets::Quake3Shader>>(std::move(shaders.front()));
+      }
+      catch (const ParserException& e)
+      {
+        return Error{
+          "Failed to parse shader " + location.shaderPath.string() + " in "
+          + scriptPath.string() + ": " + e.what()};
+      }
+    }
+    return cache->file;
+  };
+}
+
+} // namespace
+
+struct Quake3ShaderFileSystem::IndexedShader
+{
+  std::filesystem::path shaderPath;
+  GetImageFile getFile;
+  bool linked = false;
+};
+
 Quake3ShaderFileSystem::Quake3ShaderFileSystem(
   const FileSystem& fs,
   std::filesystem::path shaderSearchPath,
@@ -56,44 +160,62 @@ Result<void> Quake3ShaderFileSystem::doReadDirectory()
   return loadShaders().and_then([&](auto shaders) { return linkShaders(shaders); });
 }
 
-Result<std::vector<Assets::Quake3Shader>> Quake3ShaderFileSystem::loadShaders() const
+Result<std::vector<Quake3ShaderFileSystem::IndexedShader>> Quake3ShaderFileSystem::
+  loadShaders() const
 {
   if (m_fs.pathInfo(m_shaderSearchPath) != PathInfo::Directory)
   {
-    return std::vector<Assets::Quake3Shader>{};
+    return std::vector<IndexedShader>{};
   }
 
-  const auto loadShaderFile = [&](const auto& path) {
+  const auto readShaderScript = [&](const auto& path) {
     return m_fs.openFile(path).transform([&](auto file) {
       auto bufferedReader = file->reader().buffer();
-      try
-      {
-        auto parser = Quake3ShaderParser{bufferedReader.stringView()};
-        auto status = SimpleParserStatus{m_logger, path.string()};
-        return parser.parse(status);
-      }
-      catch (const ParserException& e)
-      {
-        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
-        return std::vector<Assets::Quake3Shader>{};
-      }
+      return ShaderScript{
+        path,
+        std::make_shared<const std::string>(bufferedReader.stringView()),
+        {},
+        std::nullopt};
     });
   };
 
   return m_fs
     .find(m_shaderSearchPath, TraversalMode::Flat, makeExtensionPathMatcher({".shader"}))
     .and_then([&](auto paths) {
-      return kdl::fold_results(kdl::vec_transform(paths, loadShaderFile));
+      return kdl::fold_results(kdl::vec_transform(paths, readShaderScript));
     })
-    .transform([&](auto nestedShaders) {
-      auto allShaders = kdl::vec_flatten(std::move(nestedShaders));
-      m_logger.info() << "Loaded " << allShaders.size() << " shaders";
+    .transform([&](auto scripts) {
+      // Only the shader names and the extents of their bodies are determined here, the
+      // shaders are parsed when they are opened for the first time.
+      auto indexedScripts =
+        kdl::vec_parallel_transform(std::move(scripts), indexShaderScript);
+
+      auto allShaders = std::vector<IndexedShader>{};
+      auto loggerMutex = std::make_shared<std::mutex>();
+      for (const auto& script : indexedScripts)
+      {
+        if (script.error)
+        {
+          m_logger.warn() << "Skipping malformed shader file " << script.path << ": "
+                          << *script.error;
+          continue;
+        }
+
+        for (const auto& location : script.locations)
+        {
+          allShaders.push_back(IndexedShader{
+            location.shaderPath,
+            makeGetShaderFile(
+              script.path, script.contents, location, m_logger, loggerMutex)});
+        }
+      }
+
+      m_logger.info() << "Indexed " << allShaders.size() << " shaders";
       return allShaders;
     });
 }
 
-Result<void> Quake3ShaderFileSystem::linkShaders(
-  std::vector<Assets::Quake3Shader>& shaders)
+Result<void> Quake3ShaderFileSystem::linkShaders(std::vector<IndexedShader>& shaders)
 {
   return kdl::fold_results(
            kdl::vec_transform(
@@ -118,10 +240,17 @@ Result<void> Quake3ShaderFileSystem::linkShaders(
 }
 
 void Quake3ShaderFileSystem::linkTextures(
-  const std::vector<std::filesystem::path>& textures,
-  std::vector<Assets::Quake3Shader>& shaders)
+  const std::vector<std::filesystem::path>& textures, std::vector<IndexedShader>& shaders)
 {
   m_logger.debug() << "Linking textures...";
+
+  // Maps each shader path to the indices of the shaders with that path, in script order.
+  auto shadersByPath = std::map<std::filesystem::path, std::vector<size_t>>{};
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    shadersByPath[shaders[i].shaderPath].push_back(i);
+  }
+
   for (const auto& texture : textures)
   {
     const auto shaderPath = kdl::path_remove_extension(texture);
@@ -129,27 +258,17 @@ void Quake3ShaderFileSystem::linkTextures(
     // Only link a shader if it has not been linked yet.
     if (pathInfo(shaderPath) != PathInfo::File)
     {
-      const auto shaderIt =
-        std::find_if(shaders.begin(), shaders.end(), [&shaderPath](const auto& shader) {
-          return shaderPath == shader.shaderPath;
-        });
-
-      if (shaderIt != std::end(shaders))
+      const auto shaderIt = shadersByPath.find(shaderPath);
+      if (shaderIt != shadersByPath.end() && !shaderIt->second.empty())
       {
         // Found a matching shader.
-        auto& shader = *shaderIt;
-
-        auto shaderFile = std::static_pointer_cast<File>(
-          std::make_shared<ObjectFile<Assets::Quake3Shader>>(shader));
-        addFile(
-          shaderPath,
-          [shaderFile = std::move(shaderFile)]() -> Result<std::shared_ptr<File>> {
-            return shaderFile;
-          });
+        auto& shader = shaders[shaderIt->second.front()];
+        addFile(shaderPath, shader.getFile);
 
-        // Remove the shader so that we don't revisit it when linking standalone
+        // Mark the shader as linked so that we don't revisit it when linking standalone
         // shaders.
-        shaders.erase(shaderIt);
+        shader.linked = true;
+        shaderIt->second.erase(shaderIt->second.begin());
       }
       else
       {
@@ -165,15 +284,15 @@ void Quake3ShaderFileSystem::linkTextures(
   }
 }
 
-void Quake3ShaderFileSystem::linkStandaloneShaders(
-  std::vector<Assets::Quake3Shader>& shaders)
+void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<IndexedShader>& shaders)
 {
   m_logger.debug() << "Linking standalone shaders...";
   for (auto& shader : shaders)
   {
-    const auto& shaderPath = shader.shaderPath;
-    auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shader);
-    addFile(shaderPath, [shaderFile = std::move(shaderFile)]() { return shaderFile; });
+    if (!shader.linked)
+    {
+      addFile(shader.shaderPath, shader.getFile);
+    }
   }
 }
 } // namespace TrenchBroom::IO
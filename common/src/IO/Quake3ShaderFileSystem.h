@@ -30,17 +30,13 @@ namespace TrenchBroom
 class Logger;
 } // namespace TrenchBroom
 
-namespace TrenchBroom::Assets
-{
-class Quake3Shader;
-}
-
 namespace TrenchBroom::IO
 {
 
 /**
- * Parses Quake 3 shader scripts found in a file system and makes the shader objects
- * available as virtual files in the file system.
+ * Indexes Quake 3 shader scripts found in a file system and makes the shader objects
+ * available as virtual files in the file system. The scripts are indexed in parallel, but
+ * the shaders are only parsed when their files are opened for the first time.
  *
  * Also scans for textures available at a list of search paths and generates shaders for
  * such textures which do not already have a shader by the same name.
@@ -48,6 +44,8 @@ namespace TrenchBroom::IO
 class Quake3ShaderFileSystem : public ImageFileSystemBase
 {
 private:
+  struct IndexedShader;
+
   const FileSystem& m_fs;
   std::filesystem::path m_shaderSearchPath;
   std::vector<std::filesystem::path> m_textureSearchPaths;
@@ -76,12 +74,12 @@ public:
 private:
   Result<void> doReadDirectory() override;
 
-  Result<std::vector<Assets::Quake3Shader>> loadShaders() const;
-  Result<void> linkShaders(std::vector<Assets::Quake3Shader>& shaders);
+  Result<std::vector<IndexedShader>> loadShaders() const;
+  Result<void> linkShaders(std::vector<IndexedShader>& shaders);
   void linkTextures(
     const std::vector<std::filesystem::path>& textures,
-    std::vector<Assets::Quake3Shader>& shaders);
-  void linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders);
+    std::vector<IndexedShader>& shaders);
+  void linkStandaloneShaders(std::vector<IndexedShader>& shaders);
 };
 
 } // namespace TrenchBroom::IO
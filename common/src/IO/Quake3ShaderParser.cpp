@@ -32,8 +32,9 @@
 namespace TrenchBroom::IO
 {
 
-Quake3ShaderTokenizer::Quake3ShaderTokenizer(std::string_view str)
-  : Tokenizer{std::move(str), "", '\\'}
+Quake3ShaderTokenizer::Quake3ShaderTokenizer(
+  std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{std::move(str), "", '\\', line, column}
 {
 }
 
@@ -119,8 +120,19 @@ Tokenizer<unsigned int>::Token Quake3ShaderTokenizer::emitToken()
   return Token{Quake3ShaderToken::Eof, nullptr, nullptr, length(), line(), column()};
 }
 
-Quake3ShaderParser::Quake3ShaderParser(std::string_view str)
-  : m_tokenizer{std::move(str)}
+namespace
+{
+std::filesystem::path shaderPath(const std::string& pathStr)
+{
+  // 2633: Q3 accepts absolute shader paths, so we just strip the leading slash
+  return !pathStr.empty() && pathStr[0] == '/' ? std::filesystem::path{pathStr.substr(1)}
+                                               : std::filesystem::path{pathStr};
+}
+} // namespace
+
+Quake3ShaderParser::Quake3ShaderParser(
+  std::string_view str, const size_t line, const size_t column)
+  : m_tokenizer{std::move(str), line, column}
 {
 }
 
@@ -137,6 +149,24 @@ std::vector<Assets::Quake3Shader> Quake3ShaderParser::parse(ParserStatus& status
   return result;
 }
 
+std::vector<Quake3ShaderLocation> Quake3ShaderParser::index()
+{
+  auto result = std::vector<Quake3ShaderLocation>{};
+  while (!m_tokenizer.peekToken(Quake3ShaderToken::Eol).hasType(Quake3ShaderToken::Eof))
+  {
+    const auto token =
+      expect(Quake3ShaderToken::String, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+    const auto end = skipBody();
+    result.push_back(Quake3ShaderLocation{
+      shaderPath(token.data()),
+      token.position(),
+      end - token.position(),
+      token.line(),
+      token.column()});
+  }
+  return result;
+}
+
 void Quake3ShaderParser::parseBody(Assets::Quake3Shader& shader, ParserStatus& status)
 {
   expect(Quake3ShaderToken::OBrace, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
@@ -182,16 +212,7 @@ void Quake3ShaderParser::parseTexture(
 {
   const auto token =
     expect(Quake3ShaderToken::String, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
-  const auto pathStr = token.data();
-  if (!pathStr.empty() && pathStr[0] == '/')
-  {
-    // 2633: Q3 accepts absolute shader paths, so we just strip the leading slash
-    shader.shaderPath = std::filesystem::path{pathStr.substr(1)};
-  }
-  else
-  {
-    shader.shaderPath = std::filesystem::path{token.data()};
-  }
+  shader.shaderPath = shaderPath(token.data());
 }
 
 void Quake3ShaderParser::parseBodyEntry(
@@ -331,6 +352,52 @@ void Quake3ShaderParser::skipRemainderOfEntry()
   }
 }
 
+size_t Quake3ShaderParser::skipBody()
+{
+  expect(Quake3ShaderToken::OBrace, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+  auto token = m_tokenizer.peekToken(Quake3ShaderToken::Eol);
+  expect(
+    Quake3ShaderToken::CBrace | Quake3ShaderToken::OBrace | Quake3ShaderToken::String,
+    token);
+
+  while (!token.hasType(Quake3ShaderToken::CBrace))
+  {
+    if (token.hasType(Quake3ShaderToken::OBrace))
+    {
+      skipStage();
+    }
+    else
+    {
+      skipEntry();
+    }
+    token = m_tokenizer.peekToken(Quake3ShaderToken::Eol);
+  }
+
+  token =
+    expect(Quake3ShaderToken::CBrace, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+  return token.position() + 1;
+}
+
+void Quake3ShaderParser::skipStage()
+{
+  expect(Quake3ShaderToken::OBrace, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+  auto token = m_tokenizer.peekToken(Quake3ShaderToken::Eol);
+  expect(Quake3ShaderToken::CBrace | Quake3ShaderToken::String, token);
+
+  while (!token.hasType(Quake3ShaderToken::CBrace))
+  {
+    skipEntry();
+    token = m_tokenizer.peekToken(Quake3ShaderToken::Eol);
+  }
+  expect(Quake3ShaderToken::CBrace, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+}
+
+void Quake3ShaderParser::skipEntry()
+{
+  expect(Quake3ShaderToken::String, m_tokenizer.nextToken(Quake3ShaderToken::Eol));
+  skipRemainderOfEntry();
+}
+
 Quake3ShaderParser::TokenNameMap Quake3ShaderParser::tokenNames() const
 {
   return {
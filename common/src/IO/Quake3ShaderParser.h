@@ -22,7 +22,9 @@
 #include "IO/Parser.h"
 #include "IO/Tokenizer.h"
 
+#include <filesystem>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom::Assets
 {
@@ -50,19 +52,36 @@ static const Type Eof = 1 << 8;      // end of file
 class Quake3ShaderTokenizer : public Tokenizer<Quake3ShaderToken::Type>
 {
 public:
-  explicit Quake3ShaderTokenizer(std::string_view str);
+  explicit Quake3ShaderTokenizer(
+    std::string_view str, size_t line = 1, size_t column = 1);
 
 private:
   Token emitToken() override;
 };
 
+/**
+ * The location of a single shader within a shader script.
+ */
+struct Quake3ShaderLocation
+{
+  std::filesystem::path shaderPath;
+  size_t position;
+  size_t length;
+  size_t line;
+  size_t column;
+};
+
 class Quake3ShaderParser : public Parser<Quake3ShaderToken::Type>
 {
 private:
   Quake3ShaderTokenizer m_tokenizer;
 
 public:
-  explicit Quake3ShaderParser(std::string_view str);
+  /**
+   * Creates a parser for the given string. The given line and column are reported as the
+   * position of the first character, which is useful when parsing a part of a script.
+   */
+  explicit Quake3ShaderParser(std::string_view str, size_t line = 1, size_t column = 1);
 
   /**
    * Parses a Quake 3 shader and returns the value of the qer_editorimage entry.
@@ -74,6 +93,18 @@ public:
    */
   std::vector<Assets::Quake3Shader> parse(ParserStatus& status);
 
+  /**
+   * Finds the shaders in the script without parsing their bodies. The bodies are only
+   * checked for their structure of stages and entries, but the values of the entries are
+   * not parsed. The returned locations can be passed to a new parser to parse the
+   * corresponding shaders later.
+   *
+   * @return the locations of the shaders in the order in which they appear in the script
+   *
+   * @throws ParserException if the script is not well-formed
+   */
+  std::vector<Quake3ShaderLocation> index();
+
 private:
   void parseTexture(Assets::Quake3Shader& shader, ParserStatus& status);
   void parseBody(Assets::Quake3Shader& shader, ParserStatus& status);
@@ -81,6 +112,9 @@ private:
   void parseBodyEntry(Assets::Quake3Shader& shader, ParserStatus& status);
   void parseStageEntry(Assets::Quake3ShaderStage& stage, ParserStatus& status);
   void skipRemainderOfEntry();
+  size_t skipBody();
+  void skipStage();
+  void skipEntry();
 
 private:
   TokenNameMap tokenNames() const override;
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RecordingParserStatus.h"
+
+#include "Logger.h"
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+Logger& nullLogger()
+{
+  static auto logger = NullLogger{};
+  return logger;
+}
+} // namespace
+
+RecordingParserStatus::RecordingParserStatus()
+  : ParserStatus{nullLogger(), ""}
+{
+}
+
+RecordingParserStatus::RecordingParserStatus(ParserStatus& status)
+  : ParserStatus{nullLogger(), ""}
+  , m_status{&status}
+{
+}
+
+const ParserMessages& RecordingParserStatus::messages() const
+{
+  return m_messages;
+}
+
+ParserMessages RecordingParserStatus::takeMessages()
+{
+  return std::move(m_messages);
+}
+
+void RecordingParserStatus::doProgress(const double progress)
+{
+  if (m_status)
+  {
+    m_status->progress(progress);
+  }
+}
+
+void RecordingParserStatus::doLog(const LogLevel level, const std::string& str)
+{
+  m_messages.emplace_back(level, str);
+  if (m_status)
+  {
+    m_status->logFormatted(level, str);
+  }
+}
+
+void replayMessages(ParserStatus& status, const ParserMessages& messages)
+{
+  for (const auto& [level, str] : messages)
+  {
+    status.logFormatted(level, str);
+  }
+}
+
+} // namespace TrenchBroom::IO
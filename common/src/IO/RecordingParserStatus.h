@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+using ParserMessages = std::vector<std::pair<LogLevel, std::string>>;
+
+/**
+ * Records the messages logged by a parser so that they can be logged again later, e.g.
+ * when the parser ran on a worker thread or its results are taken from a cache. If
+ * another parser status is given, messages and progress are passed on to it as well.
+ */
+class RecordingParserStatus : public ParserStatus
+{
+private:
+  ParserStatus* m_status = nullptr;
+  ParserMessages m_messages;
+
+public:
+  RecordingParserStatus();
+  explicit RecordingParserStatus(ParserStatus& status);
+
+  const ParserMessages& messages() const;
+  ParserMessages takeMessages();
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+
+/**
+ * Logs the given recorded messages to the given parser status.
+ */
+void replayMessages(ParserStatus& status, const ParserMessages& messages);
+
+} // namespace TrenchBroom::IO
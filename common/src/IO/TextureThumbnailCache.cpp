@@ -0,0 +1,232 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnailCache.h"
+
+#include "Assets/Texture.h"
+#include "Ensure.h"
+#include "Error.h"
+#include "IO/DiskIO.h"
+
+#include <fmt/format.h>
+
+#include <kdl/result.h>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr auto Magic = std::array<char, 4>{'T', 'B', 'T', 'C'};
+constexpr auto Version = std::uint32_t(1);
+
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& stream, const std::string& str)
+{
+  writeValue(stream, std::uint64_t(str.size()));
+  stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+template <typename T>
+Result<T> readValue(std::istream& stream)
+{
+  auto value = T{};
+  if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+  {
+    return Error{"Unexpected end of thumbnail cache file"};
+  }
+  return value;
+}
+
+Result<std::string> readString(std::istream& stream, const size_t maxSize)
+{
+  return readValue<std::uint64_t>(stream).and_then([&](auto size) -> Result<std::string> {
+    if (size > maxSize)
+    {
+      return Error{"Invalid string length in thumbnail cache file"};
+    }
+
+    auto str = std::string(size, '\0');
+    if (!stream.read(str.data(), static_cast<std::streamsize>(size)))
+    {
+      return Error{"Unexpected end of thumbnail cache file"};
+    }
+    return str;
+  });
+}
+
+Result<Assets::TextureThumbnail> readThumbnail(std::istream& stream)
+{
+  return readValue<std::uint64_t>(stream)
+    .join(readValue<std::uint64_t>(stream))
+    .and_then([&](auto width, auto height) -> Result<Assets::TextureThumbnail> {
+      if (width > Assets::ThumbnailSize || height > Assets::ThumbnailSize)
+      {
+        return Error{"Invalid thumbnail size in thumbnail cache file"};
+      }
+
+      auto pixels = std::vector<unsigned char>(width * height * 4);
+      if (!stream.read(
+            reinterpret_cast<char*>(pixels.data()),
+            static_cast<std::streamsize>(pixels.size())))
+      {
+        return Error{"Unexpected end of thumbnail cache file"};
+      }
+      return Assets::TextureThumbnail{width, height, std::move(pixels)};
+    });
+}
+
+using Thumbnails = std::unordered_map<std::string, Assets::TextureThumbnail>;
+
+Result<Thumbnails> readEntries(std::istream& stream, const std::uint64_t count)
+{
+  auto result = Thumbnails{};
+  for (std::uint64_t i = 0; i < count; ++i)
+  {
+    const auto success =
+      readString(stream, 4096)
+        .join(readThumbnail(stream))
+        .transform([&](auto name, auto thumbnail) {
+          result.emplace(std::move(name), std::move(thumbnail));
+        });
+    if (success.is_error())
+    {
+      return Error{"Invalid entry in thumbnail cache file"};
+    }
+  }
+  return result;
+}
+
+Result<Thumbnails> readThumbnails(
+  std::istream& stream,
+  const std::filesystem::path& collectionPath,
+  const std::filesystem::file_time_type modificationTime)
+{
+  auto magic = std::array<char, 4>{};
+  if (!stream.read(magic.data(), magic.size()) || magic != Magic)
+  {
+    return Error{"Not a thumbnail cache file"};
+  }
+
+  const auto header = readValue<std::uint32_t>(stream)
+                        .join(readValue<std::uint64_t>(stream))
+                        .join(readString(stream, 4096))
+                        .join(readValue<std::int64_t>(stream));
+  return header.and_then(
+    [&](auto version, auto thumbnailSize, auto path, auto time) -> Result<Thumbnails> {
+      if (
+        version != Version || thumbnailSize != Assets::ThumbnailSize
+        || path != collectionPath.generic_string()
+        || time != modificationTime.time_since_epoch().count())
+      {
+        return Error{"Thumbnail cache file is out of date"};
+      }
+
+      return readValue<std::uint64_t>(stream).and_then([&](auto count) {
+        return readEntries(stream, count);
+      });
+    });
+}
+
+void writeThumbnails(
+  std::ostream& stream,
+  const std::filesystem::path& collectionPath,
+  const std::filesystem::file_time_type modificationTime,
+  const std::vector<Assets::Texture>& textures,
+  const std::vector<Assets::TextureThumbnail>& thumbnails)
+{
+  stream.write(Magic.data(), Magic.size());
+  writeValue(stream, Version);
+  writeValue(stream, std::uint64_t(Assets::ThumbnailSize));
+  writeString(stream, collectionPath.generic_string());
+  writeValue(stream, std::int64_t(modificationTime.time_since_epoch().count()));
+
+  writeValue(stream, std::uint64_t(thumbnails.size()));
+  for (size_t i = 0; i < thumbnails.size(); ++i)
+  {
+    const auto& thumbnail = thumbnails[i];
+    writeString(stream, textures[i].name());
+    writeValue(stream, std::uint64_t(thumbnail.width));
+    writeValue(stream, std::uint64_t(thumbnail.height));
+    stream.write(
+      reinterpret_cast<const char*>(thumbnail.pixels.data()),
+      static_cast<std::streamsize>(thumbnail.pixels.size()));
+  }
+}
+
+} // namespace
+
+TextureThumbnailCache::TextureThumbnailCache(std::filesystem::path directory)
+  : m_directory{std::move(directory)}
+{
+}
+
+const std::filesystem::path& TextureThumbnailCache::directory() const
+{
+  return m_directory;
+}
+
+std::unordered_map<std::string, Assets::TextureThumbnail> TextureThumbnailCache::load(
+  const std::filesystem::path& collectionPath,
+  const std::filesystem::file_time_type modificationTime) const
+{
+  return Disk::withInputStream(
+           cacheFilePath(collectionPath),
+           std::ios::in | std::ios::binary,
+           [&](auto& stream) {
+             return readThumbnails(stream, collectionPath, modificationTime);
+           })
+    .value_or(Thumbnails{});
+}
+
+Result<void> TextureThumbnailCache::store(
+  const std::filesystem::path& collectionPath,
+  const std::filesystem::file_time_type modificationTime,
+  const std::vector<Assets::Texture>& textures,
+  const std::vector<Assets::TextureThumbnail>& thumbnails) const
+{
+  ensure(textures.size() == thumbnails.size(), "one thumbnail per texture");
+
+  return Disk::createDirectory(m_directory).and_then([&](auto) {
+    return Disk::withOutputStream(
+      cacheFilePath(collectionPath),
+      std::ios::out | std::ios::binary | std::ios::trunc,
+      [&](auto& stream) {
+        writeThumbnails(stream, collectionPath, modificationTime, textures, thumbnails);
+      });
+  });
+}
+
+std::filesystem::path TextureThumbnailCache::cacheFilePath(
+  const std::filesystem::path& collectionPath) const
+{
+  const auto hash = std::hash<std::string>{}(collectionPath.generic_string());
+  return m_directory / fmt::format("{:016x}.thumbnails", hash);
+}
+
+} // namespace TrenchBroom::IO
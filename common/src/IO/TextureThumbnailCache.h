@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/TextureThumbnail.h"
+#include "Result.h"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+class Texture;
+}
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Stores the thumbnails of texture collections on disk, so that they don't have to be
+ * created again when a collection is loaded the next time.
+ *
+ * Every collection is stored in its own file in the cache directory. The file records the
+ * absolute path and the modification time of the collection and is only used if both
+ * match. Within a file, the thumbnails are looked up by texture name. The files are not
+ * portable between machines.
+ */
+class TextureThumbnailCache
+{
+private:
+  std::filesystem::path m_directory;
+
+public:
+  explicit TextureThumbnailCache(std::filesystem::path directory);
+
+  const std::filesystem::path& directory() const;
+
+  /**
+   * Returns the thumbnails stored for the collection at the given absolute path, by
+   * texture name. Returns an empty map if no thumbnails are stored for the collection, if
+   * the collection was modified since they were stored or if the cache file cannot be
+   * read.
+   */
+  std::unordered_map<std::string, Assets::TextureThumbnail> load(
+    const std::filesystem::path& collectionPath,
+    std::filesystem::file_time_type modificationTime) const;
+
+  /**
+   * Stores the thumbnails of the given textures for the collection at the given absolute
+   * path, replacing any thumbnails previously stored for it.
+   */
+  Result<void> store(
+    const std::filesystem::path& collectionPath,
+    std::filesystem::file_time_type modificationTime,
+    const std::vector<Assets::Texture>& textures,
+    const std::vector<Assets::TextureThumbnail>& thumbnails) const;
+
+private:
+  std::filesystem::path cacheFilePath(const std::filesystem::path& collectionPath) const;
+};
+
+} // namespace TrenchBroom::IO
@@ -28,7 +28,10 @@
 #include <vecmath/bezier_surface.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <iterator>
 
 namespace TrenchBroom::Model
 {
@@ -127,6 +130,7 @@ void BezierPatch::setControlPoint(const size_t row, const size_t col, Point cont
   assert(col < m_pointColumnCount);
   m_controlPoints[row * m_pointColumnCount + col] = std::move(controlPoint);
   m_bounds = computeBounds(m_controlPoints);
+  m_contentHash.reset();
 }
 
 const vm::bbox3& BezierPatch::bounds() const
@@ -142,6 +146,7 @@ const std::string& BezierPatch::textureName() const
 void BezierPatch::setTextureName(std::string textureName)
 {
   m_textureName = std::move(textureName);
+  m_contentHash.reset();
 }
 
 const Assets::Texture* BezierPatch::texture() const
@@ -170,6 +175,7 @@ void BezierPatch::transform(const vm::mat4x4& transformation)
     builder.add(controlPoint.xyz());
   }
   m_bounds = builder.bounds();
+  m_contentHash.reset();
 }
 
 using SurfaceControlPoints = std::array<std::array<BezierPatch::Point, 3u>, 3u>;
@@ -259,7 +265,6 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   const size_t gridPointColumnCount = surfaceColumnCount() * quadsPerSurfaceSide + 1u;
 
   auto grid = std::vector<BezierPatch::Point>{};
-  grid.reserve(gridPointRowCount * gridPointColumnCount);
 
   /*
   Next we sample the surfaces to compute each point in the grid.
@@ -269,13 +274,12 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   the grid which is shared by adjacent surfaces. Each surface is subdivided into 3*3
   parts, which yields 4*4=16 grid points per surface.
 
-  We compute the grid row by row, so in each iteration, we need to determine which surface
-  should be sampled for the grid point. For the shared points, we could sample either
-  surface, but we decided (arbitrarily) that for a shared point, we will sample the
-  previous surface. In the diagram, the surface column / row index indicates which surface
-  will be sampled for each grid point. Suppose we want to compute the grid point at column
-  3, row 2. This is a shared point of surfaces A and B, and per our rule, we will sample
-  surface A.
+  We compute the grid surface by surface, so we need to determine which surface should be
+  sampled for each grid point. For the shared points, we could sample either surface, but
+  we decided (arbitrarily) that for a shared point, we will sample the previous surface.
+  In the diagram, the surface column / row index indicates which surface will be sampled
+  for each grid point. Suppose we want to compute the grid point at column 3, row 2. This
+  is a shared point of surfaces A and B, and per our rule, we will sample surface A.
 
   This also affects how we compute the u and v values which we use to sample each surface.
   Note that for shared grid points, either u or v or both are always 1. This is necessary
@@ -309,29 +313,86 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   value of v
   */
 
-  for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
+  // the basis weights are the same for every surface
+  auto basis = std::vector<std::array<FloatType, 3>>{};
+  basis.reserve(quadsPerSurfaceSide + 1u);
+  for (size_t i = 0u; i <= quadsPerSurfaceSide; ++i)
   {
-    const size_t surfaceRow =
-      (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-    const FloatType v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide)
-                        / static_cast<FloatType>(quadsPerSurfaceSide);
+    basis.push_back(vm::quadratic_bezier_basis(
+      static_cast<FloatType>(i) / static_cast<FloatType>(quadsPerSurfaceSide)));
+  }
 
-    for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
-    {
-      const size_t surfaceCol =
-        (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-      const FloatType u =
-        static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide)
-        / static_cast<FloatType>(quadsPerSurfaceSide);
+  grid.resize(gridPointRowCount * gridPointColumnCount);
 
+  auto surfaceGrid = std::vector<BezierPatch::Point>{};
+  for (size_t surfaceRow = 0u; surfaceRow < surfaceRowCount(); ++surfaceRow)
+  {
+    // skip the first row of points unless this is the first surface row, they were
+    // already sampled from the previous surface
+    const auto firstRow = surfaceRow > 0u ? 1u : 0u;
+
+    for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount(); ++surfaceCol)
+    {
+      const auto firstCol = surfaceCol > 0u ? 1u : 0u;
       const auto& surfaceControlPoints =
         allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-      auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-      grid.push_back(std::move(point));
+
+      surfaceGrid.clear();
+      vm::evaluate_quadratic_bezier_surface(
+        surfaceControlPoints,
+        std::next(basis.begin(), static_cast<std::ptrdiff_t>(firstCol)),
+        basis.end(),
+        std::next(basis.begin(), static_cast<std::ptrdiff_t>(firstRow)),
+        basis.end(),
+        std::back_inserter(surfaceGrid));
+
+      // copy the sampled points into the grid row by row
+      const auto surfaceGridColumnCount = quadsPerSurfaceSide + 1u - firstCol;
+      for (size_t row = 0u; row < quadsPerSurfaceSide + 1u - firstRow; ++row)
+      {
+        const auto gridRow = surfaceRow * quadsPerSurfaceSide + firstRow + row;
+        const auto gridCol = surfaceCol * quadsPerSurfaceSide + firstCol;
+        std::copy_n(
+          std::next(
+            surfaceGrid.begin(),
+            static_cast<std::ptrdiff_t>(row * surfaceGridColumnCount)),
+          surfaceGridColumnCount,
+          std::next(
+            grid.begin(),
+            static_cast<std::ptrdiff_t>(gridRow * gridPointColumnCount + gridCol)));
+      }
     }
   }
 
   return grid;
 }
 
+std::uint64_t BezierPatch::contentHash() const
+{
+  return m_contentHash.get([&]() {
+    auto hasher = ContentHasher{};
+    hasher.add(static_cast<std::uint64_t>(m_pointRowCount))
+      .add(static_cast<std::uint64_t>(m_pointColumnCount));
+    for (const auto& controlPoint : m_controlPoints)
+    {
+      hasher.add(controlPoint);
+    }
+    return hasher.add(m_textureName).hash();
+  });
+}
+
+bool operator==(const BezierPatch& lhs, const BezierPatch& rhs)
+{
+  return lhs.contentHash() == rhs.contentHash()
+         && lhs.pointRowCount() == rhs.pointRowCount()
+         && lhs.pointColumnCount() == rhs.pointColumnCount()
+         && lhs.bounds() == rhs.bounds() && lhs.controlPoints() == rhs.controlPoints()
+         && lhs.textureName() == rhs.textureName();
+}
+
+bool operator!=(const BezierPatch& lhs, const BezierPatch& rhs)
+{
+  return !(lhs == rhs);
+}
+
 } // namespace TrenchBroom::Model
@@ -21,6 +21,7 @@
 
 #include "Assets/AssetReference.h"
 #include "FloatType.h"
+#include "Model/ContentHash.h"
 
 #include <kdl/reflection_decl.h>
 
@@ -28,6 +29,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -53,6 +55,8 @@ private:
   std::string m_textureName;
   Assets::AssetReference<Assets::Texture> m_textureReference;
 
+  CachedContentHash m_contentHash;
+
   kdl_reflect_decl(
     BezierPatch,
     m_pointRowCount,
@@ -100,6 +104,15 @@ public: // control points:
   void transform(const vm::mat4x4& transformation);
 
   std::vector<Point> evaluate(size_t subdivisionsPerSurface) const;
+
+  /**
+   * Returns a hash of the control points and the texture name of this patch. Patches that
+   * compare equal have equal hashes.
+   */
+  std::uint64_t contentHash() const;
 };
 
+bool operator==(const BezierPatch& lhs, const BezierPatch& rhs);
+bool operator!=(const BezierPatch& lhs, const BezierPatch& rhs);
+
 } // namespace TrenchBroom::Model
@@ -55,24 +55,12 @@ namespace TrenchBroom::Model
 
 kdl_reflect_impl(Brush);
 
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
+  , m_contentHash{other.m_contentHash}
 {
   if (m_geometry)
   {
@@ -114,10 +102,11 @@ Result<Brush> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace>
 
 Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
 {
+  m_contentHash.reset();
   // First, add all faces to the brush geometry
   BrushFace::sortFaces(m_faces);
 
-  auto geometry = std::make_unique<BrushGeometry>(worldBounds);
+  auto geometry = std::make_shared<BrushGeometry>(worldBounds);
 
   for (size_t i = 0u; i < m_faces.size(); ++i)
   {
@@ -173,6 +162,29 @@ const vm::bbox3& Brush::bounds() const
   return m_geometry->bounds();
 }
 
+bool Brush::hasGeometry() const
+{
+  return m_geometry != nullptr;
+}
+
+void Brush::discardGeometry()
+{
+  for (auto& face : m_faces)
+  {
+    face.setGeometry(nullptr);
+  }
+  m_geometry.reset();
+}
+
+Result<void> Brush::rebuildGeometry(const vm::bbox3& worldBounds)
+{
+  if (m_geometry)
+  {
+    return kdl::void_success;
+  }
+  return updateGeometryFromFaces(worldBounds);
+}
+
 std::optional<size_t> Brush::findFace(const std::string& textureName) const
 {
   return kdl::vec_index_of(m_faces, [&](const BrushFace& face) {
@@ -223,6 +235,7 @@ const BrushFace& Brush::face(const size_t index) const
 BrushFace& Brush::face(const size_t index)
 {
   assert(index < faceCount());
+  m_contentHash.reset();
   return m_faces[index];
 }
 
@@ -238,9 +251,25 @@ const std::vector<BrushFace>& Brush::faces() const
 
 std::vector<BrushFace>& Brush::faces()
 {
+  m_contentHash.reset();
   return m_faces;
 }
 
+std::uint64_t Brush::contentHash() const
+{
+  return m_contentHash.get([&]() { return contentHash(m_faces); });
+}
+
+std::uint64_t Brush::contentHash(const std::vector<BrushFace>& faces)
+{
+  auto hasher = UnorderedContentHasher{};
+  for (const auto& face : faces)
+  {
+    hasher.add(face.contentHash());
+  }
+  return hasher.hash();
+}
+
 bool Brush::closed() const
 {
   ensure(m_geometry != nullptr, "geometry is null");
@@ -263,6 +292,7 @@ bool Brush::fullySpecified() const
 
 void Brush::cloneFaceAttributesFrom(const Brush& brush)
 {
+  m_contentHash.reset();
   for (auto& destination : m_faces)
   {
     if (const auto sourceIndex = brush.findFace(destination.boundary()))
@@ -321,6 +351,7 @@ static const BrushFace* findBestMatchingFace(
 
 void Brush::cloneFaceAttributesFrom(const std::vector<const Brush*>& brushes)
 {
+  m_contentHash.reset();
   auto candidates = std::vector<const BrushFace*>{};
   for (const auto* candidateBrush : brushes)
   {
@@ -348,6 +379,7 @@ void Brush::cloneFaceAttributesFrom(const std::vector<const Brush*>& brushes)
 
 void Brush::cloneInvertedFaceAttributesFrom(const Brush& brush)
 {
+  m_contentHash.reset();
   for (auto& destination : m_faces)
   {
     if (const auto sourceIndex = brush.findFace(destination.boundary().flip()))
@@ -368,6 +400,7 @@ void Brush::cloneInvertedFaceAttributesFrom(const Brush& brush)
 
 Result<void> Brush::clip(const vm::bbox3& worldBounds, BrushFace face)
 {
+  m_contentHash.reset();
   m_faces.push_back(std::move(face));
   return updateGeometryFromFaces(worldBounds);
 }
@@ -378,6 +411,7 @@ Result<void> Brush::moveBoundary(
   const vm::vec3& delta,
   const bool lockTexture)
 {
+  m_contentHash.reset();
   assert(faceIndex < faceCount());
 
   return m_faces[faceIndex]
@@ -388,6 +422,7 @@ Result<void> Brush::moveBoundary(
 Result<void> Brush::expand(
   const vm::bbox3& worldBounds, const FloatType delta, const bool lockTexture)
 {
+  m_contentHash.reset();
   for (auto& face : m_faces)
   {
     const vm::vec3 moveAmount = face.boundary().normal * delta;
@@ -1097,6 +1132,7 @@ Result<void> Brush::updateFacesFromGeometry(
   const BrushGeometry& newGeometry,
   const bool uvLock)
 {
+  m_contentHash.reset();
   std::vector<BrushFace> newFaces;
   newFaces.reserve(newGeometry.faces().size());
 
@@ -1171,6 +1207,7 @@ std::vector<Result<Brush>> Brush::subtract(
 
 Result<void> Brush::intersect(const vm::bbox3& worldBounds, const Brush& brush)
 {
+  m_contentHash.reset();
   m_faces = kdl::vec_concat(std::move(m_faces), brush.faces());
   return updateGeometryFromFaces(worldBounds);
 }
@@ -1178,6 +1215,7 @@ Result<void> Brush::intersect(const vm::bbox3& worldBounds, const Brush& brush)
 Result<void> Brush::transform(
   const vm::bbox3& worldBounds, const vm::mat4x4& transformation, const bool lockTextures)
 {
+  m_contentHash.reset();
   for (auto& face : m_faces)
   {
     if (!face.transform(transformation, lockTextures).is_success())
@@ -1261,6 +1299,7 @@ Result<Brush> Brush::createBrush(
 Brush Brush::convertToParaxial() const
 {
   Brush result(*this);
+  result.m_contentHash.reset();
   for (auto& face : result.m_faces)
   {
     face.convertToParaxial();
@@ -1271,6 +1310,7 @@ Brush Brush::convertToParaxial() const
 Brush Brush::convertToParallel() const
 {
   Brush result(*this);
+  result.m_contentHash.reset();
   for (auto& face : result.m_faces)
   {
     face.convertToParallel();
@@ -1349,7 +1389,7 @@ bool Brush::checkFaceLinks() const
 
 bool operator==(const Brush& lhs, const Brush& rhs)
 {
-  return lhs.faces() == rhs.faces();
+  return lhs.contentHash() == rhs.contentHash() && lhs.faces() == rhs.faces();
 }
 
 bool operator!=(const Brush& lhs, const Brush& rhs)
@@ -22,12 +22,14 @@
 #include "FloatType.h"
 #include "Macros.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ContentHash.h"
 #include "Result.h"
 
 #include <kdl/reflection_decl.h>
 
 #include <vecmath/forward.h>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -43,8 +45,6 @@ enum class MapFormat;
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -56,7 +56,20 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is shared between copies of this brush and is never modified once it
+   * has been built. Operations that change the shape of the brush build a new geometry
+   * and replace this pointer, so copying a brush to change only its face attributes does
+   * not copy its polyhedron.
+   *
+   * The face geometries store the indices of the corresponding faces in m_faces as their
+   * payloads. Since a copy has the same faces in the same order, it can share these
+   * links, too.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
+
+  CachedContentHash m_contentHash;
 
   kdl_reflect_decl(Brush, m_faces);
 
@@ -81,6 +94,30 @@ private:
 public:
   const vm::bbox3& bounds() const;
 
+public: // geometry management
+  /**
+   * Indicates whether this brush has a geometry. A brush only lacks a geometry if its
+   * geometry was discarded by calling `discardGeometry`.
+   */
+  bool hasGeometry() const;
+
+  /**
+   * Discards the geometry of this brush and keeps only its faces. This is useful to
+   * reduce the memory footprint of brushes which are only kept around to be restored
+   * later, e.g. for undo. Most functions require a geometry, so it must be rebuilt by
+   * calling `rebuildGeometry` before the brush can be used again.
+   */
+  void discardGeometry();
+
+  /**
+   * Rebuilds the geometry of this brush from its faces if it was discarded, otherwise
+   * does nothing.
+   *
+   * @param worldBounds the world bounds
+   * @return a void result or an error if the geometry could not be rebuilt
+   */
+  Result<void> rebuildGeometry(const vm::bbox3& worldBounds);
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& textureName) const;
   std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -100,6 +137,23 @@ public: // face management:
   bool closed() const;
   bool fullySpecified() const;
 
+public: // content hash
+  /**
+   * Returns a hash of the faces of this brush. Brushes that compare equal have equal
+   * hashes, so unequal brushes can be told apart without comparing their faces.
+   *
+   * The hash is cached until this brush is modified. Obtaining a face via the non-const
+   * accessors counts as a modification, so references obtained from them must not be
+   * used to modify the face after the hash was requested again.
+   */
+  std::uint64_t contentHash() const;
+
+  /**
+   * Computes the content hash of a brush with the given faces. The hash does not depend
+   * on the order of the faces.
+   */
+  static std::uint64_t contentHash(const std::vector<BrushFace>& faces);
+
 public: // clone face attributes from matching faces of other brushes
   void cloneFaceAttributesFrom(const Brush& brush);
   void cloneFaceAttributesFrom(const std::vector<const Brush*>& brushes);
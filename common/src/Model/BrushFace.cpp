@@ -24,6 +24,7 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "FloatType.h"
+#include "Model/ContentHash.h"
 #include "Model/MapFormat.h"
 #include "Model/ParallelTexCoordSystem.h"
 #include "Model/ParaxialTexCoordSystem.h"
@@ -50,9 +51,27 @@
 
 #include <sstream>
 #include <string>
+#include <variant>
 
 namespace TrenchBroom::Model
 {
+namespace
+{
+std::variant<ParaxialTexCoordSystem, ParallelTexCoordSystem> toInlineTexCoordSystem(
+  std::unique_ptr<TexCoordSystem> texCoordSystem)
+{
+  ensure(texCoordSystem != nullptr, "texCoordSystem is null");
+  if (auto* paraxial = dynamic_cast<ParaxialTexCoordSystem*>(texCoordSystem.get()))
+  {
+    return std::move(*paraxial);
+  }
+
+  auto* parallel = dynamic_cast<ParallelTexCoordSystem*>(texCoordSystem.get());
+  ensure(parallel != nullptr, "texCoordSystem is paraxial or parallel");
+  return std::move(*parallel);
+}
+} // namespace
+
 const BrushVertex* BrushFace::TransformHalfEdgeToVertex::operator()(
   const BrushHalfEdge* halfEdge) const
 {
@@ -71,7 +90,7 @@ BrushFace::BrushFace(const BrushFace& other)
   , m_boundary(other.m_boundary)
   , m_attributes(other.m_attributes)
   , m_textureReference(other.m_textureReference)
-  , m_texCoordSystem(other.m_texCoordSystem ? other.m_texCoordSystem->clone() : nullptr)
+  , m_texCoordSystem(other.m_texCoordSystem)
   , m_geometry(nullptr)
   , m_lineNumber(other.m_lineNumber)
   , m_lineCount(other.m_lineCount)
@@ -231,14 +250,13 @@ BrushFace::BrushFace(
   : m_points(points)
   , m_boundary(boundary)
   , m_attributes(attributes)
-  , m_texCoordSystem(std::move(texCoordSystem))
+  , m_texCoordSystem(toInlineTexCoordSystem(std::move(texCoordSystem)))
   , m_geometry(nullptr)
   , m_lineNumber(0)
   , m_lineCount(0)
   , m_selected(false)
   , m_markedToRenderFace(false)
 {
-  ensure(m_texCoordSystem != nullptr, "texCoordSystem is null");
 }
 
 void BrushFace::sortFaces(std::vector<BrushFace>& faces)
@@ -269,15 +287,33 @@ void BrushFace::sortFaces(std::vector<BrushFace>& faces)
   });
 }
 
+std::uint64_t BrushFace::contentHash() const
+{
+  auto hasher = ContentHasher{};
+  for (const auto& point : m_points)
+  {
+    hasher.add(point);
+  }
+  return hasher.add(m_attributes.textureName())
+    .add(m_attributes.offset())
+    .add(m_attributes.scale())
+    .add(m_attributes.rotation())
+    .add(m_attributes.surfaceContents())
+    .add(m_attributes.surfaceFlags())
+    .add(m_attributes.surfaceValue())
+    .add(m_attributes.color())
+    .hash();
+}
+
 std::unique_ptr<TexCoordSystemSnapshot> BrushFace::takeTexCoordSystemSnapshot() const
 {
-  return m_texCoordSystem->takeSnapshot();
+  return texCoordSystem().takeSnapshot();
 }
 
 void BrushFace::restoreTexCoordSystemSnapshot(
   const TexCoordSystemSnapshot& coordSystemSnapshot)
 {
-  coordSystemSnapshot.restore(*m_texCoordSystem);
+  coordSystemSnapshot.restore(mutableTexCoordSystem());
 }
 
 void BrushFace::copyTexCoordSystemFromFace(
@@ -291,14 +327,14 @@ void BrushFace::copyTexCoordSystemFromFace(
   const auto seam = vm::intersect_plane_plane(sourceFacePlane, m_boundary);
   const auto refPoint = vm::project_point(seam, center());
 
-  coordSystemSnapshot.restore(*m_texCoordSystem);
+  coordSystemSnapshot.restore(mutableTexCoordSystem());
 
   // Get the texcoords at the refPoint using the source face's attributes and tex coord
   // system
   const auto desriedCoords =
-    m_texCoordSystem->getTexCoords(refPoint, attributes, vm::vec2f::one());
+    texCoordSystem().getTexCoords(refPoint, attributes, vm::vec2f::one());
 
-  m_texCoordSystem->updateNormal(
+  mutableTexCoordSystem().updateNormal(
     sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
 
   // Adjust the offset on this face so that the texture coordinates at the refPoint stay
@@ -306,7 +342,7 @@ void BrushFace::copyTexCoordSystemFromFace(
   if (!vm::is_zero(seam.direction, vm::C::almost_zero()))
   {
     const auto currentCoords =
-      m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+      texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
     const auto offsetChange = desriedCoords - currentCoords;
     m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
   }
@@ -423,7 +459,8 @@ void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 {
   const float oldRotation = m_attributes.rotation();
   m_attributes = attributes;
-  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  mutableTexCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 bool BrushFace::setAttributes(const BrushFace& other)
@@ -496,15 +533,20 @@ Color BrushFace::resolvedColor() const
 
 void BrushFace::resetTexCoordSystemCache()
 {
-  if (m_texCoordSystem != nullptr)
-  {
-    m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
-  }
+  mutableTexCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
 }
 
 const TexCoordSystem& BrushFace::texCoordSystem() const
 {
-  return *m_texCoordSystem;
+  return std::visit(
+    [](const auto& coordSystem) -> const TexCoordSystem& { return coordSystem; },
+    m_texCoordSystem);
+}
+
+TexCoordSystem& BrushFace::mutableTexCoordSystem()
+{
+  return std::visit(
+    [](auto& coordSystem) -> TexCoordSystem& { return coordSystem; }, m_texCoordSystem);
 }
 
 const Assets::Texture* BrushFace::texture() const
@@ -542,58 +584,59 @@ bool BrushFace::setTexture(Assets::Texture* texture)
 
 vm::vec3 BrushFace::textureXAxis() const
 {
-  return m_texCoordSystem->xAxis();
+  return texCoordSystem().xAxis();
 }
 
 vm::vec3 BrushFace::textureYAxis() const
 {
-  return m_texCoordSystem->yAxis();
+  return texCoordSystem().yAxis();
 }
 
 void BrushFace::resetTextureAxes()
 {
-  m_texCoordSystem->resetTextureAxes(m_boundary.normal);
+  mutableTexCoordSystem().resetTextureAxes(m_boundary.normal);
 }
 
 void BrushFace::resetTextureAxesToParaxial()
 {
-  m_texCoordSystem->resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
+  mutableTexCoordSystem().resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
 }
 
 void BrushFace::convertToParaxial()
 {
   auto [newTexCoordSystem, newAttributes] =
-    m_texCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+    texCoordSystem().toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
 
   m_attributes = newAttributes;
-  m_texCoordSystem = std::move(newTexCoordSystem);
+  m_texCoordSystem = toInlineTexCoordSystem(std::move(newTexCoordSystem));
 }
 
 void BrushFace::convertToParallel()
 {
   auto [newTexCoordSystem, newAttributes] =
-    m_texCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+    texCoordSystem().toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
 
   m_attributes = newAttributes;
-  m_texCoordSystem = std::move(newTexCoordSystem);
+  m_texCoordSystem = toInlineTexCoordSystem(std::move(newTexCoordSystem));
 }
 
 void BrushFace::moveTexture(
   const vm::vec3& up, const vm::vec3& right, const vm::vec2f& offset)
 {
-  m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attributes);
+  texCoordSystem().moveTexture(m_boundary.normal, up, right, offset, m_attributes);
 }
 
 void BrushFace::rotateTexture(const float angle)
 {
   const float oldRotation = m_attributes.rotation();
-  m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attributes);
-  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  texCoordSystem().rotateTexture(m_boundary.normal, angle, m_attributes);
+  mutableTexCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 void BrushFace::shearTexture(const vm::vec2f& factors)
 {
-  m_texCoordSystem->shearTexture(m_boundary.normal, factors);
+  mutableTexCoordSystem().shearTexture(m_boundary.normal, factors);
 }
 
 void BrushFace::flipTexture(
@@ -602,7 +645,7 @@ void BrushFace::flipTexture(
   const vm::direction cameraRelativeFlipDirection)
 {
   const vm::mat4x4 texToWorld =
-    m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
+    texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
 
   const vm::vec3 texUAxisInWorld =
     vm::normalize((texToWorld * vm::vec4d(1, 0, 0, 0)).xyz());
@@ -663,7 +706,7 @@ Result<void> BrushFace::transform(const vm::mat4x4& transform, const bool lockTe
   }
 
   return setPoints(m_points[0], m_points[1], m_points[2]).transform([&]() {
-    m_texCoordSystem->transform(
+    mutableTexCoordSystem().transform(
       oldBoundary,
       m_boundary,
       transform,
@@ -703,15 +746,15 @@ Result<void> BrushFace::updatePointsFromVertices()
         // Get the texcoords at the refPoint using the old face's attribs and tex coord
         // system
         const auto desriedCoords =
-          m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+          texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
 
-        m_texCoordSystem->updateNormal(
+        mutableTexCoordSystem().updateNormal(
           oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
 
         // Adjust the offset on this face so that the texture coordinates at the refPoint
         // stay the same
         const auto currentCoords =
-          m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+          texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
         const auto offsetChange = desriedCoords - currentCoords;
         m_attributes.setOffset(
           correct(modOffset(m_attributes.offset() + offsetChange), 4));
@@ -722,7 +765,7 @@ Result<void> BrushFace::updatePointsFromVertices()
 vm::mat4x4 BrushFace::projectToBoundaryMatrix() const
 {
   const auto texZAxis =
-    m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
+    texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
   const auto worldToPlaneMatrix =
     vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
   const auto [invertible, planeToWorldMatrix] = vm::invert(worldToPlaneMatrix);
@@ -736,11 +779,11 @@ vm::mat4x4 BrushFace::toTexCoordSystemMatrix(
 {
   if (project)
   {
-    return vm::mat4x4::zero_out<2>() * m_texCoordSystem->toMatrix(offset, scale);
+    return vm::mat4x4::zero_out<2>() * texCoordSystem().toMatrix(offset, scale);
   }
   else
   {
-    return m_texCoordSystem->toMatrix(offset, scale);
+    return texCoordSystem().toMatrix(offset, scale);
   }
 }
 
@@ -749,18 +792,18 @@ vm::mat4x4 BrushFace::fromTexCoordSystemMatrix(
 {
   if (project)
   {
-    return projectToBoundaryMatrix() * m_texCoordSystem->fromMatrix(offset, scale);
+    return projectToBoundaryMatrix() * texCoordSystem().fromMatrix(offset, scale);
   }
   else
   {
-    return m_texCoordSystem->fromMatrix(offset, scale);
+    return texCoordSystem().fromMatrix(offset, scale);
   }
 }
 
 float BrushFace::measureTextureAngle(
   const vm::vec2f& center, const vm::vec2f& point) const
 {
-  return m_texCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+  return texCoordSystem().measureAngle(m_attributes.rotation(), center, point);
 }
 
 size_t BrushFace::vertexCount() const
@@ -839,7 +882,7 @@ void BrushFace::deselect()
 
 vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const
 {
-  return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
+  return texCoordSystem().getTexCoords(point, m_attributes, textureSize());
 }
 
 FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const
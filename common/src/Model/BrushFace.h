@@ -24,6 +24,8 @@
 #include "Macros.h"
 #include "Model/BrushFaceAttributes.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
 #include "Model/Tag.h" // BrushFace inherits from Taggable
 #include "Result.h"
 
@@ -35,8 +37,10 @@
 #include <vecmath/vec.h>
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom::Assets
@@ -93,7 +97,12 @@ private:
   BrushFaceAttributes m_attributes;
 
   Assets::AssetReference<Assets::Texture> m_textureReference;
-  std::unique_ptr<TexCoordSystem> m_texCoordSystem;
+
+  /**
+   * The texture coordinate system is stored inline to avoid a heap allocation per face
+   * and the indirection when computing texture coordinates.
+   */
+  std::variant<ParaxialTexCoordSystem, ParallelTexCoordSystem> m_texCoordSystem;
   BrushFaceGeometry* m_geometry;
 
   mutable size_t m_lineNumber;
@@ -179,6 +188,12 @@ public:
 
   static void sortFaces(std::vector<BrushFace>& faces);
 
+  /**
+   * Returns a hash of the points and the attributes of this face. Faces that compare
+   * equal have equal hashes.
+   */
+  std::uint64_t contentHash() const;
+
   std::unique_ptr<TexCoordSystemSnapshot> takeTexCoordSystemSnapshot() const;
   void restoreTexCoordSystemSnapshot(const TexCoordSystemSnapshot& coordSystemSnapshot);
   void copyTexCoordSystemFromFace(
@@ -267,6 +282,8 @@ public:
   FloatType intersectWithRay(const vm::ray3& ray) const;
 
 private:
+  TexCoordSystem& mutableTexCoordSystem();
+
   Result<void> setPoints(
     const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
   void correctPoints();
@@ -91,7 +91,7 @@ void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs)
 
 const std::string& BrushFaceAttributes::textureName() const
 {
-  return m_textureName;
+  return m_textureName.str();
 }
 
 const vm::vec2f& BrushFaceAttributes::offset() const
@@ -173,13 +173,13 @@ bool BrushFaceAttributes::valid() const
 
 bool BrushFaceAttributes::setTextureName(const std::string& textureName)
 {
-  if (textureName == m_textureName)
+  if (m_textureName == textureName)
   {
     return false;
   }
   else
   {
-    m_textureName = textureName;
+    m_textureName = InternedString{textureName};
     return true;
   }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "Model/InternedString.h"
 
 #include <kdl/reflection_decl.h>
 
@@ -45,7 +46,8 @@ public:
   static const std::string NoTextureName;
 
 private:
-  std::string m_textureName;
+  // texture names are interned because most faces of a map share a few textures
+  InternedString m_textureName;
 
   vm::vec2f m_offset;
   vm::vec2f m_scale;
@@ -33,6 +33,7 @@
 #include "Model/LayerNode.h"
 #include "Model/LinkedGroupUtils.h"
 #include "Model/ModelUtils.h"
+#include "Model/NodeAllocator.h"
 #include "Model/PatchNode.h"
 #include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
@@ -78,6 +79,26 @@ BrushNode::BrushNode(Brush brush)
 
 BrushNode::~BrushNode() = default;
 
+namespace
+{
+NodeAllocator& brushNodeAllocator()
+{
+  // leaked so that brush nodes can still be deleted during static destruction
+  static auto* allocator = new NodeAllocator{sizeof(BrushNode), alignof(BrushNode)};
+  return *allocator;
+}
+} // namespace
+
+void* BrushNode::operator new(const std::size_t size)
+{
+  return allocateNode<BrushNode>(brushNodeAllocator(), size);
+}
+
+void BrushNode::operator delete(void* ptr, const std::size_t size)
+{
+  deallocateNode<BrushNode>(brushNodeAllocator(), ptr, size);
+}
+
 const EntityNodeBase* BrushNode::entity() const
 {
   return visitParent(
@@ -287,6 +308,11 @@ const std::string& BrushNode::doGetName() const
   return name;
 }
 
+std::uint64_t BrushNode::doGetContentHash() const
+{
+  return m_brush.contentHash();
+}
+
 const vm::bbox3& BrushNode::doGetLogicalBounds() const
 {
   return m_brush.bounds();
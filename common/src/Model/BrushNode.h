@@ -32,6 +32,7 @@
 
 #include <vecmath/forward.h>
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -76,6 +77,13 @@ public:
   explicit BrushNode(Brush brush);
   ~BrushNode() override;
 
+  /**
+   * Brush nodes are allocated from a pool so that brushes which are created together,
+   * e.g. the brushes of an entity, are close to each other in memory.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
 public:
   EntityNodeBase* entity();
   const EntityNodeBase* entity() const;
@@ -100,6 +108,7 @@ private:
 
 private: // implement Node interface
   const std::string& doGetName() const override;
+  std::uint64_t doGetContentHash() const override;
   const vm::bbox3& doGetLogicalBounds() const override;
   const vm::bbox3& doGetPhysicalBounds() const override;
 
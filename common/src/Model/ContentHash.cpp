@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ContentHash.h"
+
+#include <cstring>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr std::uint64_t Prime = 0x100000001b3u;
+
+std::uint64_t mix(std::uint64_t value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdu;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53u;
+  value ^= value >> 33;
+  return value;
+}
+} // namespace
+
+ContentHasher& ContentHasher::add(const std::uint64_t value)
+{
+  m_hash = (m_hash ^ mix(value)) * Prime;
+  return *this;
+}
+
+ContentHasher& ContentHasher::add(const std::int64_t value)
+{
+  return add(static_cast<std::uint64_t>(value));
+}
+
+ContentHasher& ContentHasher::add(const int value)
+{
+  return add(static_cast<std::int64_t>(value));
+}
+
+ContentHasher& ContentHasher::add(const bool value)
+{
+  return add(static_cast<std::uint64_t>(value ? 1 : 0));
+}
+
+ContentHasher& ContentHasher::add(const double value)
+{
+  // 0.0 and -0.0 compare equal, but have different bit patterns
+  const auto normalized = value == 0.0 ? 0.0 : value;
+
+  auto bits = std::uint64_t{};
+  static_assert(sizeof(bits) == sizeof(normalized));
+  std::memcpy(&bits, &normalized, sizeof(bits));
+  return add(bits);
+}
+
+ContentHasher& ContentHasher::add(const float value)
+{
+  return add(static_cast<double>(value));
+}
+
+ContentHasher& ContentHasher::add(const std::string_view str)
+{
+  // FNV-1a
+  auto hash = std::uint64_t{0xcbf29ce484222325u};
+  for (const auto c : str)
+  {
+    hash = (hash ^ static_cast<unsigned char>(c)) * Prime;
+  }
+  return add(hash).add(static_cast<std::uint64_t>(str.size()));
+}
+
+std::uint64_t ContentHasher::hash() const
+{
+  return mix(m_hash);
+}
+
+UnorderedContentHasher& UnorderedContentHasher::add(const std::uint64_t hash)
+{
+  m_sum += mix(hash);
+  ++m_count;
+  return *this;
+}
+
+std::uint64_t UnorderedContentHasher::hash() const
+{
+  return ContentHasher{}.add(m_sum).add(m_count).hash();
+}
+
+CachedContentHash::CachedContentHash(const CachedContentHash& other) noexcept
+  : m_hash{other.m_hash.load(std::memory_order_relaxed)}
+{
+}
+
+CachedContentHash& CachedContentHash::operator=(const CachedContentHash& other) noexcept
+{
+  m_hash.store(other.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  return *this;
+}
+
+std::optional<std::uint64_t> CachedContentHash::cached() const
+{
+  const auto hash = m_hash.load(std::memory_order_relaxed);
+  return hash != 0 ? std::optional{hash} : std::nullopt;
+}
+
+void CachedContentHash::reset()
+{
+  m_hash.store(0, std::memory_order_relaxed);
+}
+
+} // namespace TrenchBroom::Model
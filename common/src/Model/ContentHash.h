@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace TrenchBroom::Model
+{
+
+/**
+ * Computes a 64 bit hash of the contents of a model object.
+ *
+ * The hash only depends on the values added to it, and not on the standard library's
+ * hash functions, so it is stable across runs and platforms. Values that compare equal
+ * are hashed equally, e.g. 0.0 and -0.0.
+ */
+class ContentHasher
+{
+private:
+  std::uint64_t m_hash = 0xcbf29ce484222325u;
+
+public:
+  ContentHasher& add(std::uint64_t value);
+  ContentHasher& add(std::int64_t value);
+  ContentHasher& add(int value);
+  ContentHasher& add(bool value);
+  ContentHasher& add(double value);
+  ContentHasher& add(float value);
+  ContentHasher& add(std::string_view str);
+
+  template <typename T, std::size_t S>
+  ContentHasher& add(const vm::vec<T, S>& vec)
+  {
+    for (std::size_t i = 0; i < S; ++i)
+    {
+      add(vec[i]);
+    }
+    return *this;
+  }
+
+  template <typename T, std::size_t R, std::size_t C>
+  ContentHasher& add(const vm::mat<T, R, C>& mat)
+  {
+    for (std::size_t i = 0; i < C; ++i)
+    {
+      add(mat[i]);
+    }
+    return *this;
+  }
+
+  template <typename T>
+  ContentHasher& add(const std::optional<T>& value)
+  {
+    add(value.has_value());
+    if (value)
+    {
+      add(*value);
+    }
+    return *this;
+  }
+
+  std::uint64_t hash() const;
+};
+
+/**
+ * Combines the given hashes in a way that does not depend on their order.
+ */
+class UnorderedContentHasher
+{
+private:
+  std::uint64_t m_sum = 0;
+  std::uint64_t m_count = 0;
+
+public:
+  UnorderedContentHasher& add(std::uint64_t hash);
+
+  std::uint64_t hash() const;
+};
+
+/**
+ * Caches the content hash of a model object.
+ *
+ * The hash is computed when it is first requested and kept until it is reset. It may be
+ * requested concurrently from several threads. Copies retain the cached hash because
+ * they have the same contents.
+ */
+class CachedContentHash
+{
+private:
+  // 0 indicates that the hash has not been computed
+  mutable std::atomic<std::uint64_t> m_hash = 0;
+
+public:
+  CachedContentHash() = default;
+  CachedContentHash(const CachedContentHash& other) noexcept;
+  CachedContentHash& operator=(const CachedContentHash& other) noexcept;
+
+  template <typename F>
+  std::uint64_t get(const F& computeHash) const
+  {
+    auto hash = m_hash.load(std::memory_order_relaxed);
+    if (hash == 0)
+    {
+      hash = computeHash();
+      if (hash == 0)
+      {
+        hash = 1;
+      }
+      m_hash.store(hash, std::memory_order_relaxed);
+    }
+    return hash;
+  }
+
+  std::optional<std::uint64_t> cached() const;
+  void reset();
+};
+
+} // namespace TrenchBroom::Model
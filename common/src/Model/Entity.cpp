@@ -21,7 +21,6 @@
 
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityModel.h"
-#include "Assets/ModelDefinition.h"
 #include "Assets/PropertyDefinition.h"
 #include "Model/EntityProperties.h"
 #include "Model/EntityPropertiesVariableStore.h"
@@ -110,6 +109,7 @@ void Entity::setProperties(
   const EntityPropertyConfig& propertyConfig, std::vector<EntityProperty> properties)
 {
   m_properties = std::move(properties);
+  invalidateCachedSpecifications();
   updateCachedProperties(propertyConfig);
 }
 
@@ -121,6 +121,7 @@ const std::vector<std::string>& Entity::protectedProperties() const
 void Entity::setProtectedProperties(std::vector<std::string> protectedProperties)
 {
   m_protectedProperties = std::move(protectedProperties);
+  m_contentHash.reset();
 }
 
 bool Entity::pointEntity() const
@@ -166,6 +167,7 @@ void Entity::setDefinition(
   }
 
   m_definition = Assets::AssetReference{definition};
+  invalidateCachedSpecifications();
   updateCachedProperties(propertyConfig);
 }
 
@@ -188,17 +190,23 @@ void Entity::setModel(
 
 Assets::ModelSpecification Entity::modelSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
-  {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->modelDefinition().modelSpecification(variableStore);
-  }
-  else
+  if (!m_cachedModelSpecification)
   {
-    return Assets::ModelSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointDefinition->modelDefinition().modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = Assets::ModelSpecification{};
+    }
   }
+
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4& Entity::modelTransformation() const
@@ -208,17 +216,23 @@ const vm::mat4x4& Entity::modelTransformation() const
 
 Assets::DecalSpecification Entity::decalSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition().decalSpecification(variableStore);
-  }
-  else
-  {
-    return Assets::DecalSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition().decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = Assets::DecalSpecification{};
+    }
   }
+
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -230,6 +244,7 @@ void Entity::unsetEntityDefinitionAndModel()
 
   m_definition = Assets::AssetReference<Assets::EntityDefinition>{};
   m_model = nullptr;
+  invalidateCachedSpecifications();
   m_cachedProperties.rotation = entityRotation(*this);
   m_cachedProperties.modelTransformation = vm::mat4x4::identity();
 }
@@ -240,6 +255,8 @@ void Entity::addOrUpdateProperty(
   std::string value,
   const bool defaultToProtected)
 {
+  invalidateCachedSpecifications(key);
+
   auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
@@ -284,6 +301,9 @@ void Entity::renameProperty(
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
+
     oldIt->setKey(std::move(newKey));
     updateCachedProperties(propertyConfig);
   }
@@ -295,6 +315,7 @@ void Entity::removeProperty(
   const auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
+    invalidateCachedSpecifications(key);
     m_properties.erase(it);
     updateCachedProperties(propertyConfig);
   }
@@ -308,6 +329,7 @@ void Entity::removeNumberedProperty(
   {
     if (it->hasNumberedPrefix(prefix))
     {
+      invalidateCachedSpecifications(it->key());
       it = m_properties.erase(it);
     }
     else
@@ -430,6 +452,23 @@ void Entity::transform(
   }
 }
 
+std::uint64_t Entity::contentHash() const
+{
+  return m_contentHash.get([&]() {
+    auto hasher = ContentHasher{};
+    for (const auto& property : m_properties)
+    {
+      hasher.add(property.key()).add(property.value());
+    }
+    hasher.add(static_cast<std::uint64_t>(m_properties.size()));
+    for (const auto& key : m_protectedProperties)
+    {
+      hasher.add(key);
+    }
+    return hasher.hash();
+  });
+}
+
 void Entity::applyRotation(
   const EntityPropertyConfig& propertyConfig, const vm::mat4x4& rotation)
 {
@@ -460,6 +499,8 @@ auto parseOrigin(const std::string* str)
 
 void Entity::updateCachedProperties(const EntityPropertyConfig& propertyConfig)
 {
+  m_contentHash.reset();
+
   const auto* classnameValue = property(EntityPropertyKeys::Classname);
   const auto* originValue = property(EntityPropertyKeys::Origin);
 
@@ -487,4 +528,44 @@ void Entity::updateCachedProperties(const EntityPropertyConfig& propertyConfig)
   }
 }
 
+void Entity::invalidateCachedSpecifications()
+{
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
+}
+
+void Entity::invalidateCachedSpecifications(const std::string& key)
+{
+  const auto* pointDefinition =
+    dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get());
+  if (!pointDefinition)
+  {
+    return;
+  }
+
+  const auto readsKey = [&](const auto& variableNames) {
+    return std::binary_search(variableNames.begin(), variableNames.end(), key);
+  };
+
+  if (readsKey(pointDefinition->modelDefinition().variableNames()))
+  {
+    m_cachedModelSpecification = std::nullopt;
+  }
+  if (readsKey(pointDefinition->decalDefinition().variableNames()))
+  {
+    m_cachedDecalSpecification = std::nullopt;
+  }
+}
+
+bool operator==(const Entity& lhs, const Entity& rhs)
+{
+  return lhs.contentHash() == rhs.contentHash() && lhs.properties() == rhs.properties()
+         && lhs.protectedProperties() == rhs.protectedProperties();
+}
+
+bool operator!=(const Entity& lhs, const Entity& rhs)
+{
+  return !(lhs == rhs);
+}
+
 } // namespace TrenchBroom::Model
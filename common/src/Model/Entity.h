@@ -20,7 +20,10 @@
 #pragma once
 
 #include "Assets/AssetReference.h"
+#include "Assets/DecalDefinition.h"
+#include "Assets/ModelDefinition.h"
 #include "FloatType.h"
+#include "Model/ContentHash.h"
 #include "Model/EntityProperties.h"
 
 #include <kdl/reflection_decl.h>
@@ -29,15 +32,15 @@
 #include <vecmath/mat.h>
 #include <vecmath/vec.h>
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom::Assets
 {
-struct DecalSpecification;
 class EntityDefinition;
 class EntityModelFrame;
-struct ModelSpecification;
 } // namespace TrenchBroom::Assets
 
 namespace TrenchBroom::Model
@@ -118,6 +121,15 @@ private:
 
   CachedProperties m_cachedProperties;
 
+  /**
+   * The model and decal specifications are evaluated on demand and cached until one of
+   * the properties read by the respective expression of the entity definition changes.
+   */
+  mutable std::optional<Assets::ModelSpecification> m_cachedModelSpecification;
+  mutable std::optional<Assets::DecalSpecification> m_cachedDecalSpecification;
+
+  CachedContentHash m_contentHash;
+
 public:
   Entity();
   Entity(
@@ -207,11 +219,24 @@ public: // property management
   void transform(
     const EntityPropertyConfig& propertyConfig, const vm::mat4x4& transformation);
 
+  /**
+   * Returns a hash of the properties and the protected properties of this entity.
+   * Entities that compare equal have equal hashes. The hash is cached until the
+   * properties change.
+   */
+  std::uint64_t contentHash() const;
+
 private:
   void applyRotation(
     const EntityPropertyConfig& propertyConfig, const vm::mat4x4& rotation);
 
   void updateCachedProperties(const EntityPropertyConfig& propertyConfig);
+
+  void invalidateCachedSpecifications();
+  void invalidateCachedSpecifications(const std::string& key);
 };
 
+bool operator==(const Entity& lhs, const Entity& rhs);
+bool operator!=(const Entity& lhs, const Entity& rhs);
+
 } // namespace TrenchBroom::Model
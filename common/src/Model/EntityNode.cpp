@@ -26,6 +26,7 @@
 #include "Model/EntityPropertiesVariableStore.h"
 #include "Model/LinkedGroupUtils.h"
 #include "Model/ModelUtils.h"
+#include "Model/NodeAllocator.h"
 #include "Model/PatchNode.h"
 #include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
@@ -65,6 +66,26 @@ EntityNode::EntityNode(
 {
 }
 
+namespace
+{
+NodeAllocator& entityNodeAllocator()
+{
+  // leaked so that entity nodes can still be deleted during static destruction
+  static auto* allocator = new NodeAllocator{sizeof(EntityNode), alignof(EntityNode)};
+  return *allocator;
+}
+} // namespace
+
+void* EntityNode::operator new(const std::size_t size)
+{
+  return allocateNode<EntityNode>(entityNodeAllocator(), size);
+}
+
+void EntityNode::operator delete(void* ptr, const std::size_t size)
+{
+  deallocateNode<EntityNode>(entityNodeAllocator(), ptr, size);
+}
+
 const vm::bbox3& EntityNode::modelBounds() const
 {
   validateBounds();
@@ -31,6 +31,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/util.h>
 
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -68,6 +69,12 @@ public:
     const Model::EntityPropertyConfig& entityPropertyConfig,
     std::initializer_list<EntityProperty> properties);
 
+  /**
+   * Entity nodes are allocated from a pool, see BrushNode.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
 public: // entity model
   const vm::bbox3& modelBounds() const;
   void setModelFrame(const Assets::EntityModelFrame* modelFrame);
@@ -339,6 +339,7 @@ std::vector<std::string> EntityNodeBase::findMissingKillTargets() const
 void EntityNodeBase::findMissingTargets(
   const std::string& prefix, std::vector<std::string>& result) const
 {
+  auto linkTargets = std::vector<EntityNodeBase*>{};
   for (const auto& property : m_entity.numberedProperties(prefix))
   {
     const auto& targetname = property.value();
@@ -348,7 +349,7 @@ void EntityNodeBase::findMissingTargets(
     }
     else
     {
-      auto linkTargets = std::vector<EntityNodeBase*>{};
+      linkTargets.clear();
       findEntityNodesWithProperty(
         EntityPropertyKeys::Targetname, targetname, linkTargets);
       if (linkTargets.empty())
@@ -492,12 +493,13 @@ void EntityNodeBase::addAllLinkSources(const std::string& targetname)
 
 void EntityNodeBase::addAllLinkTargets()
 {
+  auto linkTargets = std::vector<EntityNodeBase*>{};
   for (const auto& property : m_entity.numberedProperties(EntityPropertyKeys::Target))
   {
     const auto& targetname = property.value();
     if (!targetname.empty())
     {
-      auto linkTargets = std::vector<EntityNodeBase*>{};
+      linkTargets.clear();
       findEntityNodesWithProperty(
         EntityPropertyKeys::Targetname, targetname, linkTargets);
       addLinkTargets(linkTargets);
@@ -518,12 +520,13 @@ void EntityNodeBase::addAllKillSources(const std::string& targetname)
 
 void EntityNodeBase::addAllKillTargets()
 {
+  auto killTargets = std::vector<EntityNodeBase*>{};
   for (const auto& property : m_entity.numberedProperties(EntityPropertyKeys::Killtarget))
   {
     const std::string& targetname = property.value();
     if (!targetname.empty())
     {
-      auto killTargets = std::vector<EntityNodeBase*>{};
+      killTargets.clear();
       findEntityNodesWithProperty(
         EntityPropertyKeys::Targetname, targetname, killTargets);
       addKillTargets(killTargets);
@@ -704,6 +707,11 @@ const std::string& EntityNodeBase::doGetName() const
   return m_entity.classname();
 }
 
+std::uint64_t EntityNodeBase::doGetContentHash() const
+{
+  return m_entity.contentHash();
+}
+
 void EntityNodeBase::removeKillTarget(EntityNodeBase* node)
 {
   ensure(node, "node is not null");
@@ -169,6 +169,7 @@ protected:
 
 private: // implemenation of node interface
   const std::string& doGetName() const override;
+  std::uint64_t doGetContentHash() const override;
   void doAncestorWillChange() override;
   void doAncestorDidChange() override;
 
@@ -25,6 +25,7 @@
 #include "Model/EntityProperties.h"
 
 #include <kdl/compact_trie.h>
+#include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
 #include <iterator>
@@ -56,26 +57,52 @@ EntityNodeIndexQuery EntityNodeIndexQuery::any()
   return EntityNodeIndexQuery(Type_Any);
 }
 
-std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
-  const EntityNodeStringIndex& index) const
+std::vector<EntityNodeBase*> EntityNodeIndexQuery::execute(
+  const EntityNodeKeyIndex& index) const
 {
-  std::set<EntityNodeBase*> result;
+  std::vector<EntityNodeBase*> result;
+  const auto addNodes = [&](const auto& nodes) {
+    for (const auto& [node, count] : nodes)
+    {
+      result.push_back(node);
+    }
+  };
+
   switch (m_type)
   {
   case Type_Exact:
-    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
-    break;
+    if (m_key)
+    {
+      if (const auto it = index.find(*m_key); it != std::end(index))
+      {
+        addNodes(it->second);
+      }
+    }
+    // a node occurs only once per key
+    return result;
   case Type_Prefix:
-    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+    for (const auto& [key, nodes] : index)
+    {
+      if (kdl::cs::str_is_prefix(key.str(), m_pattern))
+      {
+        addNodes(nodes);
+      }
+    }
     break;
   case Type_Numbered:
-    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+    for (const auto& [key, nodes] : index)
+    {
+      if (isNumberedProperty(m_pattern, key.str()))
+      {
+        addNodes(nodes);
+      }
+    }
     break;
   case Type_Any:
     break;
     switchDefault();
   }
-  return result;
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
 bool EntityNodeIndexQuery::execute(
@@ -84,7 +111,15 @@ bool EntityNodeIndexQuery::execute(
   switch (m_type)
   {
   case Type_Exact:
-    return node->entity().hasProperty(m_pattern, value);
+  {
+    if (!m_key)
+    {
+      return false;
+    }
+    const auto& properties = node->entity().properties();
+    const auto it = findEntityProperty(properties, *m_key);
+    return it != std::end(properties) && it->hasValue(value);
+  }
   case Type_Prefix:
     return node->entity().hasPropertyWithPrefix(m_pattern, value);
   case Type_Numbered:
@@ -116,12 +151,12 @@ std::vector<Model::EntityProperty> EntityNodeIndexQuery::execute(
 EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& pattern)
   : m_type(type)
   , m_pattern(pattern)
+  , m_key(type == Type_Exact ? InternedString::find(pattern) : std::nullopt)
 {
 }
 
 EntityNodeIndex::EntityNodeIndex()
-  : m_keyIndex(std::make_unique<EntityNodeStringIndex>())
-  , m_valueIndex(std::make_unique<EntityNodeStringIndex>())
+  : m_valueIndex(std::make_unique<EntityNodeStringIndex>())
 {
 }
 
@@ -130,60 +165,85 @@ EntityNodeIndex::~EntityNodeIndex() = default;
 void EntityNodeIndex::addEntityNode(EntityNodeBase* node)
 {
   for (const EntityProperty& property : node->entity().properties())
-    addProperty(node, property.key(), property.value());
+  {
+    addKey(node, property.internedKey());
+    m_valueIndex->insert(property.value(), node);
+  }
 }
 
 void EntityNodeIndex::removeEntityNode(EntityNodeBase* node)
 {
   for (const EntityProperty& property : node->entity().properties())
-    removeProperty(node, property.key(), property.value());
+  {
+    removeKey(node, property.internedKey());
+    m_valueIndex->remove(property.value(), node);
+  }
 }
 
 void EntityNodeIndex::addProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->insert(key, node);
+  addKey(node, InternedString{key});
   m_valueIndex->insert(value, node);
 }
 
 void EntityNodeIndex::removeProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->remove(key, node);
+  // a key that was never interned cannot be in the index
+  if (const auto internedKey = InternedString::find(key))
+  {
+    removeKey(node, *internedKey);
+  }
   m_valueIndex->remove(value, node);
 }
 
-std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
-  const EntityNodeIndexQuery& keyQuery, const std::string& value) const
+void EntityNodeIndex::addKey(EntityNodeBase* node, const InternedString& key)
 {
-  // first, find Nodes which have `value` as the value for any key
-  std::vector<EntityNodeBase*> result;
-  m_valueIndex->find_matches(value, std::back_inserter(result));
-  if (result.empty())
-  {
-    return {};
-  }
-
-  result = kdl::vec_sort_and_remove_duplicates(std::move(result));
+  ++m_keyIndex[key][node];
+}
 
-  // next, remove results from the result set that don't match `keyQuery`
-  auto it = std::begin(result);
-  while (it != std::end(result))
+void EntityNodeIndex::removeKey(EntityNodeBase* node, const InternedString& key)
+{
+  if (auto keyIt = m_keyIndex.find(key); keyIt != std::end(m_keyIndex))
   {
-    const EntityNodeBase* node = *it;
-    if (!keyQuery.execute(node, value))
-      it = result.erase(it);
-    else
-      ++it;
+    auto& nodes = keyIt->second;
+    auto nodeIt = nodes.find(node);
+    if (nodeIt != std::end(nodes) && --nodeIt->second == 0)
+    {
+      nodes.erase(nodeIt);
+      if (nodes.empty())
+      {
+        m_keyIndex.erase(keyIt);
+      }
+    }
   }
+}
 
+void EntityNodeIndex::findEntityNodes(
+  const EntityNodeIndexQuery& keyQuery,
+  const std::string& value,
+  std::vector<EntityNodeBase*>& result) const
+{
+  forEachEntityNode(keyQuery, value, [&](auto* node) { result.push_back(node); });
+}
+
+std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
+  const EntityNodeIndexQuery& keyQuery, const std::string& value) const
+{
+  std::vector<EntityNodeBase*> result;
+  findEntityNodes(keyQuery, value, result);
   return result;
 }
 
 std::vector<std::string> EntityNodeIndex::allKeys() const
 {
   std::vector<std::string> result;
-  m_keyIndex->get_keys(std::back_inserter(result));
+  result.reserve(m_keyIndex.size());
+  for (const auto& [key, nodes] : m_keyIndex)
+  {
+    result.push_back(key.str());
+  }
   return result;
 }
 
@@ -192,7 +252,7 @@ std::vector<std::string> EntityNodeIndex::allValuesForKeys(
 {
   std::vector<std::string> result;
 
-  const std::set<EntityNodeBase*> nameResult = keyQuery.execute(*m_keyIndex);
+  const std::vector<EntityNodeBase*> nameResult = keyQuery.execute(m_keyIndex);
   for (const auto node : nameResult)
   {
     const auto matchingProperties = keyQuery.execute(node);
@@ -19,11 +19,14 @@
 
 #pragma once
 
-#include <kdl/compact_trie_forward.h>
+#include "Model/InternedString.h"
+
+#include <kdl/compact_trie.h>
 
 #include <memory>
-#include <set>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -35,6 +38,13 @@ class EntityProperty;
 
 using EntityNodeStringIndex = kdl::compact_trie<EntityNodeBase*>;
 
+/**
+ * Maps each interned property key to the nodes that have a property with that key, and to
+ * the number of such properties per node.
+ */
+using EntityNodeKeyIndex =
+  std::unordered_map<InternedString, std::unordered_map<EntityNodeBase*, size_t>>;
+
 class EntityNodeIndexQuery
 {
 public:
@@ -49,6 +59,8 @@ public:
 private:
   Type m_type;
   std::string m_pattern;
+  // only set for exact queries whose key was interned, no property can match otherwise
+  std::optional<InternedString> m_key;
 
 public:
   static EntityNodeIndexQuery exact(const std::string& pattern);
@@ -56,7 +68,11 @@ public:
   static EntityNodeIndexQuery numbered(const std::string& pattern);
   static EntityNodeIndexQuery any();
 
-  std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
+  /**
+   * Returns the nodes that have a property with a key matching this query, without
+   * duplicates.
+   */
+  std::vector<EntityNodeBase*> execute(const EntityNodeKeyIndex& index) const;
   bool execute(const EntityNodeBase* node, const std::string& value) const;
   std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
 
@@ -67,7 +83,7 @@ private:
 class EntityNodeIndex
 {
 private:
-  std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
+  EntityNodeKeyIndex m_keyIndex;
   std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
 
 public:
@@ -82,10 +98,39 @@ public:
   void removeProperty(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  /**
+   * Calls the given function for every node that has a property with a key matching the
+   * given query and exactly the given value. Every node is visited once, and no memory is
+   * allocated.
+   */
+  template <typename F>
+  void forEachEntityNode(
+    const EntityNodeIndexQuery& keyQuery, const std::string& value, const F& f) const
+  {
+    m_valueIndex->for_each_value(value, [&](EntityNodeBase* node) {
+      if (keyQuery.execute(node, value))
+      {
+        f(node);
+      }
+    });
+  }
+
+  /**
+   * Appends the nodes that have a property with a key matching the given query and
+   * exactly the given value to the given vector.
+   */
+  void findEntityNodes(
+    const EntityNodeIndexQuery& keyQuery,
+    const std::string& value,
+    std::vector<EntityNodeBase*>& result) const;
   std::vector<EntityNodeBase*> findEntityNodes(
     const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
   std::vector<std::string> allKeys() const;
   std::vector<std::string> allValuesForKeys(const EntityNodeIndexQuery& keyQuery) const;
+
+private:
+  void addKey(EntityNodeBase* node, const InternedString& key);
+  void removeKey(EntityNodeBase* node, const InternedString& key);
 };
 } // namespace Model
 } // namespace TrenchBroom
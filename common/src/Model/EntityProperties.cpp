@@ -25,6 +25,8 @@
 #include <kdl/string_compare.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -86,15 +88,19 @@ kdl_reflect_impl(EntityPropertyConfig);
 
 bool isNumberedProperty(std::string_view prefix, std::string_view key)
 {
-  // %* matches 0 or more digits
-  const std::string pattern = std::string(prefix) + "%*";
-  return kdl::cs::str_matches_glob(key, pattern);
+  // the prefix followed by 0 or more digits, like the glob pattern prefix%*, but without
+  // building the pattern
+  return kdl::cs::str_is_prefix(key, prefix)
+         && std::all_of(
+           std::next(std::begin(key), static_cast<std::ptrdiff_t>(prefix.size())),
+           std::end(key),
+           [](const char c) { return c >= '0' && c <= '9'; });
 }
 
 EntityProperty::EntityProperty() = default;
 
 EntityProperty::EntityProperty(std::string key, std::string value)
-  : m_key{std::move(key)}
+  : m_key{key}
   , m_value{std::move(value)}
 {
 }
@@ -102,6 +108,11 @@ EntityProperty::EntityProperty(std::string key, std::string value)
 kdl_reflect_impl(EntityProperty);
 
 const std::string& EntityProperty::key() const
+{
+  return m_key.str();
+}
+
+const InternedString& EntityProperty::internedKey() const
 {
   return m_key;
 }
@@ -113,7 +124,12 @@ const std::string& EntityProperty::value() const
 
 bool EntityProperty::hasKey(std::string_view key) const
 {
-  return kdl::cs::str_is_equal(m_key, key);
+  return kdl::cs::str_is_equal(m_key.str(), key);
+}
+
+bool EntityProperty::hasKey(const InternedString& key) const
+{
+  return m_key == key;
 }
 
 bool EntityProperty::hasValue(const std::string_view value) const
@@ -128,7 +144,7 @@ bool EntityProperty::hasKeyAndValue(std::string_view key, std::string_view value
 
 bool EntityProperty::hasPrefix(const std::string_view prefix) const
 {
-  return kdl::cs::str_is_prefix(m_key, prefix);
+  return kdl::cs::str_is_prefix(m_key.str(), prefix);
 }
 
 bool EntityProperty::hasPrefixAndValue(
@@ -139,7 +155,7 @@ bool EntityProperty::hasPrefixAndValue(
 
 bool EntityProperty::hasNumberedPrefix(const std::string_view prefix) const
 {
-  return isNumberedProperty(prefix, m_key);
+  return isNumberedProperty(prefix, m_key.str());
 }
 
 bool EntityProperty::hasNumberedPrefixAndValue(
@@ -150,7 +166,7 @@ bool EntityProperty::hasNumberedPrefixAndValue(
 
 void EntityProperty::setKey(std::string key)
 {
-  m_key = std::move(key);
+  m_key = InternedString{key};
 }
 
 void EntityProperty::setValue(std::string value)
@@ -209,6 +225,15 @@ std::vector<EntityProperty>::iterator findEntityProperty(
     });
 }
 
+std::vector<EntityProperty>::const_iterator findEntityProperty(
+  const std::vector<EntityProperty>& properties, const InternedString& key)
+{
+  return std::find_if(
+    std::begin(properties), std::end(properties), [&](const auto& property) {
+      return property.hasKey(key);
+    });
+}
+
 const std::string& findEntityPropertyOrDefault(
   const std::vector<EntityProperty>& properties,
   const std::string& key,
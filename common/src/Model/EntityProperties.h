@@ -20,6 +20,7 @@
 #pragma once
 
 #include "EL/Expression.h"
+#include "Model/InternedString.h"
 
 #include <kdl/reflection_decl.h>
 
@@ -99,7 +100,8 @@ bool isNumberedProperty(std::string_view prefix, std::string_view key);
 class EntityProperty
 {
 private:
-  std::string m_key;
+  // keys are interned because the same few keys are used by all entities of a map
+  InternedString m_key;
   std::string m_value;
 
 public:
@@ -109,9 +111,11 @@ public:
   kdl_reflect_decl(EntityProperty, m_key, m_value);
 
   const std::string& key() const;
+  const InternedString& internedKey() const;
   const std::string& value() const;
 
   bool hasKey(std::string_view key) const;
+  bool hasKey(const InternedString& key) const;
   bool hasValue(std::string_view value) const;
   bool hasKeyAndValue(std::string_view key, std::string_view value) const;
   bool hasPrefix(std::string_view prefix) const;
@@ -131,6 +135,8 @@ std::vector<EntityProperty>::const_iterator findEntityProperty(
   const std::vector<EntityProperty>& properties, const std::string& key);
 std::vector<EntityProperty>::iterator findEntityProperty(
   std::vector<EntityProperty>& properties, const std::string& key);
+std::vector<EntityProperty>::const_iterator findEntityProperty(
+  const std::vector<EntityProperty>& properties, const InternedString& key);
 
 const std::string& findEntityPropertyOrDefault(
   const std::vector<EntityProperty>& properties,
@@ -36,6 +36,7 @@
 #include "IO/DiskIO.h"
 #include "IO/DkmParser.h"
 #include "IO/EntParser.h"
+#include "IO/EntityDefinitionParser.h"
 #include "IO/ExportOptions.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
@@ -415,12 +416,19 @@ Result<std::vector<std::unique_ptr<Assets::EntityDefinition>>> GameImpl::
   const auto extension = path.extension().string();
   const auto& defaultColor = m_config.entityConfig.defaultColor;
 
+  if (
+    auto definitions = IO::EntityDefinitionParser::findCachedDefinitions(
+      status, m_entityDefinitionClassInfoCache, path, defaultColor))
+  {
+    return std::move(*definitions);
+  }
+
   if (kdl::ci::str_is_equal(".fgd", extension))
   {
     return IO::Disk::openFile(path).transform([&](auto file) {
       auto reader = file->reader().buffer();
       auto parser = IO::FgdParser{reader.stringView(), defaultColor, path};
-      return parser.parseDefinitions(status);
+      return parser.parseDefinitions(status, m_entityDefinitionClassInfoCache, path);
     });
   }
   if (kdl::ci::str_is_equal(".def", extension))
@@ -428,7 +436,7 @@ Result<std::vector<std::unique_ptr<Assets::EntityDefinition>>> GameImpl::
     return IO::Disk::openFile(path).transform([&](auto file) {
       auto reader = file->reader().buffer();
       auto parser = IO::DefParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
+      return parser.parseDefinitions(status, m_entityDefinitionClassInfoCache, path);
     });
   }
   if (kdl::ci::str_is_equal(".ent", extension))
@@ -436,7 +444,7 @@ Result<std::vector<std::unique_ptr<Assets::EntityDefinition>>> GameImpl::
     return IO::Disk::openFile(path).transform([&](auto file) {
       auto reader = file->reader().buffer();
       auto parser = IO::EntParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
+      return parser.parseDefinitions(status, m_entityDefinitionClassInfoCache, path);
     });
   }
 
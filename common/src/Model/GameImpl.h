@@ -20,6 +20,7 @@
 #pragma once
 
 #include "FloatType.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 #include "Model/Game.h"
 #include "Model/GameFileSystem.h"
 #include "Result.h"
@@ -51,6 +52,7 @@ private:
   GameFileSystem m_fs;
   std::filesystem::path m_gamePath;
   std::vector<std::filesystem::path> m_additionalSearchPaths;
+  mutable IO::EntityDefinitionClassInfoCache m_entityDefinitionClassInfoCache;
 
 public:
   GameImpl(GameConfig& config, std::filesystem::path gamePath, Logger& logger);
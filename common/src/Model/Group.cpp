@@ -41,6 +41,7 @@ const std::string& Group::name() const
 void Group::setName(std::string name)
 {
   m_name = std::move(name);
+  m_contentHash.reset();
 }
 
 const vm::mat4x4& Group::transformation() const
@@ -51,11 +52,30 @@ const vm::mat4x4& Group::transformation() const
 void Group::setTransformation(const vm::mat4x4& transformation)
 {
   m_transformation = transformation;
+  m_contentHash.reset();
 }
 
 void Group::transform(const vm::mat4x4& transformation)
 {
   m_transformation = transformation * m_transformation;
+  m_contentHash.reset();
+}
+
+std::uint64_t Group::contentHash() const
+{
+  return m_contentHash.get(
+    [&]() { return ContentHasher{}.add(m_name).add(m_transformation).hash(); });
+}
+
+bool operator==(const Group& lhs, const Group& rhs)
+{
+  return lhs.contentHash() == rhs.contentHash() && lhs.name() == rhs.name()
+         && lhs.transformation() == rhs.transformation();
+}
+
+bool operator!=(const Group& lhs, const Group& rhs)
+{
+  return !(lhs == rhs);
 }
 
 } // namespace TrenchBroom::Model
@@ -20,11 +20,13 @@
 #pragma once
 
 #include "FloatType.h"
+#include "Model/ContentHash.h"
 
 #include <kdl/reflection_decl.h>
 
 #include <vecmath/mat.h>
 
+#include <cstdint>
 #include <string>
 
 namespace TrenchBroom::Model
@@ -37,6 +39,8 @@ private:
 
   vm::mat4x4 m_transformation;
 
+  CachedContentHash m_contentHash;
+
   kdl_reflect_decl(Group, m_name, m_transformation);
 
 public:
@@ -48,6 +52,15 @@ public:
   const vm::mat4x4& transformation() const;
   void setTransformation(const vm::mat4x4& transformation);
   void transform(const vm::mat4x4& transformation);
+
+  /**
+   * Returns a hash of the name and the transformation of this group. Groups that compare
+   * equal have equal hashes.
+   */
+  std::uint64_t contentHash() const;
 };
 
+bool operator==(const Group& lhs, const Group& rhs);
+bool operator!=(const Group& lhs, const Group& rhs);
+
 } // namespace TrenchBroom::Model
@@ -160,6 +160,11 @@ const std::string& GroupNode::doGetName() const
   return m_group.name();
 }
 
+std::uint64_t GroupNode::doGetContentHash() const
+{
+  return m_group.contentHash();
+}
+
 const vm::bbox3& GroupNode::doGetLogicalBounds() const
 {
   if (!m_boundsValid)
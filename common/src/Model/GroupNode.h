@@ -98,6 +98,7 @@ private:
 
 private: // implement methods inherited from Node
   const std::string& doGetName() const override;
+  std::uint64_t doGetContentHash() const override;
   const vm::bbox3& doGetLogicalBounds() const override;
   const vm::bbox3& doGetPhysicalBounds() const override;
 
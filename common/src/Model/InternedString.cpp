@@ -0,0 +1,160 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternedString.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+const std::string& emptyString()
+{
+  static const auto empty = std::string{};
+  return empty;
+}
+
+/**
+ * The table is split into shards with their own locks, so that threads interning
+ * different strings rarely wait for each other. Most strings are already interned, so
+ * lookups only take a shared lock.
+ */
+struct InternTableShard
+{
+  std::shared_mutex mutex;
+  // the keys are views of the owned strings, which never move
+  std::unordered_map<std::string_view, std::unique_ptr<const std::string>> table;
+};
+
+constexpr auto InternTableShardCount = size_t(16);
+
+InternTableShard& shardFor(const std::string_view str)
+{
+  static auto shards = std::array<InternTableShard, InternTableShardCount>{};
+  return shards[std::hash<std::string_view>{}(str) % InternTableShardCount];
+}
+
+const std::string* lookup(InternTableShard& shard, const std::string_view str)
+{
+  const auto lock = std::shared_lock{shard.mutex};
+  const auto it = shard.table.find(str);
+  return it != shard.table.end() ? it->second.get() : nullptr;
+}
+
+const std::string* intern(const std::string_view str)
+{
+  if (str.empty())
+  {
+    return &emptyString();
+  }
+
+  auto& shard = shardFor(str);
+  if (const auto* interned = lookup(shard, str))
+  {
+    return interned;
+  }
+
+  const auto lock = std::unique_lock{shard.mutex};
+  auto it = shard.table.find(str);
+  if (it == shard.table.end())
+  {
+    auto interned = std::make_unique<const std::string>(str);
+    const auto key = std::string_view{*interned};
+    it = shard.table.emplace(key, std::move(interned)).first;
+  }
+  return it->second.get();
+}
+} // namespace
+
+InternedString::InternedString()
+  : m_string{&emptyString()}
+{
+}
+
+InternedString::InternedString(const std::string_view str)
+  : m_string{intern(str)}
+{
+}
+
+InternedString::InternedString(const std::string* string)
+  : m_string{string}
+{
+}
+
+std::optional<InternedString> InternedString::find(const std::string_view str)
+{
+  if (str.empty())
+  {
+    return InternedString{};
+  }
+
+  if (const auto* interned = lookup(shardFor(str), str))
+  {
+    return InternedString{interned};
+  }
+  return std::nullopt;
+}
+
+const std::string& InternedString::str() const
+{
+  return *m_string;
+}
+
+bool InternedString::empty() const
+{
+  return m_string->empty();
+}
+
+bool operator==(const InternedString& lhs, const InternedString& rhs)
+{
+  return lhs.m_string == rhs.m_string;
+}
+
+bool operator!=(const InternedString& lhs, const InternedString& rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator==(const InternedString& lhs, const std::string_view rhs)
+{
+  return *lhs.m_string == rhs;
+}
+
+bool operator!=(const InternedString& lhs, const std::string_view rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator<(const InternedString& lhs, const InternedString& rhs)
+{
+  return lhs.m_string != rhs.m_string && *lhs.m_string < *rhs.m_string;
+}
+
+std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs)
+{
+  return lhs << rhs.str();
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom::Model
+{
+
+/**
+ * A handle to a string stored in a global table of interned strings. Equal strings are
+ * stored only once, so copying and comparing handles for equality is as cheap as copying
+ * and comparing a pointer, and the string is shared by all objects that refer to it.
+ *
+ * Interned strings are never released, so this should only be used for strings that are
+ * drawn from a limited vocabulary, such as texture names. Interning is thread safe.
+ */
+class InternedString
+{
+private:
+  const std::string* m_string;
+
+public:
+  /**
+   * Creates a handle to the empty string.
+   */
+  InternedString();
+
+  /**
+   * Interns the given string and creates a handle to it.
+   */
+  explicit InternedString(std::string_view str);
+
+  /**
+   * Returns a handle to the given string if it was interned before, and nothing
+   * otherwise. Unlike the constructor, this never adds the string to the table, so it
+   * should be used to look up strings that are not stored, such as search keys.
+   */
+  static std::optional<InternedString> find(std::string_view str);
+
+  const std::string& str() const;
+  bool empty() const;
+
+  friend bool operator==(const InternedString& lhs, const InternedString& rhs);
+  friend bool operator!=(const InternedString& lhs, const InternedString& rhs);
+  friend bool operator==(const InternedString& lhs, std::string_view rhs);
+  friend bool operator!=(const InternedString& lhs, std::string_view rhs);
+
+  /**
+   * Orders the handles by their strings, not by their addresses.
+   */
+  friend bool operator<(const InternedString& lhs, const InternedString& rhs);
+
+  friend std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs);
+
+private:
+  explicit InternedString(const std::string* string);
+};
+
+} // namespace TrenchBroom::Model
+
+template <>
+struct std::hash<TrenchBroom::Model::InternedString>
+{
+  std::size_t operator()(const TrenchBroom::Model::InternedString& str) const noexcept
+  {
+    // equal strings share their address
+    return std::hash<const std::string*>{}(&str.str());
+  }
+};
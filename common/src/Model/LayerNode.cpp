@@ -20,6 +20,7 @@
 #include "LayerNode.h"
 
 #include "Ensure.h"
+#include "Model/ContentHash.h"
 #include "Model/BrushNode.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityProperties.h"
@@ -35,6 +36,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -89,6 +91,17 @@ const std::string& LayerNode::doGetName() const
   return layer().name();
 }
 
+std::uint64_t LayerNode::doGetContentHash() const
+{
+  return ContentHasher{}
+    .add(m_layer.defaultLayer())
+    .add(m_layer.name())
+    .add(m_layer.hasSortIndex() ? std::optional{m_layer.sortIndex()} : std::nullopt)
+    .add(m_layer.color())
+    .add(m_layer.omitFromExport())
+    .hash();
+}
+
 const vm::bbox3& LayerNode::doGetLogicalBounds() const
 {
   if (!m_boundsValid)
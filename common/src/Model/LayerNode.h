@@ -69,6 +69,7 @@ public:
 
 private: // implement Node interface
   const std::string& doGetName() const override;
+  std::uint64_t doGetContentHash() const override;
   const vm::bbox3& doGetLogicalBounds() const override;
   const vm::bbox3& doGetPhysicalBounds() const override;
   FloatType doGetProjectedArea(vm::axis::type axis) const override;
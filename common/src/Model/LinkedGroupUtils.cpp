@@ -25,6 +25,7 @@
 #include "Model/Node.h"
 #include "Model/NodeContents.h"
 #include "Model/NodeQueries.h"
+#include "Model/TexCoordSystem.h"
 #include "Uuid.h"
 
 #include "kdl/grouped_range.h"
@@ -33,6 +34,9 @@
 #include <kdl/result_fold.h>
 #include <kdl/zip_iterator.h>
 
+#include <algorithm>
+#include <numeric>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 
@@ -203,11 +207,13 @@ namespace
 {
 Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
   const Node* nodeToClone,
-  std::unordered_map<const Node*, NodeContents>& origNodeToTransformedContents,
+  const std::unordered_map<const Node*, size_t>& nodeIndices,
+  std::vector<NodeContents>& transformedContents,
   const vm::bbox3& worldBounds)
 {
   // First, clone `n`, and move in the new (transformed) content which was
   // prepared for it above
+  auto& contents = transformedContents[nodeIndices.at(nodeToClone)].get();
   auto clone = nodeToClone->accept(kdl::overload(
     [](const WorldNode*) -> std::unique_ptr<Node> {
       ensure(false, "Linked group structure is valid");
@@ -216,27 +222,26 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
       ensure(false, "Linked group structure is valid");
     },
     [&](const GroupNode* groupNode) -> std::unique_ptr<Node> {
-      auto& group = std::get<Group>(origNodeToTransformedContents.at(groupNode).get());
-      auto newGroupNode = std::make_unique<GroupNode>(std::move(group));
+      auto newGroupNode =
+        std::make_unique<GroupNode>(std::move(std::get<Group>(contents)));
       newGroupNode->setLinkId(groupNode->linkId());
       return newGroupNode;
     },
     [&](const EntityNode* entityNode) -> std::unique_ptr<Node> {
-      auto& entity = std::get<Entity>(origNodeToTransformedContents.at(entityNode).get());
-      auto newEntityNode = std::make_unique<EntityNode>(std::move(entity));
+      auto newEntityNode =
+        std::make_unique<EntityNode>(std::move(std::get<Entity>(contents)));
       newEntityNode->setLinkId(entityNode->linkId());
       return newEntityNode;
     },
     [&](const BrushNode* brushNode) -> std::unique_ptr<Node> {
-      auto& brush = std::get<Brush>(origNodeToTransformedContents.at(brushNode).get());
-      auto newBrushNode = std::make_unique<BrushNode>(std::move(brush));
+      auto newBrushNode =
+        std::make_unique<BrushNode>(std::move(std::get<Brush>(contents)));
       newBrushNode->setLinkId(brushNode->linkId());
       return newBrushNode;
     },
     [&](const PatchNode* patchNode) -> std::unique_ptr<Node> {
-      auto& patch =
-        std::get<BezierPatch>(origNodeToTransformedContents.at(patchNode).get());
-      auto newPatchNode = std::make_unique<PatchNode>(std::move(patch));
+      auto newPatchNode =
+        std::make_unique<PatchNode>(std::move(std::get<BezierPatch>(contents)));
       newPatchNode->setLinkId(patchNode->linkId());
       return newPatchNode;
     }));
@@ -250,7 +255,10 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
                              nodeToClone->children(),
                              [&](const auto* childNode) {
                                return cloneAndTransformRecursive(
-                                 childNode, origNodeToTransformedContents, worldBounds);
+                                 childNode,
+                                 nodeIndices,
+                                 transformedContents,
+                                 worldBounds);
                              }))
     .transform([&](auto childClones) {
       for (auto& childClone : childClones)
@@ -262,76 +270,6 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
     });
 }
 
-/**
- * Given a node, clones its children recursively and applies the given transform.
- *
- * Returns a vector of the cloned direct children of `node`.
- */
-Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
-  const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
-{
-  auto nodesToClone = collectDescendants(std::vector{&node});
-
-  using TransformResult = Result<std::pair<const Node*, NodeContents>>;
-
-  // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
-  // `nodesToClone`
-  auto transformResults =
-    kdl::vec_parallel_transform(nodesToClone, [&](const Node* nodeToTransform) {
-      return nodeToTransform->accept(kdl::overload(
-        [](const WorldNode*) -> TransformResult {
-          ensure(false, "Linked group structure is valid");
-        },
-        [](const LayerNode*) -> TransformResult {
-          ensure(false, "Linked group structure is valid");
-        },
-        [&](const GroupNode* groupNode) -> TransformResult {
-          auto group = groupNode->group();
-          group.transform(transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-        },
-        [&](const EntityNode* entityNode) -> TransformResult {
-          auto entity = entityNode->entity();
-          entity.transform(entityNode->entityPropertyConfig(), transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-        },
-        [&](const BrushNode* brushNode) -> TransformResult {
-          auto brush = brushNode->brush();
-          return brush.transform(worldBounds, transformation, true)
-            .and_then([&]() -> TransformResult {
-              return std::make_pair(nodeToTransform, NodeContents{std::move(brush)});
-            });
-        },
-        [&](const PatchNode* patchNode) -> TransformResult {
-          auto patch = patchNode->patch();
-          patch.transform(transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-        }));
-    });
-
-  return kdl::fold_results(std::move(transformResults))
-    .or_else(
-      [](const auto&) -> Result<std::vector<std::pair<const Node*, NodeContents>>> {
-        return Error{"Failed to transform a linked node"};
-      })
-    .and_then(
-      [&](auto origNodeAndTransformedContents)
-        -> Result<std::vector<std::unique_ptr<Node>>> {
-        // Move into map for easier lookup
-        auto resultsMap = std::unordered_map<const Node*, NodeContents>{
-          origNodeAndTransformedContents.begin(), origNodeAndTransformedContents.end()};
-        origNodeAndTransformedContents.clear();
-
-        // Do a recursive traversal of the input node tree again,
-        // creating a matching tree structure, and move in the contents
-        // we've transformed above.
-        return kdl::fold_results(
-          kdl::vec_transform(node.children(), [&](const auto* childNode) {
-            return cloneAndTransformRecursive(childNode, resultsMap, worldBounds);
-          }));
-      });
-}
-
 auto makeLinkIdToNodeMap(const std::vector<Node*>& nodes)
 {
   auto result = std::unordered_map<std::string_view, const Node*>{};
@@ -456,6 +394,111 @@ void preserveEntityProperties(
       [](const BrushNode*) {},
       [](const PatchNode*) {}));
 }
+
+/**
+ * Checks whether transforming the given brush would yield the given corresponding brush.
+ *
+ * Only the faces are transformed, which is much cheaper than rebuilding the geometry of
+ * the transformed brush. The faces are transformed in a copy of the brush, which shares
+ * the geometry of the brush, so that texture lock uses the face centers as its invariant
+ * just like Brush::transform does. Since transforming is deterministic, the faces are
+ * equal if the corresponding brush was created by transforming an unchanged brush.
+ */
+bool isTransformedBrush(
+  const Brush& brush, const vm::mat4x4& transformation, const Brush& correspondingBrush)
+{
+  if (brush.faceCount() != correspondingBrush.faceCount())
+  {
+    return false;
+  }
+
+  const auto& correspondingFaces = correspondingBrush.faces();
+
+  // BrushFace::transform never swaps the first point, so we can use it to reject a
+  // changed brush before copying it and transforming its faces
+  if (!std::all_of(brush.faces().begin(), brush.faces().end(), [&](const auto& face) {
+        const auto firstPoint = vm::correct(transformation * face.points()[0]);
+        return std::any_of(
+          correspondingFaces.begin(),
+          correspondingFaces.end(),
+          [&](const auto& correspondingFace) {
+            return correspondingFace.points()[0] == firstPoint;
+          });
+      }))
+  {
+    return false;
+  }
+
+  auto transformedBrush = brush;
+  auto& transformedFaces = transformedBrush.faces();
+  return std::all_of(
+    transformedFaces.begin(), transformedFaces.end(), [&](auto& transformedFace) {
+      return transformedFace.transform(transformation, true).is_success()
+             && std::any_of(
+               correspondingFaces.begin(),
+               correspondingFaces.end(),
+               [&](const auto& correspondingFace) {
+                 return correspondingFace == transformedFace
+                        && correspondingFace.texCoordSystem()
+                             == transformedFace.texCoordSystem();
+               });
+    });
+}
+
+Result<NodeContents> transformNodeContents(
+  const Node& nodeToTransform,
+  const std::unordered_map<std::string_view, const Node*>& correspondingNodes,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
+{
+  return nodeToTransform.accept(kdl::overload(
+    [](const WorldNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [](const LayerNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [&](const GroupNode* groupNode) -> Result<NodeContents> {
+      auto group = groupNode->group();
+      group.transform(transformation);
+      return NodeContents{std::move(group)};
+    },
+    [&](const EntityNode* entityNode) -> Result<NodeContents> {
+      auto entity = entityNode->entity();
+      entity.transform(entityNode->entityPropertyConfig(), transformation);
+      return NodeContents{std::move(entity)};
+    },
+    [&](const BrushNode* brushNode) -> Result<NodeContents> {
+      // reuse the corresponding brush if it is unchanged, which shares its geometry
+      if (
+        const auto* correspondingNode =
+          getCorrespondingNode<BrushNode>(correspondingNodes, brushNode->linkId());
+        correspondingNode
+        && isTransformedBrush(
+          brushNode->brush(), transformation, correspondingNode->brush()))
+      {
+        return NodeContents{correspondingNode->brush()};
+      }
+
+      auto brush = brushNode->brush();
+      return brush.transform(worldBounds, transformation, true)
+        .and_then(
+          [&]() -> Result<NodeContents> { return NodeContents{std::move(brush)}; });
+    },
+    [&](const PatchNode* patchNode) -> Result<NodeContents> {
+      auto patch = patchNode->patch();
+      patch.transform(transformation);
+      return NodeContents{std::move(patch)};
+    }));
+}
+
+struct TargetGroup
+{
+  GroupNode* groupNode;
+  vm::mat4x4 transformation;
+  std::unordered_map<std::string_view, const Node*> linkIdToNodeMap;
+};
+
 } // namespace
 
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
@@ -474,18 +517,72 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const auto _invertedSourceTransformation = invertedSourceTransformation;
   const auto targetGroupNodesToUpdate =
     kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  const auto targetGroups =
+    kdl::vec_parallel_transform(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
+      return TargetGroup{
+        targetGroupNode,
+        targetGroupNode->group().transformation() * _invertedSourceTransformation,
+        makeLinkIdToNodeMap(targetGroupNode->children())};
+    });
+
+  const auto nodesToClone = collectDescendants(std::vector{&sourceGroupNode});
+  auto nodeIndices = std::unordered_map<const Node*, size_t>{};
+  for (size_t i = 0; i < nodesToClone.size(); ++i)
+  {
+    nodeIndices[nodesToClone[i]] = i;
+  }
+
+  // Transform the nodes for all target groups in a single parallel pass so that the work
+  // is balanced regardless of the number of target groups
+  using TransformResult = std::optional<Result<NodeContents>>;
+  auto transformResults = std::vector<std::vector<TransformResult>>(
+    targetGroups.size(), std::vector<TransformResult>(nodesToClone.size()));
+
+  kdl::parallel_for(
+    targetGroups.size() * nodesToClone.size(), [&](const size_t index) {
+      const auto targetIndex = index / nodesToClone.size();
+      const auto nodeIndex = index % nodesToClone.size();
+      const auto& targetGroup = targetGroups[targetIndex];
+
+      transformResults[targetIndex][nodeIndex] = transformNodeContents(
+        *nodesToClone[nodeIndex],
+        targetGroup.linkIdToNodeMap,
+        worldBounds,
+        targetGroup.transformation);
+    });
+
+  // Assemble the new children of each target group in parallel
+  auto targetIndices = std::vector<size_t>(targetGroups.size());
+  std::iota(targetIndices.begin(), targetIndices.end(), 0);
+
   return kdl::fold_results(
-    kdl::vec_transform(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
-      const auto transformation =
-        targetGroupNode->group().transformation() * _invertedSourceTransformation;
-      return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
-        .transform([&](auto newChildren) {
-          const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetGroupNode->children());
-          preserveGroupNames(newChildren, linkIdToNodeMap);
-          preserveEntityProperties(newChildren, linkIdToNodeMap);
-          return std::pair{static_cast<Node*>(targetGroupNode), std::move(newChildren)};
-        });
-    }));
+    kdl::vec_parallel_transform(
+      std::move(targetIndices),
+      [&](const size_t targetIndex) -> Result<UpdateLinkedGroupsResult::value_type> {
+        const auto& targetGroup = targetGroups[targetIndex];
+        return kdl::fold_results(
+                 kdl::vec_transform(
+                   std::move(transformResults[targetIndex]),
+                   [](auto&& transformResult) { return std::move(*transformResult); }))
+          .or_else([](const auto&) -> Result<std::vector<NodeContents>> {
+            return Error{"Failed to transform a linked node"};
+          })
+          .and_then([&](auto transformedContents) {
+            // Do a recursive traversal of the source node tree again, creating a
+            // matching tree structure, and move in the contents we've transformed above.
+            return kdl::fold_results(
+              kdl::vec_transform(sourceGroupNode.children(), [&](const auto* childNode) {
+                return cloneAndTransformRecursive(
+                  childNode, nodeIndices, transformedContents, worldBounds);
+              }));
+          })
+          .transform([&](auto newChildren) {
+            preserveGroupNames(newChildren, targetGroup.linkIdToNodeMap);
+            preserveEntityProperties(newChildren, targetGroup.linkIdToNodeMap);
+            return std::pair{
+              static_cast<Node*>(targetGroup.groupNode), std::move(newChildren)};
+          });
+      }));
 }
 
 namespace
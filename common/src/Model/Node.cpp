@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/ContentHash.h"
 #include "Model/EntityProperties.h"
 #include "Model/Issue.h"
 #include "Model/Validator.h"
@@ -53,6 +54,17 @@ const std::string& Node::name() const
   return doGetName();
 }
 
+std::uint64_t Node::contentHash() const
+{
+  auto hasher = ContentHasher{};
+  hasher.add(doGetContentHash());
+  for (const auto* child : m_children)
+  {
+    hasher.add(child->contentHash());
+  }
+  return hasher.add(static_cast<std::uint64_t>(m_children.size())).hash();
+}
+
 NodePath Node::pathFrom(const Node& ancestor) const
 {
   auto result = NodePath{};
@@ -33,6 +33,7 @@
 #include <vecmath/util.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -135,6 +136,14 @@ public: // getters
    */
   FloatType projectedArea(vm::axis::type axis) const;
 
+  /**
+   * Returns a hash of the contents of this node and of its descendants. Nodes with equal
+   * contents and equal children have equal hashes, so this can be used to detect
+   * whether a subtree has changed. Only the hashes of the node contents are cached, so
+   * this visits all descendants.
+   */
+  std::uint64_t contentHash() const;
+
 public: // cloning and snapshots
   Node* clone(const vm::bbox3& worldBounds, SetLinkId setLinkIds) const;
   Node* cloneRecursively(const vm::bbox3& worldBounds, SetLinkId setLinkIds) const;
@@ -515,6 +524,7 @@ protected: // index management
 
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
+  virtual std::uint64_t doGetContentHash() const = 0;
   virtual const vm::bbox3& doGetLogicalBounds() const = 0;
   virtual const vm::bbox3& doGetPhysicalBounds() const = 0;
 
@@ -0,0 +1,207 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeAllocator.h"
+
+#include "Ensure.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+struct FreeSlot
+{
+  FreeSlot* next;
+};
+
+constexpr std::size_t SlotAlignment = alignof(std::max_align_t);
+
+constexpr std::size_t roundUp(const std::size_t size, const std::size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+/**
+ * The header of a chunk, followed by its slots. Chunks are aligned to their size, so the
+ * chunk of a slot can be found by masking its address.
+ */
+struct NodeAllocator::Chunk
+{
+  Chunk* previous = nullptr;
+  Chunk* next = nullptr;
+  FreeSlot* freeSlots = nullptr;
+  std::size_t usedSlots = 0;
+  bool available = false;
+
+  static constexpr std::size_t headerSize()
+  {
+    return roundUp(sizeof(Chunk), SlotAlignment);
+  }
+
+  static Chunk* of(void* slot)
+  {
+    return reinterpret_cast<Chunk*>(
+      reinterpret_cast<std::uintptr_t>(slot) & ~static_cast<std::uintptr_t>(ChunkSize - 1));
+  }
+
+  std::byte* slots() { return reinterpret_cast<std::byte*>(this) + headerSize(); }
+};
+
+NodeAllocator::NodeAllocator(
+  const std::size_t objectSize, const std::size_t objectAlignment)
+  : m_slotSize{roundUp(std::max(objectSize, sizeof(FreeSlot)), SlotAlignment)}
+  , m_slotsPerChunk{(ChunkSize - Chunk::headerSize()) / m_slotSize}
+{
+  ensure(
+    objectAlignment <= SlotAlignment && (objectAlignment & (objectAlignment - 1)) == 0,
+    "object alignment must be supported");
+  ensure(m_slotsPerChunk > 0, "object must fit into a chunk");
+}
+
+void* NodeAllocator::allocate()
+{
+  const auto lock = std::lock_guard{m_mutex};
+
+  if (!m_availableChunks)
+  {
+    linkChunk(createChunk());
+  }
+
+  auto* chunk = m_availableChunks;
+  auto* slot = chunk->freeSlots;
+  chunk->freeSlots = slot->next;
+  ++chunk->usedSlots;
+  ++m_allocationCount;
+
+  if (!chunk->freeSlots)
+  {
+    unlinkChunk(chunk);
+  }
+
+  return slot;
+}
+
+void NodeAllocator::deallocate(void* ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+
+  const auto lock = std::lock_guard{m_mutex};
+
+  auto* chunk = Chunk::of(ptr);
+  chunk->freeSlots = new (ptr) FreeSlot{chunk->freeSlots};
+  --chunk->usedSlots;
+  --m_allocationCount;
+
+  if (chunk->usedSlots == 0 && m_chunkCount > 1)
+  {
+    // keep the last chunk to avoid creating a chunk for every node if a single node is
+    // created and deleted repeatedly
+    if (chunk->available)
+    {
+      unlinkChunk(chunk);
+    }
+    releaseChunk(chunk);
+  }
+  else if (!chunk->available)
+  {
+    linkChunk(chunk);
+  }
+}
+
+std::size_t NodeAllocator::chunkCount() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_chunkCount;
+}
+
+std::size_t NodeAllocator::allocationCount() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_allocationCount;
+}
+
+std::size_t NodeAllocator::slotsPerChunk() const
+{
+  return m_slotsPerChunk;
+}
+
+NodeAllocator::Chunk* NodeAllocator::createChunk()
+{
+  auto* memory = ::operator new(ChunkSize, std::align_val_t{ChunkSize});
+  auto* chunk = new (memory) Chunk{};
+
+  // thread the free list through the slots in ascending order so that consecutively
+  // allocated objects are adjacent
+  auto* slots = chunk->slots();
+  for (std::size_t i = m_slotsPerChunk; i > 0; --i)
+  {
+    chunk->freeSlots = new (slots + (i - 1) * m_slotSize) FreeSlot{chunk->freeSlots};
+  }
+
+  ++m_chunkCount;
+  return chunk;
+}
+
+void NodeAllocator::releaseChunk(Chunk* chunk)
+{
+  chunk->~Chunk();
+  ::operator delete(chunk, std::align_val_t{ChunkSize});
+  --m_chunkCount;
+}
+
+void NodeAllocator::linkChunk(Chunk* chunk)
+{
+  chunk->previous = nullptr;
+  chunk->next = m_availableChunks;
+  if (m_availableChunks)
+  {
+    m_availableChunks->previous = chunk;
+  }
+  m_availableChunks = chunk;
+  chunk->available = true;
+}
+
+void NodeAllocator::unlinkChunk(Chunk* chunk)
+{
+  if (chunk->previous)
+  {
+    chunk->previous->next = chunk->next;
+  }
+  else
+  {
+    m_availableChunks = chunk->next;
+  }
+  if (chunk->next)
+  {
+    chunk->next->previous = chunk->previous;
+  }
+  chunk->previous = nullptr;
+  chunk->next = nullptr;
+  chunk->available = false;
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace TrenchBroom::Model
+{
+
+/**
+ * Allocates objects of a fixed size from large, aligned chunks of memory.
+ *
+ * Nodes are allocated and deleted individually, but a map contains many of them, and
+ * the general purpose allocator spreads them over the heap and adds bookkeeping to each
+ * one. This allocator packs them into chunks instead, so that nodes which are created
+ * one after the other, e.g. the brushes of an entity when a map is loaded or when an
+ * entity is cloned, end up next to each other in memory.
+ *
+ * Freed slots are reused and a chunk is returned to the system once all of its slots are
+ * free again. Allocation and deallocation are thread safe.
+ *
+ * An allocator must outlive all objects allocated from it. Node types use allocators that
+ * are never destroyed, since nodes may be deleted during static destruction.
+ */
+class NodeAllocator
+{
+private:
+  struct Chunk;
+
+  std::size_t m_slotSize;
+  std::size_t m_slotsPerChunk;
+
+  mutable std::mutex m_mutex;
+  // the chunks that have at least one free slot
+  Chunk* m_availableChunks = nullptr;
+  std::size_t m_chunkCount = 0;
+  std::size_t m_allocationCount = 0;
+
+public:
+  /**
+   * The size of the chunks. Freeing a block of 64 KiB or more makes glibc consolidate its
+   * free lists, which is slow after a large map was deleted, so chunks stay below that.
+   */
+  static constexpr std::size_t ChunkSize = 32 * 1024;
+
+  /**
+   * Creates an allocator for objects with the given size and alignment. The alignment
+   * must be a power of two that is not greater than that of std::max_align_t.
+   */
+  NodeAllocator(std::size_t objectSize, std::size_t objectAlignment);
+
+  /**
+   * Returns an uninitialized slot of the object size passed to the constructor.
+   *
+   * @throws std::bad_alloc if no memory could be allocated
+   */
+  void* allocate();
+
+  /**
+   * Returns the given slot to this allocator. The slot must have been returned by
+   * allocate().
+   */
+  void deallocate(void* ptr);
+
+  /**
+   * Returns the number of chunks currently held by this allocator.
+   */
+  std::size_t chunkCount() const;
+
+  /**
+   * Returns the number of slots that are currently allocated.
+   */
+  std::size_t allocationCount() const;
+
+  /**
+   * Returns the number of slots in each chunk.
+   */
+  std::size_t slotsPerChunk() const;
+
+private:
+  Chunk* createChunk();
+  void releaseChunk(Chunk* chunk);
+  void linkChunk(Chunk* chunk);
+  void unlinkChunk(Chunk* chunk);
+
+  deleteCopyAndMove(NodeAllocator);
+};
+
+/**
+ * Implements the class specific allocation functions of a node type using the given
+ * allocator. Objects of a derived type have a different size and are allocated using the
+ * global allocation functions instead.
+ */
+template <typename T>
+void* allocateNode(NodeAllocator& allocator, const std::size_t size)
+{
+  return size == sizeof(T) ? allocator.allocate() : ::operator new(size);
+}
+
+template <typename T>
+void deallocateNode(NodeAllocator& allocator, void* ptr, const std::size_t size)
+{
+  if (size == sizeof(T))
+  {
+    allocator.deallocate(ptr);
+  }
+  else
+  {
+    ::operator delete(ptr);
+  }
+}
+
+} // namespace TrenchBroom::Model
@@ -32,6 +32,7 @@
 #include <kdl/reflection_impl.h>
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -218,82 +219,42 @@ void NodeCollection::addNode(Node* node)
     }));
 }
 
-static const auto doRemoveNodes = [](
-                                    auto& nodes,
-                                    auto& layers,
-                                    auto& groups,
-                                    auto& entities,
-                                    auto& brushes,
-                                    auto& patches,
-                                    auto cur,
-                                    auto end) {
-  auto nodeEnd = std::end(nodes);
-  auto layerEnd = std::end(layers);
-  auto groupEnd = std::end(groups);
-  auto entityEnd = std::end(entities);
-  auto brushEnd = std::end(brushes);
-  auto patchEnd = std::end(patches);
-
-  while (cur != end)
-  {
-    (*cur)->accept(kdl::overload(
-      [](WorldNode*) {},
-      [&](LayerNode* layer) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, layer);
-        layerEnd = std::remove(std::begin(layers), layerEnd, layer);
-      },
-      [&](GroupNode* group) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, group);
-        groupEnd = std::remove(std::begin(groups), groupEnd, group);
-      },
-      [&](EntityNode* entity) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, entity);
-        entityEnd = std::remove(std::begin(entities), entityEnd, entity);
-      },
-      [&](BrushNode* brush) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, brush);
-        brushEnd = std::remove(std::begin(brushes), brushEnd, brush);
-      },
-      [&](PatchNode* patch) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, patch);
-        patchEnd = std::remove(std::begin(patches), patchEnd, patch);
-      }));
-    ++cur;
-  }
+namespace
+{
+template <typename T, typename P>
+void eraseNodesIf(std::vector<T*>& nodes, const P& pred)
+{
+  nodes.erase(std::remove_if(nodes.begin(), nodes.end(), pred), nodes.end());
+}
+} // namespace
 
-  nodes.erase(nodeEnd, std::end(nodes));
-  layers.erase(layerEnd, std::end(layers));
-  groups.erase(groupEnd, std::end(groups));
-  entities.erase(entityEnd, std::end(entities));
-  brushes.erase(brushEnd, std::end(brushes));
-  patches.erase(patchEnd, std::end(patches));
-};
+template <typename P>
+void NodeCollection::removeNodesIf(const P& pred)
+{
+  eraseNodesIf(m_nodes, pred);
+  eraseNodesIf(m_layers, pred);
+  eraseNodesIf(m_groups, pred);
+  eraseNodesIf(m_entities, pred);
+  eraseNodesIf(m_brushes, pred);
+  eraseNodesIf(m_patches, pred);
+}
 
 void NodeCollection::removeNodes(const std::vector<Node*>& nodes)
 {
-  doRemoveNodes(
-    m_nodes,
-    m_layers,
-    m_groups,
-    m_entities,
-    m_brushes,
-    m_patches,
-    std::begin(nodes),
-    std::end(nodes));
+  if (nodes.empty())
+  {
+    return;
+  }
+
+  // a single pass over the collection instead of one per removed node
+  const auto nodesToRemove = std::unordered_set<const Node*>{nodes.begin(), nodes.end()};
+  removeNodesIf([&](const Node* node) { return nodesToRemove.count(node) > 0; });
 }
 
 void NodeCollection::removeNode(Node* node)
 {
   ensure(node != nullptr, "node is null");
-  doRemoveNodes(
-    m_nodes,
-    m_layers,
-    m_groups,
-    m_entities,
-    m_brushes,
-    m_patches,
-    &node,
-    std::next(&node));
+  removeNodesIf([&](const Node* candidate) { return candidate == node; });
 }
 
 void NodeCollection::clear()
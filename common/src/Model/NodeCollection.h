@@ -90,6 +90,10 @@ public:
   void removeNode(Node* node);
 
   void clear();
+
+private:
+  template <typename P>
+  void removeNodesIf(const P& pred);
 };
 } // namespace Model
 } // namespace TrenchBroom
@@ -49,7 +49,7 @@ private:
   void doRestore(ParaxialTexCoordSystem& coordSystem) const override;
 };
 
-class ParallelTexCoordSystem : public TexCoordSystem
+class ParallelTexCoordSystem final : public TexCoordSystem
 {
 private:
   vm::vec3 m_xAxis;
@@ -133,7 +133,7 @@ private:
     const vm::vec3& point2,
     const BrushFaceAttributes& attribs) const override;
 
-  deleteCopyAndMove(ParallelTexCoordSystem);
+  defineCopyAndMove(ParallelTexCoordSystem);
 };
 } // namespace Model
 } // namespace TrenchBroom
@@ -31,7 +31,7 @@ namespace TrenchBroom
 {
 namespace Model
 {
-class ParaxialTexCoordSystem : public TexCoordSystem
+class ParaxialTexCoordSystem final : public TexCoordSystem
 {
 private:
   static const vm::vec3 BaseAxes[];
@@ -129,8 +129,7 @@ public:
     const vm::vec3& xAxis,
     const vm::vec3& yAxis);
 
-private:
-  deleteCopyAndMove(ParaxialTexCoordSystem);
+  defineCopyAndMove(ParaxialTexCoordSystem);
 };
 } // namespace Model
 } // namespace TrenchBroom
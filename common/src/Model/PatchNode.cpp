@@ -90,7 +90,7 @@ kdl_reflect_impl(PatchGrid);
  * sides of the grid coincide, we treat them as one grid point and average their normals.
  */
 std::vector<vm::vec3> computeGridNormals(
-  const std::vector<BezierPatch::Point> patchGrid,
+  const std::vector<BezierPatch::Point>& patchGrid,
   const size_t pointRowCount,
   const size_t pointColumnCount)
 {
@@ -281,6 +281,8 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
   assert(patchGrid.size() == normals.size());
 
   auto points = std::vector<PatchGrid::Point>{};
+  points.reserve(patchGrid.size());
+
   auto boundsBuilder = vm::bbox3::builder{};
   for (const auto [point, normal] : kdl::make_zip_range(patchGrid, normals))
   {
@@ -359,6 +361,11 @@ const std::string& PatchNode::doGetName() const
   return name;
 }
 
+std::uint64_t PatchNode::doGetContentHash() const
+{
+  return m_patch.contentHash();
+}
+
 const vm::bbox3& PatchNode::doGetLogicalBounds() const
 {
   return m_patch.bounds();
@@ -68,7 +68,7 @@ struct PatchGrid
 
 // public for testing
 std::vector<vm::vec3> computeGridNormals(
-  std::vector<BezierPatch::Point> patchGrid,
+  const std::vector<BezierPatch::Point>& patchGrid,
   size_t pointRowCount,
   size_t pointColumnCount);
 
@@ -99,6 +99,7 @@ public:
 
 private: // implement Node interface
   const std::string& doGetName() const override;
+  std::uint64_t doGetContentHash() const override;
   const vm::bbox3& doGetLogicalBounds() const override;
   const vm::bbox3& doGetPhysicalBounds() const override;
 
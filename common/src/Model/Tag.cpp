@@ -224,6 +224,11 @@ bool Taggable::addTag(const Tag& tag)
 
 bool Taggable::removeTag(const Tag& tag)
 {
+  if (!hasTag(tag))
+  {
+    return false;
+  }
+
   const auto it = m_tags.find(TagReference(tag));
   if (it == std::end(m_tags))
   {
@@ -341,6 +346,11 @@ SmartTag& SmartTag::operator=(const SmartTag& other)
 
 SmartTag& SmartTag::operator=(SmartTag&& other) = default;
 
+const TagMatcher& SmartTag::matcher() const
+{
+  return *m_matcher;
+}
+
 bool SmartTag::matches(const Taggable& taggable) const
 {
   return m_matcher->matches(taggable);
@@ -19,11 +19,18 @@
 
 #include "TagManager.h"
 
+#include "Assets/Texture.h"
 #include "Ensure.h"
+#include "Model/BrushFace.h"
 #include "Model/Tag.h"
+#include "Model/TagMatcher.h"
 #include "Model/TagType.h"
+#include "Model/TagVisitor.h"
+
+#include <kdl/string_compare.h>
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 
@@ -31,6 +38,24 @@ namespace TrenchBroom
 {
 namespace Model
 {
+namespace
+{
+std::uint64_t nextTextureTagCacheKey()
+{
+  // 0 is never used as a key, see Assets::Texture::cachedTagMask
+  static auto nextKey = std::atomic<std::uint64_t>{1};
+  return nextKey++;
+}
+
+class BrushFaceVisitor : public ConstTagVisitor
+{
+public:
+  const BrushFace* face = nullptr;
+
+  void visit(const BrushFace& i_face) override { face = &i_face; }
+};
+} // namespace
+
 bool TagManager::TagCmp::operator()(const SmartTag& lhs, const SmartTag& rhs) const
 {
   return lhs.name() < rhs.name();
@@ -51,6 +76,11 @@ bool TagManager::TagCmp::operator()(const std::string& lhs, const std::string& r
   return lhs < rhs;
 }
 
+TagManager::TagManager()
+  : m_textureTagCacheKey{nextTextureTagCacheKey()}
+{
+}
+
 const std::vector<SmartTag>& TagManager::smartTags() const
 {
   return m_smartTags.get_data();
@@ -110,19 +140,117 @@ void TagManager::registerSmartTags(const std::vector<SmartTag>& tags)
 
     it->setIndex(nextIndex);
   }
+
+  m_faceTags = TagType::NoType;
+  m_textureTags = TagType::NoType;
+  m_textureNamePatterns = TextureNamePatternMatcher{};
+  m_surfaceParmTagPositions.clear();
+  m_textureTagCacheKey = nextTextureTagCacheKey();
+
+  const auto& smartTags = m_smartTags.get_data();
+  for (size_t i = 0; i < smartTags.size(); ++i)
+  {
+    const auto& tag = smartTags[i];
+    if (
+      const auto* nameMatcher =
+        dynamic_cast<const TextureNameTagMatcher*>(&tag.matcher()))
+    {
+      m_textureNamePatterns.addPattern(nameMatcher->pattern(), tag.type());
+      m_textureTags |= tag.type();
+    }
+    else if (dynamic_cast<const SurfaceParmTagMatcher*>(&tag.matcher()))
+    {
+      m_surfaceParmTagPositions.push_back(i);
+      m_textureTags |= tag.type();
+    }
+    else if (dynamic_cast<const FlagsTagMatcher*>(&tag.matcher()))
+    {
+      m_faceTags |= tag.type();
+    }
+  }
+  m_faceTags |= m_textureTags;
 }
 
 void TagManager::clearSmartTags()
 {
   m_smartTags.clear();
+  m_faceTags = TagType::NoType;
+  m_textureTags = TagType::NoType;
+  m_textureNamePatterns = TextureNamePatternMatcher{};
+  m_surfaceParmTagPositions.clear();
+  m_textureTagCacheKey = nextTextureTagCacheKey();
 }
 
 void TagManager::updateTags(Taggable& taggable) const
 {
+  auto visitor = BrushFaceVisitor{};
+  if (m_faceTags != TagType::NoType)
+  {
+    taggable.accept(visitor);
+  }
+
+  // smart tags that only match brush faces never match any other taggable, and the smart
+  // tags that only depend on the texture of a face are matched once per texture
+  const auto precomputedTags = visitor.face ? m_textureTags : m_faceTags;
+  const auto matchingTags = visitor.face && m_textureTags != TagType::NoType
+                              ? textureTags(*visitor.face)
+                              : TagType::NoType;
+
   for (const auto& tag : m_smartTags)
   {
-    tag.update(taggable);
+    const auto matches = (tag.type() & precomputedTags) != 0
+                           ? (tag.type() & matchingTags) != 0
+                           : tag.matches(taggable);
+    if (matches)
+    {
+      taggable.addTag(tag);
+    }
+    else
+    {
+      taggable.removeTag(tag);
+    }
+  }
+}
+
+TagType::Type TagManager::textureTags(const BrushFace& face) const
+{
+  const auto& textureName = face.attributes().textureName();
+  const auto* texture = face.texture();
+
+  // the texture name of a face can differ from the name of its texture until the texture
+  // is updated, so we only use the cache if the names match
+  if (texture && kdl::ci::str_is_equal(texture->name(), textureName))
+  {
+    if (const auto cachedTags = texture->cachedTagMask(m_textureTagCacheKey))
+    {
+      return *cachedTags;
+    }
+
+    const auto tags = textureTags(textureName, texture);
+    texture->setCachedTagMask(m_textureTagCacheKey, tags);
+    return tags;
+  }
+
+  return textureTags(textureName, texture);
+}
+
+TagType::Type TagManager::textureTags(
+  const std::string_view textureName, const Assets::Texture* texture) const
+{
+  auto tags = m_textureNamePatterns.matches(textureName);
+
+  const auto& smartTags = m_smartTags.get_data();
+  for (const auto position : m_surfaceParmTagPositions)
+  {
+    const auto& tag = smartTags[position];
+    const auto& matcher = static_cast<const TextureTagMatcher&>(tag.matcher());
+    if (matcher.matchesTexture(texture))
+    {
+      tags |= tag.type();
+    }
   }
+
+  return tags;
 }
 
 size_t TagManager::freeTagIndex()
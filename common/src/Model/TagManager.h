@@ -20,15 +20,26 @@
 #pragma once
 
 #include "Model/Tag.h"
+#include "Model/TagMatcher.h"
 
 #include <kdl/vector_set.h>
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace TrenchBroom
 {
+namespace Assets
+{
+class Texture;
+}
+
 namespace Model
 {
+class BrushFace;
+
 /**
  * Manages the tags used in a document and updates smart tags on taggable objects.
  */
@@ -45,7 +56,25 @@ private:
 
   kdl::vector_set<SmartTag, TagCmp> m_smartTags;
 
+  /**
+   * The smart tags whose matchers only match brush faces. They are not matched against
+   * any other taggable.
+   */
+  TagType::Type m_faceTags = TagType::NoType;
+
+  /**
+   * Smart tags whose matchers only depend on the texture of a face are not matched
+   * individually. Instead, the texture name patterns are compiled into a single matcher
+   * and the resulting tags are cached on the textures, keyed by m_textureTagCacheKey.
+   */
+  TagType::Type m_textureTags = TagType::NoType;
+  TextureNamePatternMatcher m_textureNamePatterns;
+  std::vector<size_t> m_surfaceParmTagPositions;
+  std::uint64_t m_textureTagCacheKey;
+
 public:
+  TagManager();
+
   /**
    * Returns a vector containing all smart tags registered with this manager.
    */
@@ -115,6 +144,13 @@ public:
   void updateTags(Taggable& taggable) const;
 
 private:
+  /**
+   * Returns the mask of the smart tags that only depend on the texture of the given face
+   * and that match it.
+   */
+  TagType::Type textureTags(const BrushFace& face) const;
+  TagType::Type textureTags(
+    std::string_view textureName, const Assets::Texture* texture) const;
   size_t freeTagIndex();
 };
 } // namespace Model
@@ -39,6 +39,7 @@
 #include <kdl/struct_io.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <ostream>
 #include <vector>
 
@@ -185,6 +186,140 @@ bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) con
   return kdl::ci::str_matches_glob(textureName, m_pattern);
 }
 
+const std::string& TextureNameTagMatcher::pattern() const
+{
+  return m_pattern;
+}
+
+void TextureNamePatternMatcher::Patterns::add(
+  std::string_view pattern, const TagType::Type tags)
+{
+  if (pattern.find_first_of("?%\\") != std::string_view::npos)
+  {
+    globs.emplace_back(pattern, tags);
+    return;
+  }
+
+  auto body = pattern;
+  const auto leadingWildcard = !body.empty() && body.front() == '*';
+  if (leadingWildcard)
+  {
+    body.remove_prefix(1);
+  }
+  const auto trailingWildcard = !body.empty() && body.back() == '*';
+  if (trailingWildcard)
+  {
+    body.remove_suffix(1);
+  }
+
+  if (body.find('*') != std::string_view::npos)
+  {
+    globs.emplace_back(pattern, tags);
+  }
+  else if (leadingWildcard && trailingWildcard)
+  {
+    infixes.emplace_back(body, tags);
+  }
+  else if (leadingWildcard)
+  {
+    suffixes.emplace_back(body, tags);
+  }
+  else if (trailingWildcard)
+  {
+    prefixes.emplace_back(body, tags);
+  }
+  else
+  {
+    const auto it = std::lower_bound(
+      literals.begin(), literals.end(), body, [](const auto& literal, const auto& value) {
+        return kdl::ci::str_compare(std::get<0>(literal), value) < 0;
+      });
+    if (it != literals.end() && kdl::ci::str_is_equal(std::get<0>(*it), body))
+    {
+      std::get<1>(*it) |= tags;
+    }
+    else
+    {
+      literals.emplace(it, body, tags);
+    }
+  }
+}
+
+TagType::Type TextureNamePatternMatcher::Patterns::matches(
+  const std::string_view textureName) const
+{
+  auto result = TagType::NoType;
+
+  const auto it = std::lower_bound(
+    literals.begin(),
+    literals.end(),
+    textureName,
+    [](const auto& literal, const auto& value) {
+      return kdl::ci::str_compare(std::get<0>(literal), value) < 0;
+    });
+  if (it != literals.end() && kdl::ci::str_is_equal(std::get<0>(*it), textureName))
+  {
+    result |= std::get<1>(*it);
+  }
+
+  for (const auto& [prefix, tags] : prefixes)
+  {
+    if (kdl::ci::str_is_prefix(textureName, prefix))
+    {
+      result |= tags;
+    }
+  }
+  for (const auto& [suffix, tags] : suffixes)
+  {
+    if (kdl::ci::str_is_suffix(textureName, suffix))
+    {
+      result |= tags;
+    }
+  }
+  for (const auto& [infix, tags] : infixes)
+  {
+    if (kdl::ci::str_contains(textureName, infix))
+    {
+      result |= tags;
+    }
+  }
+  for (const auto& [glob, tags] : globs)
+  {
+    if (kdl::ci::str_matches_glob(textureName, glob))
+    {
+      result |= tags;
+    }
+  }
+
+  return result;
+}
+
+void TextureNamePatternMatcher::addPattern(
+  const std::string& pattern, const TagType::Type tags)
+{
+  // see TextureNameTagMatcher::matchesTextureName
+  if (pattern.find('/') == std::string::npos)
+  {
+    m_lastComponentPatterns.add(pattern, tags);
+  }
+  else
+  {
+    m_fullNamePatterns.add(pattern, tags);
+  }
+}
+
+TagType::Type TextureNamePatternMatcher::matches(const std::string_view textureName) const
+{
+  auto lastComponent = textureName;
+  if (const auto pos = textureName.find_last_of('/'); pos != std::string_view::npos)
+  {
+    lastComponent = textureName.substr(pos + 1);
+  }
+
+  return m_fullNamePatterns.matches(textureName)
+         | m_lastComponentPatterns.matches(lastComponent);
+}
+
 SurfaceParmTagMatcher::SurfaceParmTagMatcher(const std::string& parameter)
   : m_parameters({parameter})
 {
@@ -30,6 +30,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
@@ -91,7 +92,10 @@ public:
   bool canEnable() const override;
   void appendToStream(std::ostream& str) const override;
 
-private:
+  /**
+   * Indicates whether this matcher matches the given texture. The result only depends on
+   * the texture and can therefore be shared by all faces that use it.
+   */
   virtual bool matchesTexture(const Assets::Texture* texture) const = 0;
 };
 
@@ -106,11 +110,56 @@ public:
   bool matches(const Taggable& taggable) const override;
   void appendToStream(std::ostream& str) const override;
 
+  const std::string& pattern() const;
+
 private:
   bool matchesTexture(const Assets::Texture* texture) const override;
   bool matchesTextureName(std::string_view textureName) const;
 };
 
+/**
+ * Matches a texture name against many texture name patterns at once and returns the
+ * combined tags of all matching patterns. The patterns have the same semantics as in
+ * TextureNameTagMatcher.
+ *
+ * Literal patterns are looked up by binary search, and patterns that only contain a
+ * leading or trailing wildcard are matched by comparing prefixes or suffixes. Only the
+ * remaining patterns are matched as globs.
+ */
+class TextureNamePatternMatcher
+{
+private:
+  using PatternList = std::vector<std::tuple<std::string, TagType::Type>>;
+
+  struct Patterns
+  {
+    // sorted case insensitively
+    PatternList literals;
+    PatternList prefixes;
+    PatternList suffixes;
+    PatternList infixes;
+    PatternList globs;
+
+    void add(std::string_view pattern, TagType::Type tags);
+    TagType::Type matches(std::string_view textureName) const;
+  };
+
+  Patterns m_fullNamePatterns;
+  Patterns m_lastComponentPatterns;
+
+public:
+  /**
+   * Adds the given pattern. If the pattern matches a texture name, the given tags are
+   * added to the result of matches.
+   */
+  void addPattern(const std::string& pattern, TagType::Type tags);
+
+  /**
+   * Returns the combined tags of all patterns that match the given texture name.
+   */
+  TagType::Type matches(std::string_view textureName) const;
+};
+
 class SurfaceParmTagMatcher : public TextureTagMatcher
 {
 private:
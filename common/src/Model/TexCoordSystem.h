@@ -202,7 +202,13 @@ protected:
     return axis / safeScale(T1(factor));
   }
 
-  deleteCopyAndMove(TexCoordSystem);
+  /**
+   * Only the final subclasses can be copied, so a coord system can't be sliced.
+   */
+  TexCoordSystem(const TexCoordSystem& other) = default;
+  TexCoordSystem(TexCoordSystem&& other) noexcept = default;
+  TexCoordSystem& operator=(const TexCoordSystem& other) = default;
+  TexCoordSystem& operator=(TexCoordSystem&& other) = default;
 };
 } // namespace Model
 } // namespace TrenchBroom
@@ -38,8 +38,11 @@
 
 #include <vecmath/bbox_io.h>
 
+#include <cassert>
+#include <exception>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -255,6 +258,50 @@ void WorldNode::rebuildNodeTree()
   }
 }
 
+WorldNode::DeferNodeTreeUpdates::DeferNodeTreeUpdates(WorldNode& worldNode)
+  : m_worldNode{worldNode}
+  , m_wasDeferred{worldNode.m_deferNodeTreeUpdates}
+{
+  m_worldNode.m_deferNodeTreeUpdates = true;
+}
+
+WorldNode::DeferNodeTreeUpdates::~DeferNodeTreeUpdates()
+{
+  assert(
+    m_wasDeferred || std::uncaught_exceptions() > 0
+    || m_worldNode.m_nodesWithDeferredNodeTreeUpdates.empty());
+  m_worldNode.m_deferNodeTreeUpdates = m_wasDeferred;
+}
+
+void WorldNode::DeferNodeTreeUpdates::flush()
+{
+  if (!m_wasDeferred)
+  {
+    m_worldNode.updateDeferredNodes();
+  }
+}
+
+void WorldNode::updateDeferredNodes()
+{
+  if (!m_nodesWithDeferredNodeTreeUpdates.empty())
+  {
+    auto updates = std::vector<std::pair<vm::bbox3, Node*>>{};
+    updates.reserve(m_nodesWithDeferredNodeTreeUpdates.size());
+
+    auto visited = std::unordered_set<Node*>{};
+    for (auto* node : m_nodesWithDeferredNodeTreeUpdates)
+    {
+      if (visited.insert(node).second)
+      {
+        updates.emplace_back(node->physicalBounds(), node);
+      }
+    }
+    m_nodesWithDeferredNodeTreeUpdates.clear();
+
+    m_nodeTree->update_many(updates);
+  }
+}
+
 void WorldNode::invalidateAllIssues()
 {
   accept([](auto&& thisLambda, Node* node) {
@@ -404,6 +451,9 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
 {
   if (m_updateNodeTree)
   {
+    // the removed nodes must not remain in the list of deferred updates
+    updateDeferredNodes();
+
     const auto doRemove = [&](auto* nodeToRemove) {
       if (!m_nodeTree->remove(nodeToRemove))
       {
@@ -431,13 +481,24 @@ void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
 {
   if (m_updateNodeTree)
   {
+    const auto update = [&](auto* nodeToUpdate) {
+      if (m_deferNodeTreeUpdates)
+      {
+        m_nodesWithDeferredNodeTreeUpdates.push_back(nodeToUpdate);
+      }
+      else
+      {
+        m_nodeTree->update(nodeToUpdate->physicalBounds(), nodeToUpdate);
+      }
+    };
+
     node->accept(kdl::overload(
       [](WorldNode*) {},
       [](LayerNode*) {},
       [](GroupNode*) {},
-      [&](EntityNode* entity) { m_nodeTree->update(entity->physicalBounds(), entity); },
-      [&](BrushNode* brush) { m_nodeTree->update(brush->physicalBounds(), brush); },
-      [&](PatchNode* patch) { m_nodeTree->update(patch->physicalBounds(), patch); }));
+      [&](EntityNode* entity) { update(entity); },
+      [&](BrushNode* brush) { update(brush); },
+      [&](PatchNode* patch) { update(patch); }));
   }
 }
 
@@ -483,9 +544,7 @@ void WorldNode::doFindEntityNodesWithProperty(
   const std::string& value,
   std::vector<Model::EntityNodeBase*>& result) const
 {
-  result = kdl::vec_concat(
-    std::move(result),
-    m_entityNodeIndex->findEntityNodes(EntityNodeIndexQuery::exact(name), value));
+  m_entityNodeIndex->findEntityNodes(EntityNodeIndexQuery::exact(name), value, result);
 }
 
 void WorldNode::doFindEntityNodesWithNumberedProperty(
@@ -493,9 +552,8 @@ void WorldNode::doFindEntityNodesWithNumberedProperty(
   const std::string& value,
   std::vector<Model::EntityNodeBase*>& result) const
 {
-  result = kdl::vec_concat(
-    std::move(result),
-    m_entityNodeIndex->findEntityNodes(EntityNodeIndexQuery::numbered(prefix), value));
+  m_entityNodeIndex->findEntityNodes(
+    EntityNodeIndexQuery::numbered(prefix), value, result);
 }
 
 void WorldNode::doAddToIndex(
@@ -59,6 +59,8 @@ private:
   using NodeTree = octree<FloatType, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
+  bool m_deferNodeTreeUpdates = false;
+  std::vector<Node*> m_nodesWithDeferredNodeTreeUpdates;
 
   IdType m_nextPersistentId = 1;
 
@@ -142,7 +144,38 @@ public: // node tree bulk updating
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Defers updating the node tree when the physical bounds of nodes change for as long as
+   * an instance of this class exists. Calling flush() on the outermost instance updates
+   * all changed nodes at once.
+   *
+   * The destructor does not update the node tree, since updating it can throw. If an
+   * instance is destroyed without being flushed, e.g. because an exception is thrown, the
+   * changed nodes are updated by the next flush or when a node is removed.
+   */
+  class DeferNodeTreeUpdates
+  {
+  private:
+    WorldNode& m_worldNode;
+    bool m_wasDeferred;
+
+  public:
+    explicit DeferNodeTreeUpdates(WorldNode& worldNode);
+    ~DeferNodeTreeUpdates();
+
+    /**
+     * Updates the nodes whose physical bounds changed. Does nothing if this instance is
+     * nested in another one, which will update the nodes when it is flushed.
+     *
+     * @throws NodeTreeException if a changed node is not found in the node tree
+     */
+    void flush();
+
+    deleteCopyAndMove(DeferNodeTreeUpdates);
+  };
+
 private:
+  void updateDeferredNodes();
   void invalidateAllIssues();
 
 private: // implement Node interface
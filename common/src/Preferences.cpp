@@ -191,6 +191,8 @@ Preference<bool> EnableMSAA("Renderer/Enable multisampling", true);
 Preference<bool> TextureLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
 
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 1024);
+
 Preference<std::filesystem::path>& RendererFontPath()
 {
   static Preference<std::filesystem::path> fontPath(
@@ -384,6 +386,7 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureMagFilter,
     &TextureLock,
     &UVLock,
+    &UndoMemoryBudget,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
@@ -132,6 +132,12 @@ extern Preference<bool> EnableMSAA;
 extern Preference<bool> TextureLock;
 extern Preference<bool> UVLock;
 
+/**
+ * The maximum memory used by the undo history in MiB, or 0 if the undo history is not
+ * limited.
+ */
+extern Preference<int> UndoMemoryBudget;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
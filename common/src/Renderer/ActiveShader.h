@@ -45,6 +45,12 @@ public:
   {
     m_program.set(name, value);
   }
+
+  template <class T>
+  void setAttribute(const std::string& name, const T& value)
+  {
+    m_program.setAttribute(name, value);
+  }
 };
 } // namespace Renderer
 } // namespace TrenchBroom
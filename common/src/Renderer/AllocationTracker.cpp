@@ -65,6 +65,8 @@ static std::vector<AllocationTracker::Block*>::iterator findFirstLargerOrEqualBi
 void AllocationTracker::unlinkFromBinList(Block* block)
 {
   assert(block->free);
+  assert(m_freeBlockCount > 0);
+  --m_freeBlockCount;
 
   if (block->prevOfSameSize == nullptr)
   {
@@ -118,6 +120,7 @@ void AllocationTracker::linkToBinList(Block* block)
   assert(block->size > 0);
   assert(block->prevOfSameSize == nullptr);
   assert(block->nextOfSameSize == nullptr);
+  ++m_freeBlockCount;
 
   auto it = findFirstLargerOrEqualBin(m_freeBlockSizeBins, block->size);
 
@@ -203,6 +206,10 @@ AllocationTracker::Block* AllocationTracker::allocate(const size_t needed)
 
   block->nextOfSameSize = nullptr;
   block->prevOfSameSize = nullptr;
+  --m_freeBlockCount;
+
+  m_usedSize += needed;
+  ++m_usedBlockCount;
 
   if (block->size == needed)
   {
@@ -257,6 +264,10 @@ void AllocationTracker::free(Block* block)
   assert(block->prevOfSameSize == nullptr);
   assert(block->nextOfSameSize == nullptr);
 
+  assert(m_usedSize >= block->size && m_usedBlockCount > 0);
+  m_usedSize -= block->size;
+  --m_usedBlockCount;
+
   Block* left = block->left;
   Block* right = block->right;
 
@@ -365,6 +376,9 @@ AllocationTracker::AllocationTracker(const Index initial_capacity)
   , m_leftmostBlock(nullptr)
   , m_rightmostBlock(nullptr)
   , m_recycledBlockList(nullptr)
+  , m_usedSize(0)
+  , m_usedBlockCount(0)
+  , m_freeBlockCount(0)
 {
   if (initial_capacity > 0)
   {
@@ -378,6 +392,9 @@ AllocationTracker::AllocationTracker()
   , m_leftmostBlock(nullptr)
   , m_rightmostBlock(nullptr)
   , m_recycledBlockList(nullptr)
+  , m_usedSize(0)
+  , m_usedBlockCount(0)
+  , m_freeBlockCount(0)
 {
 }
 
@@ -486,8 +503,150 @@ bool AllocationTracker::hasAllocations() const
   return false;
 }
 
+double AllocationTracker::Stats::fragmentation() const
+{
+  if (freeSize == 0)
+  {
+    return 0.0;
+  }
+  return 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeSize);
+}
+
+AllocationTracker::Stats AllocationTracker::stats() const
+{
+  return Stats{
+    m_capacity,
+    m_usedSize,
+    m_capacity - m_usedSize,
+    m_usedBlockCount,
+    m_freeBlockCount,
+    largestPossibleAllocation()};
+}
+
+AllocationTracker::Index AllocationTracker::compact(
+  const Index maxMovedSize, const MoveCallback& move)
+{
+  checkInvariants();
+
+  // find the leftmost hole
+  Block* hole = m_leftmostBlock;
+  while (hole != nullptr && !hole->free)
+  {
+    hole = hole->right;
+  }
+
+  Index movedSize = 0;
+
+  // Adjacent free blocks are always merged, so the block to the right of a hole is used.
+  // Swap the hole with that block, then merge the hole with the next hole, if any.
+  while (hole != nullptr && hole->right != nullptr)
+  {
+    Block* block = hole->right;
+    assert(!block->free);
+
+    if (movedSize > 0 && movedSize + block->size > maxMovedSize)
+    {
+      break;
+    }
+
+    Block* left = hole->left;
+    Block* right = block->right;
+    const Index oldPos = block->pos;
+
+    block->pos = hole->pos;
+    block->left = left;
+    block->right = hole;
+    if (left == nullptr)
+    {
+      assert(m_leftmostBlock == hole);
+      m_leftmostBlock = block;
+    }
+    else
+    {
+      left->right = block;
+    }
+
+    // the hole keeps its size, so it stays in its size bin
+    hole->pos = block->pos + block->size;
+    hole->left = block;
+    hole->right = right;
+    if (right == nullptr)
+    {
+      assert(m_rightmostBlock == block);
+      m_rightmostBlock = hole;
+    }
+    else
+    {
+      right->left = hole;
+    }
+
+    move(*block, oldPos);
+    movedSize += block->size;
+
+    if (right != nullptr && right->free)
+    {
+      // keep hole, delete right
+      unlinkFromBinList(hole);
+      unlinkFromBinList(right);
+
+      hole->size += right->size;
+      hole->right = right->right;
+      if (hole->right != nullptr)
+      {
+        hole->right->left = hole;
+      }
+      else
+      {
+        assert(m_rightmostBlock == right);
+        m_rightmostBlock = hole;
+      }
+
+      recycle(right);
+      linkToBinList(hole);
+    }
+  }
+
+  checkInvariants();
+  return movedSize;
+}
+
 // Testing / debugging
 
+AllocationTracker::Range AllocationTracker::usedRange() const
+{
+  if (!hasAllocations())
+  {
+    return Range{0, 0};
+  }
+
+  // adjacent free blocks are always merged, so only the outermost blocks can be free
+  const auto begin = m_leftmostBlock->free ? m_leftmostBlock->size : Index(0);
+  const auto end = m_rightmostBlock->free ? m_rightmostBlock->pos : m_capacity;
+  return Range{begin, end - begin};
+}
+
+std::vector<AllocationTracker::Range> AllocationTracker::usedRanges() const
+{
+  auto result = std::vector<Range>{};
+  auto previousUsed = false;
+  for (Block* block = m_leftmostBlock; block != nullptr; block = block->right)
+  {
+    if (!block->free)
+    {
+      if (previousUsed)
+      {
+        result.back().size += block->size;
+      }
+      else
+      {
+        result.push_back(Range{block->pos, block->size});
+      }
+    }
+    previousUsed = !block->free;
+  }
+  return result;
+}
+
 std::vector<AllocationTracker::Range> AllocationTracker::freeBlocks() const
 {
   kdl::vector_set<Range> res;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace TrenchBroom
@@ -67,6 +68,29 @@ public:
     Block* nextRecycledBlock;
   };
 
+  struct Stats
+  {
+    Index capacity;
+    Index usedSize;
+    Index freeSize;
+    size_t usedBlockCount;
+    size_t freeBlockCount;
+    Index largestFreeBlock;
+
+    /**
+     * Returns the portion of the free space that is not part of the largest free block.
+     * This is 0 if all free space is contiguous and approaches 1 if it is scattered over
+     * many small holes.
+     */
+    double fragmentation() const;
+  };
+
+  /**
+   * Called by compact() for every block it moves, after the block's pos was updated. The
+   * old and the new range of the block may overlap.
+   */
+  using MoveCallback = std::function<void(const Block& block, Index oldPos)>;
+
 private:
   /**
    * Size of memory managed by this AllocationTracker.
@@ -90,6 +114,10 @@ private:
    */
   Block* m_recycledBlockList;
 
+  Index m_usedSize;
+  size_t m_usedBlockCount;
+  size_t m_freeBlockCount;
+
   /**
    * A map from Block size to a linked list of Blocks of that exact size
    * (the linked list is stored in the prevOfSameSize/nextOfSameSize pointers)
@@ -134,6 +162,24 @@ public:
    */
   bool hasAllocations() const;
 
+  /**
+   * Returns statistics about the used and free space. Constant time.
+   */
+  Stats stats() const;
+
+  /**
+   * Closes the holes between the used blocks by moving them towards the start of the
+   * buffer, starting with the leftmost hole. Stops once all used blocks are contiguous or
+   * moving the next block would exceed `maxMovedSize`, but always moves at least one
+   * block if there is a hole. This allows compacting a buffer incrementally.
+   *
+   * The moved blocks keep their identity, so Block pointers held by the caller remain
+   * valid. For each moved block, `move` is called so that the caller can move its data.
+   *
+   * Returns the total size of the moved blocks.
+   */
+  Index compact(Index maxMovedSize, const MoveCallback& move);
+
   // Testing / debugging
 
   class Range
@@ -148,6 +194,18 @@ public:
     bool operator<(const Range& other) const;
   };
 
+  /**
+   * Returns the smallest range that contains all allocations, or an empty range if there
+   * are none. Constant time.
+   */
+  Range usedRange() const;
+
+  /**
+   * Returns the ranges covered by allocations in ascending order. Adjacent allocations
+   * are merged into one range, so the ranges are separated by free blocks. Linear time.
+   */
+  std::vector<Range> usedRanges() const;
+
   std::vector<Range> freeBlocks() const;
   std::vector<Range> usedBlocks() const;
   Index largestPossibleAllocation() const;
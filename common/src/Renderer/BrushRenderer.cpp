@@ -31,6 +31,8 @@
 #include "Renderer/BrushRendererBrushCache.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/parallel.h>
+
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -187,7 +189,7 @@ void BrushRenderer::invalidateBrush(const Model::BrushNode* brushNode)
 
 bool BrushRenderer::valid() const
 {
-  return m_invalidBrushes.empty();
+  return m_invalidBrushes.empty() && m_faceIndicesValid;
 }
 
 void BrushRenderer::clear()
@@ -200,10 +202,13 @@ void BrushRenderer::clear()
   m_edgeIndices = std::make_shared<BrushIndexArray>();
   m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
+  m_transparentFaceIndices = std::make_shared<PackedBrushIndexArray>();
+  m_opaqueFaceIndices = std::make_shared<PackedBrushIndexArray>();
+  m_faceIndicesValid = true;
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
+  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaceIndices, m_faceColor};
   m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
+    FaceRenderer{m_vertexArray, m_transparentFaceIndices, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
@@ -373,23 +378,122 @@ public:
   }
 };
 
+/**
+ * An invalid brush that is being validated. validate() fills this in several passes, some
+ * of which run in parallel.
+ */
+struct BrushRenderer::StagedBrush
+{
+  /**
+   * The faces of the brush with the same texture, given as a range of the cached faces
+   * sorted by texture.
+   */
+  struct TextureFaces
+  {
+    const Assets::Texture* texture;
+    size_t firstFace;
+    size_t endFace;
+    size_t opaqueIndexCount = 0;
+    size_t transparentIndexCount = 0;
+    BrushIndexArray* opaqueIndices = nullptr;
+    AllocationTracker::Block* opaqueIndicesKey = nullptr;
+    BrushIndexArray* transparentIndices = nullptr;
+    AllocationTracker::Block* transparentIndicesKey = nullptr;
+  };
+
+  const Model::BrushNode* brushNode;
+  Filter::EdgeRenderPolicy edgePolicy;
+  size_t edgeIndexCount = 0;
+  std::vector<TextureFaces> textureFaces = {};
+  AllocationTracker::Block* vertexHolderKey = nullptr;
+  AllocationTracker::Block* edgeIndicesKey = nullptr;
+};
+
+// Spawning threads is only worth it for many brushes, e.g. after loading a map.
+static constexpr size_t MinBrushCountForParallelValidation = 256;
+
+template <typename T, typename L>
+static void forEachStagedBrush(std::vector<T>& stagedBrushes, const L& lambda)
+{
+  if (stagedBrushes.size() < MinBrushCountForParallelValidation)
+  {
+    for (auto& stagedBrush : stagedBrushes)
+    {
+      lambda(stagedBrush);
+    }
+  }
+  else
+  {
+    kdl::parallel_for(
+      stagedBrushes.size(), [&](const size_t i) { lambda(stagedBrushes[i]); });
+  }
+}
+
 void BrushRenderer::validate()
 {
   assert(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  // evaluate filter. only evaluate the filter once per brush. The filter may read the
+  // preferences, which is only allowed on the main thread.
+  auto stagedBrushes = std::vector<StagedBrush>{};
+  stagedBrushes.reserve(m_invalidBrushes.size());
+  for (const auto* brushNode : m_invalidBrushes)
   {
-    validateBrush(*brushNode);
+    const auto [facePolicy, edgePolicy] = wrapper.markFaces(*brushNode);
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      // NOTE: skipped brushes are not inserted into m_brushInfo
+      stagedBrushes.push_back(StagedBrush{brushNode, edgePolicy});
+    }
   }
   m_invalidBrushes.clear();
+
+  forEachStagedBrush(
+    stagedBrushes, [&](StagedBrush& stagedBrush) { stageBrush(stagedBrush); });
+
+  // Allocating may grow the VBOs and move their contents, so all blocks must be allocated
+  // before writing to any of them.
+  m_brushInfo.reserve(m_brushInfo.size() + stagedBrushes.size());
+  for (auto& stagedBrush : stagedBrushes)
+  {
+    allocateBrush(stagedBrush);
+  }
+
+  forEachStagedBrush(
+    stagedBrushes, [&](const StagedBrush& stagedBrush) { writeBrush(stagedBrush); });
+
+  compact();
+
+  m_opaqueFaceIndices->update(*m_opaqueFaces);
+  m_transparentFaceIndices->update(*m_transparentFaces);
+  m_faceIndicesValid = true;
   assert(valid());
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
+  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaceIndices, m_faceColor};
   m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
+    FaceRenderer{m_vertexArray, m_transparentFaceIndices, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
+size_t BrushRenderer::faceDrawCallCount() const
+{
+  return m_opaqueFaceIndices->drawCallCount() + m_transparentFaceIndices->drawCallCount();
+}
+
+size_t BrushRenderer::faceDrawRangeCount() const
+{
+  return m_opaqueFaceIndices->rangeCount() + m_transparentFaceIndices->rangeCount();
+}
+
+size_t BrushRenderer::faceIndexCount() const
+{
+  return m_opaqueFaceIndices->indexCount() + m_transparentFaceIndices->indexCount();
+}
+
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
 {
   assert(vertexCount >= 3);
@@ -503,65 +607,30 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
+static BrushIndexArray& findOrCreateIndexArray(
+  TextureToBrushIndicesMap& faceVboMap, const Assets::Texture* texture)
 {
-  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
-  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
-
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
+  auto& holderPtr = faceVboMap[texture];
+  if (holderPtr == nullptr)
   {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
+    // inserts into map!
+    holderPtr = std::make_shared<BrushIndexArray>();
   }
+  return *holderPtr;
+}
 
-  BrushInfo& info = m_brushInfo[&brushNode];
+void BrushRenderer::stageBrush(StagedBrush& stagedBrush) const
+{
+  const auto& brushNode = *stagedBrush.brushNode;
 
-  // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
   brushCache.validateVertexCache(brushNode);
-  const auto& cachedVertices = brushCache.cachedVertices();
-  ensure(!cachedVertices.empty(), "Brush must have cached vertices");
-
-  assert(m_vertexArray != nullptr);
-  auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-  info.vertexHolderKey = vertBlock;
 
-  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+  stagedBrush.edgeIndexCount = countMarkedEdgeIndices(brushNode, stagedBrush.edgePolicy);
 
-  // insert edge indices into VBO
-  {
-    const size_t edgeIndexCount = countMarkedEdgeIndices(brushNode, edgePolicy);
-    if (edgeIndexCount > 0)
-    {
-      auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
-      info.edgeIndicesKey = key;
-      getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
-    }
-    else
-    {
-      // it's possible to have no edges to render
-      // e.g. select all faces of a brush, and the unselected brush renderer
-      // will hit this branch.
-      ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
-    }
-  }
-
-  // insert face indices
-
-  auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
+  const auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
   const size_t facesSortedByTexSize = facesSortedByTex.size();
+  stagedBrush.textureFaces.reserve(facesSortedByTexSize);
 
   size_t nextI;
   for (size_t i = 0; i < facesSortedByTexSize; i = nextI)
@@ -596,74 +665,203 @@ void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
       }
     }
 
-    if (transparentIndexCount > 0)
+    if (opaqueIndexCount > 0 || transparentIndexCount > 0)
     {
-      auto& faceVboMap = *m_transparentFaces;
-      auto& holderPtr = faceVboMap[texture];
-      if (holderPtr == nullptr)
-      {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
-      }
+      stagedBrush.textureFaces.push_back(StagedBrush::TextureFaces{
+        texture, i, nextI, opaqueIndexCount, transparentIndexCount});
+    }
+  }
+}
 
-      auto [key, insertDest] =
-        holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
-      info.transparentFaceIndicesKeys.emplace_back(texture, key);
+void BrushRenderer::allocateBrush(StagedBrush& stagedBrush)
+{
+  assert(m_allBrushes.find(stagedBrush.brushNode) != std::end(m_allBrushes));
+  assert(m_brushInfo.find(stagedBrush.brushNode) == std::end(m_brushInfo));
 
-      // process all faces with this texture (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByTex[j];
-        if (
-          cache.face->isMarked()
-          && shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
+  BrushInfo& info = m_brushInfo[stagedBrush.brushNode];
 
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-      assert(currentDest == (insertDest + transparentIndexCount));
+  const auto& cachedVertices =
+    stagedBrush.brushNode->brushRendererBrushCache().cachedVertices();
+  ensure(!cachedVertices.empty(), "Brush must have cached vertices");
+
+  assert(m_vertexArray != nullptr);
+  stagedBrush.vertexHolderKey = m_vertexArray->allocateVertices(cachedVertices.size());
+  info.vertexHolderKey = stagedBrush.vertexHolderKey;
+
+  if (stagedBrush.edgeIndexCount > 0)
+  {
+    stagedBrush.edgeIndicesKey =
+      m_edgeIndices->allocateElements(stagedBrush.edgeIndexCount);
+    info.edgeIndicesKey = stagedBrush.edgeIndicesKey;
+  }
+  else
+  {
+    // it's possible to have no edges to render
+    // e.g. select all faces of a brush, and the unselected brush renderer
+    // will hit this branch.
+    ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
+  }
+
+  for (auto& textureFaces : stagedBrush.textureFaces)
+  {
+    const auto* texture = textureFaces.texture;
+    if (textureFaces.transparentIndexCount > 0)
+    {
+      textureFaces.transparentIndices =
+        &findOrCreateIndexArray(*m_transparentFaces, texture);
+      textureFaces.transparentIndicesKey =
+        textureFaces.transparentIndices->allocateElements(
+          textureFaces.transparentIndexCount);
+      info.transparentFaceIndicesKeys.emplace_back(
+        texture, textureFaces.transparentIndicesKey);
+    }
+    if (textureFaces.opaqueIndexCount > 0)
+    {
+      textureFaces.opaqueIndices = &findOrCreateIndexArray(*m_opaqueFaces, texture);
+      textureFaces.opaqueIndicesKey =
+        textureFaces.opaqueIndices->allocateElements(textureFaces.opaqueIndexCount);
+      info.opaqueFaceIndicesKeys.emplace_back(texture, textureFaces.opaqueIndicesKey);
     }
+  }
+}
+
+void BrushRenderer::writeBrush(const StagedBrush& stagedBrush) const
+{
+  const auto& brushNode = *stagedBrush.brushNode;
+  const auto& brushCache = brushNode.brushRendererBrushCache();
 
-    if (opaqueIndexCount > 0)
+  // copy vertices
+  const auto& cachedVertices = brushCache.cachedVertices();
+  auto* vertexDest = m_vertexArray->verticesOfBlock(stagedBrush.vertexHolderKey);
+  std::memcpy(
+    vertexDest, cachedVertices.data(), cachedVertices.size() * sizeof(*vertexDest));
+
+  const auto brushVerticesStartIndex =
+    static_cast<GLuint>(stagedBrush.vertexHolderKey->pos);
+
+  // write edge indices
+  if (stagedBrush.edgeIndicesKey != nullptr)
+  {
+    getMarkedEdgeIndices(
+      brushNode,
+      stagedBrush.edgePolicy,
+      brushVerticesStartIndex,
+      m_edgeIndices->elementsOfBlock(stagedBrush.edgeIndicesKey));
+  }
+
+  // write face indices
+  const auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
+  const auto writeFaceIndices = [&](
+                                  const StagedBrush::TextureFaces& textureFaces,
+                                  const bool transparent,
+                                  GLuint* dest,
+                                  const size_t indexCount) {
+    // process all faces with this texture (they'll be consecutive)
+    auto* currentDest = dest;
+    for (size_t j = textureFaces.firstFace; j < textureFaces.endFace; ++j)
     {
-      auto& faceVboMap = *m_opaqueFaces;
-      auto& holderPtr = faceVboMap[texture];
-      if (holderPtr == nullptr)
+      const auto& cache = facesSortedByTex[j];
+      if (
+        cache.face->isMarked()
+        && shouldDrawFaceInTransparentPass(brushNode, *cache.face) == transparent)
       {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
+        addTriIndicesForPolygon(
+          currentDest,
+          static_cast<GLuint>(
+            brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
+          cache.vertexCount);
+
+        currentDest += triIndicesCountForPolygon(cache.vertexCount);
       }
+    }
+    assert(currentDest == (dest + indexCount));
+    unused(indexCount);
+  };
 
-      auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
-      info.opaqueFaceIndicesKeys.emplace_back(texture, key);
+  for (const auto& textureFaces : stagedBrush.textureFaces)
+  {
+    if (textureFaces.transparentIndicesKey != nullptr)
+    {
+      writeFaceIndices(
+        textureFaces,
+        true,
+        textureFaces.transparentIndices->elementsOfBlock(
+          textureFaces.transparentIndicesKey),
+        textureFaces.transparentIndexCount);
+    }
+    if (textureFaces.opaqueIndicesKey != nullptr)
+    {
+      writeFaceIndices(
+        textureFaces,
+        false,
+        textureFaces.opaqueIndices->elementsOfBlock(textureFaces.opaqueIndicesKey),
+        textureFaces.opaqueIndexCount);
+    }
+  }
+}
 
-      // process all faces with this texture (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByTex[j];
-        if (
-          cache.face->isMarked()
-          && !shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
+// Only compact an array if a large part of it is free, but scattered over many holes.
+static constexpr size_t MinFreeSizeForCompaction = 4096;
+static constexpr double MinFragmentationForCompaction = 0.5;
 
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
+// Limits the number of vertices or indices moved per array and validation.
+static constexpr size_t MaxCompactionSize = 1u << 16;
+
+static bool shouldCompact(const AllocationTracker::Stats& stats)
+{
+  return stats.freeSize >= MinFreeSizeForCompaction
+         && stats.freeSize * 4 >= stats.capacity
+         && stats.fragmentation() >= MinFragmentationForCompaction;
+}
+
+void BrushRenderer::compact()
+{
+  if (shouldCompact(m_vertexArray->stats()))
+  {
+    auto brushInfoByVertexBlock =
+      std::unordered_map<const AllocationTracker::Block*, const BrushInfo*>{};
+    brushInfoByVertexBlock.reserve(m_brushInfo.size());
+    for (const auto& [brushNode, info] : m_brushInfo)
+    {
+      brushInfoByVertexBlock.emplace(info.vertexHolderKey, &info);
+    }
+
+    // the indices of a brush refer to its vertices, so they must be moved, too
+    m_vertexArray->compact(MaxCompactionSize, [&](const auto& block, const auto oldPos) {
+      const auto& info = *brushInfoByVertexBlock.at(&block);
+      const auto oldBase = static_cast<GLuint>(oldPos);
+      const auto newBase = static_cast<GLuint>(block.pos);
+
+      if (info.edgeIndicesKey != nullptr)
+      {
+        m_edgeIndices->rebaseElementsOfBlock(info.edgeIndicesKey, oldBase, newBase);
+      }
+      for (const auto& [texture, key] : info.opaqueFaceIndicesKeys)
+      {
+        m_opaqueFaces->at(texture)->rebaseElementsOfBlock(key, oldBase, newBase);
+      }
+      for (const auto& [texture, key] : info.transparentFaceIndicesKeys)
+      {
+        m_transparentFaces->at(texture)->rebaseElementsOfBlock(key, oldBase, newBase);
       }
-      assert(currentDest == (insertDest + opaqueIndexCount));
+    });
+  }
+
+  const auto compactIndices = [](BrushIndexArray& indexArray) {
+    if (shouldCompact(indexArray.stats()))
+    {
+      indexArray.compact(MaxCompactionSize);
     }
+  };
+
+  compactIndices(*m_edgeIndices);
+  for (auto& [texture, indexArray] : *m_opaqueFaces)
+  {
+    compactIndices(*indexArray);
+  }
+  for (auto& [texture, indexArray] : *m_transparentFaces)
+  {
+    compactIndices(*indexArray);
   }
 }
 
@@ -699,12 +897,13 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
 
   if (it == std::end(m_brushInfo))
   {
-    // This means BrushRenderer::validateBrush skipped rendering the brush, so it was
+    // This means BrushRenderer::validate skipped rendering the brush, so it was
     // never uploaded to the VBO's
     return;
   }
 
   const BrushInfo& info = it->second;
+  m_faceIndicesValid = false;
 
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
@@ -34,6 +34,11 @@
 
 namespace TrenchBroom
 {
+namespace Assets
+{
+class Texture;
+}
+
 namespace Model
 {
 class BrushNode;
@@ -155,6 +160,12 @@ private:
   std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
   std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
 
+  // the face indices of all textures packed into one buffer each, updated in validate()
+  std::shared_ptr<PackedBrushIndexArray> m_transparentFaceIndices;
+  std::shared_ptr<PackedBrushIndexArray> m_opaqueFaceIndices;
+  // false if face indices were removed since the packed arrays were last updated
+  bool m_faceIndicesValid;
+
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
@@ -295,10 +306,53 @@ public:
    */
   void validate();
 
+  /**
+   * Returns the number of draw calls issued per frame to render the faces in both the
+   * opaque and the transparent pass. Only exposed for benchmarking.
+   */
+  size_t faceDrawCallCount() const;
+
+  /**
+   * Returns the number of index ranges rendered per frame for the faces in both the
+   * opaque and the transparent pass. Each draw call renders one or more ranges. Only
+   * exposed for benchmarking.
+   */
+  size_t faceDrawRangeCount() const;
+
+  /**
+   * Returns the number of indices rendered per frame for the faces in both the opaque and
+   * the transparent pass. Only exposed for benchmarking.
+   */
+  size_t faceIndexCount() const;
+
 private:
+  struct StagedBrush;
+
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
-  void validateBrush(const Model::BrushNode& brushNode);
+
+  /**
+   * Validates the vertex cache of the given brush and counts its indices. Called for
+   * several brushes in parallel.
+   */
+  void stageBrush(StagedBrush& stagedBrush) const;
+
+  /**
+   * Allocates the blocks of the given brush in the VBOs and records them in m_brushInfo.
+   */
+  void allocateBrush(StagedBrush& stagedBrush);
+
+  /**
+   * Writes the vertices and indices of the given brush into its allocated blocks. Called
+   * for several brushes in parallel.
+   */
+  void writeBrush(const StagedBrush& stagedBrush) const;
+
+  /**
+   * Incrementally compacts the vertex and index arrays once they are fragmented, e.g. by
+   * a long editing session. Without this, the arrays only ever grow.
+   */
+  void compact();
 
 public:
   /**
@@ -19,10 +19,13 @@
 
 #include "Renderer/BrushRendererArrays.h"
 
+#include "Macros.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace TrenchBroom
 {
@@ -72,6 +75,18 @@ void DirtyRangeTracker::markDirty(const size_t pos, const size_t size)
     throw std::invalid_argument("markDirty provided range out of bounds");
   }
 
+  if (size == 0)
+  {
+    return;
+  }
+
+  if (clean())
+  {
+    m_dirtyPos = pos;
+    m_dirtySize = size;
+    return;
+  }
+
   const size_t newPos = std::min(pos, m_dirtyPos);
   const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
 
@@ -123,6 +138,8 @@ VertexArrayInterface::~VertexArrayInterface() {}
 BrushIndexArray::BrushIndexArray()
   : m_indexHolder()
   , m_allocationTracker(0)
+  , m_validIndexCount(0)
+  , m_version(0)
 {
 }
 
@@ -134,25 +151,36 @@ bool BrushIndexArray::hasValidIndices() const
 std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::
   getPointerToInsertElementsAt(const size_t elementCount)
 {
-  auto block = m_allocationTracker.allocate(elementCount);
-  if (block != nullptr)
+  auto* block = allocateElements(elementCount);
+  return {block, elementsOfBlock(block)};
+}
+
+AllocationTracker::Block* BrushIndexArray::allocateElements(const size_t elementCount)
+{
+  m_validIndexCount += elementCount;
+  ++m_version;
+
+  auto* block = m_allocationTracker.allocate(elementCount);
+  if (block == nullptr)
   {
-    GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
-    return {block, dest};
+    // retry
+    const size_t newSize = std::max(
+      2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + elementCount);
+    m_allocationTracker.expand(newSize);
+    m_indexHolder.resize(newSize);
+
+    // insert again
+    block = m_allocationTracker.allocate(elementCount);
+    assert(block != nullptr);
   }
 
-  // retry
-  const size_t newSize = std::max(
-    2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + elementCount);
-  m_allocationTracker.expand(newSize);
-  m_indexHolder.resize(newSize);
-
-  // insert again
-  block = m_allocationTracker.allocate(elementCount);
-  assert(block != nullptr);
+  m_indexHolder.markDirty(block->pos, elementCount);
+  return block;
+}
 
-  GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
-  return {block, dest};
+GLuint* BrushIndexArray::elementsOfBlock(const AllocationTracker::Block* key)
+{
+  return m_indexHolder.elements() + key->pos;
 }
 
 void BrushIndexArray::zeroElementsWithKey(AllocationTracker::Block* key)
@@ -162,6 +190,95 @@ void BrushIndexArray::zeroElementsWithKey(AllocationTracker::Block* key)
   m_allocationTracker.free(key);
 
   m_indexHolder.zeroRange(pos, size);
+
+  m_validIndexCount -= size;
+  ++m_version;
+}
+
+size_t BrushIndexArray::capacity() const
+{
+  return m_allocationTracker.capacity();
+}
+
+size_t BrushIndexArray::validIndexCount() const
+{
+  return m_validIndexCount;
+}
+
+size_t BrushIndexArray::version() const
+{
+  return m_version;
+}
+
+AllocationTracker::Range BrushIndexArray::usedRange() const
+{
+  return m_allocationTracker.usedRange();
+}
+
+std::vector<AllocationTracker::Range> BrushIndexArray::usedRanges() const
+{
+  return m_allocationTracker.usedRanges();
+}
+
+size_t BrushIndexArray::copyValidIndices(GLuint* dest) const
+{
+  auto count = size_t(0);
+  for (const auto& block : m_allocationTracker.usedBlocks())
+  {
+    std::copy_n(m_indexHolder.elements() + block.pos, block.size, dest + count);
+    count += block.size;
+  }
+  return count;
+}
+
+void BrushIndexArray::rebaseElementsOfBlock(
+  const AllocationTracker::Block* key, const GLuint oldBase, const GLuint newBase)
+{
+  auto* dest = m_indexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+  for (size_t i = 0; i < key->size; ++i)
+  {
+    dest[i] = dest[i] - oldBase + newBase;
+  }
+  ++m_version;
+}
+
+AllocationTracker::Stats BrushIndexArray::stats() const
+{
+  return m_allocationTracker.stats();
+}
+
+size_t BrushIndexArray::compact(const size_t maxIndexCount)
+{
+  const auto movedIndexCount = m_allocationTracker.compact(
+    maxIndexCount, [&](const auto& block, const auto oldPos) {
+      auto* elements = m_indexHolder.elements();
+      std::memmove(
+        elements + block.pos, elements + oldPos, block.size * sizeof(*elements));
+      m_indexHolder.markDirty(block.pos, block.size);
+
+      // the vacated part of the old range must not be rendered
+      const auto vacatedPos = std::max(block.pos + block.size, oldPos);
+      m_indexHolder.zeroRange(vacatedPos, oldPos + block.size - vacatedPos);
+    });
+
+  if (movedIndexCount > 0)
+  {
+    ++m_version;
+  }
+  return movedIndexCount;
+}
+
+void BrushIndexArray::uploadIndices(Vbo& vbo, const size_t offset, const bool all)
+{
+  const auto& dirtyRange = m_indexHolder.dirtyRange();
+  const auto pos = all ? size_t(0) : dirtyRange.m_dirtyPos;
+  const auto count = all ? m_indexHolder.size() : dirtyRange.m_dirtySize;
+  if (count > 0)
+  {
+    vbo.writeArray(
+      (offset + pos) * sizeof(GLuint), m_indexHolder.elements() + pos, count);
+  }
+  m_indexHolder.markClean();
 }
 
 void BrushIndexArray::render(const PrimType primType) const
@@ -191,6 +308,198 @@ void BrushIndexArray::cleanupIndices()
   m_indexHolder.unbindBlock();
 }
 
+// PackedBrushIndexArray
+
+PackedBrushIndexArray::PackedBrushIndexArray() = default;
+
+PackedBrushIndexArray::~PackedBrushIndexArray()
+{
+  if (m_vbo != nullptr)
+  {
+    m_vboManager->destroyVbo(m_vbo);
+  }
+}
+
+void PackedBrushIndexArray::update(const TextureToBrushIndicesMap& indexArrays)
+{
+  if (!layoutValid(indexArrays))
+  {
+    layout(indexArrays);
+  }
+
+  // only the commands of the arrays that have changed are updated
+  for (size_t i = 0; i < m_slots.size(); ++i)
+  {
+    auto& slot = m_slots[i];
+    if (slot.version != slot.indexArray->version())
+    {
+      slot.version = slot.indexArray->version();
+
+      auto drawCommand = DrawCommand{slot.texture, slot.indexArray->usedRanges(), {}, {}};
+      for (auto& range : drawCommand.ranges)
+      {
+        range.pos += slot.offset;
+        drawCommand.counts.push_back(static_cast<GLsizei>(range.size));
+        drawCommand.offsets.push_back(
+          reinterpret_cast<const GLvoid*>(sizeof(GLuint) * range.pos));
+      }
+      m_drawCommands[i] = std::move(drawCommand);
+      m_prepared = false;
+    }
+  }
+}
+
+const std::vector<PackedBrushIndexArray::DrawCommand>& PackedBrushIndexArray::
+  drawCommands() const
+{
+  return m_drawCommands;
+}
+
+size_t PackedBrushIndexArray::indexCount() const
+{
+  auto result = size_t(0);
+  for (const auto& drawCommand : m_drawCommands)
+  {
+    for (const auto& range : drawCommand.ranges)
+    {
+      result += range.size;
+    }
+  }
+  return result;
+}
+
+size_t PackedBrushIndexArray::drawCallCount() const
+{
+  return size_t(std::count_if(
+    m_drawCommands.begin(), m_drawCommands.end(), [](const auto& drawCommand) {
+      return !drawCommand.ranges.empty();
+    }));
+}
+
+size_t PackedBrushIndexArray::rangeCount() const
+{
+  auto result = size_t(0);
+  for (const auto& drawCommand : m_drawCommands)
+  {
+    result += drawCommand.ranges.size();
+  }
+  return result;
+}
+
+void PackedBrushIndexArray::render(
+  const PrimType primType, const DrawCommand& drawCommand) const
+{
+  assert(prepared());
+
+  // the offsets are relative to the start of the buffer, which is never a block of a
+  // streaming buffer
+  assert(m_vbo->offset() == 0);
+
+  const auto& counts = drawCommand.counts;
+  const auto& offsets = drawCommand.offsets;
+  if (counts.size() > 1 && GLEW_VERSION_1_4)
+  {
+    glAssert(glMultiDrawElements(
+      toGL(primType),
+      counts.data(),
+      glType<GLuint>(),
+      offsets.data(),
+      static_cast<GLsizei>(counts.size())));
+  }
+  else
+  {
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+      glAssert(glDrawElements(toGL(primType), counts[i], glType<GLuint>(), offsets[i]));
+    }
+  }
+}
+
+bool PackedBrushIndexArray::prepared() const
+{
+  return m_prepared;
+}
+
+void PackedBrushIndexArray::prepare(VboManager& vboManager)
+{
+  if (m_prepared)
+  {
+    return;
+  }
+
+  // the buffer never shrinks, the unused space at the end is not rendered
+  const auto capacity = m_size * sizeof(GLuint);
+  const auto reallocate = m_vbo == nullptr || m_vbo->capacity() < capacity;
+  if (reallocate)
+  {
+    if (m_vbo != nullptr)
+    {
+      m_vboManager->destroyVbo(m_vbo);
+    }
+    m_vboManager = &vboManager;
+    m_vbo = m_vboManager->allocateVbo(
+      VboType::ElementArrayBuffer, capacity, VboUsage::DynamicDraw);
+  }
+
+  for (auto& slot : m_slots)
+  {
+    slot.indexArray->uploadIndices(*m_vbo, slot.offset, reallocate || !slot.uploaded);
+    slot.uploaded = true;
+  }
+
+  m_prepared = true;
+}
+
+void PackedBrushIndexArray::setupIndices()
+{
+  m_vbo->bind();
+}
+
+void PackedBrushIndexArray::cleanupIndices()
+{
+  m_vbo->unbind();
+}
+
+bool PackedBrushIndexArray::layoutValid(const TextureToBrushIndicesMap& indexArrays) const
+{
+  if (m_slots.size() != indexArrays.size())
+  {
+    return false;
+  }
+
+  for (const auto& slot : m_slots)
+  {
+    const auto it = indexArrays.find(slot.texture);
+    if (
+      it == indexArrays.end() || it->second.get() != slot.indexArray
+      || it->second->capacity() > slot.capacity)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void PackedBrushIndexArray::layout(const TextureToBrushIndicesMap& indexArrays)
+{
+  m_slots.clear();
+  m_drawCommands.clear();
+  m_prepared = false;
+
+  auto offset = size_t(0);
+  for (const auto& [texture, indexArray] : indexArrays)
+  {
+    const auto capacity = indexArray->capacity();
+    m_slots.push_back(
+      Slot{texture, indexArray.get(), offset, capacity, false, std::nullopt});
+    m_drawCommands.push_back(DrawCommand{texture, {}, {}, {}});
+    offset += capacity;
+  }
+
+  m_size = std::max(m_size, offset);
+}
+
 // BrushVertexArray
 
 BrushVertexArray::BrushVertexArray()
@@ -202,25 +511,34 @@ BrushVertexArray::BrushVertexArray()
 std::pair<AllocationTracker::Block*, BrushVertexArray::Vertex*> BrushVertexArray::
   getPointerToInsertVerticesAt(const size_t vertexCount)
 {
-  auto block = m_allocationTracker.allocate(vertexCount);
-  if (block != nullptr)
+  auto* block = allocateVertices(vertexCount);
+  return {block, verticesOfBlock(block)};
+}
+
+AllocationTracker::Block* BrushVertexArray::allocateVertices(const size_t vertexCount)
+{
+  auto* block = m_allocationTracker.allocate(vertexCount);
+  if (block == nullptr)
   {
-    Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
-    return {block, dest};
+    // retry
+    const size_t newSize = std::max(
+      2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + vertexCount);
+    m_allocationTracker.expand(newSize);
+    m_vertexHolder.resize(newSize);
+
+    // insert again
+    block = m_allocationTracker.allocate(vertexCount);
+    assert(block != nullptr);
   }
 
-  // retry
-  const size_t newSize = std::max(
-    2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + vertexCount);
-  m_allocationTracker.expand(newSize);
-  m_vertexHolder.resize(newSize);
-
-  // insert again
-  block = m_allocationTracker.allocate(vertexCount);
-  assert(block != nullptr);
+  m_vertexHolder.markDirty(block->pos, vertexCount);
+  return block;
+}
 
-  Vertex* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertexCount);
-  return {block, dest};
+BrushVertexArray::Vertex* BrushVertexArray::verticesOfBlock(
+  const AllocationTracker::Block* key)
+{
+  return m_vertexHolder.elements() + key->pos;
 }
 
 void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
@@ -233,6 +551,25 @@ void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
   // us to re-use the space later
 }
 
+AllocationTracker::Stats BrushVertexArray::stats() const
+{
+  return m_allocationTracker.stats();
+}
+
+size_t BrushVertexArray::compact(
+  const size_t maxVertexCount, const AllocationTracker::MoveCallback& didMove)
+{
+  return m_allocationTracker.compact(
+    maxVertexCount, [&](const auto& block, const auto oldPos) {
+      auto* elements = m_vertexHolder.elements();
+      std::memmove(
+        elements + block.pos, elements + oldPos, block.size * sizeof(*elements));
+      m_vertexHolder.markDirty(block.pos, block.size);
+
+      didMove(block, oldPos);
+    });
+}
+
 bool BrushVertexArray::setupVertices()
 {
   return m_vertexHolder.setupVertices();
@@ -32,11 +32,17 @@
 
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
 {
+namespace Assets
+{
+class Texture;
+}
+
 namespace Renderer
 {
 struct DirtyRangeTracker
@@ -163,12 +169,14 @@ public:
   T* getPointerToWriteElementsTo(
     const size_t offsetWithinBlock, const size_t elementCount)
   {
-    assert(offsetWithinBlock + elementCount <= m_snapshot.size());
+    markDirty(offsetWithinBlock, elementCount);
+    return m_snapshot.data() + offsetWithinBlock;
+  }
 
-    // mark dirty range
+  void markDirty(const size_t offsetWithinBlock, const size_t elementCount)
+  {
+    assert(offsetWithinBlock + elementCount <= m_snapshot.size());
     m_dirtyRange.markDirty(offsetWithinBlock, elementCount);
-
-    return m_snapshot.data() + offsetWithinBlock;
   }
 
   bool prepared() const
@@ -221,10 +229,25 @@ public:
     assert(prepared());
   }
 
+  /**
+   * Returns the range of elements that were changed since they were last uploaded.
+   */
+  const DirtyRangeTracker& dirtyRange() const { return m_dirtyRange; }
+
+  /**
+   * Marks all elements as uploaded. Use this if the elements were uploaded to another
+   * buffer than this holder's own block.
+   */
+  void markClean() { m_dirtyRange = DirtyRangeTracker(m_snapshot.size()); }
+
   bool empty() const { return m_snapshot.empty(); }
 
   size_t size() const { return m_snapshot.size(); }
 
+  const T* elements() const { return m_snapshot.data(); }
+
+  T* elements() { return m_snapshot.data(); }
+
   void bindBlock() { m_vbo->bind(); }
 
   void unbindBlock() { m_vbo->unbind(); }
@@ -256,6 +279,8 @@ class BrushIndexArray
 private:
   IndexHolder m_indexHolder;
   AllocationTracker m_allocationTracker;
+  size_t m_validIndexCount;
+  size_t m_version;
 
 public:
   BrushIndexArray();
@@ -278,11 +303,81 @@ public:
   std::pair<AllocationTracker::Block*, GLuint*> getPointerToInsertElementsAt(
     size_t elementCount);
 
+  /**
+   * Allocates room for the given number of indices without returning a pointer to it.
+   * Use this to allocate several blocks before writing to any of them: growing the array
+   * moves its contents, so the pointers to previously allocated blocks become invalid.
+   */
+  AllocationTracker::Block* allocateElements(size_t elementCount);
+
+  /**
+   * Returns a pointer to the indices of the given block. Since the blocks don't overlap,
+   * different blocks may be written to from different threads.
+   */
+  GLuint* elementsOfBlock(const AllocationTracker::Block* key);
+
   /**
    * Deletes indices for the given brush and marks the allocation as free.
    */
   void zeroElementsWithKey(AllocationTracker::Block* key);
 
+  /**
+   * Returns the number of indices this array has room for, including freed ranges.
+   */
+  size_t capacity() const;
+
+  /**
+   * Returns the number of indices in allocated ranges.
+   */
+  size_t validIndexCount() const;
+
+  /**
+   * Returns a number that changes whenever indices are inserted or deleted.
+   */
+  size_t version() const;
+
+  /**
+   * Returns the smallest range that contains all allocated indices.
+   */
+  AllocationTracker::Range usedRange() const;
+
+  /**
+   * Returns the ranges of allocated indices, skipping the freed ranges between them.
+   */
+  std::vector<AllocationTracker::Range> usedRanges() const;
+
+  /**
+   * Copies the indices of all allocated ranges to the given destination, skipping the
+   * freed ranges. Returns the number of copied indices, which is at most capacity().
+   */
+  size_t copyValidIndices(GLuint* dest) const;
+
+  /**
+   * Writes the indices of this array to the given VBO, starting at the given offset in
+   * indices, and marks them as uploaded. Unless `all` is true, only the indices that
+   * changed since the last upload are written.
+   *
+   * This is used by PackedBrushIndexArray to upload several arrays into one buffer. An
+   * array that is uploaded like this must not be prepared and rendered by itself.
+   */
+  void uploadIndices(Vbo& vbo, size_t offset, bool all);
+
+  /**
+   * Moves the indices of the given block so that they refer to vertices that were moved
+   * from `oldBase` to `newBase`.
+   */
+  void rebaseElementsOfBlock(
+    const AllocationTracker::Block* key, GLuint oldBase, GLuint newBase);
+
+  AllocationTracker::Stats stats() const;
+
+  /**
+   * Closes the holes left by deleted indices by moving allocated ranges towards the start
+   * of the array, moving at most about `maxIndexCount` indices. The keys remain valid.
+   * Returns the number of moved indices.
+   */
+  size_t compact(size_t maxIndexCount);
+
   void render(const PrimType primType) const;
   bool prepared() const;
   void prepare(VboManager& vboManager);
@@ -291,6 +386,102 @@ public:
   void cleanupIndices();
 };
 
+using TextureToBrushIndicesMap =
+  std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+
+/**
+ * Uploads the indices of several BrushIndexArrays, one per texture, into a single index
+ * buffer, so that the faces of all textures can be rendered without switching index
+ * buffers.
+ *
+ * Every texture gets a slot that is as large as the capacity of its BrushIndexArray and
+ * mirrors its layout. This way, the indices are uploaded directly from the arrays without
+ * keeping another copy in memory, and only the ranges that changed since the last upload
+ * are written. Freed ranges are not rendered: each texture's allocated ranges are drawn
+ * with a single glMultiDrawElements call. The slots are only laid out anew when a texture
+ * is added or removed or when an array grows.
+ */
+class PackedBrushIndexArray
+{
+public:
+  struct DrawCommand
+  {
+    const Assets::Texture* texture;
+    /**
+     * The ranges of indices to render in ascending order, skipping freed ranges.
+     */
+    std::vector<AllocationTracker::Range> ranges;
+    /**
+     * The same ranges as arguments for glMultiDrawElements.
+     */
+    GLCounts counts;
+    std::vector<const GLvoid*> offsets;
+  };
+
+private:
+  struct Slot
+  {
+    const Assets::Texture* texture;
+    BrushIndexArray* indexArray;
+    size_t offset;
+    size_t capacity;
+    bool uploaded;
+    std::optional<size_t> version;
+  };
+
+  VboManager* m_vboManager = nullptr;
+  Vbo* m_vbo = nullptr;
+  size_t m_size = 0;
+  bool m_prepared = true;
+  std::vector<Slot> m_slots;
+  std::vector<DrawCommand> m_drawCommands;
+
+public:
+  PackedBrushIndexArray();
+  ~PackedBrushIndexArray();
+
+  PackedBrushIndexArray(const PackedBrushIndexArray&) = delete;
+  PackedBrushIndexArray& operator=(const PackedBrushIndexArray&) = delete;
+
+  /**
+   * Updates the slots of the arrays that have changed since the last update.
+   */
+  void update(const TextureToBrushIndicesMap& indexArrays);
+
+  /**
+   * Returns one command per texture with the ranges of the indices to render. The command
+   * of a texture without any indices has no ranges.
+   */
+  const std::vector<DrawCommand>& drawCommands() const;
+
+  /**
+   * Returns the number of indices to render for all textures.
+   */
+  size_t indexCount() const;
+
+  /**
+   * Returns the number of draw commands that have any ranges to render.
+   */
+  size_t drawCallCount() const;
+
+  /**
+   * Returns the number of index ranges to render for all textures. Without
+   * glMultiDrawElements, this is the number of draw calls.
+   */
+  size_t rangeCount() const;
+
+  void render(PrimType primType, const DrawCommand& drawCommand) const;
+  bool prepared() const;
+  void prepare(VboManager& vboManager);
+
+  void setupIndices();
+  void cleanupIndices();
+
+private:
+  bool layoutValid(const TextureToBrushIndicesMap& indexArrays) const;
+  void layout(const TextureToBrushIndicesMap& indexArrays);
+};
+
 class VertexArrayInterface
 {
 public:
@@ -372,8 +563,28 @@ public:
   std::pair<AllocationTracker::Block*, Vertex*> getPointerToInsertVerticesAt(
     size_t vertexCount);
 
+  /**
+   * See BrushIndexArray::allocateElements().
+   */
+  AllocationTracker::Block* allocateVertices(size_t vertexCount);
+
+  /**
+   * See BrushIndexArray::elementsOfBlock().
+   */
+  Vertex* verticesOfBlock(const AllocationTracker::Block* key);
+
   void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+  AllocationTracker::Stats stats() const;
+
+  /**
+   * Closes the holes left by deleted vertices by moving allocated ranges towards the
+   * start of the array, moving at most about `maxVertexCount` vertices. The keys remain
+   * valid, but since the indices referring to the moved vertices must be updated,
+   * `didMove` is called for every moved range. Returns the number of moved vertices.
+   */
+  size_t compact(size_t maxVertexCount, const AllocationTracker::MoveCallback& didMove);
+
   // setting up GL attributes
   bool setupVertices();
   void cleanupVertices();
@@ -71,7 +71,7 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
     return;
   }
 
-  // build vertex cache and face cache
+  // build vertex cache, face cache and edge cache
   const auto& brush = brushNode.brush();
 
   m_cachedVertices.clear();
@@ -80,36 +80,55 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
   m_cachedFacesSortedByTexture.clear();
   m_cachedFacesSortedByTexture.reserve(brush.faceCount());
 
+  m_cachedEdges.clear();
+  m_cachedEdges.reserve(brush.edgeCount());
+
   for (const auto& face : brush.faces())
   {
     const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
     // The boundary is in CCW order, but the renderer expects CW order:
-    auto& boundary = face.geometry()->boundary();
+    const auto& boundary = face.geometry()->boundary();
+    const auto vertexCount = boundary.size();
     for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it)
     {
-      auto* currentHalfEdge = *it;
-      auto* vertex = currentHalfEdge->origin();
-
-      // Set the vertex payload to the index, relative to the brush's first vertex being
-      // 0. This is used below when building the edge cache. NOTE: we'll overwrite the
-      // payload as we visit the same vertex several times while visiting different faces,
-      // this is fine.
+      const auto* currentHalfEdge = *it;
+      const auto* vertex = currentHalfEdge->origin();
+
+      // The vertices of the face are cached in reverse order, so the destination of the
+      // current half edge was cached just before its origin (or last, if the current half
+      // edge was visited first). Every edge is cached when visiting its first half edge.
+      //
+      // Copies of a brush share its geometry, and the caches of several brushes are
+      // validated concurrently, so we must not store the vertex indices in the geometry's
+      // vertex payloads.
       const auto currentIndex = m_cachedVertices.size();
-      vertex->setPayload(static_cast<GLuint>(currentIndex));
+      const auto* edge = currentHalfEdge->edge();
+      if (edge->firstEdge() == currentHalfEdge)
+      {
+        const auto destinationIndex =
+          currentIndex > indexOfFirstVertexRelativeToBrush
+            ? currentIndex - 1
+            : indexOfFirstVertexRelativeToBrush + vertexCount - 1;
+
+        const auto faceIndex2 = edge->secondFace()->payload();
+        assert(faceIndex2);
+
+        m_cachedEdges.emplace_back(
+          &face, &brush.face(*faceIndex2), currentIndex, destinationIndex);
+      }
 
       const auto& position = vertex->position();
       m_cachedVertices.emplace_back(
         vm::vec3f{position},
         vm::vec3f{face.boundary().normal},
         face.textureCoords(position));
-
-      currentHalfEdge = currentHalfEdge->previous();
     }
 
     // face cache
     m_cachedFacesSortedByTexture.emplace_back(&face, indexOfFirstVertexRelativeToBrush);
   }
+  assert(m_cachedEdges.size() == brush.edgeCount());
 
   // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
   // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`),
@@ -120,27 +139,6 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
     m_cachedFacesSortedByTexture.end(),
     [](const CachedFace& a, const CachedFace& b) { return a.texture < b.texture; });
 
-  // Build edge index cache
-
-  m_cachedEdges.clear();
-  m_cachedEdges.reserve(brush.edgeCount());
-
-  for (const auto* currentEdge : brush.edges())
-  {
-    const auto faceIndex1 = currentEdge->firstFace()->payload();
-    const auto faceIndex2 = currentEdge->secondFace()->payload();
-    assert(faceIndex1 && faceIndex2);
-
-    const auto& face1 = brush.face(*faceIndex1);
-    const auto& face2 = brush.face(*faceIndex2);
-
-    const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-    const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
-
-    m_cachedEdges.emplace_back(
-      &face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
-  }
-
   m_rendererCacheValid = true;
 }
 
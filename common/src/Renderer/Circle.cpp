@@ -35,12 +35,13 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-Circle::Circle(const float radius, const size_t segments, const bool filled)
+Circle::Circle(
+  const float radius, const size_t segments, const bool filled, const VboUsage usage)
   : m_filled(filled)
 {
   assert(radius > 0.0f);
   assert(segments > 0);
-  init2D(radius, segments, 0.0f, vm::Cf::two_pi());
+  init2D(radius, segments, 0.0f, vm::Cf::two_pi(), usage);
 }
 
 Circle::Circle(
@@ -106,7 +107,8 @@ void Circle::init2D(
   const float radius,
   const size_t segments,
   const float startAngle,
-  const float angleLength)
+  const float angleLength,
+  const VboUsage usage)
 {
   using Vertex = GLVertexTypes::P2::Vertex;
 
@@ -115,7 +117,8 @@ void Circle::init2D(
   {
     positions.push_back(vm::vec2f::zero());
   }
-  m_array = VertexArray::move(Vertex::toList(positions.size(), std::begin(positions)));
+  m_array =
+    VertexArray::move(Vertex::toList(positions.size(), std::begin(positions)), usage);
 }
 
 void Circle::init3D(
@@ -35,7 +35,11 @@ private:
   bool m_filled;
 
 public:
-  Circle(float radius, size_t segments, bool filled);
+  Circle(
+    float radius,
+    size_t segments,
+    bool filled,
+    VboUsage usage = VboUsage::StaticDraw);
   Circle(float radius, size_t segments, bool filled, float startAngle, float angleLength);
   Circle(
     float radius,
@@ -63,7 +67,12 @@ private:
     vm::axis::type axis,
     float startAngle,
     float angleLength);
-  void init2D(float radius, size_t segments, float startAngle, float angleLength);
+  void init2D(
+    float radius,
+    size_t segments,
+    float startAngle,
+    float angleLength,
+    VboUsage usage = VboUsage::StaticDraw);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
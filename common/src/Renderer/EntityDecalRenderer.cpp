@@ -151,7 +151,8 @@ void EntityDecalRenderer::clear()
   m_entities.clear();
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_faces = std::make_shared<TextureToBrushIndicesMap>();
-  m_faceRenderer = FaceRenderer{m_vertexArray, m_faces, m_faceColor};
+  m_faceIndices = std::make_shared<PackedBrushIndexArray>();
+  m_faceRenderer = FaceRenderer{m_vertexArray, m_faceIndices, m_faceColor};
 }
 
 void EntityDecalRenderer::updateNode(Model::Node* node)
@@ -413,6 +414,7 @@ void EntityDecalRenderer::render(RenderContext&, RenderBatch& renderBatch)
   {
     validateDecalData(ent, data);
   }
+  m_faceIndices->update(*m_faces);
 
   m_faceRenderer.render(renderBatch);
 }
@@ -80,6 +80,7 @@ private:
     std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
 
   std::shared_ptr<TextureToBrushIndicesMap> m_faces;
+  std::shared_ptr<PackedBrushIndexArray> m_faceIndices;
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   FaceRenderer m_faceRenderer;
   Color m_faceColor;
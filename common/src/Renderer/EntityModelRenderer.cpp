@@ -24,6 +24,7 @@
 #include "Assets/EntityModelManager.h"
 #include "Assets/ModelDefinition.h"
 #include "EL/ELExceptions.h"
+#include "Ensure.h"
 #include "Logger.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
@@ -35,18 +36,74 @@
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
-#include "Renderer/Transformation.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboManager.h"
 
 #include <vecmath/mat.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+bool instancedRenderingSupported()
+{
+  return GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced;
+}
+
+size_t instanceCount(const std::vector<EntityModelInstanceBatch>& batches)
+{
+  auto result = size_t(0);
+  for (const auto& batch : batches)
+  {
+    result += batch.transformations.size();
+  }
+  return result;
+}
+} // namespace
+
+std::vector<EntityModelInstanceBatch> makeEntityModelInstanceBatches(
+  const std::unordered_map<const Model::EntityNode*, TexturedRenderer*>& entities,
+  const Model::EditorContext& editorContext,
+  const bool showHiddenEntities)
+{
+  auto result = std::vector<EntityModelInstanceBatch>{};
+  auto batchIndices = std::unordered_map<const TexturedRenderer*, size_t>{};
+
+  for (const auto& [entityNode, renderer] : entities)
+  {
+    if (!showHiddenEntities && !editorContext.visible(entityNode))
+    {
+      continue;
+    }
+
+    const auto* model = entityNode->entity().model();
+    if (!model)
+    {
+      continue;
+    }
+
+    const auto [it, inserted] = batchIndices.emplace(renderer, result.size());
+    if (inserted)
+    {
+      result.push_back(EntityModelInstanceBatch{renderer, model->orientation(), {}});
+    }
+
+    result[it->second].transformations.emplace_back(
+      entityNode->entity().modelTransformation());
+  }
+
+  return result;
+}
+
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
   Assets::EntityModelManager& entityModelManager,
@@ -62,6 +119,7 @@ EntityModelRenderer::EntityModelRenderer(
 EntityModelRenderer::~EntityModelRenderer()
 {
   clear();
+  freeInstanceVbo();
 }
 
 void EntityModelRenderer::addEntity(const Model::EntityNode* entityNode)
@@ -158,6 +216,13 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
+
+  m_batches =
+    makeEntityModelInstanceBatches(m_entities, m_editorContext, m_showHiddenEntities);
+  if (instancedRenderingSupported())
+  {
+    uploadInstanceTransformations(vboManager);
+  }
 }
 
 void EntityModelRenderer::doRender(RenderContext& renderContext)
@@ -190,28 +255,107 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
   shader.set("CameraUp", renderContext.camera().up());
   shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-  for (const auto& [entityNode, renderer] : m_entities)
+  if (m_instanceVbo != nullptr && instancedRenderingSupported())
   {
-    if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
-    {
-      continue;
-    }
+    renderInstanced(renderContext, shader);
+  }
+  else
+  {
+    renderIndividually(shader);
+  }
+}
 
-    const auto* model = entityNode->entity().model();
-    if (!model)
+void EntityModelRenderer::uploadInstanceTransformations(VboManager& vboManager)
+{
+  const auto size = instanceCount(m_batches) * sizeof(vm::mat4x4f);
+  if (size == 0)
+  {
+    return;
+  }
+
+  if (m_instanceVbo == nullptr || m_instanceVbo->capacity() < size)
+  {
+    // grow geometrically so that adding entities doesn't reallocate every frame
+    const auto capacity =
+      std::max(size, m_instanceVbo != nullptr ? 2 * m_instanceVbo->capacity() : 0);
+
+    freeInstanceVbo();
+    m_vboManager = &vboManager;
+    m_instanceVbo =
+      vboManager.allocateVbo(VboType::ArrayBuffer, capacity, VboUsage::DynamicDraw);
+  }
+
+  auto offset = size_t(0);
+  for (const auto& batch : m_batches)
+  {
+    offset += m_instanceVbo->writeBuffer(offset, batch.transformations);
+  }
+  m_instanceVbo->unbind();
+}
+
+void EntityModelRenderer::freeInstanceVbo()
+{
+  if (m_instanceVbo != nullptr)
+  {
+    m_vboManager->destroyVbo(m_instanceVbo);
+    m_instanceVbo = nullptr;
+  }
+}
+
+void EntityModelRenderer::renderInstanced(
+  RenderContext& renderContext, ActiveShader& shader)
+{
+  auto* program = renderContext.shaderManager().currentProgram();
+  ensure(program != nullptr, "must have a program bound to render instanced");
+
+  // a mat4 attribute occupies four consecutive locations, one per column
+  const auto location =
+    static_cast<GLuint>(program->findAttributeLocation("ModelMatrix"));
+  for (GLuint i = 0; i < 4; ++i)
+  {
+    glAssert(glEnableVertexAttribArray(location + i));
+    glAssert(glVertexAttribDivisorARB(location + i, 1));
+  }
+
+  auto offset = size_t(0);
+  for (const auto& batch : m_batches)
+  {
+    shader.set("Orientation", static_cast<int>(batch.orientation));
+
+    m_instanceVbo->bind();
+    for (GLuint i = 0; i < 4; ++i)
     {
-      continue;
+      glAssert(glVertexAttribPointer(
+        location + i,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        static_cast<GLsizei>(sizeof(vm::mat4x4f)),
+        reinterpret_cast<GLvoid*>(offset + i * sizeof(vm::vec4f))));
     }
+    m_instanceVbo->unbind();
 
-    shader.set("Orientation", static_cast<int>(model->orientation()));
-
-    const auto transformation = vm::mat4x4f{entityNode->entity().modelTransformation()};
-    const auto multMatrix =
-      MultiplyModelMatrix{renderContext.transformation(), transformation};
+    batch.renderer->renderInstanced(batch.transformations.size());
+    offset += batch.transformations.size() * sizeof(vm::mat4x4f);
+  }
 
-    shader.set("ModelMatrix", transformation);
+  for (GLuint i = 0; i < 4; ++i)
+  {
+    glAssert(glVertexAttribDivisorARB(location + i, 0));
+    glAssert(glDisableVertexAttribArray(location + i));
+  }
+}
 
-    renderer->render();
+void EntityModelRenderer::renderIndividually(ActiveShader& shader)
+{
+  for (const auto& batch : m_batches)
+  {
+    shader.set("Orientation", static_cast<int>(batch.orientation));
+    for (const auto& transformation : batch.transformations)
+    {
+      shader.setAttribute("ModelMatrix", transformation);
+      batch.renderer->render();
+    }
   }
 }
 } // namespace Renderer
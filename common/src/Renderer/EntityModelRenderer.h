@@ -22,7 +22,11 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include <vecmath/forward.h>
+#include <vecmath/mat.h>
+
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -31,7 +35,8 @@ class Logger;
 namespace Assets
 {
 class EntityModelManager;
-}
+enum class Orientation;
+} // namespace Assets
 
 namespace Model
 {
@@ -41,9 +46,31 @@ class EntityNode;
 
 namespace Renderer
 {
+class ActiveShader;
 class RenderBatch;
 class ShaderConfig;
 class TexturedRenderer;
+class Vbo;
+
+/**
+ * The visible entities that share a model. They are rendered together as instances of
+ * the model.
+ */
+struct EntityModelInstanceBatch
+{
+  TexturedRenderer* renderer;
+  Assets::Orientation orientation;
+  std::vector<vm::mat4x4f> transformations;
+};
+
+/**
+ * Groups the given entities by their model renderers. Entities that are not visible or
+ * that don't have a model are skipped.
+ */
+std::vector<EntityModelInstanceBatch> makeEntityModelInstanceBatches(
+  const std::unordered_map<const Model::EntityNode*, TexturedRenderer*>& entities,
+  const Model::EditorContext& editorContext,
+  bool showHiddenEntities);
 
 class EntityModelRenderer : public DirectRenderable
 {
@@ -55,6 +82,10 @@ private:
 
   std::unordered_map<const Model::EntityNode*, TexturedRenderer*> m_entities;
 
+  std::vector<EntityModelInstanceBatch> m_batches;
+  VboManager* m_vboManager = nullptr;
+  Vbo* m_instanceVbo = nullptr;
+
   bool m_applyTinting;
   Color m_tintColor;
 
@@ -112,6 +143,12 @@ public:
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+
+  void uploadInstanceTransformations(VboManager& vboManager);
+  void freeInstanceVbo();
+
+  void renderInstanced(RenderContext& renderContext, ActiveShader& shader);
+  void renderIndividually(ActiveShader& shader);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
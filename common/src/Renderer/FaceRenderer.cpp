@@ -83,10 +83,10 @@ FaceRenderer::FaceRenderer()
 
 FaceRenderer::FaceRenderer(
   std::shared_ptr<BrushVertexArray> vertexArray,
-  std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap,
+  std::shared_ptr<PackedBrushIndexArray> indexArray,
   const Color& faceColor)
   : m_vertexArray(std::move(vertexArray))
-  , m_indexArrayMap(std::move(indexArrayMap))
+  , m_indexArray(std::move(indexArray))
   , m_faceColor(faceColor)
   , m_grayscale(false)
   , m_tint(false)
@@ -97,7 +97,7 @@ FaceRenderer::FaceRenderer(
 FaceRenderer::FaceRenderer(const FaceRenderer& other)
   : IndexedRenderable(other)
   , m_vertexArray(other.m_vertexArray)
-  , m_indexArrayMap(other.m_indexArrayMap)
+  , m_indexArray(other.m_indexArray)
   , m_faceColor(other.m_faceColor)
   , m_grayscale(other.m_grayscale)
   , m_tint(other.m_tint)
@@ -117,7 +117,7 @@ void swap(FaceRenderer& left, FaceRenderer& right)
 {
   using std::swap;
   swap(left.m_vertexArray, right.m_vertexArray);
-  swap(left.m_indexArrayMap, right.m_indexArrayMap);
+  swap(left.m_indexArray, right.m_indexArray);
   swap(left.m_faceColor, right.m_faceColor);
   swap(left.m_grayscale, right.m_grayscale);
   swap(left.m_tint, right.m_tint);
@@ -153,16 +153,12 @@ void FaceRenderer::render(RenderBatch& renderBatch)
 void FaceRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
   m_vertexArray->prepare(vboManager);
-
-  for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap)
-  {
-    brushIndexHolderPtr->prepare(vboManager);
-  }
+  m_indexArray->prepare(vboManager);
 }
 
 void FaceRenderer::doRender(RenderContext& context)
 {
-  if (m_indexArrayMap->empty())
+  if (m_indexArray->drawCommands().empty())
     return;
 
   if (m_vertexArray->setupVertices())
@@ -208,13 +204,16 @@ void FaceRenderer::doRender(RenderContext& context)
     {
       glAssert(glDepthMask(GL_FALSE));
     }
-    for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap)
+    // the indices of all textures are in one buffer, so it only needs to be bound once
+    m_indexArray->setupIndices();
+    for (const auto& drawCommand : m_indexArray->drawCommands())
     {
-      if (!brushIndexHolderPtr->hasValidIndices())
+      if (drawCommand.ranges.empty())
       {
         continue;
       }
 
+      const auto* texture = drawCommand.texture;
       const bool enableMasked = texture != nullptr && texture->masked();
 
       // set any per-texture uniforms
@@ -222,11 +221,10 @@ void FaceRenderer::doRender(RenderContext& context)
       shader.set("EnableMasked", enableMasked);
 
       func.before(texture);
-      brushIndexHolderPtr->setupIndices();
-      brushIndexHolderPtr->render(PrimType::Triangles);
-      brushIndexHolderPtr->cleanupIndices();
+      m_indexArray->render(PrimType::Triangles, drawCommand);
       func.after(texture);
     }
+    m_indexArray->cleanupIndices();
     if (m_alpha < 1.0f)
     {
       glAssert(glDepthMask(GL_TRUE));
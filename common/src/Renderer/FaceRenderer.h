@@ -26,19 +26,13 @@
 #include <vecmath/vec.h>
 
 #include <memory>
-#include <unordered_map>
 
 namespace TrenchBroom
 {
-namespace Assets
-{
-class Texture;
-}
-
 namespace Renderer
 {
-class BrushIndexArray;
 class BrushVertexArray;
+class PackedBrushIndexArray;
 class RenderBatch;
 
 class FaceRenderer : public IndexedRenderable
@@ -46,11 +40,8 @@ class FaceRenderer : public IndexedRenderable
 private:
   struct RenderFunc;
 
-  using TextureToBrushIndicesMap =
-    const std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
+  std::shared_ptr<PackedBrushIndexArray> m_indexArray;
   Color m_faceColor;
   bool m_grayscale;
   bool m_tint;
@@ -61,7 +52,7 @@ public:
   FaceRenderer();
   FaceRenderer(
     std::shared_ptr<BrushVertexArray> vertexArray,
-    std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap,
+    std::shared_ptr<PackedBrushIndexArray> indexArray,
     const Color& faceColor);
 
   FaceRenderer(const FaceRenderer& other);
@@ -36,6 +36,21 @@ FontManager::FontManager()
 
 FontManager::~FontManager() = default;
 
+void FontManager::beginFrame()
+{
+  m_textStats = TextStats{};
+}
+
+const FontManager::TextStats& FontManager::textStats() const
+{
+  return m_textStats;
+}
+
+FontManager::TextStats& FontManager::textStats()
+{
+  return m_textStats;
+}
+
 void FontManager::clearCache()
 {
   m_cache.clear();
@@ -35,14 +35,44 @@ class TextureFont;
 
 class FontManager
 {
+public:
+  struct TextStats
+  {
+    /**
+     * The number of strings that were rendered.
+     */
+    size_t renderedStrings = 0;
+    /**
+     * The number of strings that were skipped because they were too far away, outside of
+     * the viewport or hidden behind a nearer string.
+     */
+    size_t culledStrings = 0;
+    /**
+     * The number of vertices of the rendered glyph quads.
+     */
+    size_t textVertices = 0;
+  };
+
 private:
   std::unique_ptr<FontFactory> m_factory;
   std::map<FontDescriptor, std::unique_ptr<TextureFont>> m_cache;
+  TextStats m_textStats;
 
 public:
   FontManager();
   ~FontManager();
 
+  /**
+   * Resets the text statistics, must be called at the start of every frame.
+   */
+  void beginFrame();
+
+  /**
+   * Returns the statistics of the text rendered since the start of the current frame.
+   */
+  const TextStats& textStats() const;
+  TextStats& textStats();
+
   TextureFont& font(const FontDescriptor& fontDescriptor);
   FontDescriptor selectFontSize(
     const FontDescriptor& fontDescriptor,
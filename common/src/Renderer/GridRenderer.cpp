@@ -37,7 +37,8 @@ namespace TrenchBroom
 namespace Renderer
 {
 GridRenderer::GridRenderer(const OrthographicCamera& camera, const vm::bbox3& worldBounds)
-  : m_vertexArray(VertexArray::move(vertices(camera, worldBounds)))
+  : m_vertexArray(
+    VertexArray::move(vertices(camera, worldBounds), VboUsage::StreamDraw))
 {
 }
 
@@ -34,6 +34,10 @@ class OrthographicCamera;
 class RenderContext;
 class VboManager;
 
+/**
+ * Renders the grid of a 2D view. Since the grid depends on the camera, a grid renderer is
+ * created for each frame and must not be rendered after the frame is over.
+ */
 class GridRenderer : public DirectRenderable
 {
 private:
@@ -38,8 +38,10 @@ private:
 public:
   IndexRangeRenderer();
   template <typename VertexSpec>
-  explicit IndexRangeRenderer(IndexRangeMapBuilder<VertexSpec>& builder)
-    : m_vertexArray(VertexArray::move(std::move(builder.vertices())))
+  explicit IndexRangeRenderer(
+    IndexRangeMapBuilder<VertexSpec>& builder,
+    const VboUsage usage = VboUsage::StaticDraw)
+    : m_vertexArray(VertexArray::move(std::move(builder.vertices()), usage))
     , m_indexArray(std::move(builder.indices()))
   {
   }
@@ -38,11 +38,12 @@
 #include "Renderer/TexturedIndexArrayRenderer.h"
 #include "Renderer/VertexArray.h"
 
-#include <kdl/vector_utils.h>
-
+#include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -142,6 +143,12 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
 
   if (renderContext.showFaces())
   {
+    // reduce the level of detail of distant patches in the 3D view only
+    m_renderLevelsOfDetail = renderContext.camera().perspectiveProjection();
+    if (m_renderLevelsOfDetail)
+    {
+      validateLevelsOfDetail(renderContext.camera());
+    }
     renderBatch.add(this);
   }
 
@@ -155,78 +162,121 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
   }
 }
 
-static TexturedIndexArrayRenderer buildMeshRenderer(
-  const std::vector<const Model::PatchNode*>& patchNodes,
-  const Model::EditorContext& editorContext)
+namespace
 {
-  size_t vertexCount = 0u;
-  auto indexArrayMapSize = TexturedIndexArrayMap::Size{};
+// the level of detail is increased while a quad of the patch grid is larger than this
+// many pixels on screen
+constexpr auto MaxQuadPixelSize = 16.0f;
 
-  for (const auto* patchNode : patchNodes)
-  {
-    if (editorContext.visible(patchNode))
-    {
-      vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
+size_t maxLevelOfDetail(const Model::PatchNode& patchNode)
+{
+  const auto subdivisions =
+    patchNode.grid().quadRowCount() / patchNode.patch().surfaceRowCount();
 
-      const auto* texture = patchNode->patch().texture();
-      const auto quadCount =
-        patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
-      indexArrayMapSize.inc(texture, PrimType::Triangles, 6u * quadCount);
-    }
+  auto level = size_t(0);
+  while ((size_t(1) << (level + 1u)) <= subdivisions)
+  {
+    ++level;
   }
+  return level;
+}
+} // namespace
 
-  using Vertex = GLVertexTypes::P3NT2::Vertex;
-  auto vertices = std::vector<Vertex>{};
-  vertices.reserve(vertexCount);
+std::vector<GLuint> makePatchGridTriangles(
+  const size_t pointRowCount, const size_t pointColumnCount, const size_t stride)
+{
+  assert(stride > 0u);
+  assert(pointRowCount > 1u && (pointRowCount - 1u) % stride == 0u);
+  assert(pointColumnCount > 1u && (pointColumnCount - 1u) % stride == 0u);
 
-  auto indexArrayMapBuilder = TexturedIndexArrayMapBuilder{indexArrayMapSize};
-  using Index = TexturedIndexArrayMapBuilder::Index;
+  const auto lastRow = pointRowCount - 1u;
+  const auto lastCol = pointColumnCount - 1u;
+  const auto index = [&](const size_t row, const size_t col) {
+    return static_cast<GLuint>(row * pointColumnCount + col);
+  };
 
-  for (const auto* patchNode : patchNodes)
+  auto result = std::vector<GLuint>{};
+  auto perimeter = std::vector<GLuint>{};
+
+  for (size_t row = 0u; row < lastRow; row += stride)
   {
-    if (editorContext.visible(patchNode))
+    for (size_t col = 0u; col < lastCol; col += stride)
     {
-      const auto vertexOffset = vertices.size();
+      const auto top = row == 0u;
+      const auto right = col + stride == lastCol;
+      const auto bottom = row + stride == lastRow;
+      const auto left = col == 0u;
 
-      const auto& grid = patchNode->grid();
-      auto gridVertices = kdl::vec_transform(grid.points, [](const auto& p) {
-        return Vertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.texCoords}};
-      });
-      vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
+      if (stride == 1u || !(top || right || bottom || left))
+      {
+        const auto i0 = index(row, col);
+        const auto i1 = index(row, col + stride);
+        const auto i2 = index(row + stride, col + stride);
+        const auto i3 = index(row + stride, col);
+        result.insert(std::end(result), {i0, i1, i2, i2, i3, i0});
+      }
+      else
+      {
+        // walk around the quad, visiting every point on the sides that lie on the border
+        // of the patch and only the corners on the other sides
+        const auto step = [&](const bool border) { return border ? size_t(1) : stride; };
 
-      const auto* texture = patchNode->patch().texture();
+        perimeter.clear();
+        for (size_t c = col; c < col + stride; c += step(top))
+        {
+          perimeter.push_back(index(row, c));
+        }
+        for (size_t r = row; r < row + stride; r += step(right))
+        {
+          perimeter.push_back(index(r, col + stride));
+        }
+        for (size_t c = col + stride; c > col; c -= step(bottom))
+        {
+          perimeter.push_back(index(row + stride, c));
+        }
+        for (size_t r = row + stride; r > row; r -= step(left))
+        {
+          perimeter.push_back(index(r, col));
+        }
 
-      const auto pointsPerRow = grid.pointColumnCount;
-      for (size_t row = 0u; row < grid.quadRowCount(); ++row)
-      {
-        for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
+        const auto center = index(row + stride / 2u, col + stride / 2u);
+        for (size_t i = 0u; i < perimeter.size(); ++i)
         {
-          const auto i0 = vertexOffset + row * pointsPerRow + col;
-          const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
-          const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
-          const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
-
-          indexArrayMapBuilder.addTriangle(
-            texture,
-            static_cast<Index>(i0),
-            static_cast<Index>(i1),
-            static_cast<Index>(i2));
-          indexArrayMapBuilder.addTriangle(
-            texture,
-            static_cast<Index>(i2),
-            static_cast<Index>(i3),
-            static_cast<Index>(i0));
+          const auto next = perimeter[(i + 1u) % perimeter.size()];
+          result.insert(std::end(result), {center, perimeter[i], next});
         }
       }
     }
   }
 
-  auto vertexArray = VertexArray::move(std::move(vertices));
-  auto indexArray = IndexArray::move(std::move(indexArrayMapBuilder.indices()));
-  return TexturedIndexArrayRenderer{
-    std::move(vertexArray),
-    std::move(indexArray),
-    std::move(indexArrayMapBuilder.ranges())};
+  return result;
+}
+
+size_t computePatchLevelOfDetail(const Model::PatchNode& patchNode, const Camera& camera)
+{
+  const auto maxLevel = maxLevelOfDetail(patchNode);
+
+  const auto bounds = vm::bbox3f{patchNode.grid().bounds};
+  const auto nearestPoint = bounds.constrain(camera.position());
+  const auto unitsPerPixel = camera.perspectiveScalingFactor(nearestPoint);
+  if (unitsPerPixel <= 0.0f)
+  {
+    return maxLevel;
+  }
+
+  const auto& patch = patchNode.patch();
+  const auto surfaceCount = std::max(patch.surfaceRowCount(), patch.surfaceColumnCount());
+  const auto surfaceSize =
+    vm::get_max_component(bounds.size()) / static_cast<float>(surfaceCount);
+  auto quadPixelSize = surfaceSize / unitsPerPixel;
+
+  auto level = size_t(0);
+  while (level < maxLevel && quadPixelSize > MaxQuadPixelSize)
+  {
+    quadPixelSize /= 2.0f;
+    ++level;
+  }
+  return level;
 }
 
 static DirectEdgeRenderer buildEdgeRenderer(
@@ -306,16 +356,124 @@ void PatchRenderer::validate()
 {
   if (!m_valid)
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
+    using Vertex = GLVertexTypes::P3NT2::Vertex;
+    auto vertices = std::vector<Vertex>{};
+
+    m_patchMeshes.clear();
+    for (const auto* patchNode : m_patchNodes)
+    {
+      if (m_editorContext.visible(patchNode))
+      {
+        const auto maxLevel = maxLevelOfDetail(*patchNode);
+        m_patchMeshes.push_back(
+          PatchMesh{patchNode, vertices.size(), maxLevel, maxLevel});
+
+        const auto& grid = patchNode->grid();
+        vertices.reserve(vertices.size() + grid.points.size());
+        for (const auto& p : grid.points)
+        {
+          vertices.emplace_back(
+            vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.texCoords});
+        }
+      }
+    }
+
+    // the levels of detail only select subsets of the full patch grids, so all mesh
+    // renderers share the same vertices and only differ in their indices
+    m_vertexArray = VertexArray::move(std::move(vertices));
+    m_patchMeshRenderer = buildMeshRenderer(false);
+    m_lodPatchMeshRendererValid = false;
     m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
 
     m_valid = true;
   }
 }
 
+void PatchRenderer::validateLevelsOfDetail(const Camera& camera)
+{
+  for (auto& patchMesh : m_patchMeshes)
+  {
+    const auto levelOfDetail = computePatchLevelOfDetail(*patchMesh.patchNode, camera);
+    if (levelOfDetail != patchMesh.levelOfDetail)
+    {
+      patchMesh.levelOfDetail = levelOfDetail;
+      m_lodPatchMeshRendererValid = false;
+    }
+  }
+
+  if (!m_lodPatchMeshRendererValid)
+  {
+    m_lodPatchMeshRenderer = buildMeshRenderer(true);
+    m_lodPatchMeshRendererValid = true;
+  }
+}
+
+TexturedIndexArrayRenderer PatchRenderer::buildMeshRenderer(const bool levelsOfDetail)
+{
+  const auto strideOf = [&](const PatchMesh& patchMesh) {
+    return levelsOfDetail
+             ? size_t(1) << (patchMesh.maxLevelOfDetail - patchMesh.levelOfDetail)
+             : size_t(1);
+  };
+
+  auto indexArrayMapSize = TexturedIndexArrayMap::Size{};
+  for (const auto& patchMesh : m_patchMeshes)
+  {
+    const auto* texture = patchMesh.patchNode->patch().texture();
+    const auto& patchTriangles = triangles(patchMesh, strideOf(patchMesh));
+    indexArrayMapSize.inc(texture, PrimType::Triangles, patchTriangles.size());
+  }
+
+  auto indexArrayMapBuilder = TexturedIndexArrayMapBuilder{indexArrayMapSize};
+  using Index = TexturedIndexArrayMapBuilder::Index;
+
+  for (const auto& patchMesh : m_patchMeshes)
+  {
+    const auto* texture = patchMesh.patchNode->patch().texture();
+    const auto& patchTriangles = triangles(patchMesh, strideOf(patchMesh));
+    const auto offset = static_cast<Index>(patchMesh.vertexOffset);
+
+    for (size_t i = 0u; i < patchTriangles.size(); i += 3u)
+    {
+      indexArrayMapBuilder.addTriangle(
+        texture,
+        offset + patchTriangles[i],
+        offset + patchTriangles[i + 1u],
+        offset + patchTriangles[i + 2u]);
+    }
+  }
+
+  auto indexArray = IndexArray::move(std::move(indexArrayMapBuilder.indices()));
+  return TexturedIndexArrayRenderer{
+    m_vertexArray, std::move(indexArray), std::move(indexArrayMapBuilder.ranges())};
+}
+
+const std::vector<GLuint>& PatchRenderer::triangles(
+  const PatchMesh& patchMesh, const size_t stride)
+{
+  const auto& grid = patchMesh.patchNode->grid();
+  const auto key = TriangleCacheKey{grid.pointRowCount, grid.pointColumnCount, stride};
+
+  auto it = m_triangleCache.find(key);
+  if (it == std::end(m_triangleCache))
+  {
+    auto patchTriangles =
+      makePatchGridTriangles(grid.pointRowCount, grid.pointColumnCount, stride);
+    it = m_triangleCache.emplace(key, std::move(patchTriangles)).first;
+  }
+  return it->second;
+}
+
 void PatchRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
-  m_patchMeshRenderer.prepare(vboManager);
+  if (m_renderLevelsOfDetail)
+  {
+    m_lodPatchMeshRenderer.prepare(vboManager);
+  }
+  else
+  {
+    m_patchMeshRenderer.prepare(vboManager);
+  }
 }
 
 namespace
@@ -407,7 +565,14 @@ void PatchRenderer::doRender(RenderContext& context)
   }
   */
 
-  m_patchMeshRenderer.render(func);
+  if (m_renderLevelsOfDetail)
+  {
+    m_lodPatchMeshRenderer.render(func);
+  }
+  else
+  {
+    m_patchMeshRenderer.render(func);
+  }
 
   /*
   if (m_alpha < 1.0f) {
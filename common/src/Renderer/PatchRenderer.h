@@ -26,6 +26,8 @@
 
 #include <kdl/vector_set.h>
 
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
@@ -38,6 +40,7 @@ class PatchNode;
 
 namespace Renderer
 {
+class Camera;
 class RenderBatch;
 class RenderContext;
 class VboManager;
@@ -45,12 +48,31 @@ class VboManager;
 class PatchRenderer : public IndexedRenderable
 {
 private:
+  struct PatchMesh
+  {
+    const Model::PatchNode* patchNode;
+    size_t vertexOffset;
+    size_t maxLevelOfDetail;
+    size_t levelOfDetail;
+  };
+
+  using TriangleCacheKey = std::tuple<size_t, size_t, size_t>;
+
   const Model::EditorContext& m_editorContext;
 
   bool m_valid = true;
   kdl::vector_set<const Model::PatchNode*> m_patchNodes;
 
+  std::vector<PatchMesh> m_patchMeshes;
+  VertexArray m_vertexArray;
+
+  // caches the triangle indices of a patch grid by point rows, point columns and stride
+  std::map<TriangleCacheKey, std::vector<GLuint>> m_triangleCache;
+
   TexturedIndexArrayRenderer m_patchMeshRenderer;
+  TexturedIndexArrayRenderer m_lodPatchMeshRenderer;
+  bool m_lodPatchMeshRendererValid = false;
+  bool m_renderLevelsOfDetail = false;
   DirectEdgeRenderer m_edgeRenderer;
 
   Color m_defaultColor;
@@ -121,10 +143,36 @@ public:
 
 private:
   void validate();
+  void validateLevelsOfDetail(const Camera& camera);
+
+  TexturedIndexArrayRenderer buildMeshRenderer(bool levelsOfDetail);
+  const std::vector<GLuint>& triangles(const PatchMesh& patchMesh, size_t stride);
 
 private: // implement IndexedRenderable interface
   void prepareVerticesAndIndices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
+
+// public for testing
+/**
+ * Returns the indices of the triangles that cover a patch grid with the given number of
+ * point rows and columns, using only every stride-th row and column of the grid.
+ *
+ * The quads that touch the border of the patch are fanned out from their center point so
+ * that the border always uses every point of the grid. Thereby, a patch never cracks
+ * against its neighbours, regardless of the stride at which either of them is rendered.
+ * If the stride is 1, every quad of the grid is split into two triangles.
+ */
+std::vector<GLuint> makePatchGridTriangles(
+  size_t pointRowCount, size_t pointColumnCount, size_t stride);
+
+// public for testing
+/**
+ * Returns the number of subdivisions per surface at which the given patch should be
+ * rendered when viewed with the given camera, such that the quads of the patch grid do
+ * not get much larger than a few pixels on screen. The result never exceeds the number
+ * of subdivisions of the patch grid.
+ */
+size_t computePatchLevelOfDetail(const Model::PatchNode& patchNode, const Camera& camera);
 } // namespace Renderer
 } // namespace TrenchBroom
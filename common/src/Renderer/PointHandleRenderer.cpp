@@ -36,9 +36,9 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-PointHandleRenderer::PointHandleRenderer()
-  : m_handle(pref(Preferences::HandleRadius), 16, true)
-  , m_highlight(2.0f * pref(Preferences::HandleRadius), 16, false)
+PointHandleRenderer::PointHandleRenderer(const VboUsage usage)
+  : m_handle(pref(Preferences::HandleRadius), 16, true, usage)
+  , m_highlight(2.0f * pref(Preferences::HandleRadius), 16, false, usage)
 {
 }
 
@@ -47,7 +47,11 @@ private:
   Circle m_highlight;
 
 public:
-  PointHandleRenderer();
+  /**
+   * Pass VboUsage::StreamDraw if this renderer is only rendered during the current frame,
+   * e.g. if it is added to a render batch using RenderBatch::addOneShot.
+   */
+  explicit PointHandleRenderer(VboUsage usage = VboUsage::StaticDraw);
 
   void addPoint(const Color& color, const vm::vec3f& position);
   void addHighlight(const Color& color, const vm::vec3f& position);
@@ -183,6 +183,11 @@ void PrimitiveRenderer::TriangleRenderAttributes::render(
   }
 }
 
+PrimitiveRenderer::PrimitiveRenderer(const VboUsage usage)
+  : m_usage{usage}
+{
+}
+
 void PrimitiveRenderer::renderLine(
   const Color& color,
   const float lineWidth,
@@ -340,7 +345,8 @@ void PrimitiveRenderer::prepareLines(VboManager& vboManager)
   for (auto& [attributes, mesh] : m_lineMeshes)
   {
     IndexRangeRenderer& renderer =
-      m_lineMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh)))
+      m_lineMeshRenderers
+        .insert(std::make_pair(attributes, IndexRangeRenderer(mesh, m_usage)))
         .first->second;
     renderer.prepare(vboManager);
   }
@@ -351,7 +357,8 @@ void PrimitiveRenderer::prepareTriangles(VboManager& vboManager)
   for (auto& [attributes, mesh] : m_triangleMeshes)
   {
     IndexRangeRenderer& renderer =
-      m_triangleMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh)))
+      m_triangleMeshRenderers
+        .insert(std::make_pair(attributes, IndexRangeRenderer(mesh, m_usage)))
         .first->second;
     renderer.prepare(vboManager);
   }
@@ -22,6 +22,7 @@
 #include "Color.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/VboManager.h"
 
 #include <map>
 #include <vector>
@@ -101,7 +102,15 @@ private:
   using TriangleMeshRendererMap = std::map<TriangleRenderAttributes, IndexRangeRenderer>;
   TriangleMeshRendererMap m_triangleMeshRenderers;
 
+  VboUsage m_usage;
+
 public:
+  /**
+   * Pass VboUsage::StreamDraw if this renderer is only rendered during the current frame,
+   * e.g. if it is added to a render batch using RenderBatch::addOneShot.
+   */
+  explicit PrimitiveRenderer(VboUsage usage = VboUsage::StaticDraw);
+
   void renderLine(
     const Color& color,
     float lineWidth,
@@ -195,6 +195,16 @@ void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
     findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
 }
 
+void ShaderProgram::setAttribute(const std::string& name, const vm::mat4x4f& value)
+{
+  assert(checkActive());
+  const auto location = static_cast<GLuint>(findAttributeLocation(name));
+  for (size_t i = 0; i < 4; ++i)
+  {
+    glAssert(glVertexAttrib4fv(location + GLuint(i), value[i].v));
+  }
+}
+
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
 {
   auto it = m_attributeCache.find(name);
@@ -75,6 +75,12 @@ public:
   void set(const std::string& name, const vm::mat3x3f& value);
   void set(const std::string& name, const vm::mat4x4f& value);
 
+  /**
+   * Sets the value of the given vertex attribute for all vertices that don't take it from
+   * an attribute array.
+   */
+  void setAttribute(const std::string& name, const vm::mat4x4f& value);
+
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StreamingAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom::Renderer
+{
+
+StreamingAllocator::StreamingAllocator(const Index capacity, const Index maxCapacity)
+  : m_capacity{capacity}
+  , m_maxCapacity{std::max(capacity, maxCapacity)}
+{
+  assert(m_capacity > 0);
+}
+
+StreamingAllocator::Index StreamingAllocator::capacity() const
+{
+  return m_capacity;
+}
+
+StreamingAllocator::Index StreamingAllocator::frameSize() const
+{
+  return m_cursor - m_frameStart;
+}
+
+StreamingAllocator::FrameStart StreamingAllocator::beginFrame()
+{
+  const auto demand = m_frameDemand;
+  m_frameDemand = 0;
+
+  // assume that the next frame needs about as much as the previous frame, and reserve
+  // twice that so that the buffer can be used in turns by at least two frames
+  if (demand > m_capacity / 2 && m_capacity < m_maxCapacity)
+  {
+    while (m_capacity < 2 * demand && m_capacity < m_maxCapacity)
+    {
+      m_capacity = std::min(2 * m_capacity, m_maxCapacity);
+    }
+    m_cursor = m_frameStart = 0;
+    return FrameStart::Grow;
+  }
+
+  if (m_cursor + demand > m_capacity)
+  {
+    m_cursor = m_frameStart = 0;
+    return FrameStart::Wrap;
+  }
+
+  m_frameStart = m_cursor;
+  return FrameStart::Continue;
+}
+
+std::optional<StreamingAllocator::Index> StreamingAllocator::allocate(
+  const Index size, const Index alignment)
+{
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  const auto offset = (m_cursor + alignment - 1) & ~(alignment - 1);
+  if (offset + size > m_capacity)
+  {
+    m_frameDemand += size;
+    return std::nullopt;
+  }
+
+  m_frameDemand += offset + size - m_cursor;
+  m_cursor = offset + size;
+  return offset;
+}
+
+} // namespace TrenchBroom::Renderer
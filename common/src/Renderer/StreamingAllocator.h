@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace TrenchBroom::Renderer
+{
+
+/**
+ * Hands out ranges of a ring buffer for data that is only used during the current frame.
+ *
+ * Within a frame, ranges are allocated linearly and never overlap. At the start of the
+ * next frame, allocation either continues after the previous frame's ranges, starts
+ * over at the beginning of the buffer, or, if the previous frame did not fit, continues
+ * in a bigger buffer. The owner of the actual buffer is told which of these happened so
+ * that it can synchronize with the GPU or reallocate the buffer.
+ *
+ * This class does not depend on OpenGL.
+ */
+class StreamingAllocator
+{
+public:
+  using Index = size_t;
+
+  enum class FrameStart
+  {
+    /**
+     * Allocation continues after the previous frame's ranges.
+     */
+    Continue,
+    /**
+     * Allocation starts over at the beginning of the buffer, so ranges from previous
+     * frames will be overwritten.
+     */
+    Wrap,
+    /**
+     * The capacity was increased to fit the previous frame's allocations, and allocation
+     * starts over at the beginning of a new buffer.
+     */
+    Grow,
+  };
+
+private:
+  Index m_capacity;
+  Index m_maxCapacity;
+  Index m_cursor = 0;
+  Index m_frameStart = 0;
+  /**
+   * The number of bytes requested during the current frame, including any alignment
+   * padding and the requests that did not fit.
+   */
+  Index m_frameDemand = 0;
+
+public:
+  StreamingAllocator(Index capacity, Index maxCapacity);
+
+  Index capacity() const;
+
+  /**
+   * The number of bytes allocated since the last call to beginFrame.
+   */
+  Index frameSize() const;
+
+  /**
+   * Begins a new frame. All ranges allocated before are released.
+   */
+  FrameStart beginFrame();
+
+  /**
+   * Allocates a range of the given size whose offset is a multiple of the given
+   * alignment, which must be a power of two.
+   *
+   * Returns the offset of the range, or nothing if the range does not fit into the
+   * remainder of the buffer.
+   */
+  std::optional<Index> allocate(Index size, Index alignment);
+};
+
+} // namespace TrenchBroom::Renderer
@@ -35,6 +35,12 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -46,23 +52,23 @@ const size_t TextRenderer::RectCornerSegments = 3;
 const float TextRenderer::RectCornerRadius = 3.0f;
 
 TextRenderer::Entry::Entry(
-  std::vector<vm::vec2f>& i_vertices,
-  const vm::vec2f& i_size,
+  std::shared_ptr<const TextureFont::GlyphRun> i_glyphRun,
   const vm::vec3f& i_offset,
+  const float i_distance,
   const Color& i_textColor,
   const Color& i_backgroundColor)
-  : size(i_size)
+  : glyphRun(std::move(i_glyphRun))
   , offset(i_offset)
+  , distance(i_distance)
   , textColor(i_textColor)
   , backgroundColor(i_backgroundColor)
 {
-  using std::swap;
-  swap(vertices, i_vertices);
 }
 
 TextRenderer::EntryCollection::EntryCollection()
   : textVertexCount(0)
   , rectVertexCount(0)
+  , culledEntryCount(0)
 {
 }
 
@@ -106,49 +112,41 @@ void TextRenderer::renderString(
   const TextAnchor& position,
   const bool onTop)
 {
-
   const Camera& camera = renderContext.camera();
   const float distance = camera.perpendicularDistanceTo(position.position(camera));
-  if (distance <= 0.0f)
-    return;
 
-  if (!isVisible(renderContext, string, position, distance, onTop))
+  // check the distance first so that far away strings are not even laid out
+  if (distance <= 0.0f || !isInViewDistance(renderContext, distance, onTop))
+  {
+    ++renderContext.fontManager().textStats().culledStrings;
     return;
+  }
 
   FontManager& fontManager = renderContext.fontManager();
   TextureFont& font = fontManager.font(m_fontDescriptor);
 
-  std::vector<vm::vec2f> vertices = font.quads(string, true);
-  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-  const vm::vec2f size = font.measure(string);
-  const vm::vec3f offset = position.offset(camera, size);
+  auto glyphRun = font.glyphRun(string);
+  if (!isInViewport(renderContext, round(glyphRun->size), position))
+  {
+    ++fontManager.textStats().culledStrings;
+    return;
+  }
 
-  if (onTop)
-    addEntry(
-      m_entriesOnTop,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
-  else
-    addEntry(
-      m_entries,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
+  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+  const vm::vec3f offset = position.offset(camera, glyphRun->size);
+
+  addEntry(
+    onTop ? m_entriesOnTop : m_entries,
+    Entry(
+      std::move(glyphRun),
+      offset,
+      distance,
+      Color(textColor, alphaFactor * textColor.a()),
+      Color(backgroundColor, alphaFactor * backgroundColor.a())));
 }
 
-bool TextRenderer::isVisible(
-  RenderContext& renderContext,
-  const AttrString& string,
-  const TextAnchor& position,
-  const float distance,
-  const bool onTop) const
+bool TextRenderer::isInViewDistance(
+  const RenderContext& renderContext, const float distance, const bool onTop) const
 {
   if (!onTop)
   {
@@ -157,11 +155,17 @@ bool TextRenderer::isVisible(
     if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
       return false;
   }
+  return true;
+}
 
+bool TextRenderer::isInViewport(
+  const RenderContext& renderContext,
+  const vm::vec2f& size,
+  const TextAnchor& position) const
+{
   const Camera& camera = renderContext.camera();
   const Camera::Viewport& viewport = camera.viewport();
 
-  const vm::vec2f size = stringSize(renderContext, string);
   const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
   const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -191,23 +195,127 @@ float TextRenderer::computeAlphaFactor(
   }
 }
 
-void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry)
+void TextRenderer::addEntry(EntryCollection& collection, Entry entry)
 {
-  collection.entries.push_back(entry);
-  collection.textVertexCount += entry.vertices.size();
+  collection.textVertexCount += entry.glyphRun->vertices.size() / 2;
   collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
+  collection.entries.push_back(std::move(entry));
 }
 
-vm::vec2f TextRenderer::stringSize(
-  RenderContext& renderContext, const AttrString& string) const
+namespace
 {
-  FontManager& fontManager = renderContext.fontManager();
-  TextureFont& font = fontManager.font(m_fontDescriptor);
-  return round(font.measure(string));
+bool overlaps(const TextCullingEntry& lhs, const TextCullingEntry& rhs)
+{
+  return lhs.min.x() < rhs.max.x() && rhs.min.x() < lhs.max.x()
+         && lhs.min.y() < rhs.max.y() && rhs.min.y() < lhs.max.y();
+}
+
+// the size of the cells of the screen grid used to find overlapping strings, in pixels
+constexpr float ScreenCellSize = 64.0f;
+} // namespace
+
+std::vector<bool> cullOverlappingText(const std::vector<TextCullingEntry>& entries)
+{
+  // entries on top come first, then nearer entries take precedence
+  auto order = std::vector<size_t>(entries.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+    return entries[lhs].onTop != entries[rhs].onTop
+             ? entries[lhs].onTop
+             : entries[lhs].distance < entries[rhs].distance;
+  });
+
+  const auto cellIndex = [](const float coord) {
+    return static_cast<int>(std::floor(coord / ScreenCellSize));
+  };
+  const auto cellKey = [](const int x, const int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32u)
+           | static_cast<uint64_t>(static_cast<uint32_t>(y));
+  };
+
+  // maps each screen grid cell to the kept entries that touch it
+  auto cells = std::unordered_map<uint64_t, std::vector<const TextCullingEntry*>>{};
+  auto result = std::vector<bool>(entries.size(), false);
+
+  for (const auto index : order)
+  {
+    const auto& entry = entries[index];
+    const auto minX = cellIndex(entry.min.x());
+    const auto maxX = cellIndex(entry.max.x());
+    const auto minY = cellIndex(entry.min.y());
+    const auto maxY = cellIndex(entry.max.y());
+
+    auto culled = false;
+    for (auto x = minX; x <= maxX && !culled && !entry.onTop; ++x)
+    {
+      for (auto y = minY; y <= maxY && !culled; ++y)
+      {
+        if (const auto it = cells.find(cellKey(x, y)); it != cells.end())
+        {
+          culled = std::any_of(
+            it->second.begin(), it->second.end(), [&](const auto* other) {
+              return overlaps(entry, *other);
+            });
+        }
+      }
+    }
+
+    if (!culled)
+    {
+      for (auto x = minX; x <= maxX; ++x)
+      {
+        for (auto y = minY; y <= maxY; ++y)
+        {
+          cells[cellKey(x, y)].push_back(&entry);
+        }
+      }
+      result[index] = true;
+    }
+  }
+
+  return result;
+}
+
+void TextRenderer::cullOverlappingEntries()
+{
+  auto cullingEntries = std::vector<TextCullingEntry>{};
+  cullingEntries.reserve(m_entries.entries.size() + m_entriesOnTop.entries.size());
+
+  const auto addCullingEntries = [&](const auto& collection, const bool onTop) {
+    for (const auto& entry : collection.entries)
+    {
+      const auto min = entry.offset.xy() - m_inset;
+      const auto max = min + entry.glyphRun->size + 2.0f * m_inset;
+      cullingEntries.push_back(TextCullingEntry{min, max, entry.distance, onTop});
+    }
+  };
+  addCullingEntries(m_entries, false);
+  addCullingEntries(m_entriesOnTop, true);
+
+  const auto kept = cullOverlappingText(cullingEntries);
+
+  // the entries on top are at the end and always kept
+  auto entries = std::move(m_entries.entries);
+  m_entries.entries.clear();
+  m_entries.textVertexCount = 0;
+  m_entries.rectVertexCount = 0;
+
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (kept[i])
+    {
+      addEntry(m_entries, std::move(entries[i]));
+    }
+    else
+    {
+      ++m_entries.culledEntryCount;
+    }
+  }
 }
 
 void TextRenderer::doPrepareVertices(VboManager& vboManager)
 {
+  cullOverlappingEntries();
   prepare(m_entries, false, vboManager);
   prepare(m_entriesOnTop, true, vboManager);
 }
@@ -226,8 +334,10 @@ void TextRenderer::prepare(
     addEntry(entry, onTop, textVertices, rectVertices);
   }
 
-  collection.textArray = VertexArray::move(std::move(textVertices));
-  collection.rectArray = VertexArray::move(std::move(rectVertices));
+  // the arrays are rebuilt whenever this renderer is prepared, so they are only rendered
+  // during the current frame
+  collection.textArray = VertexArray::move(std::move(textVertices), VboUsage::StreamDraw);
+  collection.rectArray = VertexArray::move(std::move(rectVertices), VboUsage::StreamDraw);
 
   collection.textArray.prepare(vboManager);
   collection.rectArray.prepare(vboManager);
@@ -239,8 +349,8 @@ void TextRenderer::addEntry(
   std::vector<TextVertex>& textVertices,
   std::vector<RectVertex>& rectVertices)
 {
-  const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-  const vm::vec2f& stringSize = entry.size;
+  const std::vector<vm::vec2f>& stringVertices = entry.glyphRun->vertices;
+  const vm::vec2f& stringSize = entry.glyphRun->size;
 
   const vm::vec3f& offset = entry.offset;
 
@@ -278,6 +388,11 @@ void TextRenderer::doRender(RenderContext& renderContext)
   const vm::mat4x4f view = vm::view_matrix(vm::vec3f::neg_z(), vm::vec3f::pos_y());
   ReplaceTransformation ortho(renderContext.transformation(), projection, view);
 
+  auto& textStats = renderContext.fontManager().textStats();
+  textStats.renderedStrings += m_entries.entries.size() + m_entriesOnTop.entries.size();
+  textStats.culledStrings += m_entries.culledEntryCount + m_entriesOnTop.culledEntryCount;
+  textStats.textVertices += m_entries.textVertexCount + m_entriesOnTop.textVertexCount;
+
   render(m_entries, renderContext);
 
   glAssert(glDisable(GL_DEPTH_TEST));
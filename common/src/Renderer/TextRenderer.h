@@ -23,11 +23,13 @@
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextureFont.h"
 #include "Renderer/VertexArray.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom
@@ -38,6 +40,24 @@ class AttrString;
 class RenderContext;
 class TextAnchor;
 
+/**
+ * The screen rectangle of a string considered by cullOverlappingText.
+ */
+struct TextCullingEntry
+{
+  vm::vec2f min;
+  vm::vec2f max;
+  float distance;
+  bool onTop;
+};
+
+/**
+ * Returns for each of the given entries whether it is kept. Overlapping strings cannot be
+ * read anyway, so an entry is culled if it overlaps a nearer entry that is kept or an
+ * entry that is rendered on top. Entries rendered on top are never culled.
+ */
+std::vector<bool> cullOverlappingText(const std::vector<TextCullingEntry>& entries);
+
 class TextRenderer : public DirectRenderable
 {
 private:
@@ -49,16 +69,16 @@ private:
 
   struct Entry
   {
-    std::vector<vm::vec2f> vertices;
-    vm::vec2f size;
+    std::shared_ptr<const TextureFont::GlyphRun> glyphRun;
     vm::vec3f offset;
+    float distance;
     Color textColor;
     Color backgroundColor;
 
     Entry(
-      std::vector<vm::vec2f>& i_vertices,
-      const vm::vec2f& i_size,
+      std::shared_ptr<const TextureFont::GlyphRun> i_glyphRun,
       const vm::vec3f& i_offset,
+      float i_distance,
       const Color& i_textColor,
       const Color& i_backgroundColor);
   };
@@ -70,6 +90,7 @@ private:
     EntryList entries;
     size_t textVertexCount;
     size_t rectVertexCount;
+    size_t culledEntryCount;
 
     VertexArray textArray;
     VertexArray rectArray;
@@ -117,17 +138,20 @@ private:
     const TextAnchor& position,
     bool onTop);
 
-  bool isVisible(
-    RenderContext& renderContext,
-    const AttrString& string,
-    const TextAnchor& position,
-    float distance,
-    bool onTop) const;
+  bool isInViewDistance(
+    const RenderContext& renderContext, float distance, bool onTop) const;
+  bool isInViewport(
+    const RenderContext& renderContext,
+    const vm::vec2f& size,
+    const TextAnchor& position) const;
   float computeAlphaFactor(
     const RenderContext& renderContext, float distance, bool onTop) const;
-  void addEntry(EntryCollection& collection, const Entry& entry);
+  void addEntry(EntryCollection& collection, Entry entry);
 
-  vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+  /**
+   * Removes the entries that are culled by cullOverlappingText.
+   */
+  void cullOverlappingEntries();
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
@@ -205,6 +205,28 @@ vm::vec2f TextureFont::measure(const AttrString& string) const
   return measureString.size();
 }
 
+std::shared_ptr<const TextureFont::GlyphRun> TextureFont::glyphRun(
+  const AttrString& string)
+{
+  auto it = m_glyphRuns.lower_bound(string);
+  if (it == std::end(m_glyphRuns) || it->first.compare(string) != 0)
+  {
+    if (m_glyphRuns.size() >= MaxCachedGlyphRuns)
+    {
+      m_glyphRuns.clear();
+      it = std::end(m_glyphRuns);
+    }
+
+    auto glyphRun = std::make_shared<const GlyphRun>(GlyphRun{
+      quads(string, true),
+      measure(string),
+    });
+    it = m_glyphRuns.emplace_hint(it, string, std::move(glyphRun));
+  }
+
+  return it->second;
+}
+
 std::vector<vm::vec2f> TextureFont::quads(
   const std::string& string, const bool clockwise, const vm::vec2f& offset) const
 {
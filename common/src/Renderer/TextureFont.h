@@ -19,11 +19,13 @@
 
 #pragma once
 
+#include "AttrString.h"
 #include "Macros.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,12 +34,28 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-class AttrString;
 class FontGlyph;
 class FontTexture;
 
 class TextureFont
 {
+public:
+  /**
+   * The clockwise glyph quads of a string laid out at the origin, and the size of the
+   * string.
+   */
+  struct GlyphRun
+  {
+    std::vector<vm::vec2f> vertices;
+    vm::vec2f size;
+  };
+
+  /**
+   * The glyph run cache is cleared once it holds this many strings, e.g. after many
+   * entities have been renamed.
+   */
+  static constexpr size_t MaxCachedGlyphRuns = 4096;
+
 private:
   std::unique_ptr<FontTexture> m_texture;
   std::vector<FontGlyph> m_glyphs;
@@ -48,6 +66,8 @@ private:
   unsigned char m_firstChar;
   unsigned char m_charCount;
 
+  std::map<AttrString, std::shared_ptr<const GlyphRun>> m_glyphRuns;
+
 public:
   TextureFont(
     std::unique_ptr<FontTexture> texture,
@@ -71,6 +91,12 @@ public:
     const vm::vec2f& offset = vm::vec2f::zero()) const;
   vm::vec2f measure(const AttrString& string) const;
 
+  /**
+   * Returns the glyph run of the given string. Glyph runs are cached, so strings that
+   * are rendered every frame, such as entity classnames, are only laid out once.
+   */
+  std::shared_ptr<const GlyphRun> glyphRun(const AttrString& string);
+
   std::vector<vm::vec2f> quads(
     const std::string& string,
     bool clockwise,
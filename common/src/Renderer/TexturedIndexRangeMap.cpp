@@ -150,6 +150,18 @@ void TexturedIndexRangeMap::render(VertexArray& vertexArray, TextureRenderFunc&
   }
 }
 
+void TexturedIndexRangeMap::renderInstanced(
+  VertexArray& vertexArray, const size_t instanceCount)
+{
+  auto func = DefaultTextureRenderFunc{};
+  for (const auto& [texture, indexArray] : *m_data)
+  {
+    func.before(texture);
+    indexArray.renderInstanced(vertexArray, instanceCount);
+    func.after(texture);
+  }
+}
+
 void TexturedIndexRangeMap::forEachPrimitive(
   std::function<void(const Texture*, PrimType, size_t, size_t)> func) const
 {
@@ -184,6 +184,16 @@ public:
    */
   void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+  /**
+   * Renders the primitives stored in this index range map using the vertices in the given
+   * vertex array, once for each of the given number of instances. The primitives are
+   * batched by their associated textures.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(VertexArray& vertexArray, size_t instanceCount);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -73,6 +73,15 @@ void TexturedIndexRangeRenderer::render(TextureRenderFunc& func)
   }
 }
 
+void TexturedIndexRangeRenderer::renderInstanced(const size_t instanceCount)
+{
+  if (m_vertexArray.setup())
+  {
+    m_indexRange.renderInstanced(m_vertexArray, instanceCount);
+    m_vertexArray.cleanup();
+  }
+}
+
 MultiTexturedIndexRangeRenderer::MultiTexturedIndexRangeRenderer(
   std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> renderers)
   : m_renderers(std::move(renderers))
@@ -116,5 +125,13 @@ void MultiTexturedIndexRangeRenderer::render(TextureRenderFunc& func)
     renderer->render(func);
   }
 }
+
+void MultiTexturedIndexRangeRenderer::renderInstanced(const size_t instanceCount)
+{
+  for (auto& renderer : m_renderers)
+  {
+    renderer->renderInstanced(instanceCount);
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -47,6 +47,12 @@ public:
   virtual void prepare(VboManager& vboManager) = 0;
   virtual void render() = 0;
   virtual void render(TextureRenderFunc& func) = 0;
+
+  /**
+   * Renders the given number of instances. The per instance data must be set up by the
+   * caller.
+   */
+  virtual void renderInstanced(size_t instanceCount) = 0;
 };
 
 class TexturedIndexRangeRenderer : public TexturedRenderer
@@ -70,6 +76,7 @@ public:
   void prepare(VboManager& vboManager) override;
   void render() override;
   void render(TextureRenderFunc& func) override;
+  void renderInstanced(size_t instanceCount) override;
 };
 
 class MultiTexturedIndexRangeRenderer : public TexturedRenderer
@@ -87,6 +94,7 @@ public:
   void prepare(VboManager& vboManager) override;
   void render() override;
   void render(TextureRenderFunc& func) override;
+  void renderInstanced(size_t instanceCount) override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
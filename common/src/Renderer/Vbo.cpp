@@ -30,6 +30,9 @@ namespace Renderer
 Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage)
   : m_type(type)
   , m_capacity(capacity)
+  , m_offset(0)
+  , m_streamed(false)
+  , m_mappedMemory(nullptr)
 {
   assert(m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER);
 
@@ -38,10 +41,29 @@ Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage)
   glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
 }
 
+Vbo::Vbo(
+  GLenum type,
+  const GLuint bufferId,
+  const size_t offset,
+  const size_t capacity,
+  unsigned char* mappedMemory)
+  : m_type(type)
+  , m_capacity(capacity)
+  , m_bufferId(bufferId)
+  , m_offset(offset)
+  , m_streamed(true)
+  , m_mappedMemory(mappedMemory)
+{
+  assert(m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER);
+}
+
 void Vbo::free()
 {
   assert(m_bufferId != 0);
-  glAssert(glDeleteBuffers(1, &m_bufferId));
+  if (!m_streamed)
+  {
+    glAssert(glDeleteBuffers(1, &m_bufferId));
+  }
   m_bufferId = 0;
 }
 
@@ -52,7 +74,7 @@ Vbo::~Vbo()
 
 size_t Vbo::offset() const
 {
-  return 0;
+  return m_offset;
 }
 
 size_t Vbo::capacity() const
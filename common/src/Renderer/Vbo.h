@@ -22,6 +22,7 @@
 #include "Renderer/VboManager.h"
 
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 #include <vector>
 
@@ -43,24 +44,46 @@ private:
   GLenum m_type;
   size_t m_capacity;
   GLuint m_bufferId;
+  size_t m_offset;
+  /**
+   * If true, this VBO is a block of a streaming buffer owned by the VboManager.
+   */
+  bool m_streamed;
+  /**
+   * The persistently mapped memory of this VBO's block, or null if the block is not
+   * mapped.
+   */
+  unsigned char* m_mappedMemory;
 
   /**
    * Immediately creates and binds to a buffer of the given type and capacity.
    * The contents are initially unspecified.
    */
   Vbo(GLenum type, size_t capacity, GLenum usage);
+
+  /**
+   * Creates a VBO for a block of a streaming buffer at the given offset. If the streaming
+   * buffer is persistently mapped, mappedMemory points to the start of the block.
+   */
+  Vbo(
+    GLenum type,
+    GLuint bufferId,
+    size_t offset,
+    size_t capacity,
+    unsigned char* mappedMemory);
   ~Vbo();
 
   /**
-   * Deletes the underlying OpenGL buffer with glDeleteBuffers.
-   * Must be called before the destructor.
+   * Deletes the underlying OpenGL buffer with glDeleteBuffers, unless this VBO is a block
+   * of a streaming buffer. Must be called before the destructor.
    * Calling any other methods after free() is disallowed.
    */
   void free();
 
 public:
   /**
-   * Deprecated, always returns 0.
+   * Returns the offset of this VBO's data in the underlying OpenGL buffer. This is 0
+   * unless this VBO is a block of a streaming buffer.
    */
   size_t offset() const;
   size_t capacity() const;
@@ -98,8 +121,14 @@ public:
     static_assert(std::is_trivially_copyable<T>::value);
     static_assert(std::is_standard_layout<T>::value);
 
+    if (m_mappedMemory != nullptr)
+    {
+      std::memcpy(m_mappedMemory + address, array, size);
+      return size;
+    }
+
     const GLvoid* ptr = static_cast<const GLvoid*>(array);
-    const GLintptr offset = static_cast<GLintptr>(address);
+    const GLintptr offset = static_cast<GLintptr>(m_offset + address);
     const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
     glAssert(glBindBuffer(m_type, m_bufferId));
     glAssert(glBufferSubData(m_type, offset, sizei, ptr));
@@ -21,9 +21,12 @@
 
 #include "GL.h"
 #include "Macros.h"
+#include "Renderer/StreamingAllocator.h"
 #include "Vbo.h"
 
 #include <algorithm> // for std::max
+#include <deque>
+#include <optional>
 
 namespace TrenchBroom
 {
@@ -52,10 +55,190 @@ static GLenum usageToOpenGL(const VboUsage usage)
     return GL_STATIC_DRAW;
   case VboUsage::DynamicDraw:
     return GL_DYNAMIC_DRAW;
+  case VboUsage::StreamDraw:
+    return GL_STREAM_DRAW;
     switchDefault();
   }
 }
 
+static const size_t InitialStreamingBufferCapacity = 1u << 20;
+static const size_t MaxStreamingBufferCapacity = 1u << 26;
+static const size_t StreamingBufferAlignment = 16u;
+
+static bool supportsPersistentMapping()
+{
+  return GLEW_ARB_buffer_storage && GLEW_ARB_sync;
+}
+
+// VboManager::StreamingBuffer
+
+/**
+ * A ring buffer that VBOs for data that is only drawn during the current frame are
+ * carved out of.
+ *
+ * If the driver supports it, the buffer is persistently mapped and the VBOs write
+ * directly into the mapped memory. Each frame is then guarded by a fence, and before a
+ * block is handed out again, we wait for the fences of the frames which used it.
+ *
+ * Otherwise, the VBOs write using glBufferSubData, and the buffer is orphaned whenever
+ * allocation starts over at its beginning, so that the driver can hand us new storage
+ * while the GPU still reads from the old one.
+ */
+class VboManager::StreamingBuffer
+{
+private:
+  struct Fence
+  {
+    size_t lap;
+    size_t frameStart;
+    GLsync sync;
+  };
+
+  GLenum m_type;
+  bool m_persistent;
+  StreamingAllocator m_allocator;
+  GLuint m_bufferId = 0;
+  unsigned char* m_mappedMemory = nullptr;
+
+  /**
+   * Counts how often allocation started over at the beginning of the buffer.
+   */
+  size_t m_lap = 0;
+  std::optional<size_t> m_frameStart;
+  std::deque<Fence> m_fences;
+
+public:
+  explicit StreamingBuffer(const GLenum type)
+    : m_type{type}
+    , m_persistent{supportsPersistentMapping()}
+    , m_allocator{InitialStreamingBufferCapacity, MaxStreamingBufferCapacity}
+  {
+    create();
+  }
+
+  // The OpenGL context may not be current anymore when the VboManager is destroyed, so
+  // the buffer is released along with the context.
+  ~StreamingBuffer() = default;
+
+  Vbo* allocate(const size_t capacity)
+  {
+    const auto offset = m_allocator.allocate(capacity, StreamingBufferAlignment);
+    if (!offset)
+    {
+      return nullptr;
+    }
+
+    if (!m_frameStart)
+    {
+      m_frameStart = *offset;
+    }
+    waitForFences(*offset + capacity);
+
+    auto* mappedMemory = m_mappedMemory != nullptr ? m_mappedMemory + *offset : nullptr;
+    return new Vbo{m_type, m_bufferId, *offset, capacity, mappedMemory};
+  }
+
+  void beginFrame()
+  {
+    if (m_persistent && m_frameStart)
+    {
+      auto* sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      m_fences.push_back(Fence{m_lap, *m_frameStart, sync});
+    }
+    m_frameStart = std::nullopt;
+
+    switch (m_allocator.beginFrame())
+    {
+    case StreamingAllocator::FrameStart::Continue:
+      break;
+    case StreamingAllocator::FrameStart::Wrap:
+      ++m_lap;
+      if (!m_persistent)
+      {
+        glAssert(glBindBuffer(m_type, m_bufferId));
+        glAssert(glBufferData(
+          m_type,
+          static_cast<GLsizeiptr>(m_allocator.capacity()),
+          nullptr,
+          GL_STREAM_DRAW));
+      }
+      break;
+    case StreamingAllocator::FrameStart::Grow:
+      ++m_lap;
+      destroy();
+      create();
+      break;
+      switchDefault();
+    }
+  }
+
+private:
+  void create()
+  {
+    const auto size = static_cast<GLsizeiptr>(m_allocator.capacity());
+
+    glAssert(glGenBuffers(1, &m_bufferId));
+    glAssert(glBindBuffer(m_type, m_bufferId));
+    if (m_persistent)
+    {
+      const auto flags = GLbitfield(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT)
+                         | GLbitfield(GL_MAP_COHERENT_BIT);
+      glAssert(glBufferStorage(m_type, size, nullptr, flags));
+      m_mappedMemory =
+        static_cast<unsigned char*>(glMapBufferRange(m_type, 0, size, flags));
+      if (m_mappedMemory == nullptr)
+      {
+        // the storage of the buffer is immutable now, so start over with a regular one
+        glAssert(glDeleteBuffers(1, &m_bufferId));
+        m_persistent = false;
+        create();
+      }
+    }
+    else
+    {
+      glAssert(glBufferData(m_type, size, nullptr, GL_STREAM_DRAW));
+    }
+  }
+
+  void destroy()
+  {
+    if (m_mappedMemory != nullptr)
+    {
+      glAssert(glBindBuffer(m_type, m_bufferId));
+      glAssert(glUnmapBuffer(m_type));
+      m_mappedMemory = nullptr;
+    }
+    glAssert(glDeleteBuffers(1, &m_bufferId));
+    m_bufferId = 0;
+
+    // the GL keeps the storage of the deleted buffer alive while the GPU still reads it
+    for (const auto& fence : m_fences)
+    {
+      glAssert(glDeleteSync(fence.sync));
+    }
+    m_fences.clear();
+  }
+
+  /**
+   * Waits until the GPU has finished the frames of the previous laps which used the
+   * buffer before the given offset.
+   */
+  void waitForFences(const size_t end)
+  {
+    while (!m_fences.empty() && m_fences.front().lap < m_lap
+           && (m_fences.front().frameStart < end || m_fences.front().lap + 1 < m_lap))
+    {
+      const auto sync = m_fences.front().sync;
+      while (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000u)
+             == GL_TIMEOUT_EXPIRED)
+      {
+      }
+      glAssert(glDeleteSync(sync));
+      m_fences.pop_front();
+    }
+  }
+};
+
 // VboManager
 
 VboManager::VboManager(ShaderManager* shaderManager)
@@ -66,8 +249,21 @@ VboManager::VboManager(ShaderManager* shaderManager)
 {
 }
 
+VboManager::~VboManager() = default;
+
 Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage)
 {
+  if (usage == VboUsage::StreamDraw)
+  {
+    if (auto* result = streamingBuffer(type).allocate(capacity))
+    {
+      m_streamingStats.streamedBytes += capacity;
+      m_streamingStats.avoidedAllocations++;
+      return result;
+    }
+    m_streamingStats.overflowAllocations++;
+  }
+
   auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
 
   m_currentVboSize += capacity;
@@ -79,6 +275,13 @@ Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage
 
 void VboManager::destroyVbo(Vbo* vbo)
 {
+  if (vbo->m_streamed)
+  {
+    vbo->free();
+    delete vbo;
+    return;
+  }
+
   m_currentVboSize -= vbo->capacity();
   m_currentVboCount--;
 
@@ -86,6 +289,19 @@ void VboManager::destroyVbo(Vbo* vbo)
   delete vbo;
 }
 
+void VboManager::beginFrame()
+{
+  m_streamingStats = StreamingStats{};
+  if (m_arrayStreamingBuffer)
+  {
+    m_arrayStreamingBuffer->beginFrame();
+  }
+  if (m_elementArrayStreamingBuffer)
+  {
+    m_elementArrayStreamingBuffer->beginFrame();
+  }
+}
+
 size_t VboManager::peakVboCount() const
 {
   return m_peakVboCount;
@@ -101,9 +317,25 @@ size_t VboManager::currentVboSize() const
   return m_currentVboSize;
 }
 
+const VboManager::StreamingStats& VboManager::streamingStats() const
+{
+  return m_streamingStats;
+}
+
 ShaderManager& VboManager::shaderManager()
 {
   return *m_shaderManager;
 }
+
+VboManager::StreamingBuffer& VboManager::streamingBuffer(const VboType type)
+{
+  auto& streamingBuffer = type == VboType::ArrayBuffer ? m_arrayStreamingBuffer
+                                                       : m_elementArrayStreamingBuffer;
+  if (!streamingBuffer)
+  {
+    streamingBuffer = std::make_unique<StreamingBuffer>(typeToOpenGL(type));
+  }
+  return *streamingBuffer;
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,6 +22,7 @@
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <memory>
 
 namespace TrenchBroom
 {
@@ -39,31 +40,82 @@ enum class VboType
 enum class VboUsage
 {
   StaticDraw,
-  DynamicDraw
+  DynamicDraw,
+  /**
+   * The contents are written once and only drawn until the next call to
+   * VboManager::beginFrame. Such VBOs are carved out of a streaming buffer instead of
+   * creating a separate OpenGL buffer for each of them.
+   */
+  StreamDraw
 };
 
 class VboManager
 {
+public:
+  struct StreamingStats
+  {
+    /**
+     * The number of bytes written into the streaming buffers.
+     */
+    size_t streamedBytes = 0;
+    /**
+     * The number of VBOs that were carved out of the streaming buffers, each of which
+     * avoided creating an OpenGL buffer.
+     */
+    size_t avoidedAllocations = 0;
+    /**
+     * The number of VBOs that did not fit into the streaming buffers and were allocated
+     * separately.
+     */
+    size_t overflowAllocations = 0;
+  };
+
 private:
+  class StreamingBuffer;
+
   size_t m_peakVboCount;
   size_t m_currentVboCount;
   size_t m_currentVboSize;
   ShaderManager* m_shaderManager;
 
+  std::unique_ptr<StreamingBuffer> m_arrayStreamingBuffer;
+  std::unique_ptr<StreamingBuffer> m_elementArrayStreamingBuffer;
+  StreamingStats m_streamingStats;
+
 public:
   explicit VboManager(ShaderManager* shaderManager);
+  ~VboManager();
+
   /**
    * Immediately creates and binds to an OpenGL buffer of the given type and capacity.
    * The contents are initially unspecified. See Vbo class.
+   *
+   * If the given usage is VboUsage::StreamDraw, the returned VBO is a block of a
+   * streaming buffer if possible. Such a VBO must not be drawn after the next call to
+   * beginFrame.
    */
   Vbo* allocateVbo(VboType type, size_t capacity, VboUsage usage = VboUsage::StaticDraw);
   void destroyVbo(Vbo* vbo);
 
+  /**
+   * Begins a new frame. The blocks of the streaming buffers that were handed out before
+   * will be reused.
+   */
+  void beginFrame();
+
   size_t peakVboCount() const;
   size_t currentVboCount() const;
   size_t currentVboSize() const;
 
+  /**
+   * Returns the statistics of the streaming buffers since the last call to beginFrame.
+   */
+  const StreamingStats& streamingStats() const;
+
   ShaderManager& shaderManager();
+
+private:
+  StreamingBuffer& streamingBuffer(VboType type);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
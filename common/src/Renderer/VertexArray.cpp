@@ -132,6 +132,38 @@ void VertexArray::render(
   }
 }
 
+void VertexArray::renderInstanced(
+  const PrimType primType,
+  const GLIndices& indices,
+  const GLCounts& counts,
+  const GLint primCount,
+  const GLsizei instanceCount)
+{
+  assert(prepared());
+
+  const auto drawInstanced = [&]() {
+    for (GLint i = 0; i < primCount; ++i)
+    {
+      const auto ui = static_cast<size_t>(i);
+      glAssert(glDrawArraysInstancedARB(
+        toGL(primType), indices[ui], counts[ui], instanceCount));
+    }
+  };
+
+  if (!m_setup)
+  {
+    if (setup())
+    {
+      drawInstanced();
+      cleanup();
+    }
+  }
+  else
+  {
+    drawInstanced();
+  }
+}
+
 void VertexArray::render(
   const PrimType primType, const GLIndices& indices, const GLsizei count)
 {
@@ -70,6 +70,7 @@ private:
     VboManager* m_vboManager;
     Vbo* m_vbo;
     size_t m_vertexCount;
+    VboUsage m_usage;
 
   public:
     size_t vertexCount() const override { return m_vertexCount; }
@@ -81,8 +82,7 @@ private:
       if (m_vertexCount > 0 && m_vbo == nullptr)
       {
         m_vboManager = &vboManager;
-        m_vbo = vboManager.allocateVbo(VboType::ArrayBuffer, sizeInBytes());
-        ;
+        m_vbo = vboManager.allocateVbo(VboType::ArrayBuffer, sizeInBytes(), m_usage);
         m_vbo->writeBuffer(0, doGetVertices());
       }
     }
@@ -101,10 +101,11 @@ private:
     }
 
   protected:
-    Holder(const size_t vertexCount)
+    Holder(const size_t vertexCount, const VboUsage usage)
       : m_vboManager(nullptr)
       , m_vbo(nullptr)
       , m_vertexCount(vertexCount)
+      , m_usage(usage)
     {
     }
 
@@ -134,14 +135,14 @@ private:
     VertexList m_vertices;
 
   public:
-    ByValueHolder(const VertexList& vertices)
-      : Holder<VertexSpec>(vertices.size())
+    ByValueHolder(const VertexList& vertices, const VboUsage usage)
+      : Holder<VertexSpec>(vertices.size(), usage)
       , m_vertices(vertices)
     {
     }
 
-    ByValueHolder(VertexList&& vertices)
-      : Holder<VertexSpec>(vertices.size())
+    ByValueHolder(VertexList&& vertices, const VboUsage usage)
+      : Holder<VertexSpec>(vertices.size(), usage)
       , m_vertices(std::move(vertices))
     {
     }
@@ -167,7 +168,7 @@ private:
 
   public:
     ByRefHolder(const VertexList& vertices)
-      : Holder<VertexSpec>(vertices.size())
+      : Holder<VertexSpec>(vertices.size(), VboUsage::StaticDraw)
       , m_vertices(vertices)
     {
     }
@@ -191,29 +192,42 @@ public:
    * Creates a new vertex array by copying the given vertices. After this operation, the
    * given vector of vertices is left unchanged.
    *
+   * Pass VboUsage::StreamDraw if the vertex array is only rendered during the current
+   * frame, see VboManager::allocateVbo.
+   *
    * @tparam Attrs the vertex attribute types
    * @param vertices the vertices to copy
+   * @param usage the usage of the vertex buffer object
    * @return the vertex array
    */
   template <typename... Attrs>
-  static VertexArray copy(const std::vector<GLVertex<Attrs...>>& vertices)
+  static VertexArray copy(
+    const std::vector<GLVertex<Attrs...>>& vertices,
+    const VboUsage usage = VboUsage::StaticDraw)
   {
     return VertexArray(
-      std::make_shared<ByValueHolder<typename GLVertex<Attrs...>::Type>>(vertices));
+      std::make_shared<ByValueHolder<typename GLVertex<Attrs...>::Type>>(
+        vertices, usage));
   }
 
   /**
    * Creates a new vertex array by moving the contents of the given vertices.
    *
+   * Pass VboUsage::StreamDraw if the vertex array is only rendered during the current
+   * frame, see VboManager::allocateVbo.
+   *
    * @tparam Attrs the vertex attribute types
    * @param vertices the vertices to move
+   * @param usage the usage of the vertex buffer object
    * @return the vertex array
    */
   template <typename... Attrs>
-  static VertexArray move(std::vector<GLVertex<Attrs...>>&& vertices)
+  static VertexArray move(
+    std::vector<GLVertex<Attrs...>>&& vertices,
+    const VboUsage usage = VboUsage::StaticDraw)
   {
     return VertexArray(std::make_shared<ByValueHolder<typename GLVertex<Attrs...>::Type>>(
-      std::move(vertices)));
+      std::move(vertices), usage));
   }
 
   /**
@@ -319,6 +333,24 @@ public:
   void render(
     PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
 
+  /**
+   * Renders a number of sub ranges of this vertex array as ranges of primitives of the
+   * given type, once for each of the given number of instances. The per instance data
+   * must be set up by the caller. Requires the ARB_draw_instanced extension.
+   *
+   * @param primType the primitive type to render
+   * @param indices the start indices of the ranges to render
+   * @param counts the lengths of the ranges to render
+   * @param primCount the number of ranges to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(
+    PrimType primType,
+    const GLIndices& indices,
+    const GLCounts& counts,
+    GLint primCount,
+    GLsizei instanceCount);
+
   /**
    * Renders a number of primitives of the given type, the vertices of which are indicates
    * by the given index array.
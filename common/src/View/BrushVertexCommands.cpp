@@ -28,10 +28,12 @@ namespace TrenchBroom
 {
 namespace View
 {
+// The vertex handles are selected by position after undo, so the geometry of the stored
+// brushes must be restored exactly and must not be discarded.
 BrushVertexCommandBase::BrushVertexCommandBase(
   const std::string& name,
   std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes)
-  : SwapNodeContentsCommand{name, std::move(nodes)}
+  : SwapNodeContentsCommand{name, std::move(nodes), false}
 {
 }
 
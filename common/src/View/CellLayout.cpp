@@ -24,9 +24,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
 namespace TrenchBroom::View
 {
+namespace
+{
+
+float itemScale(
+  const LayoutItem& item,
+  const float maxUpScale,
+  const float maxWidth,
+  const float maxHeight)
+{
+  return std::min(
+    std::min(maxWidth / item.itemWidth, maxHeight / item.itemHeight), maxUpScale);
+}
+
+} // namespace
 
 float LayoutBounds::left() const
 {
@@ -180,6 +195,7 @@ void LayoutCell::doLayout(
 LayoutRow::LayoutRow(
   const float x,
   const float y,
+  const size_t firstItemIndex,
   const float cellMargin,
   const float titleMargin,
   const float maxWidth,
@@ -199,6 +215,7 @@ LayoutRow::LayoutRow(
   , m_minCellHeight{minCellHeight}
   , m_maxCellHeight{maxCellHeight}
   , m_bounds{x, y, 0.0f, 0.0f}
+  , m_firstItemIndex{firstItemIndex}
 {
 }
 
@@ -207,6 +224,16 @@ const LayoutBounds& LayoutRow::bounds() const
   return m_bounds;
 }
 
+size_t LayoutRow::firstItemIndex() const
+{
+  return m_firstItemIndex;
+}
+
+size_t LayoutRow::itemCount() const
+{
+  return m_itemCount;
+}
+
 const std::vector<LayoutCell>& LayoutRow::cells() const
 {
   return m_cells;
@@ -239,42 +266,20 @@ bool LayoutRow::intersectsY(const float y, const float height) const
   return m_bounds.intersectsY(y, height);
 }
 
-bool LayoutRow::canAddItem(
-  const float itemWidth,
-  const float itemHeight,
-  const float titleWidth,
-  const float titleHeight) const
+bool LayoutRow::canAddItem(const LayoutItem& item) const
 {
-  auto x = m_bounds.right();
   auto width = m_bounds.width;
-  if (!m_cells.empty())
+  if (m_itemCount > 0)
   {
-    x += m_cellMargin;
     width += m_cellMargin;
   }
+  width += cellWidth(item);
 
-  auto cell = LayoutCell{
-    std::any{},
-    "",
-    x,
-    m_bounds.top(),
-    itemWidth,
-    itemHeight,
-    titleWidth,
-    titleHeight,
-    m_titleMargin,
-    m_maxUpScale,
-    m_minCellWidth,
-    m_maxCellWidth,
-    m_minCellHeight,
-    m_maxCellHeight};
-  width += cell.cellBounds().width;
-
-  if (m_maxCells == 0 && width > m_maxWidth && !m_cells.empty())
+  if (m_maxCells == 0 && width > m_maxWidth && m_itemCount > 0)
   {
     return false;
   }
-  if (m_maxCells > 0 && m_cells.size() >= m_maxCells - 1)
+  if (m_maxCells > 0 && m_itemCount >= m_maxCells - 1)
   {
     return false;
   }
@@ -282,66 +287,73 @@ bool LayoutRow::canAddItem(
   return true;
 }
 
-void LayoutRow::addItem(
-  std::any item,
-  std::string title,
-  const float itemWidth,
-  const float itemHeight,
-  const float titleWidth,
-  const float titleHeight)
+void LayoutRow::addItem(const LayoutItem& item)
 {
-  float x = m_bounds.right();
-  float width = m_bounds.width;
-  if (!m_cells.empty())
+  auto width = m_bounds.width;
+  if (m_itemCount > 0)
   {
-    x += m_cellMargin;
     width += m_cellMargin;
   }
+  width += cellWidth(item);
 
-  auto cell = LayoutCell{
-    std::move(item),
-    std::move(title),
-    x,
-    m_bounds.top(),
-    itemWidth,
-    itemHeight,
-    titleWidth,
-    titleHeight,
-    m_titleMargin,
-    m_maxUpScale,
-    m_minCellWidth,
-    m_maxCellWidth,
-    m_minCellHeight,
-    m_maxCellHeight};
-  width += cell.cellBounds().width;
-
-  const auto newItemRowHeight =
-    cell.cellBounds().height - cell.titleBounds().height - m_titleMargin;
-  if (newItemRowHeight > m_minCellHeight)
-  {
-    m_minCellHeight = newItemRowHeight;
-    assert(m_minCellHeight <= m_maxCellHeight);
-    readjustItems();
-  }
+  // This mirrors the computation of the cell height in LayoutCell::doLayout. The item row
+  // height only ever grows, and all cells of this row are laid out using the final item
+  // row height when they are materialized.
+  const auto scale = itemScale(item, m_maxUpScale, m_maxCellWidth, m_maxCellHeight);
+  const auto itemRowHeight = std::max(m_minCellHeight, scale * item.itemHeight);
+  m_minCellHeight = itemRowHeight;
+  assert(m_minCellHeight <= m_maxCellHeight);
 
+  const auto cellHeight = itemRowHeight + item.titleHeight + m_titleMargin;
   m_bounds = LayoutBounds{
-    m_bounds.left(),
-    m_bounds.top(),
-    width,
-    std::max(m_bounds.height, cell.cellBounds().height)};
+    m_bounds.left(), m_bounds.top(), width, std::max(m_bounds.height, cellHeight)};
 
-  m_cells.push_back(std::move(cell));
+  ++m_itemCount;
+  m_cells.clear();
 }
 
-void LayoutRow::readjustItems()
+void LayoutRow::materializeCells(const std::vector<LayoutItem>& items)
 {
-  for (auto& cell : m_cells)
+  if (m_cells.size() == m_itemCount)
+  {
+    return;
+  }
+
+  assert(m_firstItemIndex + m_itemCount <= items.size());
+
+  m_cells.clear();
+  m_cells.reserve(m_itemCount);
+
+  auto x = m_bounds.left();
+  for (size_t i = m_firstItemIndex; i < m_firstItemIndex + m_itemCount; ++i)
   {
-    cell.updateLayout(
-      m_maxUpScale, m_minCellWidth, m_maxCellWidth, m_minCellHeight, m_maxCellHeight);
+    const auto& item = items[i];
+    const auto& cell = m_cells.emplace_back(
+      item.item,
+      item.title,
+      x,
+      m_bounds.top(),
+      item.itemWidth,
+      item.itemHeight,
+      item.titleWidth,
+      item.titleHeight,
+      m_titleMargin,
+      m_maxUpScale,
+      m_minCellWidth,
+      m_maxCellWidth,
+      m_minCellHeight,
+      m_maxCellHeight);
+    x = cell.cellBounds().right() + m_cellMargin;
   }
 }
 
+float LayoutRow::cellWidth(const LayoutItem& item) const
+{
+  const auto scale = itemScale(item, m_maxUpScale, m_maxCellWidth, m_maxCellHeight);
+  const auto clippedTitleWidth = std::min(item.titleWidth, m_maxCellWidth);
+  return std::max(m_minCellWidth, std::max(scale * item.itemWidth, clippedTitleWidth));
+}
+
 LayoutGroup::LayoutGroup(
   std::string title,
   const float x,
@@ -442,6 +454,17 @@ LayoutBounds LayoutGroup::bounds() const
     m_contentBounds.bottom() - m_titleBounds.top()};
 }
 
+const std::vector<LayoutItem>& LayoutGroup::items() const
+{
+  return m_items;
+}
+
+std::vector<LayoutItem> LayoutGroup::releaseItems()
+{
+  m_rows.clear();
+  return std::move(m_items);
+}
+
 const std::vector<LayoutRow>& LayoutGroup::rows() const
 {
   return m_rows;
@@ -449,40 +472,56 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
 
 size_t LayoutGroup::indexOfRowAt(const float y) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
+  const auto it =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return y >= row.bounds().bottom();
+    });
+  return size_t(std::distance(m_rows.begin(), it));
+}
+
+const LayoutCell* LayoutGroup::cellAt(const float x, const float y)
+{
+  for (auto it = firstRowNotAbove(y); it != m_rows.end() && y >= it->bounds().top(); ++it)
   {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y < rowBounds.bottom())
+    it->materializeCells(m_items);
+    if (const auto* cell = it->cellAt(x, y))
     {
-      return i;
+      return cell;
     }
   }
 
-  return m_rows.size();
+  return nullptr;
 }
 
-const LayoutCell* LayoutGroup::cellAt(const float x, const float y) const
+const LayoutCell* LayoutGroup::cellForItem(const size_t itemIndex)
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
+  // rows store consecutive ranges of items, so the row containing the item is found by
+  // its item range alone
+  const auto it =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return row.firstItemIndex() + row.itemCount() <= itemIndex;
+    });
+  if (it == m_rows.end())
   {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y > rowBounds.bottom())
-    {
-      continue;
-    }
-    if (y < rowBounds.top())
-    {
-      return nullptr;
-    }
-    if (const auto* cell = row.cellAt(x, y))
+    return nullptr;
+  }
+
+  it->materializeCells(m_items);
+  return &it->cells()[itemIndex - it->firstItemIndex()];
+}
+
+void LayoutGroup::collectCells(
+  const float y, const float height, std::vector<const LayoutCell*>& result)
+{
+  for (auto it = firstRowNotAbove(y); it != m_rows.end() && it->intersectsY(y, height);
+       ++it)
+  {
+    it->materializeCells(m_items);
+    for (const auto& cell : it->cells())
     {
-      return cell;
+      result.push_back(&cell);
     }
   }
-
-  return nullptr;
 }
 
 bool LayoutGroup::hitTest(const float x, const float y) const
@@ -495,20 +534,18 @@ bool LayoutGroup::intersectsY(const float y, const float height) const
   return bounds().intersectsY(y, height);
 }
 
-void LayoutGroup::addItem(
-  std::any item,
-  std::string title,
-  const float itemWidth,
-  const float itemHeight,
-  const float titleWidth,
-  const float titleHeight)
+void LayoutGroup::addItem(LayoutItem item)
 {
+  const auto itemIndex = m_items.size();
+  m_items.push_back(std::move(item));
+
   if (m_rows.empty())
   {
     const auto y = m_contentBounds.top();
     m_rows.emplace_back(
       m_contentBounds.left(),
       y,
+      itemIndex,
       m_cellMargin,
       m_titleMargin,
       m_contentBounds.width,
@@ -520,13 +557,14 @@ void LayoutGroup::addItem(
       m_maxCellHeight);
   }
 
-  if (!m_rows.back().canAddItem(itemWidth, itemHeight, titleWidth, titleHeight))
+  if (!m_rows.back().canAddItem(m_items.back()))
   {
     const auto oldBounds = m_rows.back().bounds();
     const auto y = oldBounds.bottom() + m_rowMargin;
     m_rows.emplace_back(
       m_contentBounds.left(),
       y,
+      itemIndex,
       m_cellMargin,
       m_titleMargin,
       m_contentBounds.width,
@@ -547,9 +585,8 @@ void LayoutGroup::addItem(
 
   const auto oldRowHeight = m_rows.back().bounds().height;
 
-  assert(m_rows.back().canAddItem(itemWidth, itemHeight, titleWidth, titleHeight));
-  m_rows.back().addItem(
-    std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight);
+  assert(m_rows.back().canAddItem(m_items.back()));
+  m_rows.back().addItem(m_items.back());
 
   const auto newRowHeight = m_rows.back().bounds().height;
   m_contentBounds = LayoutBounds{
@@ -559,6 +596,13 @@ void LayoutGroup::addItem(
     m_contentBounds.height + (newRowHeight - oldRowHeight)};
 }
 
+std::vector<LayoutRow>::iterator LayoutGroup::firstRowNotAbove(const float y)
+{
+  return std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+    return row.bounds().bottom() < y;
+  });
+}
+
 CellLayout::CellLayout(const size_t maxCellsPerRow)
   : m_maxCellsPerRow{maxCellsPerRow}
 {
@@ -722,18 +766,11 @@ float CellLayout::rowPosition(const float y, const int offset)
     validate();
   }
 
-  auto groupIndex = m_groups.size();
-  for (size_t i = 0; i < m_groups.size(); ++i)
-  {
-    const LayoutGroup& candidate = m_groups[i];
-    const LayoutBounds groupBounds = candidate.bounds();
-    if (y + m_rowMargin > groupBounds.bottom())
-    {
-      continue;
-    }
-    groupIndex = i;
-    break;
-  }
+  const auto groupIt =
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return y + m_rowMargin > group.bounds().bottom();
+    });
+  auto groupIndex = size_t(std::distance(m_groups.begin(), groupIt));
 
   if (groupIndex == m_groups.size())
   {
@@ -809,19 +846,13 @@ const LayoutCell* CellLayout::cellAt(const float x, const float y)
     validate();
   }
 
-  for (size_t i = 0; i < m_groups.size(); ++i)
+  auto it =
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return group.bounds().bottom() < y;
+    });
+  for (; it != m_groups.end() && y >= it->bounds().top(); ++it)
   {
-    const auto& group = m_groups[i];
-    const auto groupBounds = group.bounds();
-    if (y > groupBounds.bottom())
-    {
-      continue;
-    }
-    if (y < groupBounds.top())
-    {
-      return nullptr;
-    }
-    if (const auto* cell = group.cellAt(x, y))
+    if (const auto* cell = it->cellAt(x, y))
     {
       return cell;
     }
@@ -830,6 +861,25 @@ const LayoutCell* CellLayout::cellAt(const float x, const float y)
   return nullptr;
 }
 
+std::vector<const LayoutCell*> CellLayout::cells(const float y, const float height)
+{
+  if (!m_valid)
+  {
+    validate();
+  }
+
+  auto result = std::vector<const LayoutCell*>{};
+  auto it =
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return group.bounds().bottom() < y;
+    });
+  for (; it != m_groups.end() && it->intersectsY(y, height); ++it)
+  {
+    it->collectCells(y, height, result);
+  }
+  return result;
+}
+
 void CellLayout::addGroup(std::string title, const float titleHeight)
 {
   if (!m_valid)
@@ -875,6 +925,18 @@ void CellLayout::addItem(
     validate();
   }
 
+  addItem(LayoutItem{
+    std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight});
+}
+
+void CellLayout::clear()
+{
+  m_groups.clear();
+  invalidate();
+}
+
+void CellLayout::addItem(LayoutItem item)
+{
   if (m_groups.empty())
   {
     m_groups.emplace_back(
@@ -890,27 +952,20 @@ void CellLayout::addItem(
       m_maxCellWidth,
       m_minCellHeight,
       m_maxCellHeight);
-    m_height += titleHeight;
-    if (titleHeight > 0.0f)
+    m_height += item.titleHeight;
+    if (item.titleHeight > 0.0f)
     {
       m_height += m_rowMargin;
     }
   }
 
   const auto oldGroupHeight = m_groups.back().bounds().height;
-  m_groups.back().addItem(
-    std::move(item), std::move(title), itemWidth, itemHeight, titleWidth, titleHeight);
+  m_groups.back().addItem(std::move(item));
   const auto newGroupHeight = m_groups.back().bounds().height;
 
   m_height += (newGroupHeight - oldGroupHeight);
 }
 
-void CellLayout::clear()
-{
-  m_groups.clear();
-  invalidate();
-}
-
 void CellLayout::validate()
 {
   if (m_width <= 0.0f)
@@ -922,29 +977,17 @@ void CellLayout::validate()
   m_valid = true;
   if (!m_groups.empty())
   {
-    auto copy = m_groups;
+    // The items are moved into the new groups, so relayouting does not copy them, and no
+    // cells are created until they are requested.
+    auto oldGroups = std::move(m_groups);
     m_groups.clear();
 
-    for (auto& group : copy)
+    for (auto& group : oldGroups)
     {
       addGroup(group.title(), group.titleBounds().height);
-      for (const auto& row : group.rows())
+      for (auto& item : group.releaseItems())
       {
-        for (const auto& cell : row.cells())
-        {
-          const auto& itemBounds = cell.itemBounds();
-          const auto& titleBounds = cell.titleBounds();
-          const auto scale = cell.scale();
-          const auto itemWidth = itemBounds.width / scale;
-          const auto itemHeight = itemBounds.height / scale;
-          addItem(
-            cell.item(),
-            cell.title(),
-            itemWidth,
-            itemHeight,
-            titleBounds.width,
-            titleBounds.height);
-        }
+        addItem(std::move(item));
       }
     }
   }
@@ -111,6 +111,21 @@ private:
     float maxUpScale, float minWidth, float maxWidth, float minHeight, float maxHeight);
 };
 
+struct LayoutItem
+{
+  std::any item;
+  std::string title;
+  float itemWidth;
+  float itemHeight;
+  float titleWidth;
+  float titleHeight;
+};
+
+/**
+ * A row only stores the range of items it contains and its bounds, which can be computed
+ * without creating any cells. The cells of a row are created on demand by calling
+ * `materializeCells`.
+ */
 class LayoutRow
 {
 private:
@@ -124,6 +139,8 @@ private:
   float m_minCellHeight;
   float m_maxCellHeight;
   LayoutBounds m_bounds;
+  size_t m_firstItemIndex;
+  size_t m_itemCount = 0;
 
   std::vector<LayoutCell> m_cells;
 
@@ -131,6 +148,7 @@ public:
   LayoutRow(
     float x,
     float y,
+    size_t firstItemIndex,
     float cellMargin,
     float titleMargin,
     float maxWidth,
@@ -143,23 +161,24 @@ public:
 
   const LayoutBounds& bounds() const;
 
+  size_t firstItemIndex() const;
+  size_t itemCount() const;
+
+  /**
+   * Returns the cells of this row. This is empty unless `materializeCells` was called.
+   */
   const std::vector<LayoutCell>& cells() const;
   const LayoutCell* cellAt(float x, float y) const;
 
   bool intersectsY(float y, float height) const;
 
-  bool canAddItem(
-    float itemWidth, float itemHeight, float titleWidth, float titleHeight) const;
-  void addItem(
-    std::any item,
-    std::string title,
-    float itemWidth,
-    float itemHeight,
-    float titleWidth,
-    float titleHeight);
+  bool canAddItem(const LayoutItem& item) const;
+  void addItem(const LayoutItem& item);
+
+  void materializeCells(const std::vector<LayoutItem>& items);
 
 private:
-  void readjustItems();
+  float cellWidth(const LayoutItem& item) const;
 };
 
 class LayoutGroup
@@ -178,6 +197,7 @@ private:
   LayoutBounds m_titleBounds;
   LayoutBounds m_contentBounds;
 
+  std::vector<LayoutItem> m_items;
   std::vector<LayoutRow> m_rows;
 
 public:
@@ -218,20 +238,22 @@ public:
   const LayoutBounds& contentBounds() const;
   LayoutBounds bounds() const;
 
+  const std::vector<LayoutItem>& items() const;
+  std::vector<LayoutItem> releaseItems();
+
   const std::vector<LayoutRow>& rows() const;
   size_t indexOfRowAt(float y) const;
-  const LayoutCell* cellAt(float x, float y) const;
+  const LayoutCell* cellAt(float x, float y);
+  const LayoutCell* cellForItem(size_t itemIndex);
+  void collectCells(float y, float height, std::vector<const LayoutCell*>& result);
 
   bool hitTest(float x, float y) const;
   bool intersectsY(float y, float height) const;
 
-  void addItem(
-    std::any item,
-    std::string title,
-    float itemWidth,
-    float itemHeight,
-    float titleWidth,
-    float titleHeight);
+  void addItem(LayoutItem item);
+
+private:
+  std::vector<LayoutRow>::iterator firstRowNotAbove(float y);
 };
 
 class CellLayout
@@ -297,6 +319,39 @@ public:
   const std::vector<LayoutGroup>& groups();
   const LayoutCell* cellAt(float x, float y);
 
+  /**
+   * Returns the cells that intersect the given vertical range. Cells are only created for
+   * the rows in this range, so this is cheap even if the layout contains many items.
+   */
+  std::vector<const LayoutCell*> cells(float y, float height);
+
+  /**
+   * Returns the cell of the first item for which the given predicate of type
+   * `const std::any& item -> bool` returns true, or nullptr if there is no such item.
+   * Only the cells of the row containing that item are created.
+   */
+  template <typename P>
+  const LayoutCell* findCell(const P& predicate)
+  {
+    if (!m_valid)
+    {
+      validate();
+    }
+
+    for (auto& group : m_groups)
+    {
+      const auto& items = group.items();
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+        if (predicate(items[i].item))
+        {
+          return group.cellForItem(i);
+        }
+      }
+    }
+    return nullptr;
+  }
+
   void addGroup(std::string title, float titleHeight);
   void addItem(
     std::any item,
@@ -309,6 +364,7 @@ public:
   void clear();
 
 private:
+  void addItem(LayoutItem item);
   void validate();
 };
 
@@ -473,47 +473,39 @@ auto collectStringVertices(
         vertices.insert(
           std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
       }
-
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& cellTitle = cell.title();
-            const auto textureNameBounds = cell.titleBounds();
-            const auto textureNameFont = fontManager.selectFontSize(
-              defaultFont, cellTitle, textureNameBounds.width, 6);
-            const auto& font = fontManager.font(textureNameFont);
-            const auto textureNameSize = font.measure(cellTitle);
-
-            const auto textureNameX =
-              textureNameBounds.left()
-              + std::max((textureNameBounds.width - textureNameSize.x()) / 2.0f, 0.0f);
-
-            // y is relative to top, but OpenGL coords are relative to bottom, so invert
-            const auto renderOffset =
-              vm::vec2f{textureNameX, y + height - textureNameBounds.bottom()};
-
-            const auto cellTitleQuads = font.quads(cellTitle, false, renderOffset);
-
-            const auto textureNameVertices = TextVertex::toList(
-              cellTitleQuads.size() / 2,
-              kdl::skip_iterator{
-                std::begin(cellTitleQuads), std::end(cellTitleQuads), 0, 2},
-              kdl::skip_iterator{
-                std::begin(cellTitleQuads), std::end(cellTitleQuads), 1, 2},
-              kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-
-            auto& allTextureNameVertices = stringVertices[textureNameFont];
-            allTextureNameVertices =
-              kdl::vec_concat(std::move(allTextureNameVertices), textureNameVertices);
-          }
-        }
-      }
     }
   }
 
+  for (const auto* cell : layout.cells(y, height))
+  {
+    const auto& cellTitle = cell->title();
+    const auto textureNameBounds = cell->titleBounds();
+    const auto textureNameFont =
+      fontManager.selectFontSize(defaultFont, cellTitle, textureNameBounds.width, 6);
+    const auto& font = fontManager.font(textureNameFont);
+    const auto textureNameSize = font.measure(cellTitle);
+
+    const auto textureNameX =
+      textureNameBounds.left()
+      + std::max((textureNameBounds.width - textureNameSize.x()) / 2.0f, 0.0f);
+
+    // y is relative to top, but OpenGL coords are relative to bottom, so invert
+    const auto renderOffset =
+      vm::vec2f{textureNameX, y + height - textureNameBounds.bottom()};
+
+    const auto cellTitleQuads = font.quads(cellTitle, false, renderOffset);
+
+    const auto textureNameVertices = TextVertex::toList(
+      cellTitleQuads.size() / 2,
+      kdl::skip_iterator{std::begin(cellTitleQuads), std::end(cellTitleQuads), 0, 2},
+      kdl::skip_iterator{std::begin(cellTitleQuads), std::end(cellTitleQuads), 1, 2},
+      kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
+
+    auto& allTextureNameVertices = stringVertices[textureNameFont];
+    allTextureNameVertices =
+      kdl::vec_concat(std::move(allTextureNameVertices), textureNameVertices);
+  }
+
   return stringVertices;
 }
 } // namespace
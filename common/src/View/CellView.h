@@ -64,26 +64,15 @@ public:
   void resizeEvent(QResizeEvent* event) override;
 
   /**
-   * Scroll to a cell. Pass a visitor of type `const Cell& cell -> bool` that returns true
-   * for the cell that should be scrolled to.
+   * Scroll to a cell. Pass a visitor of type `const std::any& item -> bool` that returns
+   * true for the item of the cell that should be scrolled to.
    */
   template <class L>
   void scrollToCell(L&& visitor)
   {
-
-    for (const auto& group : m_layout.groups())
+    if (const auto* cell = m_layout.findCell(visitor))
     {
-      for (const auto& row : group.rows())
-      {
-        for (const auto& cell : row.cells())
-        {
-          if (visitor(cell))
-          {
-            scrollToCellInternal(cell);
-            return;
-          }
-        }
-      }
+      scrollToCellInternal(*cell);
     }
   }
 
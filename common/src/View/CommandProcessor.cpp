@@ -59,6 +59,18 @@ struct CommandProcessor::TransactionState
   }
 };
 
+struct CommandProcessor::StoredCommand
+{
+  std::unique_ptr<UndoableCommand> command;
+  size_t memoryUsage;
+
+  explicit StoredCommand(std::unique_ptr<UndoableCommand> i_command)
+    : command{std::move(i_command)}
+    , memoryUsage{command->memoryUsage()}
+  {
+  }
+};
+
 struct CommandProcessor::SubmitAndStoreResult
 {
   std::unique_ptr<CommandResult> commandResult;
@@ -157,6 +169,16 @@ private:
 
     return false;
   }
+
+  size_t doGetMemoryUsage() const override
+  {
+    auto result = UndoableCommand::doGetMemoryUsage();
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
 };
 
 CommandProcessor::CommandProcessor(
@@ -187,7 +209,7 @@ const std::string& CommandProcessor::undoCommandName() const
   }
   else
   {
-    return m_undoStack.back()->name();
+    return m_undoStack.back().command->name();
   }
 }
 
@@ -199,7 +221,26 @@ const std::string& CommandProcessor::redoCommandName() const
   }
   else
   {
-    return m_redoStack.back()->name();
+    return m_redoStack.back().command->name();
+  }
+}
+
+size_t CommandProcessor::memoryUsage() const
+{
+  return m_memoryUsage;
+}
+
+std::optional<size_t> CommandProcessor::memoryBudget() const
+{
+  return m_memoryBudget;
+}
+
+void CommandProcessor::setMemoryBudget(const std::optional<size_t> memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  if (m_transactionStack.empty())
+  {
+    trimUndoStack();
   }
 }
 
@@ -251,6 +292,7 @@ std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command
   {
     m_undoStack.clear();
     m_redoStack.clear();
+    m_memoryUsage = 0;
   }
   return result;
 }
@@ -313,6 +355,7 @@ void CommandProcessor::clear()
 
   m_undoStack.clear();
   m_redoStack.clear();
+  m_memoryUsage = 0;
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
 
@@ -325,8 +368,15 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
     return SubmitAndStoreResult(std::move(commandResult), false);
   }
 
-  const auto commandStored = storeCommand(std::move(command), collate);
+  // clear the redo stack first so that its commands are not taken into account when the
+  // undo stack is trimmed
+  for (const auto& storedCommand : m_redoStack)
+  {
+    m_memoryUsage -= storedCommand.memoryUsage;
+  }
   m_redoStack.clear();
+
+  const auto commandStored = storeCommand(std::move(command), collate);
   return SubmitAndStoreResult(std::move(commandResult), commandStored);
 }
 
@@ -443,13 +493,20 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
-    if (lastCommand->collateWith(*command))
+    if (lastCommand.command->collateWith(*command))
     {
+      // the collated command may have taken over some of the other command's state
+      m_memoryUsage -= lastCommand.memoryUsage;
+      lastCommand.memoryUsage = lastCommand.command->memoryUsage();
+      m_memoryUsage += lastCommand.memoryUsage;
+      trimUndoStack();
       return false;
     }
   }
 
-  m_undoStack.push_back(std::move(command));
+  m_undoStack.emplace_back(std::move(command));
+  m_memoryUsage += m_undoStack.back().memoryUsage;
+  trimUndoStack();
   return true;
 }
 
@@ -458,7 +515,9 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   assert(m_transactionStack.empty());
   assert(!m_undoStack.empty());
 
-  return kdl::vec_pop_back(m_undoStack);
+  auto storedCommand = kdl::vec_pop_back(m_undoStack);
+  m_memoryUsage -= storedCommand.memoryUsage;
+  return std::move(storedCommand.command);
 }
 
 bool CommandProcessor::collatable(
@@ -471,7 +530,8 @@ bool CommandProcessor::collatable(
 void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   assert(m_transactionStack.empty());
-  m_redoStack.push_back(std::move(command));
+  m_redoStack.emplace_back(std::move(command));
+  m_memoryUsage += m_redoStack.back().memoryUsage;
 }
 
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
@@ -479,7 +539,28 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
   assert(m_transactionStack.empty());
   assert(!m_redoStack.empty());
 
-  return kdl::vec_pop_back(m_redoStack);
+  auto storedCommand = kdl::vec_pop_back(m_redoStack);
+  m_memoryUsage -= storedCommand.memoryUsage;
+  return std::move(storedCommand.command);
+}
+
+void CommandProcessor::trimUndoStack()
+{
+  assert(m_transactionStack.empty());
+
+  if (!m_memoryBudget)
+  {
+    return;
+  }
+
+  auto count = size_t(0);
+  while (*m_memoryBudget < m_memoryUsage && count + 1 < m_undoStack.size())
+  {
+    m_memoryUsage -= m_undoStack[count].memoryUsage;
+    ++count;
+  }
+
+  m_undoStack.erase(m_undoStack.begin(), std::next(m_undoStack.begin(), long(count)));
 }
 } // namespace View
 } // namespace TrenchBroom
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,10 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The command processor keeps track of the estimated memory usage of the stored commands.
+ * If a memory budget is set, the oldest commands are removed from the undo stack whenever
+ * the memory usage exceeds the budget.
  */
 class CommandProcessor
 {
@@ -67,17 +72,30 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  struct StoredCommand;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
    */
-  std::vector<std::unique_ptr<UndoableCommand>> m_undoStack;
+  std::vector<StoredCommand> m_undoStack;
 
   /**
    * Holds the commands that were undone, with the most recently undone command at the
    * beginning of the vector.
    */
-  std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
+  std::vector<StoredCommand> m_redoStack;
+
+  /**
+   * The estimated number of bytes occupied by the commands on the undo and redo stacks.
+   */
+  size_t m_memoryUsage = 0;
+
+  /**
+   * The maximum number of bytes that the commands on the undo and redo stacks should
+   * occupy, or nullopt if the memory usage is not limited.
+   */
+  std::optional<size_t> m_memoryBudget;
 
   /**
    * The time stamp of when the last command was executed.
@@ -168,6 +186,27 @@ public:
    */
   const std::string& redoCommandName() const;
 
+  /**
+   * Returns the estimated number of bytes occupied by the commands on the undo and redo
+   * stacks.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Returns the memory budget or nullopt if the memory usage is not limited.
+   */
+  std::optional<size_t> memoryBudget() const;
+
+  /**
+   * Sets the maximum number of bytes that the commands on the undo and redo stacks should
+   * occupy. If the memory usage exceeds the given budget, the oldest commands are removed
+   * from the undo stack until the budget is met. The most recently executed command is
+   * never removed.
+   *
+   * @param memoryBudget the budget in bytes, or nullopt to disable the limit
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -391,6 +430,12 @@ private:
    * @return the topmost command of the redo stack
    */
   std::unique_ptr<UndoableCommand> popFromRedoStack();
+
+  /**
+   * Removes the oldest commands from the undo stack until the memory usage does not
+   * exceed the memory budget anymore or until only one command remains on the undo stack.
+   */
+  void trimUndoStack();
 };
 } // namespace View
 } // namespace TrenchBroom
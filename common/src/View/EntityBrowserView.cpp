@@ -186,99 +186,99 @@ QString EntityBrowserView::dndData(const Cell& cell)
   return prefix + name;
 }
 
+namespace
+{
+bool matchesFilterPatterns(
+  const Assets::PointEntityDefinition& definition,
+  const std::vector<std::string>& filterPatterns)
+{
+  return kdl::all_of(filterPatterns, [&](const auto& pattern) {
+    return kdl::ci::str_contains(definition.name(), pattern);
+  });
+}
+} // namespace
+
 void EntityBrowserView::addEntitiesToLayout(
   Layout& layout,
   const std::vector<Assets::EntityDefinition*>& definitions,
   const Renderer::FontDescriptor& font)
 {
+  const auto filterPatterns = kdl::str_split(m_filterText, " ");
   for (const auto* definition : definitions)
   {
     const auto* pointEntityDefinition =
       static_cast<const Assets::PointEntityDefinition*>(definition);
-    addEntityToLayout(layout, pointEntityDefinition, font);
+    if (
+      (!m_hideUnused || pointEntityDefinition->usageCount() > 0)
+      && matchesFilterPatterns(*pointEntityDefinition, filterPatterns))
+    {
+      addEntityToLayout(layout, pointEntityDefinition, font);
+    }
   }
 }
 
-namespace
-{
-bool matchesFilterText(
-  const Assets::PointEntityDefinition& definition, const std::string& filterText)
-{
-  return filterText.empty()
-         || kdl::all_of(kdl::str_split(filterText, " "), [&](const auto& pattern) {
-              return kdl::ci::str_contains(definition.name(), pattern);
-            });
-}
-} // namespace
-
 void EntityBrowserView::addEntityToLayout(
   Layout& layout,
   const Assets::PointEntityDefinition* definition,
   const Renderer::FontDescriptor& font)
 {
-  if (
-    (!m_hideUnused || definition->usageCount() > 0)
-    && matchesFilterText(*definition, m_filterText))
+  const auto maxCellWidth = layout.maxCellWidth();
+  const auto actualFont =
+    fontManager().selectFontSize(font, definition->name(), maxCellWidth, 5);
+  const auto actualSize = fontManager().font(actualFont).measure(definition->name());
+  const auto spec =
+    Assets::safeGetModelSpecification(m_logger, definition->name(), [&]() {
+      return definition->modelDefinition().defaultModelSpecification();
+    });
+
+  const auto* frame = m_entityModelManager.frame(spec);
+  const auto modelScale = vm::vec3f{Assets::safeGetModelScale(
+    definition->modelDefinition(),
+    EL::NullVariableStore{},
+    m_defaultScaleModelExpression)};
+
+  auto* modelRenderer = static_cast<Renderer::TexturedRenderer*>(nullptr);
+  auto rotatedBounds = vm::bbox3f{};
+  auto modelOrientation = Assets::Orientation::Oriented;
+
+  if (frame != nullptr)
   {
-
-    const auto maxCellWidth = layout.maxCellWidth();
-    const auto actualFont =
-      fontManager().selectFontSize(font, definition->name(), maxCellWidth, 5);
-    const auto actualSize = fontManager().font(actualFont).measure(definition->name());
-    const auto spec =
-      Assets::safeGetModelSpecification(m_logger, definition->name(), [&]() {
-        return definition->modelDefinition().defaultModelSpecification();
-      });
-
-    const auto* frame = m_entityModelManager.frame(spec);
-    const auto modelScale = vm::vec3f{Assets::safeGetModelScale(
-      definition->modelDefinition(),
-      EL::NullVariableStore{},
-      m_defaultScaleModelExpression)};
-
-    auto* modelRenderer = static_cast<Renderer::TexturedRenderer*>(nullptr);
-    auto rotatedBounds = vm::bbox3f{};
-    auto modelOrientation = Assets::Orientation::Oriented;
-
-    if (frame != nullptr)
-    {
-      const auto scalingMatrix = vm::scaling_matrix(modelScale);
-      const auto bounds = frame->bounds();
-      const auto center = bounds.center();
-      const auto scaledCenter = scalingMatrix * center;
-      const auto transform = vm::translation_matrix(scaledCenter)
-                             * vm::rotation_matrix(m_rotation) * scalingMatrix
-                             * vm::translation_matrix(-center);
-
-      modelRenderer = m_entityModelManager.renderer(spec);
-      rotatedBounds = bounds.transform(transform);
-      modelOrientation = frame->orientation();
-    }
-    else
-    {
-      rotatedBounds = vm::bbox3f{definition->bounds()};
-      const auto center = rotatedBounds.center();
-      const auto transform = vm::translation_matrix(-center)
-                             * vm::rotation_matrix(m_rotation)
-                             * vm::translation_matrix(center);
-      rotatedBounds = rotatedBounds.transform(transform);
-    }
-
-    const auto boundsSize = rotatedBounds.size();
-    layout.addItem(
-      EntityCellData{
-        definition,
-        modelRenderer,
-        modelOrientation,
-        actualFont,
-        rotatedBounds,
-        modelScale},
-      definition->name(),
-      boundsSize.y(),
-      boundsSize.z(),
-      actualSize.x(),
-      static_cast<float>(font.size()) + 2.0f);
+    const auto scalingMatrix = vm::scaling_matrix(modelScale);
+    const auto bounds = frame->bounds();
+    const auto center = bounds.center();
+    const auto scaledCenter = scalingMatrix * center;
+    const auto transform = vm::translation_matrix(scaledCenter)
+                           * vm::rotation_matrix(m_rotation) * scalingMatrix
+                           * vm::translation_matrix(-center);
+
+    modelRenderer = m_entityModelManager.renderer(spec);
+    rotatedBounds = bounds.transform(transform);
+    modelOrientation = frame->orientation();
   }
+  else
+  {
+    rotatedBounds = vm::bbox3f{definition->bounds()};
+    const auto center = rotatedBounds.center();
+    const auto transform = vm::translation_matrix(-center)
+                           * vm::rotation_matrix(m_rotation)
+                           * vm::translation_matrix(center);
+    rotatedBounds = rotatedBounds.transform(transform);
+  }
+
+  const auto boundsSize = rotatedBounds.size();
+  layout.addItem(
+    EntityCellData{
+      definition,
+      modelRenderer,
+      modelOrientation,
+      actualFont,
+      rotatedBounds,
+      modelScale},
+    definition->name(),
+    boundsSize.y(),
+    boundsSize.z(),
+    actualSize.x(),
+    static_cast<float>(font.size()) + 2.0f);
 }
 
 void EntityBrowserView::doClear() {}
@@ -315,32 +315,20 @@ void EntityBrowserView::renderBounds(Layout& layout, const float y, const float
   using BoundsVertex = Renderer::GLVertexTypes::P3C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto* cell : layout.cells(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto* definition = cellData(*cell).entityDefinition;
+    auto* modelRenderer = cellData(*cell).modelRenderer;
+
+    if (modelRenderer == nullptr)
     {
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto* definition = cellData(cell).entityDefinition;
-            auto* modelRenderer = cellData(cell).modelRenderer;
-
-            if (modelRenderer == nullptr)
-            {
-              const auto itemTrans = itemTransformation(cell, y, height, false);
-              const auto& color = definition->color();
-              vm::bbox3f{definition->bounds()}.for_each_edge(
-                [&](const vm::vec3f& v1, const vm::vec3f& v2) {
-                  vertices.emplace_back(itemTrans * v1, color);
-                  vertices.emplace_back(itemTrans * v2, color);
-                });
-            }
-          }
-        }
-      }
+      const auto itemTrans = itemTransformation(*cell, y, height, false);
+      const auto& color = definition->color();
+      vm::bbox3f{definition->bounds()}.for_each_edge(
+        [&](const vm::vec3f& v1, const vm::vec3f& v2) {
+          vertices.emplace_back(itemTrans * v1, color);
+          vertices.emplace_back(itemTrans * v2, color);
+        });
     }
   }
 
@@ -374,31 +362,17 @@ void EntityBrowserView::renderModels(
   shader.set("CameraUp", CameraUp);
   shader.set("ViewMatrix", transformation.viewMatrix());
 
-  for (const auto& group : layout.groups())
+  for (const auto* cell : layout.cells(y, height))
   {
-    if (group.intersectsY(y, height))
+    if (auto* modelRenderer = cellData(*cell).modelRenderer)
     {
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            if (auto* modelRenderer = cellData(cell).modelRenderer)
-            {
-              shader.set(
-                "Orientation", static_cast<int>(cellData(cell).modelOrientation));
-
-              const auto itemTrans = itemTransformation(cell, y, height, true);
-              shader.set("ModelMatrix", itemTrans);
-
-              const auto multMatrix =
-                Renderer::MultiplyModelMatrix{transformation, itemTrans};
-              modelRenderer->render();
-            }
-          }
-        }
-      }
+      shader.set("Orientation", static_cast<int>(cellData(*cell).modelOrientation));
+
+      const auto itemTrans = itemTransformation(*cell, y, height, true);
+      shader.setAttribute("ModelMatrix", itemTrans);
+
+      const auto multMatrix = Renderer::MultiplyModelMatrix{transformation, itemTrans};
+      modelRenderer->render();
     }
   }
 }
@@ -21,7 +21,9 @@
 
 #include <QApplication>
 
+#include "Assets/TextureManager.h"
 #include "Exceptions.h"
+#include "IO/SystemPaths.h"
 #include "TrenchBroomApp.h"
 #include "View/AboutDialog.h"
 #include "View/MapDocument.h"
@@ -114,6 +116,8 @@ MapFrame* FrameManager::createOrReuseFrame()
   if (!m_singleFrame || m_frames.empty())
   {
     auto document = MapDocumentCommandFacade::newMapDocument();
+    document->textureManager().setThumbnailCacheDirectory(
+      IO::SystemPaths::userDataDirectory() / "Thumbnails");
     createFrame(document);
   }
   return topFrame();
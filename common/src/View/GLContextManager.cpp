@@ -46,6 +46,7 @@ std::string GLContextManager::GLVersion = "unknown";
 
 GLContextManager::GLContextManager()
   : m_initialized(false)
+  , m_frameStarted(false)
   , m_shaderManager(std::make_unique<Renderer::ShaderManager>())
   , m_vboManager(std::make_unique<Renderer::VboManager>(m_shaderManager.get()))
   , m_fontManager(std::make_unique<Renderer::FontManager>())
@@ -119,6 +120,21 @@ bool GLContextManager::initialize()
   return false;
 }
 
+void GLContextManager::beginFrame()
+{
+  if (!m_frameStarted)
+  {
+    m_frameStarted = true;
+    m_vboManager->beginFrame();
+    m_fontManager->beginFrame();
+  }
+}
+
+void GLContextManager::endFrame()
+{
+  m_frameStarted = false;
+}
+
 Renderer::VboManager& GLContextManager::vboManager()
 {
   return *m_vboManager;
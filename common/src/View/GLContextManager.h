@@ -44,6 +44,7 @@ public:
 
 private:
   bool m_initialized;
+  bool m_frameStarted;
 
   std::string m_glVendor;
   std::string m_glRenderer;
@@ -60,6 +61,18 @@ public:
   bool initialized() const;
   bool initialize();
 
+  /**
+   * Begins a new frame for the managers shared by all views unless a frame was already
+   * begun and not yet ended. Every view calls this before rendering, so the managers are
+   * reset only once even though several views render one frame.
+   */
+  void beginFrame();
+
+  /**
+   * Ends the current frame. Called once the rendered views are composed.
+   */
+  void endFrame();
+
   Renderer::VboManager& vboManager();
   Renderer::FontManager& fontManager();
   Renderer::ShaderManager& shaderManager();
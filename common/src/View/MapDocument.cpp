@@ -1522,6 +1522,25 @@ void MapDocument::invalidateSelectionBounds()
   m_selectionBoundsValid = false;
 }
 
+void MapDocument::extendSelectionBounds(const std::vector<Model::Node*>& nodes)
+{
+  if (!m_selectionBoundsValid)
+  {
+    return;
+  }
+
+  // layers do not contribute to the selection bounds, see computeLogicalBounds
+  if (m_selectedNodes.nodeCount() == m_selectedNodes.layerCount())
+  {
+    m_selectionBounds = computeLogicalBounds(nodes);
+  }
+  else
+  {
+    m_selectionBounds =
+      vm::merge(m_selectionBounds, computeLogicalBounds(nodes, m_selectionBounds));
+  }
+}
+
 void MapDocument::validateSelectionBounds() const
 {
   m_selectionBounds = computeLogicalBounds(m_selectedNodes.nodes());
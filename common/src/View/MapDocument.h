@@ -413,6 +413,14 @@ protected:
   void updateLastSelectionBounds();
   void invalidateSelectionBounds();
 
+  /**
+   * Adds the bounds of the given nodes to the selection bounds. Selecting nodes can only
+   * grow the selection bounds, so they need not be recomputed from all selected nodes.
+   *
+   * Must be called before the given nodes are added to m_selectedNodes.
+   */
+  void extendSelectionBounds(const std::vector<Model::Node*>& nodes);
+
 private:
   void validateSelectionBounds() const;
   void clearSelection();
@@ -58,6 +58,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -74,6 +75,7 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument()
 MapDocumentCommandFacade::MapDocumentCommandFacade()
   : m_commandProcessor(std::make_unique<CommandProcessor>(this))
 {
+  updateUndoMemoryBudget();
   connectObservers();
 }
 
@@ -103,13 +105,13 @@ void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& no
     }
   }
 
+  extendSelectionBounds(selected);
   m_selectedNodes.addNodes(selected);
 
   Selection selection;
   selection.addSelectedNodes(selected);
 
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
 }
 
 void MapDocumentCommandFacade::performSelect(
@@ -222,7 +224,10 @@ void MapDocumentCommandFacade::performDeselect(
     }
   }
 
-  m_selectedBrushFaces = kdl::vec_erase_all(std::move(m_selectedBrushFaces), deselected);
+  // every deselected face has just been marked as not selected
+  m_selectedBrushFaces = kdl::vec_filter(
+    std::move(m_selectedBrushFaces),
+    [](const auto& handle) { return handle.face().selected(); });
 
   Selection selection;
   selection.addDeselectedBrushFaces(deselected);
@@ -407,15 +412,14 @@ void MapDocumentCommandFacade::performSwapNodeContents(
 {
   const auto nodes =
     kdl::vec_transform(nodesToSwap, [](const auto& pair) { return pair.first; });
-  const auto parents = collectAncestors(nodes);
-  const auto descendants = collectDescendants(nodes);
+
+  // notify the observers only once about the swapped nodes and their ancestors and
+  // descendants to avoid invalidating the renderers several times
+  const auto changedNodes = kdl::vec_concat(
+    nodes, collectAncestors(nodes), collectDescendants(nodes));
 
   NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-  NotifyBeforeAndAfter notifyDescendants(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+    nodesWillChangeNotifier, nodesDidChangeNotifier, changedNodes);
 
   const auto [notifyWadsChange, notifyEntityDefinitionsChange, notifyModsChange] =
     notifySpecialWorldProperties(*game(), nodesToSwap);
@@ -430,36 +434,41 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   NotifyBeforeAndAfter notifyMods(
     notifyModsChange, modsWillChangeNotifier, modsDidChangeNotifier);
 
-  for (auto& pair : nodesToSwap)
   {
-    auto* node = pair.first;
-    auto& contents = pair.second.get();
-
-    pair.second = node->accept(kdl::overload(
-      [&](Model::WorldNode* worldNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          worldNode->setEntity(std::get<Model::Entity>(std::move(contents))));
-      },
-      [&](Model::LayerNode* layerNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          layerNode->setLayer(std::get<Model::Layer>(std::move(contents))));
-      },
-      [&](Model::GroupNode* groupNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          groupNode->setGroup(std::get<Model::Group>(std::move(contents))));
-      },
-      [&](Model::EntityNode* entityNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          entityNode->setEntity(std::get<Model::Entity>(std::move(contents))));
-      },
-      [&](Model::BrushNode* brushNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          brushNode->setBrush(std::get<Model::Brush>(std::move(contents))));
-      },
-      [&](Model::PatchNode* patchNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          patchNode->setPatch(std::get<Model::BezierPatch>(std::move(contents))));
-      }));
+    // update the node tree once for all nodes with changed bounds
+    auto deferNodeTreeUpdates = Model::WorldNode::DeferNodeTreeUpdates{*m_world};
+    for (auto& pair : nodesToSwap)
+    {
+      auto* node = pair.first;
+      auto& contents = pair.second.get();
+
+      pair.second = node->accept(kdl::overload(
+        [&](Model::WorldNode* worldNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            worldNode->setEntity(std::get<Model::Entity>(std::move(contents))));
+        },
+        [&](Model::LayerNode* layerNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            layerNode->setLayer(std::get<Model::Layer>(std::move(contents))));
+        },
+        [&](Model::GroupNode* groupNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            groupNode->setGroup(std::get<Model::Group>(std::move(contents))));
+        },
+        [&](Model::EntityNode* entityNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            entityNode->setEntity(std::get<Model::Entity>(std::move(contents))));
+        },
+        [&](Model::BrushNode* brushNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            brushNode->setBrush(std::get<Model::Brush>(std::move(contents))));
+        },
+        [&](Model::PatchNode* patchNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            patchNode->setPatch(std::get<Model::BezierPatch>(std::move(contents))));
+        }));
+    }
+    deferNodeTreeUpdates.flush();
   }
 
   if (!notifyEntityDefinitionsChange && !notifyModsChange)
@@ -630,6 +639,25 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::preferenceDidChange);
+}
+
+void MapDocumentCommandFacade::preferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    updateUndoMemoryBudget();
+  }
+}
+
+void MapDocumentCommandFacade::updateUndoMemoryBudget()
+{
+  const auto budgetInMiB = pref(Preferences::UndoMemoryBudget);
+  m_commandProcessor->setMemoryBudget(
+    budgetInMiB > 0 ? std::optional{size_t(budgetInMiB) * 1024u * 1024u} : std::nullopt);
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -21,6 +21,7 @@
 
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Renderer/FontManager.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/Transformation.h"
@@ -108,16 +109,29 @@ RenderView::RenderView(GLContextManager& contextManager, QWidget* parent)
     m_maxFrameTimeMsecs = 0;
     m_lastFPSCounterUpdate = currentTime;
 
+    const auto& streamingStats = m_glContext->vboManager().streamingStats();
+    const auto& textStats = m_glContext->fontManager().textStats();
+
     m_currentFPS =
       std::string("Avg FPS: ") + std::to_string(avgFps)
       + " Max time between frames: " + std::to_string(maxFrameTime) + "ms. "
       + std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs ("
       + std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling "
-      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u)
+      + " KiB. Last frame streamed "
+      + std::to_string(streamingStats.streamedBytes / 1024u) + " KiB into "
+      + std::to_string(streamingStats.avoidedAllocations) + " VBOs ("
+      + std::to_string(streamingStats.overflowAllocations) + " overflowed), "
+      + std::to_string(textStats.renderedStrings) + " strings ("
+      + std::to_string(textStats.culledStrings) + " culled) with "
+      + std::to_string(textStats.textVertices) + " text vertices";
   });
 
   fpsCounter->start(1000);
 
+  // all views of a window are rendered before they are composed, so this ends the frame
+  connect(this, &QOpenGLWidget::aboutToCompose, [&]() { m_glContext->endFrame(); });
+
   setMouseTracking(true); // request mouse move events even when no button is held down
   setFocusPolicy(Qt::StrongFocus); // accept focus by clicking or tab
 }
@@ -248,6 +262,7 @@ void RenderView::resizeGL(int w, int h)
 
 void RenderView::render()
 {
+  m_glContext->beginFrame();
   processInput();
   clearBackground();
   doRender();
@@ -318,7 +333,8 @@ void RenderView::renderFocusIndicator()
                          Vertex(vm::vec3f(0.0f, h, 0.0f), outer),
                          Vertex(vm::vec3f(0.0f, 0.0f, 0.0f), outer),
                          Vertex(vm::vec3f(t, t, 0.0f), inner),
-                         Vertex(vm::vec3f(t, h - t, 0.0f), inner)}));
+                         Vertex(vm::vec3f(t, h - t, 0.0f), inner)}),
+    Renderer::VboUsage::StreamDraw);
 
   array.prepare(vboManager());
   array.render(Renderer::PrimType::Quads);
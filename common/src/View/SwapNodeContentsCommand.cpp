@@ -19,23 +19,81 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "Error.h"
+#include "Model/BezierPatch.h"
 #include "Model/Brush.h"
+#include "Model/BrushFace.h"
 #include "Model/Entity.h"
+#include "Model/EntityProperties.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
 #include "Model/Node.h"
+#include "Model/Polyhedron.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+size_t estimateMemoryUsage(const Model::Brush& brush)
+{
+  auto result = sizeof(Model::Brush) + brush.faceCount() * sizeof(Model::BrushFace);
+  if (brush.hasGeometry())
+  {
+    result +=
+      brush.vertexCount() * sizeof(Model::BrushVertex)
+      + brush.edgeCount() * (sizeof(Model::BrushEdge) + 2 * sizeof(Model::BrushHalfEdge))
+      + brush.faceCount() * sizeof(Model::BrushFaceGeometry);
+  }
+  return result;
+}
+
+size_t estimateMemoryUsage(const Model::Entity& entity)
+{
+  auto result = sizeof(Model::Entity);
+  for (const auto& property : entity.properties())
+  {
+    // the keys are interned and shared, so only their handles count
+    result += sizeof(Model::EntityProperty) + property.value().capacity();
+  }
+  return result;
+}
+
+size_t estimateMemoryUsage(const Model::BezierPatch& patch)
+{
+  return sizeof(Model::BezierPatch)
+         + patch.controlPoints().size() * sizeof(Model::BezierPatch::Point);
+}
+
+size_t estimateMemoryUsage(const Model::NodeContents& contents)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Model::Layer&) { return sizeof(Model::Layer); },
+      [](const Model::Group&) { return sizeof(Model::Group); },
+      [](const Model::Entity& entity) { return estimateMemoryUsage(entity); },
+      [](const Model::Brush& brush) { return estimateMemoryUsage(brush); },
+      [](const Model::BezierPatch& patch) { return estimateMemoryUsage(patch); }),
+    contents.get());
+}
+} // namespace
+
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   const std::string& name,
-  std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes)
+  std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes,
+  const bool discardBrushGeometry)
   : UpdateLinkedGroupsCommandBase(name, true)
   , m_nodes(std::move(nodes))
+  , m_discardBrushGeometry{discardBrushGeometry}
 {
 }
 
@@ -44,15 +102,13 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade* document)
 {
-  document->performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade* document)
 {
-  document->performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
@@ -72,5 +128,58 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
 
   return false;
 }
+
+size_t SwapNodeContentsCommand::doGetMemoryUsage() const
+{
+  auto result = UndoableCommand::doGetMemoryUsage();
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += sizeof(node) + estimateMemoryUsage(contents);
+  }
+  return result;
+}
+
+std::unique_ptr<CommandResult> SwapNodeContentsCommand::swapNodeContents(
+  MapDocumentCommandFacade* document)
+{
+  auto brushes = std::vector<Model::Brush*>{};
+  for (auto& [node, contents] : m_nodes)
+  {
+    if (auto* brush = std::get_if<Model::Brush>(&contents.get()))
+    {
+      brushes.push_back(brush);
+    }
+  }
+
+  const auto& worldBounds = document->worldBounds();
+  const auto rebuilt = kdl::vec_parallel_transform(brushes, [&](auto* brush) {
+    return brush->rebuildGeometry(worldBounds).is_success();
+  });
+
+  // the stored brushes must not keep their geometry, even if the swap fails
+  const auto discardGeometry = [&]() {
+    if (m_discardBrushGeometry)
+    {
+      for (auto& [node, contents] : m_nodes)
+      {
+        if (auto* brush = std::get_if<Model::Brush>(&contents.get()))
+        {
+          brush->discardGeometry();
+        }
+      }
+    }
+  };
+
+  if (!std::all_of(rebuilt.begin(), rebuilt.end(), [](const auto b) { return b; }))
+  {
+    discardGeometry();
+    return std::make_unique<CommandResult>(false);
+  }
+
+  document->performSwapNodeContents(m_nodes);
+  discardGeometry();
+
+  return std::make_unique<CommandResult>(true);
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -39,15 +39,28 @@ class Node;
 
 namespace View
 {
+/**
+ * Swaps the contents of the given nodes with the given contents. Afterwards, the command
+ * holds the previous contents of the nodes so that they can be swapped back on undo.
+ *
+ * To reduce the memory footprint of the undo history, the geometry of stored brushes is
+ * discarded and rebuilt from the brush faces before the brushes are swapped back into
+ * their nodes. This can be disabled by commands which rely on the stored geometry being
+ * restored exactly.
+ */
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
   std::vector<std::pair<Model::Node*, Model::NodeContents>> m_nodes;
 
+private:
+  bool m_discardBrushGeometry;
+
 public:
   SwapNodeContentsCommand(
     const std::string& name,
-    std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes);
+    std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes,
+    bool discardBrushGeometry = true);
   ~SwapNodeContentsCommand();
 
   std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override;
@@ -56,6 +69,11 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t doGetMemoryUsage() const override;
+
+private:
+  std::unique_ptr<CommandResult> swapNodeContents(MapDocumentCommandFacade* document);
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 } // namespace View
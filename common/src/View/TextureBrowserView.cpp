@@ -23,6 +23,7 @@
 #include <QTextStream>
 
 #include "Assets/Texture.h"
+#include "Assets/TextureAtlas.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "PreferenceManager.h"
@@ -48,7 +49,10 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <any>
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom::View
@@ -127,9 +131,8 @@ void TextureBrowserView::setSelectedTexture(const Assets::Texture* selectedTextu
 
 void TextureBrowserView::revealTexture(const Assets::Texture* texture)
 {
-  scrollToCell([=](const Cell& cell) {
-    const auto& cellTexture = cellData(cell);
-    return &cellTexture == texture;
+  scrollToCell([=](const std::any& item) {
+    return std::any_cast<const Assets::Texture*>(item) == texture;
   });
 }
 
@@ -258,8 +261,9 @@ std::vector<const Assets::Texture*> TextureBrowserView::filterTextures(
   }
   if (!m_filterText.empty())
   {
+    const auto patterns = kdl::str_split(m_filterText, " ");
     textures = kdl::vec_erase_if(std::move(textures), [&](const auto* texture) {
-      return !kdl::all_of(kdl::str_split(m_filterText, " "), [&](const auto& pattern) {
+      return !kdl::all_of(patterns, [&](const auto& pattern) {
         return kdl::ci::str_contains(texture->name(), pattern);
       });
     });
@@ -324,34 +328,19 @@ void TextureBrowserView::renderBounds(Layout& layout, const float y, const float
   using BoundsVertex = Renderer::GLVertexTypes::P2C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto* cell : layout.cells(y, height))
   {
-    if (group.intersectsY(y, height))
-    {
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& texture = cellData(cell);
-            const auto& color = textureColor(texture);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
-              color);
-          }
-        }
-      }
-    }
+    const auto& bounds = cell->itemBounds();
+    const auto& texture = cellData(*cell);
+    const auto& color = textureColor(texture);
+    vertices.emplace_back(
+      vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
+    vertices.emplace_back(
+      vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+    vertices.emplace_back(
+      vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+    vertices.emplace_back(
+      vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)}, color);
   }
 
   auto vertexArray = Renderer::VertexArray::move(std::move(vertices));
@@ -385,37 +374,68 @@ void TextureBrowserView::renderTextures(Layout& layout, const float y, const flo
   shader.set("Texture", 0);
   shader.set("Brightness", pref(Preferences::Brightness));
 
-  for (const auto& group : layout.groups())
+  const auto makeQuad =
+    [&](const auto& bounds, const vm::vec2f& min, const vm::vec2f& max) {
+      const auto top = height - (bounds.top() - y);
+      const auto bottom = height - (bounds.bottom() - y);
+      return std::vector<TextureVertex>{
+        TextureVertex{{bounds.left(), top}, {min.x(), min.y()}},
+        TextureVertex{{bounds.left(), bottom}, {min.x(), max.y()}},
+        TextureVertex{{bounds.right(), bottom}, {max.x(), max.y()}},
+        TextureVertex{{bounds.right(), top}, {max.x(), min.y()}},
+      };
+    };
+
+  // Cells that are not larger than their thumbnails on screen are drawn from the
+  // thumbnail atlases, batched by atlas page, so that only one texture bind and one
+  // draw call is needed per page.
+  using ThumbnailBatchKey = std::tuple<const Assets::TextureAtlas*, size_t, bool>;
+  auto thumbnailBatches = std::map<ThumbnailBatchKey, std::vector<TextureVertex>>{};
+
+  const auto r = static_cast<float>(devicePixelRatioF());
+  for (const auto* cell : layout.cells(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto& bounds = cell->itemBounds();
+    const auto& texture = cellData(*cell);
+
+    if (const auto* atlas = texture.thumbnailAtlas())
     {
-      for (const auto& row : group.rows())
+      const auto& region = texture.thumbnailRegion();
+      if (Assets::canDrawFromThumbnail(region, bounds.width, bounds.height, r))
       {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& texture = cellData(cell);
-
-            auto vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>{
-              TextureVertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
-              TextureVertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
-              TextureVertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
-              TextureVertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
-            });
-
-            shader.set("GrayScale", texture.overridden());
-            texture.activate();
-
-            vertexArray.prepare(vboManager());
-            vertexArray.render(Renderer::PrimType::Quads);
-
-            texture.deactivate();
-          }
-        }
+        const auto [min, max] = atlas->texCoords(region);
+        auto& batch =
+          thumbnailBatches[ThumbnailBatchKey{atlas, region.page, texture.overridden()}];
+        const auto quad = makeQuad(bounds, min, max);
+        batch.insert(batch.end(), quad.begin(), quad.end());
+        continue;
       }
     }
+
+    auto vertexArray =
+      Renderer::VertexArray::move(makeQuad(bounds, vm::vec2f{0, 0}, vm::vec2f{1, 1}));
+
+    shader.set("GrayScale", texture.overridden());
+    texture.activate();
+
+    vertexArray.prepare(vboManager());
+    vertexArray.render(Renderer::PrimType::Quads);
+
+    texture.deactivate();
+  }
+
+  for (auto& [key, vertices] : thumbnailBatches)
+  {
+    const auto& [atlas, page, overridden] = key;
+    auto vertexArray = Renderer::VertexArray::move(std::move(vertices));
+
+    shader.set("GrayScale", overridden);
+    atlas->activate(page);
+
+    vertexArray.prepare(vboManager());
+    vertexArray.render(Renderer::PrimType::Quads);
+
+    atlas->deactivate();
   }
 }
 
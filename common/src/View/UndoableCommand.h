@@ -47,11 +47,18 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes that this command occupies while it is
+   * stored in the undo or redo stack.
+   */
+  size_t memoryUsage() const;
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade* document) = 0;
 
   virtual bool doCollateWith(UndoableCommand& command);
+  virtual size_t doGetMemoryUsage() const;
 
   void setModificationCount(MapDocumentCommandFacade* document);
   void resetModificationCount(MapDocumentCommandFacade* document);
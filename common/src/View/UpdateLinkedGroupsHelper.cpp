@@ -35,6 +35,8 @@
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace TrenchBroom::View
@@ -48,6 +50,30 @@ auto compareByAncestry(const Model::GroupNode* lhs, const Model::GroupNode* rhs)
   return rhs->isAncestorOf(lhs);
 }
 
+/**
+ * Collects the members of the link sets of the given groups in a single traversal of the
+ * world instead of one traversal per changed group.
+ */
+auto collectGroupsByLinkId(
+  Model::WorldNode& worldNode, const std::vector<Model::GroupNode*>& groupNodes)
+{
+  auto result = std::unordered_map<std::string, std::vector<Model::GroupNode*>>{};
+  for (const auto* groupNode : groupNodes)
+  {
+    result[groupNode->linkId()];
+  }
+
+  for (auto* groupNode : Model::collectGroups({&worldNode}))
+  {
+    if (auto it = result.find(groupNode->linkId()); it != result.end())
+    {
+      it->second.push_back(groupNode);
+    }
+  }
+
+  return result;
+}
+
 } // namespace
 
 bool checkLinkedGroupsToUpdate(const std::vector<Model::GroupNode*>& changedLinkedGroups)
@@ -138,13 +164,15 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
   }
 
   const auto& worldBounds = document.worldBounds();
+  const auto groupNodesByLinkId =
+    collectGroupsByLinkId(*document.world(), changedLinkedGroups);
+
   return kdl::fold_results(
            kdl::vec_transform(
              changedLinkedGroups,
              [&](const auto* groupNode) {
-               const auto groupNodesToUpdate = kdl::vec_erase(
-                 Model::collectGroupsWithLinkId({document.world()}, groupNode->linkId()),
-                 groupNode);
+               const auto groupNodesToUpdate =
+                 kdl::vec_erase(groupNodesByLinkId.at(groupNode->linkId()), groupNode);
 
                return Model::updateLinkedGroups(
                  *groupNode, groupNodesToUpdate, worldBounds);
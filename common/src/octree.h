@@ -415,35 +415,7 @@ public:
       throw NodeTreeException("Data already in tree");
     }
 
-    const auto address = detail::get_container(bounds, m_min_size);
-    if (is_root(address))
-    {
-      if (!m_root)
-      {
-        m_root = leaf_node{address, {}};
-      }
-      else if (!get_address(*m_root).contains(address))
-      {
-        update_root_address(*m_root, address, m_node_address_for_data);
-      }
-
-      get_data(*m_root).push_back(std::move(data));
-      m_node_address_for_data.emplace(data, get_address(*m_root));
-    }
-    else
-    {
-      if (!m_root)
-      {
-        m_root = inner_node{get_root(address), {}};
-      }
-      else if (!get_address(*m_root).contains(address))
-      {
-        update_root_address(*m_root, get_root(address), m_node_address_for_data);
-      }
-
-      insert_into_node(*m_root, address, std::move(data));
-      m_node_address_for_data.emplace(data, address);
-    }
+    insert_at(detail::get_container(bounds, m_min_size), std::move(data));
   }
 
 
@@ -491,6 +463,49 @@ public:
     insert(newBounds, data);
   }
 
+  /**
+   * Updates the nodes with the given data with the given new bounds.
+   *
+   * Nodes whose new bounds still belong into the tree node that contains them are not
+   * touched. All other nodes are removed before any of them are reinserted, so that the
+   * tree is not restructured repeatedly while the nodes are moved.
+   *
+   * @param updates pairs of new bounds and node data, every node data must be unique
+   *
+   * @throws NodeTreeException if any new bounds are invalid or if no node with some of
+   * the given data can be found in this tree; in that case, this tree is not modified
+   */
+  void update_many(const std::vector<std::pair<vm::bbox<T, 3>, U>>& updates)
+  {
+    auto to_move = std::vector<std::pair<detail::node_address, const U*>>{};
+    for (const auto& [new_bounds, data] : updates)
+    {
+      check(new_bounds);
+
+      const auto i_address = m_node_address_for_data.find(data);
+      if (i_address == m_node_address_for_data.end())
+      {
+        throw NodeTreeException("node not found");
+      }
+
+      const auto new_address = detail::get_container(new_bounds, m_min_size);
+      if (!is_stored_at(new_address, i_address->second))
+      {
+        to_move.emplace_back(new_address, &data);
+      }
+    }
+
+    for (const auto& [address, data] : to_move)
+    {
+      remove(*data);
+    }
+
+    for (const auto& [address, data] : to_move)
+    {
+      insert_at(address, *data);
+    }
+  }
+
   /**
    * Clears this node tree.
    */
@@ -630,6 +645,50 @@ public:
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 
 private:
+  /**
+   * Indicates whether data with the given address belongs into the tree node with the
+   * given address. Data for the root address is stored in the root, which may be larger.
+   */
+  static bool is_stored_at(
+    const detail::node_address& address, const detail::node_address& stored_address)
+  {
+    return address == stored_address
+           || (is_root(address) && is_root(stored_address)
+               && stored_address.contains(address));
+  }
+
+  void insert_at(const detail::node_address& address, U data)
+  {
+    if (is_root(address))
+    {
+      if (!m_root)
+      {
+        m_root = leaf_node{address, {}};
+      }
+      else if (!get_address(*m_root).contains(address))
+      {
+        update_root_address(*m_root, address, m_node_address_for_data);
+      }
+
+      get_data(*m_root).push_back(std::move(data));
+      m_node_address_for_data.emplace(data, get_address(*m_root));
+    }
+    else
+    {
+      if (!m_root)
+      {
+        m_root = inner_node{get_root(address), {}};
+      }
+      else if (!get_address(*m_root).contains(address))
+      {
+        update_root_address(*m_root, get_root(address), m_node_address_for_data);
+      }
+
+      insert_into_node(*m_root, address, std::move(data));
+      m_node_address_for_data.emplace(data, address);
+    }
+  }
+
   void check(const vm::bbox<T, 3>& bounds) const
   {
     if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
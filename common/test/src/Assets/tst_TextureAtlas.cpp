@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/TextureAtlas.h"
+#include "Assets/TextureThumbnail.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+TextureThumbnail makeThumbnail(
+  const size_t width, const size_t height, const unsigned char value = 0xFF)
+{
+  return TextureThumbnail{
+    width, height, std::vector<unsigned char>(width * height * 4, value)};
+}
+} // namespace
+
+TEST_CASE("TextureAtlas.add")
+{
+  auto atlas = TextureAtlas{8, 1};
+  CHECK(atlas.pageCount() == 0);
+
+  SECTION("Thumbnails are packed into shelves")
+  {
+    CHECK(atlas.add(makeThumbnail(3, 2)) == TextureAtlasRegion{0, 0, 0, 3, 2});
+    CHECK(atlas.add(makeThumbnail(2, 3)) == TextureAtlasRegion{0, 4, 0, 2, 3});
+    CHECK(atlas.add(makeThumbnail(2, 2)) == TextureAtlasRegion{0, 0, 4, 2, 2});
+    CHECK(atlas.add(makeThumbnail(4, 1)) == TextureAtlasRegion{0, 3, 4, 4, 1});
+    CHECK(atlas.pageCount() == 1);
+  }
+
+  SECTION("A new page is started if a thumbnail doesn't fit")
+  {
+    CHECK(atlas.add(makeThumbnail(8, 6)) == TextureAtlasRegion{0, 0, 0, 8, 6});
+    CHECK(atlas.add(makeThumbnail(2, 2)) == TextureAtlasRegion{1, 0, 0, 2, 2});
+    CHECK(atlas.pageCount() == 2);
+  }
+
+  SECTION("Thumbnails larger than a page are rejected")
+  {
+    CHECK(atlas.add(makeThumbnail(9, 1)) == std::nullopt);
+    CHECK(atlas.add(makeThumbnail(1, 9)) == std::nullopt);
+    CHECK(atlas.pageCount() == 0);
+  }
+
+  SECTION("Thumbnail pixels are copied into the page")
+  {
+    atlas.add(makeThumbnail(1, 1, 0x10));
+    atlas.add(makeThumbnail(1, 2, 0x20));
+
+    const auto& pixels = atlas.pagePixels(0);
+    REQUIRE(pixels.size() == 8 * 8 * 4);
+
+    const auto pixelAt = [&](const size_t x, const size_t y) {
+      return pixels[(y * 8 + x) * 4];
+    };
+
+    CHECK(pixelAt(0, 0) == 0x10);
+    CHECK(pixelAt(1, 0) == 0x00);
+    CHECK(pixelAt(2, 0) == 0x20);
+    CHECK(pixelAt(2, 1) == 0x20);
+    CHECK(pixelAt(0, 1) == 0x00);
+  }
+}
+
+TEST_CASE("TextureAtlas.texCoords")
+{
+  auto atlas = TextureAtlas{8, 1};
+  atlas.add(makeThumbnail(2, 4));
+  const auto region = atlas.add(makeThumbnail(2, 4));
+  REQUIRE(region);
+
+  const auto [min, max] = atlas.texCoords(*region);
+  CHECK(min == vm::vec2f{0.375f, 0.0f});
+  CHECK(max == vm::vec2f{0.625f, 0.5f});
+}
+
+TEST_CASE("TextureAtlas.canDrawFromThumbnail")
+{
+  const auto region = TextureAtlasRegion{0, 0, 0, 64, 32};
+
+  SECTION("Without scaling")
+  {
+    CHECK(canDrawFromThumbnail(region, 64.0f, 32.0f, 1.0f));
+    CHECK(canDrawFromThumbnail(region, 48.0f, 24.0f, 1.0f));
+    CHECK_FALSE(canDrawFromThumbnail(region, 65.0f, 32.0f, 1.0f));
+    CHECK_FALSE(canDrawFromThumbnail(region, 64.0f, 33.0f, 1.0f));
+  }
+
+  SECTION("On high DPI screens")
+  {
+    CHECK(canDrawFromThumbnail(region, 64.0f, 32.0f, 2.0f));
+    CHECK(canDrawFromThumbnail(region, 128.0f, 64.0f, 2.0f));
+    CHECK_FALSE(canDrawFromThumbnail(region, 129.0f, 64.0f, 2.0f));
+  }
+}
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureThumbnail.h"
+#include "Color.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+Texture makeTexture(
+  const size_t width,
+  const size_t height,
+  const GLenum format,
+  const std::vector<unsigned char>& pixels)
+{
+  auto buffer = TextureBuffer{pixels.size()};
+  std::copy(pixels.begin(), pixels.end(), buffer.data());
+  return Texture{
+    "texture",
+    width,
+    height,
+    Color{0.0f, 1.0f, 0.0f, 1.0f},
+    std::move(buffer),
+    format,
+    TextureType::Opaque};
+}
+} // namespace
+
+TEST_CASE("createTextureThumbnail")
+{
+  SECTION("Small textures are copied")
+  {
+    // clang-format off
+    const auto texture = makeTexture(2, 1, GL_RGB, {
+      0x10, 0x20, 0x30,   0x40, 0x50, 0x60,
+    });
+
+    CHECK(createTextureThumbnail(texture, 4) == TextureThumbnail{2, 1, {
+      0x10, 0x20, 0x30, 0xFF,   0x40, 0x50, 0x60, 0xFF,
+    }});
+    // clang-format on
+  }
+
+  SECTION("Large textures are downscaled by averaging")
+  {
+    // clang-format off
+    const auto texture = makeTexture(4, 2, GL_RGBA, {
+      0x00, 0x00, 0x00, 0x00,   0x10, 0x10, 0x10, 0x10,
+      0x20, 0x20, 0x20, 0x20,   0x20, 0x20, 0x20, 0x20,
+      0x20, 0x20, 0x20, 0x20,   0x30, 0x30, 0x30, 0x30,
+      0x40, 0x40, 0x40, 0x40,   0x40, 0x40, 0x40, 0x40,
+    });
+
+    CHECK(createTextureThumbnail(texture, 2) == TextureThumbnail{2, 1, {
+      0x18, 0x18, 0x18, 0x18,   0x30, 0x30, 0x30, 0x30,
+    }});
+    // clang-format on
+  }
+
+  SECTION("BGR textures are converted to RGBA")
+  {
+    // clang-format off
+    const auto texture = makeTexture(1, 1, GL_BGRA, {
+      0x10, 0x20, 0x30, 0x40,
+    });
+
+    CHECK(createTextureThumbnail(texture, 4) == TextureThumbnail{1, 1, {
+      0x30, 0x20, 0x10, 0x40,
+    }});
+    // clang-format on
+  }
+
+  SECTION("Textures without data are filled with their average color")
+  {
+    const auto texture = Texture{"texture", 2, 1};
+
+    // clang-format off
+    CHECK(createTextureThumbnail(texture, 4) == TextureThumbnail{2, 1, {
+      0x00, 0x00, 0x00, 0xFF,   0x00, 0x00, 0x00, 0xFF,
+    }});
+    // clang-format on
+  }
+}
+
+TEST_CASE("createTextureThumbnails")
+{
+  auto textures = std::vector<Texture>{};
+  textures.push_back(makeTexture(1, 1, GL_RGB, {0x10, 0x20, 0x30}));
+  textures.push_back(makeTexture(1, 1, GL_RGB, {0x40, 0x50, 0x60}));
+
+  CHECK(
+    createTextureThumbnails(textures, 4)
+    == std::vector<TextureThumbnail>{
+      TextureThumbnail{1, 1, {0x10, 0x20, 0x30, 0xFF}},
+      TextureThumbnail{1, 1, {0x40, 0x50, 0x60, 0xFF}},
+    });
+}
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EL/CompiledExpression.h"
+#include "EL/ELExceptions.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::EL
+{
+TEST_CASE("CompiledExpressionTest.evaluate")
+{
+  const auto variables = VariableTable{MapType{
+    {"x", Value{2}},
+    {"s", Value{"3"}},
+    {"b", Value{true}},
+    {"n", Value::Null},
+    {"a", Value{ArrayType{Value{1}, Value{2}, Value{3}}}},
+    {"m", Value{MapType{{"k", Value{"v"}}}}},
+  }};
+
+  // clang-format off
+  const auto expression = GENERATE(values<std::string>({
+  "true",
+  "'asdf'",
+  "x",
+  "y",
+  "[x, s, 1..3, y]",
+  "{k1: x, k2: [s], k3: y}",
+  "-x",
+  "!b",
+  "~x",
+  "(x + 1) * 2 - s % 3 / 2",
+  "x << 2 | 1 & 3 ^ 7 >> 1",
+  "x < s && s <= 3 || x > 4",
+  "b && y",
+  "y && b",
+  "false && y",
+  "n || b",
+  "x == s",
+  "x != '3'",
+  "a[1]",
+  "a[-1]",
+  "a[1..]",
+  "a[..1]",
+  "a[[0, 2]]",
+  "a[a[0]..]",
+  "m['k']",
+  "'asdf'[1..]",
+  "[x..5]",
+  "{{ x == 1 -> 'one', x == 2 -> 'two', 'many' }}",
+  "{{ y -> 'y', b -> 'b' }}",
+  "{{ y -> 'y' }}",
+  "{{ }}",
+  }));
+  // clang-format on
+
+  CAPTURE(expression);
+
+  const auto tree = IO::ELParser::parseStrict(expression);
+  const auto compiled = CompiledExpression{tree};
+
+  const auto expected = tree.evaluate(EvaluationContext{variables});
+  CHECK(compiled.evaluate(variables) == expected);
+  CHECK(compiled.evaluate(EvaluationContext{variables}) == expected);
+}
+
+TEST_CASE("CompiledExpressionTest.evaluateThrows")
+{
+  const auto variables = VariableTable{MapType{{"x", Value{2}}}};
+
+  // clang-format off
+  const auto expression = GENERATE(values<std::string>({
+  "x + []",
+  "true && 'asdf'",
+  "[] || false",
+  "x[0]",
+  "{{ [] -> x }}",
+  }));
+  // clang-format on
+
+  CAPTURE(expression);
+
+  const auto compiled = CompiledExpression{IO::ELParser::parseStrict(expression)};
+  CHECK_THROWS_AS(compiled.evaluate(variables), Exception);
+}
+
+TEST_CASE("CompiledExpressionTest.shortCircuit")
+{
+  const auto variables = VariableTable{MapType{{"x", Value{2}}}};
+
+  // the right operands would throw if they were evaluated
+  CHECK(
+    CompiledExpression{IO::ELParser::parseStrict("false && x + []")}.evaluate(variables)
+    == Value{false});
+  CHECK(
+    CompiledExpression{IO::ELParser::parseStrict("true || x + []")}.evaluate(variables)
+    == Value{true});
+  CHECK(
+    CompiledExpression{IO::ELParser::parseStrict("{{ x == 2 -> 'a', x + [] }}")}.evaluate(
+      variables)
+    == Value{"a"});
+}
+
+TEST_CASE("CompiledExpressionTest.resultExpression")
+{
+  const auto expression = IO::ELParser::parseStrict("\n  1 + x");
+  const auto compiled = CompiledExpression{expression};
+
+  const auto value = compiled.evaluate(VariableTable{MapType{{"x", Value{2}}}});
+  CHECK(value == Value{3});
+  CHECK(value.line() == expression.line());
+  CHECK(value.column() == expression.column());
+}
+
+TEST_CASE("CompiledExpressionTest.variableNames")
+{
+  using T = std::tuple<std::string, std::vector<std::string>>;
+
+  // clang-format off
+  const auto
+  [expression,                                 expectedVariableNames] = GENERATE(values<T>({
+  {"1 + 2",                                    {}},
+  {"x",                                        {"x"}},
+  {"y + x * y",                                {"x", "y"}},
+  {"{ model: m, skin: s }",                    {"m", "s"}},
+  {"{{ f == 1 -> a, b }}",                     {"a", "b", "f"}},
+  {"a[1..]",                                   {"a"}},
+  }));
+  // clang-format on
+
+  CAPTURE(expression);
+
+  const auto compiled = CompiledExpression{IO::ELParser::parseStrict(expression)};
+  CHECK(compiled.variableNames() == expectedVariableNames);
+}
+} // namespace TrenchBroom::EL
@@ -20,10 +20,13 @@
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityDefinitionTestUtils.h"
 #include "Assets/PropertyDefinition.h"
+#include "Color.h"
 #include "IO/DiskIO.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
 #include "IO/TestParserStatus.h"
 #include "IO/TraversalMode.h"
 
@@ -1004,6 +1007,83 @@ TEST_CASE("FgdParserTest.parseNestedInclude")
   }));
 }
 
+TEST_CASE("FgdParserTest.parseNestedIncludeWithCache")
+{
+  const auto path =
+    std::filesystem::current_path() / "fixture/test/IO/Fgd/parseNestedInclude/host.fgd";
+  auto file = Disk::openFile(path).value();
+  auto reader = file->reader().buffer();
+
+  auto cache = EntityDefinitionClassInfoCache{};
+  auto status = TestParserStatus{};
+
+  const auto getNames = [](const auto& defs) {
+    return kdl::vec_sort(
+      kdl::vec_transform(defs, [](const auto& def) { return def->name(); }));
+  };
+
+  auto parser = FgdParser{reader.stringView(), Color{1.0f, 1.0f, 1.0f, 1.0f}, path};
+  const auto defs = parser.parseDefinitions(status, cache, path);
+  CHECK(
+    getNames(defs)
+    == std::vector<std::string>{"info_player_coop", "info_player_start", "worldspawn"});
+
+  // the host file and both included files are cached
+  CHECK(cache.size() == 3u);
+  CHECK(cache.get(path) != std::nullopt);
+  CHECK(cache.get(path.parent_path() / "nested/include.fgd") != std::nullopt);
+  CHECK(cache.get(path.parent_path() / "nested/nested.fgd") != std::nullopt);
+
+  auto cachedParser =
+    FgdParser{reader.stringView(), Color{1.0f, 1.0f, 1.0f, 1.0f}, path};
+  const auto cachedDefs = cachedParser.parseDefinitions(status, cache, path);
+  CHECK(getNames(cachedDefs) == getNames(defs));
+}
+
+TEST_CASE("FgdParserTest.replayMessagesOfCachedInclude")
+{
+  const auto env = TestEnvironment{[](TestEnvironment& e) {
+    e.createFile("host.fgd", R"(@include "include.fgd"
+@SolidClass size(-16 -16 -16, 16 16 16) = func_host : "Host" [])");
+    e.createFile("other.fgd", R"(@include "include.fgd")");
+    e.createFile(
+      "include.fgd",
+      R"(@SolidClass size(-16 -16 -16, 16 16 16) = func_include : "Include" [])");
+  }};
+
+  const auto defaultColor = Color{1.0f, 1.0f, 1.0f, 1.0f};
+  auto cache = EntityDefinitionClassInfoCache{};
+
+  const auto parse = [&](const auto& path, ParserStatus& status) {
+    auto file = Disk::openFile(path).value();
+    auto reader = file->reader().buffer();
+    auto parser = FgdParser{reader.stringView(), defaultColor, path};
+    return parser.parseDefinitions(status, cache, path);
+  };
+
+  const auto hostPath = env.dir() / "host.fgd";
+  auto status = TestParserStatus{};
+  CHECK(parse(hostPath, status).size() == 2u);
+  CHECK(status.countStatus(LogLevel::Warn) == 2u);
+
+  SECTION("Messages are logged again when the host file is cached")
+  {
+    auto cachedStatus = TestParserStatus{};
+    const auto defs = EntityDefinitionParser::findCachedDefinitions(
+      cachedStatus, cache, hostPath, defaultColor);
+    REQUIRE(defs != std::nullopt);
+    CHECK(defs->size() == 2u);
+    CHECK(cachedStatus.countStatus(LogLevel::Warn) == 2u);
+  }
+
+  SECTION("Messages are logged again when an included file is cached")
+  {
+    auto otherStatus = TestParserStatus{};
+    CHECK(parse(env.dir() / "other.fgd", otherStatus).size() == 1u);
+    CHECK(otherStatus.countStatus(LogLevel::Warn) == 1u);
+  }
+}
+
 TEST_CASE("FgdParserTest.parseRecursiveInclude")
 {
   const auto path = std::filesystem::current_path()
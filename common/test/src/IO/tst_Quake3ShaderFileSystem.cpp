@@ -20,13 +20,18 @@
 #include "Assets/Quake3Shader.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/Quake3ShaderFileSystem.h"
+#include "IO/TestEnvironment.h"
 #include "IO/TraversalMode.h"
 #include "IO/VirtualFileSystem.h"
 #include "Logger.h"
+#include "TestLogger.h"
 
 #include <filesystem>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "CatchUtils/Matchers.h"
 
@@ -79,11 +84,25 @@ TEST_CASE("Quake3ShaderFileSystemTest.testShaderLinking")
       texturePrefix / "test/test",
       texturePrefix / "test/test2",
     }));
+
+  // Shaders are parsed when their files are opened.
+  const auto shaderFile = fs.openFile(texturePrefix / "test/test").value();
+  const auto* shaderObjectFile =
+    dynamic_cast<const ObjectFile<Assets::Quake3Shader>*>(shaderFile.get());
+  REQUIRE(shaderObjectFile != nullptr);
+
+  const auto& shader = shaderObjectFile->object();
+  CHECK(shader.shaderPath == texturePrefix / "test/test");
+  CHECK(shader.editorImage == texturePrefix / "test/editor_image.jpg");
+  CHECK(shader.surfaceParms == std::set<std::string>{"noimpact"});
+
+  // Opening the file again returns the same shader.
+  CHECK(fs.openFile(texturePrefix / "test/test").value() == shaderFile);
 }
 
 TEST_CASE("Quake3ShaderFileSystemTest.testSkipMalformedFiles")
 {
-  auto logger = NullLogger{};
+  auto logger = TestLogger{};
 
   // There is one malformed shader script, this should be skipped.
 
@@ -114,6 +133,43 @@ TEST_CASE("Quake3ShaderFileSystemTest.testSkipMalformedFiles")
       texturePrefix / "test/test",
       texturePrefix / "test/test2",
     }));
+
+  // The malformed script is reported when the file system is created.
+  CHECK(logger.countMessages(LogLevel::Warn) == 1u);
+}
+
+TEST_CASE("Quake3ShaderFileSystemTest.logWarningsWhenOpeningShader")
+{
+  auto logger = TestLogger{};
+
+  const auto env = TestEnvironment{[](TestEnvironment& e) {
+    e.createDirectory("scripts");
+    e.createFile("scripts/test.shader", R"(textures/test/test
+{
+    {
+        map textures/test/test.tga
+        blendFunc unknown
+    }
+})");
+  }};
+
+  auto fs = VirtualFileSystem{};
+  fs.mount("", std::make_unique<DiskFileSystem>(env.dir()));
+  fs.mount(
+    "",
+    createImageFileSystem<Quake3ShaderFileSystem>(
+      fs, "scripts", std::vector<std::filesystem::path>{"textures"}, logger)
+      .value());
+
+  // The shader is only parsed when it is opened.
+  CHECK(logger.countMessages(LogLevel::Warn) == 0u);
+
+  REQUIRE(fs.openFile("textures/test/test").is_success());
+  CHECK(logger.countMessages(LogLevel::Warn) == 1u);
+
+  // The cached shader is not parsed again.
+  REQUIRE(fs.openFile("textures/test/test").is_success());
+  CHECK(logger.countMessages(LogLevel::Warn) == 1u);
 }
 } // namespace IO
 } // namespace TrenchBroom
@@ -18,6 +18,7 @@
  */
 
 #include "Assets/Quake3Shader.h"
+#include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
@@ -26,7 +27,9 @@
 #include "IO/TestParserStatus.h"
 
 #include <filesystem>
+#include <set>
 #include <string>
+#include <string_view>
 
 #include "Catch2.h"
 
@@ -545,4 +548,95 @@ TEST_CASE("Quake3ShaderParserTest.parseBlendFuncParameters")
     }}));
 }
 
+TEST_CASE("Quake3ShaderParserTest.indexShaders")
+{
+  const auto data = std::string{R"(
+textures/test/first
+{
+    qer_editorimage textures/test/editor_image.jpg
+    {
+        map $lightmap
+    }
+}
+
+/textures/test/second // leading slash is stripped
+{ surfaceparm nodraw }
+)"};
+
+  auto parser = Quake3ShaderParser{data};
+  const auto locations = parser.index();
+  REQUIRE(locations.size() == 2u);
+
+  CHECK(locations[0].shaderPath == "textures/test/first");
+  CHECK(locations[0].line == 2u);
+  CHECK(locations[0].column == 1u);
+  CHECK(data.substr(locations[0].position, locations[0].length) == R"(textures/test/first
+{
+    qer_editorimage textures/test/editor_image.jpg
+    {
+        map $lightmap
+    }
+})");
+
+  CHECK(locations[1].shaderPath == "textures/test/second");
+  CHECK(locations[1].line == 10u);
+  CHECK(locations[1].column == 1u);
+  CHECK(
+    data.substr(locations[1].position, locations[1].length)
+    == "/textures/test/second // leading slash is stripped\n{ surfaceparm nodraw }");
+
+  SECTION("Indexed shaders can be parsed individually")
+  {
+    auto status = TestParserStatus{};
+    const auto& location = locations[1];
+    auto shaderParser = Quake3ShaderParser{
+      std::string_view{data}.substr(location.position, location.length),
+      location.line,
+      location.column};
+
+    const auto shaders = shaderParser.parse(status);
+    REQUIRE(shaders.size() == 1u);
+    CHECK(shaders[0].shaderPath == "textures/test/second");
+    CHECK(shaders[0].surfaceParms == std::set<std::string>{"nodraw"});
+  }
+
+  SECTION("Unbalanced braces are reported")
+  {
+    auto unbalancedParser = Quake3ShaderParser{R"(
+textures/test/first
+{
+    {
+        map $lightmap
+}
+)"};
+    CHECK_THROWS_AS(unbalancedParser.index(), ParserException);
+  }
+
+  SECTION("Nested stages are reported")
+  {
+    auto nestedStageParser = Quake3ShaderParser{R"(
+textures/test/first
+{
+    {
+        {
+            map $lightmap
+        }
+    }
+}
+)"};
+    CHECK_THROWS_AS(nestedStageParser.index(), ParserException);
+  }
+
+  SECTION("Entries without a key are reported")
+  {
+    auto missingKeyParser = Quake3ShaderParser{R"(
+textures/test/first
+{
+    $lightmap
+}
+)"};
+    CHECK_THROWS_AS(missingKeyParser.index(), ParserException);
+  }
+}
+
 } // namespace TrenchBroom::IO
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureThumbnail.h"
+#include "IO/DiskIO.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureThumbnailCache.h"
+
+#include <kdl/result.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+
+TEST_CASE("TextureThumbnailCache")
+{
+  using Thumbnails = std::unordered_map<std::string, Assets::TextureThumbnail>;
+
+  auto env = TestEnvironment{};
+  const auto cache = TextureThumbnailCache{env.dir() / "cache"};
+
+  const auto collectionPath = std::filesystem::path{"/textures/base"};
+  const auto modificationTime = std::filesystem::file_time_type::clock::now();
+
+  auto textures = std::vector<Assets::Texture>{};
+  textures.emplace_back("a", 2, 1);
+  textures.emplace_back("b", 1, 1);
+
+  const auto thumbnails = std::vector<Assets::TextureThumbnail>{
+    {2, 1, {1, 2, 3, 4, 5, 6, 7, 8}},
+    {1, 1, {9, 10, 11, 12}},
+  };
+
+  SECTION("Nothing is cached initially")
+  {
+    CHECK(cache.load(collectionPath, modificationTime) == Thumbnails{});
+  }
+
+  SECTION("Stored thumbnails are loaded by texture name")
+  {
+    REQUIRE(cache.store(collectionPath, modificationTime, textures, thumbnails)
+              .is_success());
+    CHECK(
+      cache.load(collectionPath, modificationTime)
+      == Thumbnails{{"a", thumbnails[0]}, {"b", thumbnails[1]}});
+
+    SECTION("Storing thumbnails replaces the previous ones")
+    {
+      auto otherTextures = std::vector<Assets::Texture>{};
+      otherTextures.emplace_back("c", 1, 1);
+
+      REQUIRE(
+        cache.store(collectionPath, modificationTime, otherTextures, {thumbnails[1]})
+          .is_success());
+      CHECK(
+        cache.load(collectionPath, modificationTime)
+        == Thumbnails{{"c", thumbnails[1]}});
+    }
+  }
+
+  SECTION("Thumbnails of a modified collection are not loaded")
+  {
+    REQUIRE(cache.store(collectionPath, modificationTime, textures, thumbnails)
+              .is_success());
+    CHECK(
+      cache.load(collectionPath, modificationTime + std::chrono::seconds{1})
+      == Thumbnails{});
+  }
+
+  SECTION("Thumbnails of other collections are not loaded")
+  {
+    REQUIRE(cache.store(collectionPath, modificationTime, textures, thumbnails)
+              .is_success());
+    CHECK(cache.load("/textures/other", modificationTime) == Thumbnails{});
+  }
+
+  SECTION("Damaged cache files are ignored")
+  {
+    REQUIRE(cache.store(collectionPath, modificationTime, textures, thumbnails)
+              .is_success());
+
+    const auto cacheFiles = std::vector<std::filesystem::path>{
+      std::filesystem::directory_iterator{cache.directory()}, {}};
+    REQUIRE(cacheFiles.size() == 1);
+
+    // truncate the file
+    std::filesystem::resize_file(
+      cacheFiles.front(), std::filesystem::file_size(cacheFiles.front()) - 1);
+    CHECK(cache.load(collectionPath, modificationTime) == Thumbnails{});
+  }
+}
+
+} // namespace TrenchBroom::IO
@@ -76,5 +76,34 @@ TEST_CASE("BezierPatch.transform")
                                                                   {2, 2, 0}, {3, 2, 1}, {4, 2, 0} });
   // clang-format on
 }
+
+TEST_CASE("BezierPatch.contentHash")
+{
+  // clang-format off
+  const auto original = BezierPatch{3, 3, { {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+                                            {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+                                            {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "texture"};
+  // clang-format on
+
+  auto patch = original;
+  CHECK(patch.contentHash() == original.contentHash());
+  CHECK(patch == original);
+
+  patch.setControlPoint(1, 1, {1, 1, 3});
+  CHECK(patch.contentHash() != original.contentHash());
+  CHECK(patch != original);
+
+  patch.setControlPoint(1, 1, {1, 1, 2});
+  CHECK(patch.contentHash() == original.contentHash());
+
+  patch.setTextureName("other");
+  CHECK(patch.contentHash() != original.contentHash());
+  CHECK(patch != original);
+
+  patch.setTextureName("texture");
+  patch.transform(vm::translation_matrix(vm::vec3d{2.0, 0.0, 0.0}));
+  CHECK(patch.contentHash() != original.contentHash());
+  CHECK(patch != original);
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -45,6 +45,7 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -235,6 +236,128 @@ TEST_CASE("BrushTest.resizePastWorldBounds")
   CHECK(!canMoveBoundary(brush1, worldBounds, *rightFaceIndex, vm::vec3(8000, 0, 0)));
 }
 
+TEST_CASE("BrushTest.discardAndRebuildGeometry")
+{
+  const vm::bbox3 worldBounds(8192.0);
+  const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+  const auto original =
+    builder
+      .createCuboid(vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)), "texture")
+      .value();
+  REQUIRE(original.hasGeometry());
+
+  auto brush = original;
+  brush.discardGeometry();
+  CHECK_FALSE(brush.hasGeometry());
+  CHECK(brush == original);
+
+  // copies of a brush without geometry have no geometry either
+  const auto copy = brush;
+  CHECK_FALSE(copy.hasGeometry());
+
+  CHECK(brush.rebuildGeometry(worldBounds).is_success());
+  CHECK(brush.hasGeometry());
+  CHECK(brush == original);
+  CHECK(brush.bounds() == original.bounds());
+  CHECK_THAT(
+    brush.vertexPositions(), Catch::UnorderedEquals(original.vertexPositions()));
+
+  // rebuilding a brush that has a geometry does nothing
+  CHECK(brush.rebuildGeometry(worldBounds).is_success());
+  CHECK(brush.hasGeometry());
+}
+
+TEST_CASE("BrushTest.copySharesGeometry")
+{
+  const vm::bbox3 worldBounds(8192.0);
+  const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+  const auto original =
+    builder
+      .createCuboid(vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)), "texture")
+      .value();
+
+  auto copy = original;
+  for (size_t i = 0u; i < original.faceCount(); ++i)
+  {
+    CHECK(copy.face(i).geometry() == original.face(i).geometry());
+  }
+
+  // changing face attributes does not affect the geometry
+  auto attributes = copy.face(0).attributes();
+  attributes.setTextureName("other");
+  copy.face(0).setAttributes(attributes);
+  CHECK(copy.face(0).geometry() == original.face(0).geometry());
+  CHECK(original.face(0).attributes().textureName() == "texture");
+
+  // changing the shape replaces the geometry of the copy only
+  REQUIRE(
+    copy.transform(worldBounds, vm::translation_matrix(vm::vec3(16, 0, 0)), false)
+      .is_success());
+  CHECK(copy.face(0).geometry() != original.face(0).geometry());
+  CHECK(copy.bounds() == vm::bbox3(vm::vec3(-48, -64, -64), vm::vec3(80, 64, 64)));
+  CHECK(original.bounds() == vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)));
+}
+
+TEST_CASE("BrushTest.contentHash")
+{
+  const vm::bbox3 worldBounds(8192.0);
+  const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+  const auto original =
+    builder
+      .createCuboid(vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)), "texture")
+      .value();
+
+  SECTION("Equal brushes have equal hashes")
+  {
+    const auto copy = original;
+    CHECK(copy.contentHash() == original.contentHash());
+
+    auto reversedFaces = original.faces();
+    std::reverse(reversedFaces.begin(), reversedFaces.end());
+    CHECK(Brush::contentHash(reversedFaces) == original.contentHash());
+
+    auto brush = original;
+    brush.discardGeometry();
+    CHECK(brush.contentHash() == original.contentHash());
+    REQUIRE(brush.rebuildGeometry(worldBounds).is_success());
+    CHECK(brush.contentHash() == original.contentHash());
+  }
+
+  SECTION("Changing face attributes changes the hash")
+  {
+    auto brush = original;
+    REQUIRE(brush.contentHash() == original.contentHash());
+
+    auto attributes = brush.face(0).attributes();
+    attributes.setTextureName("other");
+    brush.face(0).setAttributes(attributes);
+
+    CHECK(brush.contentHash() != original.contentHash());
+    CHECK(brush != original);
+  }
+
+  SECTION("Transforming the brush changes the hash")
+  {
+    auto brush = original;
+    REQUIRE(brush.contentHash() == original.contentHash());
+    REQUIRE(
+      brush.transform(worldBounds, vm::translation_matrix(vm::vec3(16, 0, 0)), false)
+        .is_success());
+
+    CHECK(brush.contentHash() != original.contentHash());
+    CHECK(brush != original);
+
+    REQUIRE(
+      brush.transform(worldBounds, vm::translation_matrix(vm::vec3(-16, 0, 0)), false)
+        .is_success());
+    CHECK(brush.contentHash() == original.contentHash());
+    CHECK(brush == original);
+  }
+}
+
 TEST_CASE("BrushTest.expand")
 {
   const vm::bbox3 worldBounds(8192.0);
@@ -190,6 +190,45 @@ TEST_CASE("EntityTest")
     CHECK(
       entity.modelSpecification()
       == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    SECTION("Updates cached specification when a referenced property changes")
+    {
+      entity.addOrUpdateProperty({}, "some_key", "some_value");
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.renameProperty({}, EntityPropertyKeys::Spawnflags, "other_key");
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.renameProperty({}, "other_key", EntityPropertyKeys::Spawnflags);
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.removeProperty({}, EntityPropertyKeys::Spawnflags);
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.setProperties({}, {{EntityPropertyKeys::Spawnflags, "2"}});
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+
+    SECTION("Updates cached specification when the definition changes")
+    {
+      entity.unsetEntityDefinitionAndModel();
+      CHECK(entity.modelSpecification() == Assets::ModelSpecification{});
+
+      entity.setDefinition({}, &definition);
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+    }
   }
 
   SECTION("decalSpecification")
@@ -211,6 +250,9 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty({}, "texture", "decal1");
     CHECK(entity.decalSpecification() == Assets::DecalSpecification{"decal1"});
+
+    entity.removeProperty({}, "texture");
+    CHECK(entity.decalSpecification() == Assets::DecalSpecification{""});
   }
 
   SECTION("unsetEntityDefinitionAndModel")
@@ -728,5 +770,39 @@ TEST_CASE("EntityTest")
       }
     }
   }
+
+  SECTION("contentHash")
+  {
+    const auto original = Entity{{}, {{"classname", "light"}, {"light", "300"}}};
+
+    auto entity = original;
+    CHECK(entity.contentHash() == original.contentHash());
+    CHECK(entity == original);
+
+    SECTION("Changing a property changes the hash")
+    {
+      entity.addOrUpdateProperty({}, "light", "200");
+      CHECK(entity.contentHash() != original.contentHash());
+      CHECK(entity != original);
+
+      entity.addOrUpdateProperty({}, "light", "300");
+      CHECK(entity.contentHash() == original.contentHash());
+      CHECK(entity == original);
+    }
+
+    SECTION("Reordering properties changes the hash")
+    {
+      entity.setProperties({}, {{"light", "300"}, {"classname", "light"}});
+      CHECK(entity.contentHash() != original.contentHash());
+      CHECK(entity != original);
+    }
+
+    SECTION("Changing protected properties changes the hash")
+    {
+      entity.setProtectedProperties({"light"});
+      CHECK(entity.contentHash() != original.contentHash());
+      CHECK(entity != original);
+    }
+  }
 }
 } // namespace TrenchBroom::Model
@@ -20,9 +20,11 @@
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityNodeIndex.h"
+#include "Model/InternedString.h"
 
 #include <kdl/vector_utils.h>
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -71,6 +73,23 @@ TEST_CASE("EntityNodeIndexTest.addEntityNode")
   delete entity2;
 }
 
+TEST_CASE("EntityNodeIndexTest.findUnknownKey")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity = new EntityNode({}, {{"test", "somevalue"}});
+  index.addEntityNode(entity);
+
+  // looking up a key that no entity has does not intern it
+  CHECK(findExactExact(index, "entity_node_index_unknown_key", "somevalue").empty());
+  CHECK(
+    index.allValuesForKeys(EntityNodeIndexQuery::exact("entity_node_index_unknown_key"))
+      .empty());
+  CHECK(InternedString::find("entity_node_index_unknown_key") == std::nullopt);
+
+  delete entity;
+}
+
 TEST_CASE("EntityNodeIndexTest.removeEntityNode")
 {
   EntityNodeIndex index;
@@ -191,6 +210,34 @@ TEST_CASE("EntityNodeIndexTest.addRemoveFloatProperty")
   delete entity1;
 }
 
+TEST_CASE("EntityNodeIndexTest.forEachEntityNode")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"target", "door*"}, {"target2", "door*"}});
+  EntityNode* entity2 = new EntityNode({}, {{"target", "door1"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  std::vector<EntityNodeBase*> nodes;
+  index.forEachEntityNode(
+    EntityNodeIndexQuery::numbered("target"), "door*", [&](EntityNodeBase* node) {
+      nodes.push_back(node);
+    });
+
+  // the value is not a pattern, and every node is visited once
+  CHECK(nodes == std::vector<EntityNodeBase*>{entity1});
+
+  nodes.clear();
+  index.findEntityNodes(EntityNodeIndexQuery::exact("target"), "door1", nodes);
+  index.findEntityNodes(EntityNodeIndexQuery::exact("target2"), "door1", nodes);
+  CHECK(nodes == std::vector<EntityNodeBase*>{entity2});
+
+  delete entity1;
+  delete entity2;
+}
+
 TEST_CASE("EntityNodeIndexTest.allKeys")
 {
   EntityNodeIndex index;
@@ -223,5 +270,36 @@ TEST_CASE("EntityNodeIndexTest.allValuesForKeys")
     index.allValuesForKeys(EntityNodeIndexQuery::exact("test")),
     Catch::UnorderedEquals(std::vector<std::string>{"somevalue", "somevalue2"}));
 }
+
+TEST_CASE("EntityNodeIndexTest.allValuesForPrefixAndNumberedKeys")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"target", "a"}, {"target2", "b"}});
+
+  EntityNode* entity2 =
+    new EntityNode({}, {{"targetname", "c"}, {"target_x", "d"}, {"other", "e"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::prefix("target")),
+    Catch::UnorderedEquals(std::vector<std::string>{"a", "b", "c", "d"}));
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::numbered("target")),
+    Catch::UnorderedEquals(std::vector<std::string>{"a", "b"}));
+
+  index.removeEntityNode(entity1);
+  CHECK_THAT(
+    index.allKeys(),
+    Catch::UnorderedEquals(std::vector<std::string>{"targetname", "target_x", "other"}));
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::numbered("target")),
+    Catch::UnorderedEquals(std::vector<std::string>{}));
+
+  delete entity1;
+  delete entity2;
+}
 } // namespace Model
 } // namespace TrenchBroom
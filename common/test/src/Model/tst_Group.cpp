@@ -51,5 +51,29 @@ TEST_CASE("GroupTest.transform")
     == vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0))
          * vm::translation_matrix(vm::vec3(32.0, 0.0, 0.0)));
 }
+
+TEST_CASE("GroupTest.contentHash")
+{
+  const auto original = Group{"name"};
+
+  auto group = original;
+  CHECK(group.contentHash() == original.contentHash());
+  CHECK(group == original);
+
+  group.setName("other");
+  CHECK(group.contentHash() != original.contentHash());
+  CHECK(group != original);
+
+  group.setName("name");
+  CHECK(group.contentHash() == original.contentHash());
+
+  group.transform(vm::translation_matrix(vm::vec3(32.0, 0.0, 0.0)));
+  CHECK(group.contentHash() != original.contentHash());
+  CHECK(group != original);
+
+  group.setTransformation(vm::mat4x4());
+  CHECK(group.contentHash() == original.contentHash());
+  CHECK(group == original);
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/InternedString.h"
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+
+TEST_CASE("InternedString")
+{
+  SECTION("Default constructed handles are empty")
+  {
+    CHECK(InternedString{}.empty());
+    CHECK(InternedString{}.str() == "");
+    CHECK(InternedString{} == InternedString{""});
+  }
+
+  SECTION("Equal strings share one entry")
+  {
+    const auto a = InternedString{"textures/base_wall/metal"};
+    const auto b = InternedString{std::string{"textures/base_wall/"} + "metal"};
+    const auto c = InternedString{"textures/base_wall/concrete"};
+
+    CHECK(a.str() == "textures/base_wall/metal");
+    CHECK(&a.str() == &b.str());
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(a == "textures/base_wall/metal");
+    CHECK(a != "textures/base_wall/concrete");
+  }
+
+  SECTION("Finding a string does not intern it")
+  {
+    CHECK(InternedString::find("") == InternedString{});
+    CHECK(InternedString::find("interned_string_not_interned") == std::nullopt);
+    CHECK(InternedString::find("interned_string_not_interned") == std::nullopt);
+
+    const auto interned = InternedString{"interned_string_interned"};
+    CHECK(InternedString::find("interned_string_interned") == interned);
+  }
+
+  SECTION("Handles are ordered by their strings")
+  {
+    const auto a = InternedString{"b_texture"};
+    const auto b = InternedString{"a_texture"};
+
+    CHECK(b < a);
+    CHECK_FALSE(a < b);
+    CHECK_FALSE(a < a);
+  }
+
+  SECTION("Handles are printed as their strings")
+  {
+    auto str = std::stringstream{};
+    str << InternedString{"texture"};
+    CHECK(str.str() == "texture");
+  }
+
+  SECTION("Interning is thread safe")
+  {
+    auto interned = std::vector<InternedString>(8);
+    auto threads = std::vector<std::thread>{};
+    for (size_t i = 0; i < interned.size(); ++i)
+    {
+      threads.emplace_back([&, i]() {
+        for (size_t j = 0; j < 1000; ++j)
+        {
+          interned[i] = InternedString{"texture_" + std::to_string(j)};
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const auto& str : interned)
+    {
+      CHECK(str == InternedString{"texture_999"});
+    }
+  }
+}
+
+} // namespace TrenchBroom::Model
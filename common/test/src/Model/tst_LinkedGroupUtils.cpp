@@ -20,6 +20,7 @@
 #include "Model/BezierPatch.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
@@ -38,6 +39,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
+#include <vecmath/scalar.h>
 
 #include <numeric>
 #include <unordered_set>
@@ -341,6 +343,144 @@ TEST_CASE("GroupNode.updateLinkedGroupsExceedsWorldBounds")
     });
 }
 
+TEST_CASE("GroupNode.updateLinkedGroupsWithBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* changedBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "texture").value()};
+  auto* unchangedBrushNode = new BrushNode{
+    brushBuilder.createCuboid(vm::bbox3{{64, 0, 0}, {128, 32, 32}}, "texture").value()};
+  groupNode.addChildren({changedBrushNode, unchangedBrushNode});
+
+  const auto cloneAndTranslate = [&](const vm::vec3& delta) {
+    auto groupNodeClone = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds, SetLinkId::keep))};
+    transformNode(*groupNodeClone, vm::translation_matrix(delta), worldBounds);
+    return groupNodeClone;
+  };
+
+  const auto groupNodeClone1 = cloneAndTranslate(vm::vec3{0, 128, 0});
+  const auto groupNodeClone2 = cloneAndTranslate(vm::vec3{0, 0, 128});
+
+  transformNode(
+    *changedBrushNode, vm::translation_matrix(vm::vec3{0, 0, 16}), worldBounds);
+
+  const auto translatedBrush = [&](const Brush& brush, const vm::vec3& delta) {
+    auto result = brush;
+    REQUIRE(result.transform(worldBounds, vm::translation_matrix(delta), true)
+              .is_success());
+    return result;
+  };
+
+  updateLinkedGroups(
+    groupNode, {groupNodeClone1.get(), groupNodeClone2.get()}, worldBounds)
+    .transform([&](const UpdateLinkedGroupsResult& r) {
+      REQUIRE(r.size() == 2u);
+
+      for (const auto& [groupNodeToUpdate, newChildren] : r)
+      {
+        const auto& delta = groupNodeToUpdate == groupNodeClone1.get()
+                              ? vm::vec3{0, 128, 0}
+                              : vm::vec3{0, 0, 128};
+        REQUIRE(newChildren.size() == 2u);
+
+        const auto* newChangedBrushNode =
+          dynamic_cast<BrushNode*>(newChildren.front().get());
+        const auto* newUnchangedBrushNode =
+          dynamic_cast<BrushNode*>(newChildren.back().get());
+        REQUIRE(newChangedBrushNode != nullptr);
+        REQUIRE(newUnchangedBrushNode != nullptr);
+
+        CHECK(newChangedBrushNode->linkId() == changedBrushNode->linkId());
+        CHECK(
+          newChangedBrushNode->brush()
+          == translatedBrush(changedBrushNode->brush(), delta));
+
+        CHECK(newUnchangedBrushNode->linkId() == unchangedBrushNode->linkId());
+        CHECK(
+          newUnchangedBrushNode->brush()
+          == translatedBrush(unchangedBrushNode->brush(), delta));
+
+        // the unchanged brush is reused and shares its geometry with the original brush
+        const auto& oldChangedBrush =
+          static_cast<BrushNode*>(groupNodeToUpdate->children().front())->brush();
+        const auto& oldUnchangedBrush =
+          static_cast<BrushNode*>(groupNodeToUpdate->children().back())->brush();
+        CHECK(
+          newChangedBrushNode->brush().faces().front().geometry()
+          != oldChangedBrush.faces().front().geometry());
+        CHECK(newUnchangedBrushNode->brush() == oldUnchangedBrush);
+        CHECK(
+          newUnchangedBrushNode->brush().faces().front().geometry()
+          == oldUnchangedBrush.faces().front().geometry());
+      }
+    })
+    .transform_error([](const auto&) { FAIL(); });
+}
+
+TEST_CASE("GroupNode.updateLinkedGroupsWithRotatedBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* changedBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "texture").value()};
+  auto* unchangedBrushNode = new BrushNode{
+    brushBuilder.createCuboid(vm::bbox3{{64, 0, 0}, {128, 32, 32}}, "texture").value()};
+  groupNode.addChildren({changedBrushNode, unchangedBrushNode});
+
+  auto groupNodeClone = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds, SetLinkId::keep))};
+  transformNode(
+    *groupNodeClone,
+    vm::translation_matrix(vm::vec3{256, 0, 0})
+      * vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(30.0)),
+    worldBounds);
+
+  const auto updateClone = [&]() {
+    auto result =
+      updateLinkedGroups(groupNode, {groupNodeClone.get()}, worldBounds).value();
+    REQUIRE(result.size() == 1u);
+    auto& [groupNodeToUpdate, newChildren] = result.front();
+    REQUIRE(groupNodeToUpdate == groupNodeClone.get());
+    return groupNodeToUpdate->replaceChildren(std::move(newChildren));
+  };
+
+  // the clone now contains brushes that were transformed with texture lock
+  updateClone();
+
+  transformNode(
+    *changedBrushNode, vm::translation_matrix(vm::vec3{0, 0, 16}), worldBounds);
+
+  const auto oldChildren = updateClone();
+  REQUIRE(oldChildren.size() == 2u);
+
+  const auto* oldChangedBrushNode = dynamic_cast<BrushNode*>(oldChildren.front().get());
+  const auto* oldUnchangedBrushNode = dynamic_cast<BrushNode*>(oldChildren.back().get());
+  const auto* newChangedBrushNode =
+    dynamic_cast<BrushNode*>(groupNodeClone->children().front());
+  const auto* newUnchangedBrushNode =
+    dynamic_cast<BrushNode*>(groupNodeClone->children().back());
+  REQUIRE(oldChangedBrushNode != nullptr);
+  REQUIRE(oldUnchangedBrushNode != nullptr);
+  REQUIRE(newChangedBrushNode != nullptr);
+  REQUIRE(newUnchangedBrushNode != nullptr);
+
+  CHECK(
+    newChangedBrushNode->brush().faces().front().geometry()
+    != oldChangedBrushNode->brush().faces().front().geometry());
+
+  // the unchanged brush is reused even though it was rotated with texture lock
+  CHECK(newUnchangedBrushNode->brush() == oldUnchangedBrushNode->brush());
+  CHECK(
+    newUnchangedBrushNode->brush().faces().front().geometry()
+    == oldUnchangedBrushNode->brush().faces().front().geometry());
+}
+
 static void setGroupName(GroupNode& groupNode, const std::string& name)
 {
   auto group = groupNode.group();
@@ -51,6 +51,7 @@
 #include <vecmath/ray.h>
 #include <vecmath/ray_io.h>
 
+#include <memory>
 #include <variant>
 #include <vector>
 
@@ -134,6 +135,8 @@ private: // implement Node interface
     return name;
   }
 
+  std::uint64_t doGetContentHash() const override { return 0; }
+
   const vm::bbox3& doGetLogicalBounds() const override
   {
     static const vm::bbox3 bounds;
@@ -211,6 +214,8 @@ private: // implement Node interface
     return name;
   }
 
+  std::uint64_t doGetContentHash() const override { return 0; }
+
   const vm::bbox3& doGetLogicalBounds() const override
   {
     static const vm::bbox3 bounds;
@@ -824,6 +829,51 @@ TEST_CASE("Nodepath.resolvePath")
   CHECK(child1_1_1.resolvePath(NodePath{{}}) == &child1_1_1);
 }
 
+TEST_CASE("NodeTest.contentHash")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto groupNode = GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{{}, {{"classname", "light"}}}};
+  auto* brushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+  groupNode.addChildren({entityNode, brushNode});
+
+  const auto originalHash = groupNode.contentHash();
+
+  const auto clone =
+    std::unique_ptr<Node>{groupNode.cloneRecursively(worldBounds, SetLinkId::keep)};
+  CHECK(clone->contentHash() == originalHash);
+
+  SECTION("Changing a child changes the hash")
+  {
+    auto brush = brushNode->brush();
+    REQUIRE(
+      brush.transform(worldBounds, vm::translation_matrix(vm::vec3{16, 0, 0}), false)
+        .is_success());
+    const auto originalBrush = brushNode->setBrush(std::move(brush));
+    CHECK(groupNode.contentHash() != originalHash);
+
+    brushNode->setBrush(originalBrush);
+    CHECK(groupNode.contentHash() == originalHash);
+  }
+
+  SECTION("Changing the node changes the hash")
+  {
+    auto group = groupNode.group();
+    group.setName("other");
+    groupNode.setGroup(std::move(group));
+    CHECK(groupNode.contentHash() != originalHash);
+  }
+
+  SECTION("Removing a child changes the hash")
+  {
+    groupNode.removeChild(entityNode);
+    delete entityNode;
+    CHECK(groupNode.contentHash() != originalHash);
+  }
+}
+
 TEST_CASE("NodeTest.entityPropertyConfig")
 {
   class RootNode : public TestNode
@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeAllocator.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+
+namespace
+{
+struct TestObject
+{
+  double value;
+  char data[100];
+};
+
+// has a different size than BrushNode, so it isn't allocated by the node allocator
+class DerivedBrushNode : public BrushNode
+{
+private:
+  std::vector<int> m_data = std::vector<int>(16);
+
+public:
+  using BrushNode::BrushNode;
+};
+} // namespace
+
+TEST_CASE("NodeAllocator.allocate")
+{
+  auto allocator = NodeAllocator{sizeof(TestObject), alignof(TestObject)};
+  REQUIRE(allocator.slotsPerChunk() > 1u);
+  CHECK(allocator.chunkCount() == 0u);
+  CHECK(allocator.allocationCount() == 0u);
+
+  SECTION("Consecutive allocations are adjacent")
+  {
+    auto* first = static_cast<std::byte*>(allocator.allocate());
+    auto* second = static_cast<std::byte*>(allocator.allocate());
+    CHECK(second > first);
+    CHECK(second - first < 2 * static_cast<std::ptrdiff_t>(sizeof(TestObject)));
+    CHECK(allocator.chunkCount() == 1u);
+    CHECK(allocator.allocationCount() == 2u);
+
+    allocator.deallocate(first);
+    allocator.deallocate(second);
+    CHECK(allocator.allocationCount() == 0u);
+  }
+
+  SECTION("Freed slots are reused")
+  {
+    auto* first = allocator.allocate();
+    auto* second = allocator.allocate();
+    allocator.deallocate(first);
+    CHECK(allocator.allocate() == first);
+
+    allocator.deallocate(first);
+    allocator.deallocate(second);
+  }
+
+  SECTION("Chunks are released when they are empty")
+  {
+    auto slots = std::vector<void*>{};
+    for (size_t i = 0; i < 3 * allocator.slotsPerChunk(); ++i)
+    {
+      auto* slot = allocator.allocate();
+      new (slot) TestObject{static_cast<double>(i), {}};
+      slots.push_back(slot);
+    }
+    CHECK(allocator.chunkCount() == 3u);
+    CHECK(allocator.allocationCount() == slots.size());
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+      CHECK(static_cast<TestObject*>(slots[i])->value == static_cast<double>(i));
+    }
+
+    for (auto* slot : slots)
+    {
+      allocator.deallocate(slot);
+    }
+
+    // the last chunk is kept
+    CHECK(allocator.chunkCount() == 1u);
+    CHECK(allocator.allocationCount() == 0u);
+  }
+}
+
+TEST_CASE("NodeAllocator.allocateNode")
+{
+  auto allocator = NodeAllocator{sizeof(TestObject), alignof(TestObject)};
+
+  SECTION("Objects of the node type are allocated by the allocator")
+  {
+    auto* ptr = allocateNode<TestObject>(allocator, sizeof(TestObject));
+    CHECK(allocator.allocationCount() == 1u);
+
+    deallocateNode<TestObject>(allocator, ptr, sizeof(TestObject));
+    CHECK(allocator.allocationCount() == 0u);
+  }
+
+  SECTION("Objects of a derived type are allocated by the global allocator")
+  {
+    constexpr auto derivedSize = sizeof(TestObject) + 16;
+    auto* ptr = allocateNode<TestObject>(allocator, derivedSize);
+    CHECK(allocator.allocationCount() == 0u);
+    CHECK(allocator.chunkCount() == 0u);
+
+    deallocateNode<TestObject>(allocator, ptr, derivedSize);
+    CHECK(allocator.allocationCount() == 0u);
+  }
+}
+
+TEST_CASE("NodeAllocator.nodes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto entityNode = std::make_unique<EntityNode>(Entity{});
+  entityNode->addChildren({
+    new BrushNode{builder.createCube(64.0, "texture").value()},
+    new DerivedBrushNode{builder.createCube(64.0, "texture").value()},
+  });
+
+  auto clone =
+    std::unique_ptr<Node>{entityNode->cloneRecursively(worldBounds, SetLinkId::keep)};
+  REQUIRE(clone->childCount() == 2u);
+  CHECK(dynamic_cast<BrushNode*>(clone->children().front()));
+}
+
+} // namespace TrenchBroom::Model
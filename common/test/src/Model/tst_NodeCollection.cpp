@@ -476,6 +476,77 @@ TEST_CASE("NodeCollection.removeNode")
   }
 }
 
+TEST_CASE("NodeCollection.removeNodes")
+{
+  const auto mapFormat = MapFormat::Quake3;
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto layerNode = LayerNode{Layer{"layer"}};
+  auto groupNode = GroupNode{Group{"group"}};
+  auto entityNode = EntityNode{Entity{}};
+  auto brushNode1 =
+    BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+  auto brushNode2 =
+    BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+  // clang-format off
+  auto patchNode = PatchNode{BezierPatch{3, 3, {
+    {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+    {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+    {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "texture"}};
+  // clang-format on
+
+  auto nodeCollection = NodeCollection{};
+  nodeCollection.addNodes(
+    {&layerNode, &groupNode, &entityNode, &brushNode1, &patchNode, &brushNode2});
+
+  SECTION("no nodes")
+  {
+    nodeCollection.removeNodes({});
+    CHECK(
+      nodeCollection.nodes()
+      == std::vector<Node*>{
+        &layerNode, &groupNode, &entityNode, &brushNode1, &patchNode, &brushNode2});
+  }
+
+  SECTION("some nodes")
+  {
+    nodeCollection.removeNodes({&brushNode1, &groupNode, &patchNode});
+    CHECK(
+      nodeCollection.nodes() == std::vector<Node*>{&layerNode, &entityNode, &brushNode2});
+    CHECK(nodeCollection.layers() == std::vector<LayerNode*>{&layerNode});
+    CHECK(nodeCollection.groups() == std::vector<GroupNode*>{});
+    CHECK(nodeCollection.entities() == std::vector<EntityNode*>{&entityNode});
+    CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{&brushNode2});
+    CHECK(nodeCollection.patches() == std::vector<PatchNode*>{});
+  }
+
+  SECTION("all nodes")
+  {
+    nodeCollection.removeNodes(
+      {&brushNode2, &patchNode, &brushNode1, &entityNode, &groupNode, &layerNode});
+    CHECK(nodeCollection.empty());
+    CHECK(nodeCollection.layers() == std::vector<LayerNode*>{});
+    CHECK(nodeCollection.groups() == std::vector<GroupNode*>{});
+    CHECK(nodeCollection.entities() == std::vector<EntityNode*>{});
+    CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{});
+    CHECK(nodeCollection.patches() == std::vector<PatchNode*>{});
+  }
+
+  SECTION("nodes that are not in the collection")
+  {
+    auto otherBrushNode =
+      BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+    nodeCollection.removeNodes({&otherBrushNode, &entityNode});
+    CHECK(
+      nodeCollection.nodes()
+      == std::vector<Node*>{
+        &layerNode, &groupNode, &brushNode1, &patchNode, &brushNode2});
+    CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{&brushNode1, &brushNode2});
+  }
+}
+
 TEST_CASE("NodeCollection.clear")
 {
   const auto mapFormat = MapFormat::Quake3;
@@ -17,18 +17,26 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Assets/Texture.h"
 #include "Error.h"
 #include "Exceptions.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/Tag.h"
 #include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/result.h>
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -67,5 +75,164 @@ TEST_CASE("TaggingTest.testTagBrush")
   CHECK_FALSE(brushNode->hasTag(tag1));
   CHECK_FALSE(brushNode->hasTag(tag2));
 }
+
+TEST_CASE("TaggingTest.textureNamePatternMatcher")
+{
+  auto matcher = TextureNamePatternMatcher{};
+  matcher.addPattern("trigger", 1u << 0);
+  matcher.addPattern("TRIGGER", 1u << 1);
+  matcher.addPattern("hint*", 1u << 2);
+  matcher.addPattern("*caulk", 1u << 3);
+  matcher.addPattern("*sky*", 1u << 4);
+  matcher.addPattern("common/clip", 1u << 5);
+  matcher.addPattern("wa?er", 1u << 6);
+  matcher.addPattern("\\**", 1u << 7);
+  matcher.addPattern("*", 1u << 8);
+
+  using T = std::tuple<std::string, TagType::Type>;
+
+  // clang-format off
+  const auto
+  [textureName,       expectedTags] = GENERATE(values<T>({
+  {"",                1u << 8},
+  {"trigger",         1u << 0 | 1u << 1 | 1u << 8},
+  {"base/Trigger",    1u << 0 | 1u << 1 | 1u << 8},
+  {"triggers",        1u << 8},
+  {"HINTskip",        1u << 2 | 1u << 8},
+  {"common/hint",     1u << 2 | 1u << 8},
+  {"hint/skip",       1u << 8},
+  {"common/caulk",    1u << 3 | 1u << 8},
+  {"watercaulk",      1u << 3 | 1u << 8},
+  {"dark_sky1",       1u << 4 | 1u << 8},
+  {"sky",             1u << 4 | 1u << 8},
+  {"common/clip",     1u << 5 | 1u << 8},
+  {"clip",            1u << 8},
+  {"water",           1u << 6 | 1u << 8},
+  {"base/wafer",      1u << 6 | 1u << 8},
+  {"*water",          1u << 7 | 1u << 8},
+  }));
+  // clang-format on
+
+  CAPTURE(textureName);
+
+  CHECK(matcher.matches(textureName) == expectedTags);
+}
+
+TEST_CASE("TaggingTest.updateTextureTags")
+{
+  const vm::bbox3 worldBounds{4096.0};
+
+  auto triggerTexture = Assets::Texture{"trigger", 16, 16};
+  auto waterTexture = Assets::Texture{"base/water1", 16, 16};
+  waterTexture.setSurfaceParms({"water"});
+  auto caulkTexture = Assets::Texture{"common/caulk", 16, 16};
+
+  BrushBuilder builder{MapFormat::Standard, worldBounds};
+  auto brush =
+    builder
+      .createCube(
+        64.0, "trigger", "base/water1", "common/caulk", "TRIGGER", "hint", "other")
+      .value();
+
+  for (auto& face : brush.faces())
+  {
+    if (
+      face.attributes().textureName() == "trigger"
+      || face.attributes().textureName() == "TRIGGER")
+    {
+      face.setTexture(&triggerTexture);
+    }
+    else if (face.attributes().textureName() == "base/water1")
+    {
+      face.setTexture(&waterTexture);
+    }
+    else if (face.attributes().textureName() == "common/caulk")
+    {
+      face.setTexture(&caulkTexture);
+    }
+    else if (face.attributes().textureName() == "other")
+    {
+      auto attributes = face.attributes();
+      attributes.setSurfaceContents(1);
+      face.setAttributes(attributes);
+    }
+  }
+
+  auto brushNode = BrushNode{std::move(brush)};
+
+  const auto getFace = [&](const std::string& textureName) -> const BrushFace& {
+    const auto& faces = brushNode.brush().faces();
+    return *std::find_if(faces.begin(), faces.end(), [&](const auto& face) {
+      return face.attributes().textureName() == textureName;
+    });
+  };
+
+  auto tagManager = TagManager{};
+  tagManager.registerSmartTags({
+    SmartTag{"trigger", {}, std::make_unique<TextureNameTagMatcher>("trigger")},
+    SmartTag{"caulk", {}, std::make_unique<TextureNameTagMatcher>("common/*caulk")},
+    SmartTag{"hint", {}, std::make_unique<TextureNameTagMatcher>("hint*")},
+    SmartTag{"liquid", {}, std::make_unique<SurfaceParmTagMatcher>("water")},
+    SmartTag{"detail", {}, std::make_unique<ContentFlagsTagMatcher>(1)},
+  });
+
+  const auto& trigger = tagManager.smartTag("trigger");
+  const auto& caulk = tagManager.smartTag("caulk");
+  const auto& hint = tagManager.smartTag("hint");
+  const auto& liquid = tagManager.smartTag("liquid");
+  const auto& detail = tagManager.smartTag("detail");
+
+  brushNode.initializeTags(tagManager);
+
+  CHECK(getFace("trigger").tagMask() == trigger.type());
+  CHECK(getFace("TRIGGER").tagMask() == trigger.type());
+  CHECK(getFace("base/water1").tagMask() == liquid.type());
+  CHECK(getFace("common/caulk").tagMask() == caulk.type());
+  CHECK(getFace("hint").tagMask() == hint.type());
+  CHECK(getFace("other").tagMask() == detail.type());
+  CHECK_FALSE(brushNode.hasAnyTag());
+
+  SECTION("Changing the surface parameters of a texture invalidates its cached tags")
+  {
+    waterTexture.setSurfaceParms({});
+    brushNode.updateTags(tagManager);
+
+    CHECK_FALSE(getFace("base/water1").hasAnyTag());
+  }
+
+  SECTION("Registering other smart tags invalidates the cached tags")
+  {
+    tagManager.registerSmartTags({
+      SmartTag{"liquid", {}, std::make_unique<SurfaceParmTagMatcher>("water")},
+      SmartTag{"trigger", {}, std::make_unique<TextureNameTagMatcher>("*caulk")},
+    });
+    brushNode.initializeTags(tagManager);
+
+    CHECK_FALSE(getFace("trigger").hasAnyTag());
+    CHECK_FALSE(getFace("TRIGGER").hasAnyTag());
+    CHECK(getFace("base/water1").tagMask() == tagManager.smartTag("liquid").type());
+    CHECK(getFace("common/caulk").tagMask() == tagManager.smartTag("trigger").type());
+  }
+
+  SECTION("Tags are matched by name if the texture of a face is out of date")
+  {
+    auto newBrush = brushNode.brush();
+    for (auto& face : newBrush.faces())
+    {
+      if (face.attributes().textureName() == "trigger")
+      {
+        auto attributes = face.attributes();
+        attributes.setTextureName("hint_trigger");
+        face.setAttributes(attributes);
+      }
+    }
+    brushNode.setBrush(std::move(newBrush));
+    brushNode.updateTags(tagManager);
+
+    REQUIRE(getFace("hint_trigger").texture() == &triggerTexture);
+    CHECK(getFace("hint_trigger").tagMask() == hint.type());
+    CHECK(getFace("TRIGGER").tagMask() == trigger.type());
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -40,6 +40,8 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/mat_io.h>
 
+#include <stdexcept>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -323,6 +325,125 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.deferNodeTreeUpdates")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+  worldNode.defaultLayer()->addChildren({entityNode, brushNode});
+
+  const auto& nodeTree = worldNode.nodeTree();
+  REQUIRE_THAT(
+    nodeTree.find_containers(vm::vec3d::zero()),
+    Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+  const auto transformNodes = [&]() {
+    transformNode(
+      *entityNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+    transformNode(*brushNode, vm::translation_matrix(vm::vec3d(8, 8, 8)), worldBounds);
+    transformNode(
+      *brushNode, vm::translation_matrix(vm::vec3d(376, 376, 376)), worldBounds);
+  };
+
+  SECTION("Flushing the guard applies the deferred updates")
+  {
+    {
+      auto deferNodeTreeUpdates = WorldNode::DeferNodeTreeUpdates{worldNode};
+      transformNodes();
+
+      CHECK_THAT(
+        nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+        Catch::UnorderedEquals(std::vector<Node*>{}));
+
+      deferNodeTreeUpdates.flush();
+    }
+
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d::zero()),
+      Catch::UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+    // further updates are applied immediately
+    transformNode(
+      *brushNode, vm::translation_matrix(vm::vec3d(-384, -384, -384)), worldBounds);
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d::zero()),
+      Catch::UnorderedEquals(std::vector<Node*>{brushNode}));
+  }
+
+  SECTION("Nested guards apply the deferred updates when the outermost is flushed")
+  {
+    {
+      auto outerGuard = WorldNode::DeferNodeTreeUpdates{worldNode};
+      {
+        auto innerGuard = WorldNode::DeferNodeTreeUpdates{worldNode};
+        transformNodes();
+        innerGuard.flush();
+      }
+
+      CHECK_THAT(
+        nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+        Catch::UnorderedEquals(std::vector<Node*>{}));
+
+      outerGuard.flush();
+    }
+
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+  }
+
+  SECTION("Destroying the guard while unwinding does not update the node tree")
+  {
+    try
+    {
+      const auto deferNodeTreeUpdates = WorldNode::DeferNodeTreeUpdates{worldNode};
+      transformNodes();
+      throw std::runtime_error{"error"};
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{}));
+
+    // the pending updates are applied by the next flush
+    auto deferNodeTreeUpdates = WorldNode::DeferNodeTreeUpdates{worldNode};
+    deferNodeTreeUpdates.flush();
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+  }
+
+  SECTION("Removing a node with a deferred update")
+  {
+    {
+      auto deferNodeTreeUpdates = WorldNode::DeferNodeTreeUpdates{worldNode};
+      transformNodes();
+
+      worldNode.defaultLayer()->removeChild(brushNode);
+      CHECK_FALSE(nodeTree.contains(brushNode));
+      CHECK_THAT(
+        nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+        Catch::UnorderedEquals(std::vector<Node*>{entityNode}));
+
+      delete brushNode;
+      deferNodeTreeUpdates.flush();
+    }
+
+    CHECK(nodeTree.contains(entityNode));
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
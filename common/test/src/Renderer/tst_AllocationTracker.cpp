@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <random>
+#include <tuple>
 #include <vector>
 
 #include "Catch2.h"
@@ -216,6 +217,59 @@ TEST_CASE("AllocationTrackerTest.freeMergeLeft")
   CHECK(t.largestPossibleAllocation() == 200u);
 }
 
+TEST_CASE("AllocationTrackerTest.usedRange")
+{
+  AllocationTracker t(500);
+  CHECK(t.usedRange() == AllocationTracker::Range{0, 0});
+
+  AllocationTracker::Block* blocks[4];
+  for (size_t i = 0; i < 4; ++i)
+  {
+    blocks[i] = t.allocate(100);
+  }
+  CHECK(t.usedRange() == AllocationTracker::Range{0, 400});
+
+  // free blocks in between are part of the used range
+  t.free(blocks[1]);
+  CHECK(t.usedRange() == AllocationTracker::Range{0, 400});
+
+  t.free(blocks[0]);
+  CHECK(t.usedRange() == AllocationTracker::Range{200, 200});
+
+  t.free(blocks[3]);
+  CHECK(t.usedRange() == AllocationTracker::Range{200, 100});
+
+  t.free(blocks[2]);
+  CHECK(t.usedRange() == AllocationTracker::Range{0, 0});
+}
+
+TEST_CASE("AllocationTrackerTest.usedRanges")
+{
+  using Ranges = std::vector<AllocationTracker::Range>;
+
+  AllocationTracker t(500);
+  CHECK(t.usedRanges() == Ranges{});
+
+  AllocationTracker::Block* blocks[4];
+  for (size_t i = 0; i < 4; ++i)
+  {
+    blocks[i] = t.allocate(100);
+  }
+
+  // adjacent blocks are merged
+  CHECK(t.usedRanges() == Ranges{{0, 400}});
+
+  t.free(blocks[1]);
+  CHECK(t.usedRanges() == Ranges{{0, 100}, {200, 200}});
+
+  t.free(blocks[3]);
+  CHECK(t.usedRanges() == Ranges{{0, 100}, {200, 100}});
+
+  t.free(blocks[0]);
+  t.free(blocks[2]);
+  CHECK(t.usedRanges() == Ranges{});
+}
+
 TEST_CASE("AllocationTrackerTest.expandEmpty")
 {
   AllocationTracker t;
@@ -277,6 +331,129 @@ TEST_CASE("AllocationTrackerTest.expandWithUsedSpaceAtEnd")
   }
 }
 
+TEST_CASE("AllocationTrackerTest.stats")
+{
+  AllocationTracker t(500);
+
+  AllocationTracker::Block* blocks[5];
+  for (size_t i = 0; i < 5; ++i)
+  {
+    blocks[i] = t.allocate(100);
+  }
+
+  auto stats = t.stats();
+  CHECK(stats.capacity == 500u);
+  CHECK(stats.usedSize == 500u);
+  CHECK(stats.freeSize == 0u);
+  CHECK(stats.usedBlockCount == 5u);
+  CHECK(stats.freeBlockCount == 0u);
+  CHECK(stats.largestFreeBlock == 0u);
+  CHECK(stats.fragmentation() == 0.0);
+
+  t.free(blocks[1]);
+  t.free(blocks[3]);
+
+  stats = t.stats();
+  CHECK(stats.usedSize == 300u);
+  CHECK(stats.freeSize == 200u);
+  CHECK(stats.usedBlockCount == 3u);
+  CHECK(stats.freeBlockCount == 2u);
+  CHECK(stats.largestFreeBlock == 100u);
+  CHECK(stats.fragmentation() == 0.5);
+
+  // merges both free blocks
+  t.free(blocks[2]);
+
+  stats = t.stats();
+  CHECK(stats.usedSize == 200u);
+  CHECK(stats.freeSize == 300u);
+  CHECK(stats.usedBlockCount == 2u);
+  CHECK(stats.freeBlockCount == 1u);
+  CHECK(stats.largestFreeBlock == 300u);
+  CHECK(stats.fragmentation() == 0.0);
+
+  t.expand(600);
+
+  stats = t.stats();
+  CHECK(stats.capacity == 600u);
+  CHECK(stats.freeSize == 400u);
+  CHECK(stats.freeBlockCount == 2u);
+}
+
+TEST_CASE("AllocationTrackerTest.compact")
+{
+  AllocationTracker t(600);
+
+  AllocationTracker::Block* blocks[6];
+  for (size_t i = 0; i < 6; ++i)
+  {
+    blocks[i] = t.allocate(100);
+  }
+
+  t.free(blocks[0]);
+  t.free(blocks[2]);
+  t.free(blocks[4]);
+
+  auto moves = std::vector<std::tuple<AllocationTracker::Block*, size_t, size_t>>{};
+  const auto movedSize = t.compact(1000, [&](const auto& block, const auto oldPos) {
+    moves.emplace_back(const_cast<AllocationTracker::Block*>(&block), oldPos, block.pos);
+  });
+
+  CHECK(movedSize == 300u);
+  CHECK(
+    moves
+    == std::vector<std::tuple<AllocationTracker::Block*, size_t, size_t>>{
+      {blocks[1], 100, 0},
+      {blocks[3], 300, 100},
+      {blocks[5], 500, 200},
+    });
+  CHECK(
+    t.usedBlocks()
+    == (std::vector<AllocationTracker::Range>{{0, 100}, {100, 100}, {200, 100}}));
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{300, 300}}));
+  CHECK(t.stats().freeBlockCount == 1u);
+  CHECK(t.stats().fragmentation() == 0.0);
+
+  // nothing left to compact
+  CHECK(t.compact(1000, [](const auto&, const auto) { FAIL(); }) == 0u);
+
+  // the moved blocks can still be freed and the free space can be allocated
+  t.free(blocks[3]);
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}, {200, 100}}));
+  CHECK(
+    t.freeBlocks() == (std::vector<AllocationTracker::Range>{{100, 100}, {300, 300}}));
+  CHECK(t.allocate(300) != nullptr);
+}
+
+TEST_CASE("AllocationTrackerTest.compactIncrementally")
+{
+  AllocationTracker t(500);
+
+  AllocationTracker::Block* blocks[5];
+  for (size_t i = 0; i < 5; ++i)
+  {
+    blocks[i] = t.allocate(100);
+  }
+
+  t.free(blocks[0]);
+  t.free(blocks[2]);
+
+  // moves one block even if it exceeds the limit
+  CHECK(t.compact(50, [](const auto&, const auto) {}) == 100u);
+  CHECK(
+    t.usedBlocks()
+    == (std::vector<AllocationTracker::Range>{{0, 100}, {300, 100}, {400, 100}}));
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{100, 200}}));
+
+  CHECK(t.compact(200, [](const auto&, const auto) {}) == 200u);
+  CHECK(
+    t.usedBlocks()
+    == (std::vector<AllocationTracker::Range>{{0, 100}, {100, 100}, {200, 100}}));
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{300, 200}}));
+  CHECK(blocks[3]->pos == 100u);
+  CHECK(blocks[4]->pos == 200u);
+}
+
 static constexpr size_t NumBrushes = 64'000;
 
 // between 12 and 140, inclusive.
@@ -0,0 +1,261 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Renderer/BrushRendererArrays.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+AllocationTracker::Block* insertIndices(
+  BrushIndexArray& indexArray, const std::vector<GLuint>& indices)
+{
+  auto [block, dest] = indexArray.getPointerToInsertElementsAt(indices.size());
+  std::copy(indices.begin(), indices.end(), dest);
+  return block;
+}
+
+const PackedBrushIndexArray::DrawCommand* findDrawCommand(
+  const PackedBrushIndexArray& packedArray, const Assets::Texture* texture)
+{
+  const auto& drawCommands = packedArray.drawCommands();
+  const auto it = std::find_if(
+    drawCommands.begin(), drawCommands.end(), [&](const auto& drawCommand) {
+      return drawCommand.texture == texture;
+    });
+  return it != drawCommands.end() ? &*it : nullptr;
+}
+} // namespace
+
+TEST_CASE("DirtyRangeTracker.markDirty")
+{
+  auto tracker = DirtyRangeTracker{10};
+  CHECK(tracker.clean());
+
+  tracker.markDirty(4, 2);
+  CHECK(tracker.m_dirtyPos == 4);
+  CHECK(tracker.m_dirtySize == 2);
+
+  tracker.markDirty(8, 1);
+  CHECK(tracker.m_dirtyPos == 4);
+  CHECK(tracker.m_dirtySize == 5);
+
+  tracker.markDirty(1, 0);
+  CHECK(tracker.m_dirtyPos == 4);
+  CHECK(tracker.m_dirtySize == 5);
+}
+
+TEST_CASE("BrushIndexArray.copyValidIndices")
+{
+  auto indexArray = BrushIndexArray{};
+  const auto version = indexArray.version();
+
+  auto* block1 = insertIndices(indexArray, {1, 2, 3});
+  insertIndices(indexArray, {4, 5, 6});
+  insertIndices(indexArray, {7, 8, 9});
+  CHECK(indexArray.validIndexCount() == 9);
+  CHECK(indexArray.version() != version);
+
+  const auto versionBeforeZero = indexArray.version();
+  indexArray.zeroElementsWithKey(block1);
+  CHECK(indexArray.validIndexCount() == 6);
+  CHECK(indexArray.version() != versionBeforeZero);
+
+  auto dest = std::vector<GLuint>(indexArray.capacity(), 0);
+  CHECK(indexArray.copyValidIndices(dest.data()) == 6);
+  CHECK(
+    std::vector<GLuint>(dest.begin(), dest.begin() + 6)
+    == std::vector<GLuint>{4, 5, 6, 7, 8, 9});
+}
+
+TEST_CASE("BrushIndexArray.rebaseElementsOfBlock")
+{
+  auto indexArray = BrushIndexArray{};
+  insertIndices(indexArray, {1, 2, 3});
+  auto* block = insertIndices(indexArray, {10, 11, 12});
+
+  const auto version = indexArray.version();
+  indexArray.rebaseElementsOfBlock(block, 10, 4);
+  CHECK(indexArray.version() != version);
+
+  auto dest = std::vector<GLuint>(indexArray.capacity(), 0);
+  CHECK(indexArray.copyValidIndices(dest.data()) == 6);
+  CHECK(
+    std::vector<GLuint>(dest.begin(), dest.begin() + 6)
+    == std::vector<GLuint>{1, 2, 3, 4, 5, 6});
+}
+
+TEST_CASE("BrushIndexArray.compact")
+{
+  auto indexArray = BrushIndexArray{};
+
+  auto* block1 = insertIndices(indexArray, {1, 2, 3});
+  auto* block2 = insertIndices(indexArray, {4, 5, 6, 7});
+  auto* block3 = insertIndices(indexArray, {8, 9});
+  const auto capacity = indexArray.capacity();
+
+  indexArray.zeroElementsWithKey(block1);
+  CHECK(indexArray.stats().fragmentation() > 0.0);
+
+  const auto version = indexArray.version();
+  CHECK(indexArray.compact(100) == 6);
+  CHECK(indexArray.version() != version);
+
+  CHECK(indexArray.capacity() == capacity);
+  CHECK(indexArray.validIndexCount() == 6);
+  CHECK(indexArray.stats().fragmentation() == 0.0);
+  CHECK(block2->pos == 0);
+  CHECK(block3->pos == 4);
+
+  auto dest = std::vector<GLuint>(indexArray.capacity(), 0);
+  CHECK(indexArray.copyValidIndices(dest.data()) == 6);
+  CHECK(
+    std::vector<GLuint>(dest.begin(), dest.begin() + 6)
+    == std::vector<GLuint>{4, 5, 6, 7, 8, 9});
+
+  // the keys remain valid
+  indexArray.zeroElementsWithKey(block2);
+  CHECK(indexArray.validIndexCount() == 2);
+  CHECK(indexArray.copyValidIndices(dest.data()) == 2);
+  CHECK(dest[0] == 8);
+  CHECK(dest[1] == 9);
+}
+
+TEST_CASE("PackedBrushIndexArray.update")
+{
+  const auto textureA = Assets::Texture{"a", 1, 1};
+  const auto textureB = Assets::Texture{"b", 1, 1};
+
+  auto indexArrayA = std::make_shared<BrushIndexArray>();
+  auto indexArrayB = std::make_shared<BrushIndexArray>();
+
+  auto* blockA1 = insertIndices(*indexArrayA, {1, 2, 3, 4, 5, 6});
+  auto* blockA2 = insertIndices(*indexArrayA, {7, 8, 9});
+  insertIndices(*indexArrayA, {10, 11, 12});
+  auto* blockB1 = insertIndices(*indexArrayB, {1, 2, 3});
+
+  auto indexArrays = TextureToBrushIndicesMap{
+    {&textureA, indexArrayA},
+    {&textureB, indexArrayB},
+  };
+
+  auto packedArray = PackedBrushIndexArray{};
+  packedArray.update(indexArrays);
+
+  CHECK(packedArray.drawCommands().size() == 2);
+  CHECK(packedArray.drawCallCount() == 2);
+  CHECK(packedArray.indexCount() == 15);
+  CHECK(packedArray.rangeCount() == 2);
+
+  const auto* drawCommandA = findDrawCommand(packedArray, &textureA);
+  const auto* drawCommandB = findDrawCommand(packedArray, &textureB);
+  REQUIRE(drawCommandA != nullptr);
+  REQUIRE(drawCommandB != nullptr);
+  REQUIRE(drawCommandA->ranges.size() == 1);
+  REQUIRE(drawCommandB->ranges.size() == 1);
+  CHECK(drawCommandA->ranges[0].size == 12);
+  CHECK(drawCommandB->ranges[0].size == 3);
+  CHECK(drawCommandA->counts == GLCounts{12});
+  CHECK(
+    drawCommandA->offsets
+    == std::vector<const GLvoid*>{
+      reinterpret_cast<const GLvoid*>(sizeof(GLuint) * drawCommandA->ranges[0].pos)});
+
+  const auto offsetA = drawCommandA->ranges[0].pos;
+  const auto offsetB = drawCommandB->ranges[0].pos;
+
+  // the slots don't overlap
+  CHECK(
+    (offsetA + indexArrayA->capacity() <= offsetB
+     || offsetB + indexArrayB->capacity() <= offsetA));
+
+  SECTION("Deleting indices only updates the affected slot")
+  {
+    indexArrayA->zeroElementsWithKey(blockA1);
+    packedArray.update(indexArrays);
+
+    // only the used range of the array is rendered
+    CHECK(packedArray.indexCount() == 9);
+    CHECK(
+      findDrawCommand(packedArray, &textureA)->ranges
+      == std::vector<AllocationTracker::Range>{{offsetA + 6, 6}});
+    CHECK(
+      findDrawCommand(packedArray, &textureB)->ranges
+      == std::vector<AllocationTracker::Range>{{offsetB, 3}});
+  }
+
+  SECTION("Freed ranges between allocated ranges are skipped")
+  {
+    indexArrayA->zeroElementsWithKey(blockA2);
+    packedArray.update(indexArrays);
+
+    CHECK(packedArray.indexCount() == 12);
+    CHECK(packedArray.rangeCount() == 3);
+
+    const auto* drawCommand = findDrawCommand(packedArray, &textureA);
+    CHECK(
+      drawCommand->ranges
+      == std::vector<AllocationTracker::Range>{{offsetA, 6}, {offsetA + 9, 3}});
+    CHECK(drawCommand->counts == GLCounts{6, 3});
+    CHECK(
+      drawCommand->offsets
+      == std::vector<const GLvoid*>{
+        reinterpret_cast<const GLvoid*>(sizeof(GLuint) * offsetA),
+        reinterpret_cast<const GLvoid*>(sizeof(GLuint) * (offsetA + 9))});
+  }
+
+  SECTION("Deleting all indices of a texture leaves its draw command empty")
+  {
+    indexArrays.at(&textureB)->zeroElementsWithKey(blockB1);
+    packedArray.update(indexArrays);
+
+    CHECK(packedArray.drawCommands().size() == 2);
+    CHECK(packedArray.drawCallCount() == 1);
+    CHECK(findDrawCommand(packedArray, &textureB)->ranges.empty());
+    CHECK(findDrawCommand(packedArray, &textureB)->counts.empty());
+  }
+
+  SECTION("Growing an array lays out the slots anew")
+  {
+    insertIndices(*indexArrayB, std::vector<GLuint>(indexArrayB->capacity() + 1, 1));
+    packedArray.update(indexArrays);
+
+    CHECK(packedArray.drawCommands().size() == 2);
+    CHECK(findDrawCommand(packedArray, &textureA)->counts == GLCounts{12});
+    CHECK(findDrawCommand(packedArray, &textureB)->counts == GLCounts{7});
+  }
+
+  SECTION("Removing a texture removes its draw command")
+  {
+    indexArrays.erase(&textureA);
+    packedArray.update(indexArrays);
+
+    CHECK(packedArray.drawCommands().size() == 1);
+    CHECK(findDrawCommand(packedArray, &textureA) == nullptr);
+    CHECK(findDrawCommand(packedArray, &textureB)->counts == GLCounts{3});
+  }
+}
+} // namespace TrenchBroom::Renderer
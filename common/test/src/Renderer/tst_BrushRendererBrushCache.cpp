@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Renderer/BrushRendererBrushCache.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+using EdgePositions = std::vector<std::pair<vm::vec3f, vm::vec3f>>;
+
+const vm::vec3f& cachedPosition(const BrushRendererBrushCache& cache, const size_t index)
+{
+  return getVertexComponent<0>(cache.cachedVertices()[index]);
+}
+
+const vm::vec3f& cachedNormal(const BrushRendererBrushCache& cache, const size_t index)
+{
+  return getVertexComponent<1>(cache.cachedVertices()[index]);
+}
+
+EdgePositions cachedEdgePositions(const BrushRendererBrushCache& cache)
+{
+  auto result = EdgePositions{};
+  for (const auto& edge : cache.cachedEdges())
+  {
+    result.emplace_back(
+      cachedPosition(cache, edge.vertexIndex1RelativeToBrush),
+      cachedPosition(cache, edge.vertexIndex2RelativeToBrush));
+  }
+  return result;
+}
+
+EdgePositions brushEdgePositions(const Model::Brush& brush)
+{
+  auto result = EdgePositions{};
+  for (const auto* edge : brush.edges())
+  {
+    result.emplace_back(
+      vm::vec3f{edge->firstVertex()->position()},
+      vm::vec3f{edge->secondVertex()->position()});
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("BrushRendererBrushCache.validateVertexCache")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto brushNode = Model::BrushNode{builder.createCube(64.0, "texture").value()};
+  const auto& brush = brushNode.brush();
+
+  auto& cache = brushNode.brushRendererBrushCache();
+  cache.validateVertexCache(brushNode);
+
+  CHECK(cache.cachedFacesSortedByTexture().size() == brush.faceCount());
+  CHECK(cache.cachedEdges().size() == brush.edgeCount());
+  CHECK_THAT(
+    cachedEdgePositions(cache),
+    Catch::Matchers::UnorderedEquals(brushEdgePositions(brush)));
+
+  for (const auto& edge : cache.cachedEdges())
+  {
+    // both vertices of an edge are cached for its first face
+    const auto normal = vm::vec3f{edge.face1->boundary().normal};
+    CHECK(cachedNormal(cache, edge.vertexIndex1RelativeToBrush) == normal);
+    CHECK(cachedNormal(cache, edge.vertexIndex2RelativeToBrush) == normal);
+    CHECK(edge.face1 != edge.face2);
+  }
+
+  SECTION("Copies of a brush share its geometry, but have equal caches")
+  {
+    auto copyNode = Model::BrushNode{brush};
+    auto& copyCache = copyNode.brushRendererBrushCache();
+    copyCache.validateVertexCache(copyNode);
+
+    CHECK(copyCache.cachedVertices().size() == cache.cachedVertices().size());
+    CHECK(cachedEdgePositions(copyCache) == cachedEdgePositions(cache));
+  }
+}
+} // namespace TrenchBroom::Renderer
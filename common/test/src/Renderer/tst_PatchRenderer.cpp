@@ -0,0 +1,160 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/PatchRenderer.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+namespace
+{
+using Edge = std::pair<GLuint, GLuint>;
+
+/**
+ * Counts how many triangles share each edge, ignoring the edge direction.
+ */
+std::map<Edge, size_t> countEdges(const std::vector<GLuint>& triangles)
+{
+  auto result = std::map<Edge, size_t>{};
+  for (size_t i = 0u; i < triangles.size(); i += 3u)
+  {
+    for (size_t j = 0u; j < 3u; ++j)
+    {
+      const auto v1 = triangles[i + j];
+      const auto v2 = triangles[i + (j + 1u) % 3u];
+      ++result[Edge{std::min(v1, v2), std::max(v1, v2)}];
+    }
+  }
+  return result;
+}
+
+/**
+ * Returns the edges between all adjacent points on the border of the grid.
+ */
+std::vector<Edge> borderEdges(const size_t pointRowCount, const size_t pointColumnCount)
+{
+  const auto index = [&](const size_t row, const size_t col) {
+    return static_cast<GLuint>(row * pointColumnCount + col);
+  };
+
+  auto result = std::vector<Edge>{};
+  for (size_t col = 0u; col + 1u < pointColumnCount; ++col)
+  {
+    result.emplace_back(index(0u, col), index(0u, col + 1u));
+    result.emplace_back(
+      index(pointRowCount - 1u, col), index(pointRowCount - 1u, col + 1u));
+  }
+  for (size_t row = 0u; row + 1u < pointRowCount; ++row)
+  {
+    result.emplace_back(index(row, 0u), index(row + 1u, 0u));
+    result.emplace_back(
+      index(row, pointColumnCount - 1u), index(row + 1u, pointColumnCount - 1u));
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("makePatchGridTriangles")
+{
+  SECTION("Stride 1 splits every quad into two triangles")
+  {
+    // clang-format off
+    CHECK(makePatchGridTriangles(2, 3, 1) == std::vector<GLuint>{
+      0, 1, 4, 4, 3, 0,
+      1, 2, 5, 5, 4, 1,
+    });
+    // clang-format on
+  }
+
+  SECTION("Quads touching the border are fanned out from their center")
+  {
+    // clang-format off
+    CHECK(makePatchGridTriangles(3, 3, 2) == std::vector<GLuint>{
+      4, 0, 1,
+      4, 1, 2,
+      4, 2, 5,
+      4, 5, 8,
+      4, 8, 7,
+      4, 7, 6,
+      4, 6, 3,
+      4, 3, 0,
+    });
+    // clang-format on
+  }
+
+  SECTION("The border is rendered at full resolution for every stride")
+  {
+    using T = std::tuple<size_t, size_t, size_t>;
+    const auto [pointRowCount, pointColumnCount, stride] = GENERATE(values<T>({
+      {9, 9, 1},
+      {9, 9, 2},
+      {9, 9, 4},
+      {9, 9, 8},
+      {17, 9, 4},
+      {9, 25, 8},
+    }));
+
+    CAPTURE(pointRowCount, pointColumnCount, stride);
+
+    const auto triangles =
+      makePatchGridTriangles(pointRowCount, pointColumnCount, stride);
+    const auto edgeCounts = countEdges(triangles);
+    const auto border = borderEdges(pointRowCount, pointColumnCount);
+
+    // every border edge belongs to exactly one triangle
+    for (const auto& edge : border)
+    {
+      const auto it = edgeCounts.find(edge);
+      REQUIRE(it != edgeCounts.end());
+      CHECK(it->second == 1u);
+    }
+
+    // every other edge is shared by two triangles, so there are no T-junctions
+    auto innerEdgeCount = size_t(0);
+    for (const auto& [edge, count] : edgeCounts)
+    {
+      if (count != 1u)
+      {
+        CHECK(count == 2u);
+        ++innerEdgeCount;
+      }
+    }
+    CHECK(innerEdgeCount + border.size() == edgeCounts.size());
+  }
+
+  SECTION("Larger strides produce fewer triangles")
+  {
+    CHECK(makePatchGridTriangles(17, 17, 1).size() == 3u * 512u);
+    CHECK(makePatchGridTriangles(17, 17, 2).size() < 3u * 512u);
+    CHECK(
+      makePatchGridTriangles(17, 17, 4).size()
+      < makePatchGridTriangles(17, 17, 2).size());
+    CHECK(
+      makePatchGridTriangles(17, 17, 8).size()
+      < makePatchGridTriangles(17, 17, 4).size());
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/StreamingAllocator.h"
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+using FrameStart = StreamingAllocator::FrameStart;
+
+TEST_CASE("StreamingAllocator.allocate")
+{
+  auto a = StreamingAllocator{100, 100};
+
+  CHECK(a.allocate(10, 1) == 0u);
+  CHECK(a.allocate(10, 16) == 16u);
+  CHECK(a.allocate(6, 4) == 28u);
+  CHECK(a.frameSize() == 34u);
+
+  SECTION("Allocations which do not fit are rejected")
+  {
+    CHECK(a.allocate(70, 1) == std::nullopt);
+    CHECK(a.allocate(66, 1) == 34u);
+    CHECK(a.allocate(1, 1) == std::nullopt);
+    CHECK(a.frameSize() == 100u);
+  }
+
+  SECTION("Alignment padding must fit, too")
+  {
+    CHECK(a.allocate(60, 64) == std::nullopt);
+    CHECK(a.allocate(36, 64) == 64u);
+  }
+}
+
+TEST_CASE("StreamingAllocator.beginFrame")
+{
+  auto a = StreamingAllocator{100, 400};
+
+  SECTION("Allocation continues after the previous frame")
+  {
+    CHECK(a.allocate(20, 1) == 0u);
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.frameSize() == 0u);
+    CHECK(a.allocate(20, 1) == 20u);
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.allocate(20, 1) == 40u);
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.allocate(20, 1) == 60u);
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.allocate(20, 1) == 80u);
+
+    // the next frame would not fit behind this one
+    CHECK(a.beginFrame() == FrameStart::Wrap);
+    CHECK(a.allocate(20, 1) == 0u);
+    CHECK(a.capacity() == 100u);
+  }
+
+  SECTION("Nothing happens for empty frames")
+  {
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.beginFrame() == FrameStart::Continue);
+    CHECK(a.allocate(10, 1) == 0u);
+  }
+
+  SECTION("The buffer grows if a frame takes more than half of it")
+  {
+    CHECK(a.allocate(40, 1) == 0u);
+    CHECK(a.allocate(40, 1) == 40u);
+    CHECK(a.allocate(40, 1) == std::nullopt);
+
+    CHECK(a.beginFrame() == FrameStart::Grow);
+    CHECK(a.capacity() == 400u);
+    CHECK(a.allocate(120, 1) == 0u);
+  }
+
+  SECTION("The buffer does not grow beyond its maximum capacity")
+  {
+    CHECK(a.allocate(100, 1) == 0u);
+    CHECK(a.allocate(200, 1) == std::nullopt);
+    CHECK(a.allocate(300, 1) == std::nullopt);
+
+    CHECK(a.beginFrame() == FrameStart::Grow);
+    CHECK(a.capacity() == 400u);
+
+    CHECK(a.allocate(400, 1) == 0u);
+    CHECK(a.beginFrame() == FrameStart::Wrap);
+    CHECK(a.capacity() == 400u);
+  }
+}
+
+} // namespace TrenchBroom::Renderer
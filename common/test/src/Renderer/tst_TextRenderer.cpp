@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/TextRenderer.h"
+
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+TextCullingEntry entry(
+  const vm::vec2f& min,
+  const vm::vec2f& max,
+  const float distance,
+  const bool onTop = false)
+{
+  return TextCullingEntry{min, max, distance, onTop};
+}
+} // namespace
+
+TEST_CASE("TextRenderer.cullOverlappingText")
+{
+  SECTION("Strings that don't overlap are kept")
+  {
+    CHECK(
+      cullOverlappingText({
+        entry({0, 0}, {10, 10}, 1.0f),
+        entry({20, 0}, {30, 10}, 2.0f),
+        entry({0, 20}, {10, 30}, 3.0f),
+      })
+      == std::vector<bool>{true, true, true});
+  }
+
+  SECTION("The nearer of two overlapping strings is kept")
+  {
+    CHECK(
+      cullOverlappingText({
+        entry({0, 0}, {10, 10}, 2.0f),
+        entry({5, 5}, {15, 15}, 1.0f),
+      })
+      == std::vector<bool>{false, true});
+  }
+
+  SECTION("Culled strings don't cull other strings")
+  {
+    CHECK(
+      cullOverlappingText({
+        entry({0, 0}, {10, 10}, 1.0f),
+        entry({8, 0}, {18, 10}, 2.0f),
+        entry({16, 0}, {26, 10}, 3.0f),
+      })
+      == std::vector<bool>{true, false, true});
+  }
+
+  SECTION("Strings on top are never culled")
+  {
+    CHECK(
+      cullOverlappingText({
+        entry({0, 0}, {10, 10}, 1.0f),
+        entry({5, 5}, {15, 15}, 2.0f, true),
+        entry({8, 8}, {18, 18}, 3.0f, true),
+      })
+      == std::vector<bool>{false, true, true});
+  }
+
+  SECTION("Overlaps are found across grid cell boundaries")
+  {
+    // the cells are 64 pixels wide
+    CHECK(
+      cullOverlappingText({
+        entry({50, 0}, {65, 10}, 1.0f),
+        entry({64.5f, 5}, {80, 15}, 2.0f),
+      })
+      == std::vector<bool>{true, false});
+
+    CHECK(
+      cullOverlappingText({
+        entry({-10, -10}, {200, 200}, 1.0f),
+        entry({130, 130}, {140, 140}, 2.0f),
+      })
+      == std::vector<bool>{true, false});
+  }
+
+  SECTION("Strings that touch at a grid cell boundary are kept")
+  {
+    CHECK(
+      cullOverlappingText({
+        entry({0, 0}, {64, 10}, 1.0f),
+        entry({64, 0}, {80, 10}, 2.0f),
+      })
+      == std::vector<bool>{true, true});
+  }
+}
+
+} // namespace TrenchBroom::Renderer
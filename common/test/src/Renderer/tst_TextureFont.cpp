@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/AttrString.h"
+#include "Renderer/FontGlyph.h"
+#include "Renderer/FontTexture.h"
+#include "Renderer/TextureFont.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+TextureFont makeFont()
+{
+  // printable ASCII characters, each 8 pixels wide
+  const auto firstChar = static_cast<unsigned char>(' ');
+  const auto charCount = static_cast<unsigned char>('~' - ' ' + 1);
+  return TextureFont{
+    std::make_unique<FontTexture>(charCount, 8, 0),
+    std::vector<FontGlyph>(charCount, FontGlyph{0, 0, 8, 8, 8}),
+    8,
+    2,
+    10,
+    firstChar,
+    charCount};
+}
+} // namespace
+
+TEST_CASE("TextureFont.glyphRun")
+{
+  auto font = makeFont();
+
+  const auto glyphRun = font.glyphRun(AttrString{"abc"});
+  REQUIRE(glyphRun != nullptr);
+  CHECK(glyphRun->size == vm::vec2f{24, 10});
+  CHECK(glyphRun->vertices == font.quads(AttrString{"abc"}, true));
+
+  SECTION("Glyph runs are cached")
+  {
+    CHECK(font.glyphRun(AttrString{"abc"}) == glyphRun);
+    CHECK(font.glyphRun(AttrString{"abd"}) != glyphRun);
+  }
+
+  SECTION("The cache is cleared when it is full")
+  {
+    // fill the cache with distinct strings
+    for (size_t i = 1; i < TextureFont::MaxCachedGlyphRuns; ++i)
+    {
+      font.glyphRun(AttrString{std::to_string(i)});
+    }
+    CHECK(font.glyphRun(AttrString{"abc"}) == glyphRun);
+
+    // adding another string clears the cache
+    font.glyphRun(AttrString{"def"});
+    const auto newGlyphRun = font.glyphRun(AttrString{"abc"});
+    CHECK(newGlyphRun != glyphRun);
+
+    // previously returned glyph runs remain valid
+    CHECK(newGlyphRun->vertices == glyphRun->vertices);
+    CHECK(newGlyphRun->size == glyphRun->size);
+  }
+}
+
+} // namespace TrenchBroom::Renderer
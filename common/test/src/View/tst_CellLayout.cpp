@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/CellLayout.h"
+
+#include <kdl/vector_utils.h>
+
+#include <any>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+
+TEST_CASE("CellLayoutTest.layout")
+{
+  auto layout = CellLayout{};
+  layout.setCellWidth(10.0f, 10.0f);
+  layout.setCellHeight(10.0f, 10.0f);
+  layout.setWidth(30.0f);
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    layout.addItem(i, std::to_string(i), 10.0f, 10.0f, 10.0f, 0.0f);
+  }
+
+  const auto& groups = layout.groups();
+  REQUIRE(groups.size() == 1u);
+
+  const auto& rows = groups.front().rows();
+  CHECK(
+    kdl::vec_transform(rows, [](const auto& row) { return row.itemCount(); })
+    == std::vector<size_t>{3, 3, 3, 1});
+  CHECK(
+    kdl::vec_transform(rows, [](const auto& row) { return row.bounds().top(); })
+    == std::vector<float>{0.0f, 10.0f, 20.0f, 30.0f});
+
+  SECTION("Cells are only created for the requested range")
+  {
+    const auto cells = layout.cells(15.0f, 1.0f);
+    CHECK(
+      kdl::vec_transform(
+        cells, [](const LayoutCell* cell) { return cell->itemAs<size_t>(); })
+      == std::vector<size_t>{3, 4, 5});
+    CHECK(
+      kdl::vec_transform(
+        cells, [](const LayoutCell* cell) { return cell->cellBounds().left(); })
+      == std::vector<float>{0.0f, 10.0f, 20.0f});
+
+    CHECK(rows[0].cells().empty());
+    CHECK(rows[1].cells().size() == 3u);
+    CHECK(rows[2].cells().empty());
+    CHECK(rows[3].cells().empty());
+  }
+
+  SECTION("Finding a cell by its item only creates the cells of its row")
+  {
+    const auto* cell = layout.findCell(
+      [](const std::any& item) { return std::any_cast<size_t>(item) == 7u; });
+    REQUIRE(cell != nullptr);
+    CHECK(cell->itemAs<size_t>() == 7u);
+    CHECK(cell->cellBounds().left() == 10.0f);
+    CHECK(cell->cellBounds().top() == 20.0f);
+
+    CHECK(rows[0].cells().empty());
+    CHECK(rows[1].cells().empty());
+    CHECK(rows[2].cells().size() == 3u);
+    CHECK(rows[3].cells().empty());
+
+    CHECK(
+      layout.findCell([](const std::any& item) {
+        return std::any_cast<size_t>(item) == 10u;
+      })
+      == nullptr);
+  }
+
+  SECTION("Finding a cell by position")
+  {
+    const auto* cell = layout.cellAt(5.0f, 35.0f);
+    REQUIRE(cell != nullptr);
+    CHECK(cell->itemAs<size_t>() == 9u);
+    CHECK(cell->title() == "9");
+
+    CHECK(layout.cellAt(25.0f, 35.0f) == nullptr);
+    CHECK(layout.cellAt(5.0f, 45.0f) == nullptr);
+  }
+
+  SECTION("Changing the width relayouts the items")
+  {
+    layout.setWidth(50.0f);
+
+    const auto& newRows = layout.groups().front().rows();
+    CHECK(
+      kdl::vec_transform(newRows, [](const auto& row) { return row.itemCount(); })
+      == std::vector<size_t>{5, 5});
+
+    const auto* cell = layout.cellAt(45.0f, 15.0f);
+    REQUIRE(cell != nullptr);
+    CHECK(cell->itemAs<size_t>() == 9u);
+  }
+}
+
+} // namespace TrenchBroom::View
@@ -242,6 +242,31 @@ public:
   }
 };
 
+class SizedCommand : public UndoableCommand
+{
+private:
+  size_t m_memoryUsage;
+
+public:
+  SizedCommand(std::string name, const size_t memoryUsage)
+    : UndoableCommand{std::move(name), false}
+    , m_memoryUsage{memoryUsage}
+  {
+  }
+
+  std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade*) override
+  {
+    return std::make_unique<CommandResult>(true);
+  }
+
+  std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade*) override
+  {
+    return std::make_unique<CommandResult>(true);
+  }
+
+  size_t doGetMemoryUsage() const override { return m_memoryUsage; }
+};
+
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
 {
   /*
@@ -818,5 +843,77 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
 
   commandProcessor.undo();
 }
+
+TEST_CASE("CommandProcessorTest.memoryUsage")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+  CHECK(commandProcessor.memoryUsage() == 0u);
+
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 100u));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 200u));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 300u));
+  CHECK(commandProcessor.memoryUsage() == 600u);
+
+  // undone commands are still accounted for
+  commandProcessor.undo();
+  CHECK(commandProcessor.memoryUsage() == 600u);
+
+  // executing a command clears the redo stack
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 4", 50u));
+  CHECK(commandProcessor.memoryUsage() == 350u);
+
+  SECTION("Setting a memory budget removes the oldest commands")
+  {
+    commandProcessor.setMemoryBudget(300u);
+    CHECK(commandProcessor.memoryBudget() == 300u);
+    CHECK(commandProcessor.memoryUsage() == 250u);
+
+    CHECK(commandProcessor.undoCommandName() == "command 4");
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("The most recent command is never removed")
+  {
+    commandProcessor.setMemoryBudget(10u);
+    CHECK(commandProcessor.memoryUsage() == 50u);
+
+    CHECK(commandProcessor.undoCommandName() == "command 4");
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("Storing a command removes the oldest commands")
+  {
+    commandProcessor.setMemoryBudget(400u);
+    CHECK(commandProcessor.memoryUsage() == 350u);
+
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 5", 100u));
+    CHECK(commandProcessor.memoryUsage() == 350u);
+
+    commandProcessor.undo();
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+  }
+
+  SECTION("Transactions account for their commands")
+  {
+    commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 5", 100u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 6", 100u));
+    CHECK(commandProcessor.memoryUsage() == 350u);
+
+    commandProcessor.commitTransaction();
+    CHECK(commandProcessor.memoryUsage() > 550u);
+  }
+
+  SECTION("Clearing resets the memory usage")
+  {
+    commandProcessor.clear();
+    CHECK(commandProcessor.memoryUsage() == 0u);
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -32,6 +32,8 @@
 
 #include <kdl/result.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/bbox_io.h>
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/mat_io.h>
@@ -599,6 +601,36 @@ TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.updateLastSelectionBounds")
   CHECK(document->lastSelectionBounds() == bounds);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.selectionBounds")
+{
+  const auto builder =
+    Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+  const auto box1 = vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}};
+  const auto box2 = vm::bbox3{vm::vec3{128, 0, 0}, vm::vec3{192, 32, 96}};
+
+  auto* brushNode1 = new Model::BrushNode{builder.createCuboid(box1, "texture").value()};
+  auto* brushNode2 = new Model::BrushNode{builder.createCuboid(box2, "texture").value()};
+  document->addNodes({{document->parentForNodes(), {brushNode1, brushNode2}}});
+
+  document->selectNodes({brushNode1});
+  CHECK(document->selectionBounds() == box1);
+
+  document->selectNodes({brushNode2});
+  CHECK(document->selectionBounds() == vm::merge(box1, box2));
+
+  document->deselectNodes({brushNode1});
+  CHECK(document->selectionBounds() == box2);
+
+  document->deselectAll();
+  CHECK(document->selectionBounds() == vm::bbox3{});
+
+  document->selectNodes({brushNode2, brushNode1});
+  CHECK(document->selectionBounds() == vm::merge(box1, box2));
+
+  document->translateObjects(vm::vec3{0, 0, 16});
+  CHECK(document->selectionBounds() == vm::merge(box1, box2).translate({0, 0, 16}));
+}
+
 TEST_CASE_METHOD(
   MapDocumentTest, "SelectionCommandTest.faceSelectionUndoAfterTranslationUndo")
 {
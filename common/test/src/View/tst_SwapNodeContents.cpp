@@ -32,11 +32,13 @@
 #include "Model/PatchNode.h"
 #include "TestUtils.h"
 #include "View/MapDocument.h"
+#include "View/MapDocumentCommandFacade.h"
 #include "View/MapDocumentTest.h"
 #include "View/SwapNodeContentsCommand.h"
 
 #include <kdl/memory_utils.h>
 #include <kdl/result.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/bbox.h>
 #include <vecmath/bbox_io.h>
@@ -48,6 +50,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -75,6 +78,76 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapBrushes")
 
   document->undoCommand();
   CHECK(brushNode->brush() == originalBrush);
+
+  // the geometry of the stored brush is discarded and rebuilt when it is swapped back
+  CHECK(brushNode->brush().hasGeometry());
+  CHECK_THAT(
+    brushNode->brush().vertexPositions(),
+    Catch::UnorderedEquals(originalBrush.vertexPositions()));
+
+  document->redoCommand();
+  CHECK(brushNode->brush() == modifiedBrush);
+  CHECK(brushNode->brush().hasGeometry());
+  CHECK_THAT(
+    brushNode->brush().vertexPositions(),
+    Catch::UnorderedEquals(modifiedBrush.vertexPositions()));
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.undoRedoCompressedBrushSnapshot")
+{
+  auto* facade = static_cast<MapDocumentCommandFacade*>(document.get());
+
+  auto brushNodes = std::vector<Model::BrushNode*>{};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    brushNodes.push_back(createBrushNode());
+  }
+  document->addNodes(
+    {{document->parentForNodes(), kdl::vec_static_cast<Model::Node*>(brushNodes)}});
+
+  const auto originalBrushes = kdl::vec_transform(
+    brushNodes, [](const auto* brushNode) { return brushNode->brush(); });
+
+  auto nodesToSwap = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+  auto modifiedBrushes = std::vector<Model::Brush>{};
+  for (auto* brushNode : brushNodes)
+  {
+    auto modifiedBrush = brushNode->brush();
+    REQUIRE(modifiedBrush
+              .transform(
+                document->worldBounds(),
+                vm::translation_matrix(vm::vec3{16, 0, 0}),
+                false)
+              .is_success());
+    nodesToSwap.emplace_back(brushNode, modifiedBrush);
+    modifiedBrushes.push_back(std::move(modifiedBrush));
+  }
+
+  const auto checkBrushes = [&](const auto& expectedBrushes) {
+    for (size_t i = 0; i < brushNodes.size(); ++i)
+    {
+      CHECK(brushNodes[i]->brush() == expectedBrushes[i]);
+      CHECK(brushNodes[i]->brush().hasGeometry());
+      CHECK_THAT(
+        brushNodes[i]->brush().vertexPositions(),
+        Catch::UnorderedEquals(expectedBrushes[i].vertexPositions()));
+    }
+  };
+
+  auto command = SwapNodeContentsCommand{"Swap Nodes", std::move(nodesToSwap)};
+  const auto uncompressedMemoryUsage = command.memoryUsage();
+
+  REQUIRE(command.performDo(facade)->success());
+  checkBrushes(modifiedBrushes);
+
+  // the command now stores the original brushes without their geometry
+  CHECK(command.memoryUsage() < uncompressedMemoryUsage);
+
+  REQUIRE(command.performUndo(facade)->success());
+  checkBrushes(originalBrushes);
+
+  REQUIRE(command.performDo(facade)->success());
+  checkBrushes(modifiedBrushes);
 }
 
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapPatches")
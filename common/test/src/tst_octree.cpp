@@ -546,6 +546,47 @@ TEST_CASE("octree.remove")
   }
 }
 
+TEST_CASE("octree.update_many")
+{
+  const auto makeTree = []() {
+    auto result = octree<double, int>{32.0};
+    result.insert(vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1);
+    result.insert(vm::bbox3d{{40, 2, 2}, {41, 3, 3}}, 2);
+    result.insert(vm::bbox3d{{-2, 0, 0}, {5, 3, 6}}, 3);
+    return result;
+  };
+
+  auto tree = makeTree();
+
+  SECTION("updating nodes")
+  {
+    tree.update_many({
+      {vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 1},
+      {vm::bbox3d{{-40, 2, 2}, {-39, 3, 3}}, 2},
+      {vm::bbox3d{{-3, 0, 0}, {5, 3, 6}}, 3},
+    });
+
+    auto expected = octree<double, int>{32.0};
+    expected.insert(vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 1);
+    expected.insert(vm::bbox3d{{-40, 2, 2}, {-39, 3, 3}}, 2);
+    expected.insert(vm::bbox3d{{-3, 0, 0}, {5, 3, 6}}, 3);
+
+    CHECK(tree == expected);
+  }
+
+  SECTION("updating a node that is not in the tree")
+  {
+
+    CHECK_THROWS_AS(
+      tree.update_many({
+        {vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 1},
+        {vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 4},
+      }),
+      NodeTreeException);
+    CHECK(tree == makeTree());
+  }
+}
+
 TEST_CASE("octree.insert_duplicate")
 {
   auto tree = octree<double, int>{32.0};
@@ -397,6 +397,42 @@ private:
       return result;
     }
 
+    /**
+     * Calls the given function once for every distinct value stored under the given key
+     * in this node's subtree. The key is matched exactly.
+     *
+     * @tparam F the type of the function to call
+     * @param key the key to find
+     * @param f the function to call for each value
+     */
+    template <typename F>
+    void for_each_value(const std::string_view key, const F& f) const
+    {
+      const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
+      if (m_key.size() <= key.length() && mismatch == m_key.length())
+      {
+        // m_key is a prefix of key or m_key == key
+        if (mismatch < key.length())
+        {
+          // m_key is a true prefix of key, continue at the corresponding child node
+          const auto remainder = key.substr(mismatch);
+          const auto it = m_children.find(remainder);
+          if (it != std::end(m_children))
+          {
+            it->for_each_value(remainder, f);
+          }
+        }
+        else
+        {
+          // m_key == key
+          for (const auto& [value, count] : m_values)
+          {
+            f(value);
+          }
+        }
+      }
+    }
+
     /**
      * Finds every node in this node's subtree whose keys match a pattern, and adds the
      * values to the given output iterator.
@@ -846,6 +882,20 @@ public:
     m_root.find_matches(pattern, {0u}, nullptr, match_state, out);
   }
 
+  /**
+   * Calls the given function once for every distinct value stored under the given key.
+   * Unlike `find_matches`, the key is not a pattern, and no memory is allocated.
+   *
+   * @tparam F the type of the function to call
+   * @param key the key to find
+   * @param f the function to call for each value
+   */
+  template <typename F>
+  void for_each_value(const std::string_view key, const F& f) const
+  {
+    m_root.for_each_value(key, f);
+  }
+
   /**
    * Adds the keys of all nodes in this trie to the give output iterator.
    *
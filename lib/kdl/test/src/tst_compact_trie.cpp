@@ -191,6 +191,37 @@ TEST_CASE("compact_trie_test.find_matches_with_digit_suffix")
   assertMatches(index, "k%*", {});
 }
 
+TEST_CASE("compact_trie_test.for_each_value")
+{
+  test_index index;
+  index.insert("key", "value");
+  index.insert("key", "value");
+  index.insert("key2", "value");
+  index.insert("key2", "value2");
+  index.insert("key*", "value3");
+  index.insert("k1", "value4");
+
+  const auto valuesOf = [&](const std::string& key) {
+    std::vector<std::string> values;
+    index.for_each_value(key, [&](const auto& value) { values.push_back(value); });
+    return values;
+  };
+
+  CHECK_THAT(valuesOf("whoops"), Catch::UnorderedEquals(std::vector<std::string>{}));
+  CHECK_THAT(valuesOf("ke"), Catch::UnorderedEquals(std::vector<std::string>{}));
+  CHECK_THAT(valuesOf("key"), Catch::UnorderedEquals(std::vector<std::string>{"value"}));
+  CHECK_THAT(
+    valuesOf("key2"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value", "value2"}));
+  CHECK_THAT(
+    valuesOf("key*"), Catch::UnorderedEquals(std::vector<std::string>{"value3"}));
+  CHECK_THAT(
+    valuesOf("k1"), Catch::UnorderedEquals(std::vector<std::string>{"value4"}));
+
+  index.remove("k1", "value4");
+  CHECK_THAT(valuesOf("k1"), Catch::UnorderedEquals(std::vector<std::string>{}));
+}
+
 TEST_CASE("compact_trie_test.get_keys")
 {
   test_index index;
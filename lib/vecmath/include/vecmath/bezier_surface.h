@@ -23,37 +23,119 @@
 #include "vec.h"
 
 #include <array>
+#include <iterator>
+#include <vector>
 
 namespace vm
 {
-template <typename T, size_t C>
-vec<T, C> evaluate_quadratic_bezier_surface(
-  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints, const T u, const T v)
+/**
+ * Returns the weights of the three control points of a quadratic Bezier curve at the
+ * given parameter value, i.e., the quadratic Bernstein polynomials evaluated at t.
+ *
+ * @tparam T the component type
+ * @param t the parameter value, must be in [0, 1]
+ * @return the weights of the three control points
+ */
+template <typename T>
+constexpr std::array<T, 3> quadratic_bezier_basis(const T t)
 {
-  const auto bernsteinPolynomial_0 = [](const auto x) {
-    return static_cast<T>(1) - static_cast<T>(2) * x + (x * x);
-  };
-
-  const auto bernsteinPolynomial_1 = [](const auto x) {
-    return static_cast<T>(2) * (x - (x * x));
+  return {
+    static_cast<T>(1) - static_cast<T>(2) * t + (t * t),
+    static_cast<T>(2) * (t - (t * t)),
+    t * t,
   };
+}
 
-  const auto bernsteinPolynomial_2 = [](const auto x) { return x * x; };
+namespace detail
+{
+template <typename T, size_t C>
+vec<T, C> interpolate_quadratic_bezier_curve(
+  const std::array<T, 3>& basis,
+  const vec<T, C>& p0,
+  const vec<T, C>& p1,
+  const vec<T, C>& p2)
+{
+  auto result = vec<T, C>{};
+  result = result + basis[0] * p0;
+  result = result + basis[1] * p1;
+  result = result + basis[2] * p2;
+  return result;
+}
+} // namespace detail
 
-  const auto interpolate = [&](const auto x, const std::array<vec<T, C>, 3>& p) {
-    auto result = vec<T, C>{};
-    result = result + bernsteinPolynomial_0(x) * p[0];
-    result = result + bernsteinPolynomial_1(x) * p[1];
-    result = result + bernsteinPolynomial_2(x) * p[2];
-    return result;
+template <typename T, size_t C>
+vec<T, C> evaluate_quadratic_bezier_surface(
+  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints, const T u, const T v)
+{
+  const auto interpolate = [&](const auto& basis, const std::array<vec<T, C>, 3>& p) {
+    return detail::interpolate_quadratic_bezier_curve(basis, p[0], p[1], p[2]);
   };
 
+  const auto uBasis = quadratic_bezier_basis(u);
   return interpolate(
-    v,
+    quadratic_bezier_basis(v),
     {
-      interpolate(u, controlPoints[0]),
-      interpolate(u, controlPoints[1]),
-      interpolate(u, controlPoints[2]),
+      interpolate(uBasis, controlPoints[0]),
+      interpolate(uBasis, controlPoints[1]),
+      interpolate(uBasis, controlPoints[2]),
+    });
+}
+
+/**
+ * Evaluates a quadratic Bezier surface at every combination of the given u and v
+ * parameter values, which are passed as their basis weights (see quadratic_bezier_basis).
+ * The points are written row by row to the given output iterator, that is, for the first
+ * v value and every u value, then for the second v value and every u value, and so on.
+ *
+ * The results are identical to evaluating each point separately, but since the basis
+ * weights can be computed once for many surfaces and the curves in u direction are only
+ * interpolated once per u value, this is considerably faster for larger grids.
+ *
+ * @tparam T the component type
+ * @tparam C the number of components of the control points
+ * @tparam I the type of the basis weight iterators
+ * @tparam O the type of the output iterator
+ * @param controlPoints the control points of the surface
+ * @param uBegin the first basis weights in u direction
+ * @param uEnd the end of the basis weights in u direction
+ * @param vBegin the first basis weights in v direction
+ * @param vEnd the end of the basis weights in v direction
+ * @param out the output iterator
+ * @return the output iterator after writing the points
+ */
+template <typename T, size_t C, typename I, typename O>
+O evaluate_quadratic_bezier_surface(
+  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints,
+  const I uBegin,
+  const I uEnd,
+  const I vBegin,
+  const I vEnd,
+  O out)
+{
+  // interpolate each row of control points once for every u value
+  auto columns = std::vector<std::array<vec<T, C>, 3>>{};
+  columns.reserve(static_cast<size_t>(std::distance(uBegin, uEnd)));
+  for (auto u = uBegin; u != uEnd; ++u)
+  {
+    columns.push_back({
+      detail::interpolate_quadratic_bezier_curve(
+        *u, controlPoints[0][0], controlPoints[0][1], controlPoints[0][2]),
+      detail::interpolate_quadratic_bezier_curve(
+        *u, controlPoints[1][0], controlPoints[1][1], controlPoints[1][2]),
+      detail::interpolate_quadratic_bezier_curve(
+        *u, controlPoints[2][0], controlPoints[2][1], controlPoints[2][2]),
     });
+  }
+
+  for (auto v = vBegin; v != vEnd; ++v)
+  {
+    for (const auto& column : columns)
+    {
+      *out++ =
+        detail::interpolate_quadratic_bezier_curve(*v, column[0], column[1], column[2]);
+    }
+  }
+
+  return out;
 }
 } // namespace vm
@@ -24,7 +24,9 @@
 #include <vecmath/vec_io.h>
 
 #include <array>
+#include <iterator>
 #include <tuple>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -82,4 +84,53 @@ TEST_CASE("evaluate_quadratic_bezier_surface")
 
   CHECK(evaluate_quadratic_bezier_surface(controlPoints, u, v) == expected);
 }
+
+TEST_CASE("evaluate_quadratic_bezier_surface.grid")
+{
+  // clang-format off
+  const auto controlPoints = std::array<std::array<vm::vec<double, 5>, 3>, 3>{
+    std::array<vm::vec<double, 5>, 3>{
+      vec<double, 5>{0, 0, 0, 0.0, 0.0}, vec<double, 5>{1, 0, 1, 0.5, 0.0}, vec<double, 5>{2, 0, 0, 1.0, 0.0} },
+    std::array<vm::vec<double, 5>, 3>{
+      vec<double, 5>{0, 1, 1, 0.0, 0.5}, vec<double, 5>{1, 1, 2, 0.5, 0.5}, vec<double, 5>{2, 1, 1, 1.0, 0.5} },
+    std::array<vm::vec<double, 5>, 3>{
+      vec<double, 5>{0, 2, 0, 0.0, 1.0}, vec<double, 5>{1, 2, 1, 0.5, 1.0}, vec<double, 5>{2, 2, 0, 1.0, 1.0} },
+  };
+  // clang-format on
+
+  const auto uValues = std::vector<double>{0.0, 0.125, 0.25, 0.5, 0.75, 1.0};
+  const auto vValues = std::vector<double>{0.0, 1.0 / 3.0, 2.0 / 3.0, 1.0};
+
+  auto uBasis = std::vector<std::array<double, 3>>{};
+  for (const auto u : uValues)
+  {
+    uBasis.push_back(quadratic_bezier_basis(u));
+  }
+
+  auto vBasis = std::vector<std::array<double, 3>>{};
+  for (const auto v : vValues)
+  {
+    vBasis.push_back(quadratic_bezier_basis(v));
+  }
+
+  auto expected = std::vector<vec<double, 5>>{};
+  for (const auto v : vValues)
+  {
+    for (const auto u : uValues)
+    {
+      expected.push_back(evaluate_quadratic_bezier_surface(controlPoints, u, v));
+    }
+  }
+
+  auto actual = std::vector<vec<double, 5>>{};
+  evaluate_quadratic_bezier_surface(
+    controlPoints,
+    uBasis.begin(),
+    uBasis.end(),
+    vBasis.begin(),
+    vBasis.end(),
+    std::back_inserter(actual));
+
+  CHECK(actual == expected);
+}
 } // namespace vm